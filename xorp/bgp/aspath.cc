@@ -402,6 +402,8 @@ ASPath::ASPath(const char *as_path) throw(InvalidString)
     debug_msg("ASPath(%s) constructor called\n", as_path);
     _num_segments = 0;
     _path_len = 0;
+    _hash = 0;
+    _hash_valid = false;
 
     // make a copy removing all spaces from the string.
 
@@ -551,6 +553,8 @@ ASPath::ASPath(const ASPath &asp1, const ASPath &asp2)
 {
     _num_segments = 0;
     _path_len = 0;
+    _hash = 0;
+    _hash_valid = false;
 
     size_t curseg;
     size_t matchelem = 0;
@@ -618,6 +622,7 @@ ASPath::add_segment(const ASSegment& s)
     debug_msg("Adding As Segment\n");
     _segments.push_back(s);
     _num_segments++;
+    invalidate_hash();
 
     size_t n = s.path_length();
     _path_len += n;
@@ -631,6 +636,7 @@ ASPath::prepend_segment(const ASSegment& s)
     debug_msg("Prepending As Segment\n");
     _segments.push_front(s);
     _num_segments++;
+    invalidate_hash();
 
     size_t n = s.path_length();
     _path_len += n;
@@ -713,6 +719,7 @@ ASPath::prepend_as(const AsNum &asn)
 	_segments.front().prepend_as(asn);
     }
     _path_len++;	// in both cases the length increases by one.
+    invalidate_hash();
 }
 
 void
@@ -730,25 +737,25 @@ ASPath::prepend_confed_as(const AsNum &asn)
 	_segments.front().prepend_as(asn);
     }
     _path_len++;	// in both cases the length increases by one.
+    invalidate_hash();
 }
 
 void
 ASPath::remove_confed_segments()
 {
         debug_msg("Deleting all CONFED Segments\n");
-	const_iterator iter = _segments.begin();
-	const_iterator next_iter;
+	iterator iter = _segments.begin();
 	while (iter != _segments.end()) {
-	    next_iter = iter;
-	    ++next_iter;
 	    if ((*iter).type() == AS_CONFED_SEQUENCE 
 		|| (*iter).type() == AS_CONFED_SET) {
-		_path_len--;
+		_path_len -= (*iter).path_length();
 		_num_segments--;
-		_segments.remove((*iter)); 
-	    } 
-	    iter = next_iter;
+		iter = _segments.erase(iter);
+	    } else {
+		++iter;
+	    }
 	}
+	invalidate_hash();
 }
 
 bool
@@ -766,16 +773,15 @@ ASPath::contains_confed_segments() const
 ASPath&
 ASPath::operator=(const ASPath& him)
 {
-    // clear out my list
-    while (!_segments.empty()) {
-	_segments.pop_front();
-    }
+    if (this == &him)
+	return *this;
+
+    _segments = him._segments;
+    _num_segments = him._num_segments;
+    _path_len = him._path_len;
+    _hash = him._hash;
+    _hash_valid = him._hash_valid;
 
-    // copy in from his
-    const_iterator i;
-    for (i = him._segments.begin() ;i != him._segments.end(); i++) {
-	_segments.push_back(*i);
-    }
     return *this;
 }
 
@@ -784,6 +790,8 @@ ASPath::operator==(const ASPath& him) const
 {
     if (_num_segments != him._num_segments) 
 	return false;
+    if (_hash_valid && him._hash_valid && _hash != him._hash)
+	return false;
     const_iterator my_i = _segments.begin();
     const_iterator his_i = him._segments.begin();
     for (;my_i != _segments.end(); my_i++, his_i++)
@@ -846,6 +854,21 @@ ASPath::two_byte_compatible() const
     return true;
 }
 
+uint32_t
+ASPath::compute_hash() const
+{
+    // FNV-1a over the segment types and AS numbers.
+    uint32_t h = 2166136261U;
+
+    for (const_iterator i = _segments.begin(); i != _segments.end(); ++i) {
+	h = (h ^ static_cast<uint32_t>(i->type())) * 16777619U;
+	for (size_t j = 0; j < i->as_size(); j++)
+	    h = (h ^ i->as_num(j).as4()) * 16777619U;
+    }
+
+    return h;
+}
+
 void 
 ASPath::merge_as4_path(AS4Path& as4_path)
 {
@@ -898,15 +921,16 @@ AS4Path::decode(const uint8_t *d, size_t l) throw(CorruptMessage)
 void AS4Path::cross_validate(const ASPath& as_path)
 {
     debug_msg("cross validate\n%s\n%s\n", str().c_str(), as_path.str().c_str());
+    invalidate_hash();
 	      
     if (as_path.path_length() < path_length() ) {
 	debug_msg("as_path.path_length() < path_length()\n");
 	// This is illegal.  The spec says to ignore the AS4_PATH
 	// attribute and use the data from the AS_PATH attribute throw
 	// away the data we had.
-	while (!_segments.empty()) {
-	    _segments.pop_front();
-	}
+	_segments.clear();
+	_num_segments = 0;
+	_path_len = 0;
 	// copy in from the AS_PATH version 
 	for (uint32_t i = 0; i < as_path.num_segments(); i++) {
 	    debug_msg("adding %u %s\n", i, as_path.segment(i).str().c_str()); 
@@ -971,6 +995,7 @@ void AS4Path::cross_validate(const ASPath& as_path)
 
 void AS4Path::pad_segment(const ASSegment& old_seg, ASSegment& new_seg) 
 {
+    invalidate_hash();
     debug_msg("pad: new type: %u\n", new_seg.type());
     if (new_seg.type() == AS_SET) {
 	debug_msg("new == AS_SET\n");
@@ -1037,6 +1062,7 @@ void AS4Path::do_patchup(const ASPath& as_path)
     // the AS4_PATH with an AS_SET containing anything that wasn't
     // previously in the AS4_PATH.  This at least should prevent
     // loops forming, but it's really ugly.
+    invalidate_hash();
 
     ASSegment new_set(AS_SET);
     for (uint32_t i = 0; i < as_path.path_length(); i++) {
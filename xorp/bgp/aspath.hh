@@ -26,6 +26,9 @@
 #include <sys/types.h>
 #include <inttypes.h>
 
+#include <new>
+#include <iterator>
+
 
 
 
@@ -116,12 +119,115 @@ enum ASPathSegType {
     AS_CONFED_SET = 4
 };
 
+/**
+ * A list of AS numbers stored in contiguous memory.
+ *
+ * Most AS segments are short, so up to INLINE_SIZE AS numbers are
+ * stored within the object and only longer segments allocate memory.
+ * AsNum is a plain 32 bit value, so entries are moved with memcpy().
+ */
+class ASList {
+public:
+    typedef AsNum*					iterator;
+    typedef const AsNum*				const_iterator;
+    typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+    static const size_t INLINE_SIZE = 6;
+
+    ASList() : _data(inline_data()), _size(0), _capacity(INLINE_SIZE) {}
+
+    ASList(const ASList& l)
+	: _data(inline_data()), _size(0), _capacity(INLINE_SIZE) {
+	assign(l);
+    }
+
+    ~ASList()						{ release(); }
+
+    ASList& operator=(const ASList& l) {
+	if (this != &l)
+	    assign(l);
+	return *this;
+    }
+
+    size_t size() const					{ return _size; }
+    bool empty() const					{ return _size == 0; }
+    void clear()					{ _size = 0; }
+
+    iterator begin()					{ return _data; }
+    iterator end()					{ return _data + _size; }
+    const_iterator begin() const			{ return _data; }
+    const_iterator end() const				{ return _data + _size; }
+    const_reverse_iterator rbegin() const {
+	return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const	{
+	return const_reverse_iterator(begin());
+    }
+
+    const AsNum& front() const				{ return _data[0]; }
+    const AsNum& operator[](size_t n) const		{ return _data[n]; }
+
+    void push_back(const AsNum& n) {
+	reserve(_size + 1);
+	new (_data + _size) AsNum(n);
+	_size++;
+    }
+
+    void push_front(const AsNum& n) {
+	reserve(_size + 1);
+	memmove(_data + 1, _data, _size * sizeof(AsNum));
+	new (_data) AsNum(n);
+	_size++;
+    }
+
+private:
+    AsNum* inline_data() {
+	return reinterpret_cast<AsNum*>(_inline);
+    }
+
+    void release() {
+	if (_data != inline_data())
+	    delete[] reinterpret_cast<char*>(_data);
+    }
+
+    void assign(const ASList& l) {
+	_size = 0;
+	reserve(l._size);
+	memcpy(_data, l._data, l._size * sizeof(AsNum));
+	_size = l._size;
+    }
+
+    void reserve(size_t n) {
+	if (n <= _capacity)
+	    return;
+
+	size_t capacity = 2 * _capacity;
+	if (capacity < n)
+	    capacity = n;
+
+	AsNum* data = reinterpret_cast<AsNum*>(new char[capacity *
+							sizeof(AsNum)]);
+	memcpy(data, _data, _size * sizeof(AsNum));
+	release();
+	_data = data;
+	_capacity = capacity;
+    }
+
+    AsNum*	_data;
+    uint32_t	_size;
+    uint32_t	_capacity;
+    union {
+	uint32_t	_align;
+	char		_inline[INLINE_SIZE * sizeof(AsNum)];
+    };
+};
+
 /**
  * Parent class for ASPath elements, which can be either ASSet or ASSequence.
  */
 class ASSegment {
 public:
-    typedef list<AsNum> ASLIST;
+    typedef ASList ASLIST;
     typedef ASLIST::iterator iterator;
     typedef ASLIST::const_iterator const_iterator;
     typedef ASLIST::const_reverse_iterator const_reverse_iterator;
@@ -218,12 +324,7 @@ public:
      * find the n'th AS number in the segment 
      */
     const AsNum& as_num(int n) const			{
-	const_iterator i = _aslist.begin();
-
-	while (n--)
-	    i++;
-
-	return *i;
+	return _aslist[n];
     }
 
     /**
@@ -324,7 +425,7 @@ public:
     typedef list <ASSegment>::const_iterator const_iterator;
     typedef list <ASSegment>::iterator iterator;
 
-    ASPath() : _num_segments(0), _path_len(0)		{}
+    ASPath() : _num_segments(0), _path_len(0), _hash(0), _hash_valid(false) {}
 
     /**
      * Initialize from a string in the format
@@ -335,7 +436,8 @@ public:
     /**
      * construct from received data
      */
-    ASPath(const uint8_t* d, size_t len) throw(CorruptMessage) {
+    ASPath(const uint8_t* d, size_t len) throw(CorruptMessage)
+	: _hash(0), _hash_valid(false) {
 	decode(d, len); 
     }
 
@@ -348,7 +450,8 @@ public:
      * Copy constructor
      */
     ASPath(const ASPath &a) : _segments(a._segments), 
-	_num_segments(a._num_segments), _path_len(a._path_len) {}
+	_num_segments(a._num_segments), _path_len(a._path_len),
+	_hash(a._hash), _hash_valid(a._hash_valid) {}
 
     ~ASPath()						{}
 
@@ -386,6 +489,18 @@ public:
 
     size_t num_segments() const			{ return _num_segments; }
 
+    /**
+     * @return a hash of the AS path.  It is computed when first needed
+     * and kept until the path is modified.
+     */
+    uint32_t hash() const				{
+	if (!_hash_valid) {
+	    _hash = compute_hash();
+	    _hash_valid = true;
+	}
+	return _hash;
+    }
+
     /**
      * Convert from internal to external representation, with the
      * correct representation for the original AS_PATH attribute.  If
@@ -458,8 +573,17 @@ protected:
     list <ASSegment>	_segments;
     size_t		_num_segments;
     size_t		_path_len;
+    mutable uint32_t	_hash;
+    mutable bool	_hash_valid;	// false if _hash must be recomputed.
+
+    /**
+     * Must be called whenever the path is modified.
+     */
+    void invalidate_hash()				{ _hash_valid = false; }
 
 private:
+    uint32_t compute_hash() const;
+
     /**
      * populate an ASPath from received data. Only used in the constructor.
      */
@@ -30,7 +30,10 @@
 #include <getopt.h>
 #endif
 
+#include "libxorp/timer.hh"
+
 #include "aspath.hh"
+#include "path_attribute.hh"
 
 void
 test_string(bool verbose)
@@ -284,21 +287,144 @@ test_as4_coding_compat(bool verbose)
     assert(compat_aspath == dec_aspath);
 }
 
+/**
+ * Print the time taken by a benchmark.
+ */
+static void
+report(const char* name, const TimeVal& start, uint32_t iterations)
+{
+    TimeVal end;
+    TimerList::system_gettimeofday(&end);
+
+    double elapsed = (end - start).to_ms();
+    printf("%-32s %8u iterations %10.3f ms %8.1f ns/op\n", name,
+	   XORP_UINT_CAST(iterations), elapsed,
+	   iterations ? elapsed * 1000000.0 / iterations : 0.0);
+}
+
+void
+bench_aspath(uint32_t iterations)
+{
+    /*********************************************************************/
+    /**** benchmark of the common AS path operations                  ****/
+    /*********************************************************************/
+
+    ASPath aspath("65008,3356,1299,2914,{64512,64513},6939,174,701");
+    size_t len = aspath.wire_size();
+    uint8_t *buf = new uint8_t[len];
+    aspath.encode(len, buf);
+
+    TimeVal start;
+    uint32_t found = 0;
+
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	ASPath dec_aspath(buf, len);
+	found += dec_aspath.path_length();
+    }
+    report("ASPath decode", start, iterations);
+
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	ASPath copy(aspath);
+	copy.prepend_as(AsNum(65000));
+	found += copy.path_length();
+    }
+    report("ASPath copy and prepend", start, iterations);
+
+    AsNum missing(65001);
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	if (aspath.contains(missing))
+	    found++;
+    }
+    report("ASPath loop detection", start, iterations);
+
+    ASPath other(buf, len);
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	if (aspath == other)
+	    found++;
+    }
+    report("ASPath compare", start, iterations);
+
+    delete []buf;
+
+    // Keep the compiler from optimising the loops away.
+    if (found == 0)
+	printf("\n");
+}
+
+void
+bench_community(uint32_t iterations)
+{
+    /*********************************************************************/
+    /**** benchmark of community attribute decoding and matching      ****/
+    /*********************************************************************/
+
+    CommunityAttribute ca;
+    for (uint32_t i = 0; i < 32; i++)
+	ca.add_community((3356 << 16) | (i * 7));
+    ca.add_community(CommunityAttribute::NO_EXPORT);
+
+    uint8_t buf[512];
+    size_t len = sizeof(buf);
+    bool encoded = ca.encode(buf, len, NULL);
+    assert(encoded);
+
+    TimeVal start;
+    uint32_t found = 0;
+
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	CommunityAttribute dec_ca(buf);
+	found += dec_ca.community_set().size();
+    }
+    report("Community decode", start, iterations);
+
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	if (ca.contains((3356 << 16) | (i % 256)))
+	    found++;
+    }
+    report("Community match", start, iterations);
+
+    TimerList::system_gettimeofday(&start);
+    for (uint32_t i = 0; i < iterations; i++) {
+	if (ca.contains(CommunityAttribute::NO_ADVERTISE))
+	    found++;
+    }
+    report("Community well-known match", start, iterations);
+
+    // Keep the compiler from optimising the loops away.
+    if (found == 0)
+	printf("\n");
+}
 
 int
 main(int argc, char* argv[])
 {
     int c;
     bool verbose = false;
+    uint32_t bench = 0;
 
-    while ((c = getopt(argc, argv, "v")) != EOF) {
+    while ((c = getopt(argc, argv, "vb:")) != EOF) {
 	switch (c) {
 	case 'v':
 	    verbose = true;
 	    break;
+	case 'b':
+	    bench = atoi(optarg);
+	    break;
 	}
     }
 
+    if (bench != 0) {
+	bench_aspath(bench);
+	bench_community(bench);
+	exit(0);
+    }
+
     AsNum *as[13];
     int i;
     for (i=0;i<=9;i++) {
@@ -89,6 +89,18 @@ BGPMain::BGPMain(EventLoop& eventloop)
     palist4->create_attribute_manager();
     delete palist4;
 
+    // Variables which policies can't modify.  They allow a policy push to
+    // skip routes that the changed terms can't match.  The neighbor is the
+    // origin peer in the import and source match filters only.
+    set<VarRW::Id> immutable;
+    immutable.insert(BGPVarRW<IPv4>::VAR_NETWORK4);
+    immutable.insert(BGPVarRW<IPv4>::VAR_NETWORK6);
+    _policy_filters.set_immutable_vars(filter::EXPORT, immutable);
+
+    immutable.insert(BGPVarRW<IPv4>::VAR_NEIGHBOR);
+    _policy_filters.set_immutable_vars(filter::IMPORT, immutable);
+    _policy_filters.set_immutable_vars(filter::EXPORT_SOURCEMATCH, immutable);
+
     _plumbing_unicast = new BGPPlumbing(SAFI_UNICAST,
 					_rib_ipc_handler,
 					_aggregation_handler,
@@ -1910,6 +1922,12 @@ BGPMain::reset_filter(const uint32_t& filter)
     _policy_filters.reset(filter);
 }
 
+string
+BGPMain::filter_statistics(const uint32_t& filter)
+{
+    return _policy_filters.statistics(filter);
+}
+
 void
 BGPMain::push_routes()
 {
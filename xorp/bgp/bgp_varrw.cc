@@ -136,87 +136,91 @@ BGPVarRW<A>::read_filter_ex()
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv4>::read_network4()
 {
-    return new ElemIPv4Net(_rtmsg->route()->net());
+    _network_elem.set_val(_rtmsg->route()->net());
+    return &_network_elem;
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv6>::read_network4()
 {
-    return NULL;
+    return null_element();
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv6>::read_network6()
 {
-    return _ef.create(ElemIPv6Net::id, 
-		      _rtmsg->route()->net().str().c_str());
+    _network_elem.set_val(_rtmsg->route()->net());
+    return &_network_elem;
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv4>::read_network6()
 {
-    return NULL;
+    return null_element();
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv6>::read_nexthop6()
 {
-    return _ef.create(ElemIPv6NextHop::id, 
-		      _palist->nexthop().str().c_str());
+    _nexthop_elem.set_val(_palist->nexthop());
+    return &_nexthop_elem;
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv4>::read_nexthop6()
 {
-    return NULL;
+    return null_element();
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv4>::read_nexthop4()
 {
-    return new ElemIPv4NextHop(_palist->nexthop());
+    _nexthop_elem.set_val(_palist->nexthop());
+    return &_nexthop_elem;
 }
 
 template <>
-Element*
+const Element*
 BGPVarRW<IPv6>::read_nexthop4()
 {
-    return NULL;
+    return null_element();
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_aspath()
 {
-    return new ElemASPath(_palist->aspath());
+    _aspath_elem.set_val(_palist->aspath());
+    return &_aspath_elem;
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_origin()
 {
-    uint32_t origin = _palist->origin();
-    return _ef.create(ElemU32::id, to_str(origin).c_str());
+    _origin_elem.set_val(_palist->origin());
+    return &_origin_elem;
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_localpref()
 {
     const LocalPrefAttribute* lpref = _palist->local_pref_att(); 
     if (lpref) {
-	return _ef.create(ElemU32::id, to_str(lpref->localpref()).c_str());
+	_localpref_elem.set_val(lpref->localpref());
+	return &_localpref_elem;
     } else
-	return NULL;
+	return null_element();
 }
 
 template <class A>
@@ -231,59 +235,63 @@ BGPVarRW<A>::read_community()
 
     ElemSetCom32* es = new ElemSetCom32;
 
-    const set<uint32_t>& com = ca->community_set();
-    for (set<uint32_t>::const_iterator i = com.begin(); i != com.end(); ++i) 
+    const vector<uint32_t>& com = ca->community_set();
+    for (CommunityAttribute::const_iterator i = com.begin(); i != com.end();
+	 ++i)
 	es->insert(ElemCom32(*i));
     
     return es;
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_med()
 {
     const MEDAttribute* med = _palist->med_att();
-    if (med)
-	return new ElemU32(med->med());
-    else
-	return NULL;
+    if (med) {
+	_med_elem.set_val(med->med());
+	return &_med_elem;
+    } else
+	return null_element();
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_med_remove()
 {
     const MEDAttribute* med = _palist->med_att();
-    if (med)
-	return new ElemBool(false);	// XXX: default is don't remove the MED
-    else
-	return NULL;
+    if (med) {
+	_med_remove_elem.set_val(false); // XXX: default is don't remove the MED
+	return &_med_remove_elem;
+    } else
+	return null_element();
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_aggregate_prefix_len()
 {
     // No-op. Should never be called.
-    return new ElemU32(_aggr_prefix_len);
+    _aggr_prefix_len_elem.set_val(_aggr_prefix_len);
+    return &_aggr_prefix_len_elem;
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_aggregate_brief_mode()
 {
     // No-op. Should never be called.
-    return new ElemU32(_aggr_brief_mode);
+    _aggr_brief_mode_elem.set_val(_aggr_brief_mode);
+    return &_aggr_brief_mode_elem;
 }
 
 template <class A>
-Element*
+const Element*
 BGPVarRW<A>::read_was_aggregated()
 {
-    if (_aggr_prefix_len == SR_AGGR_EBGP_WAS_AGGREGATED)
-	return new ElemBool(true);
-    else
-	return new ElemBool(false);
+    _was_aggregated_elem.set_val(_aggr_prefix_len ==
+				 SR_AGGR_EBGP_WAS_AGGREGATED);
+    return &_was_aggregated_elem;
 }
 
 template <class A>
@@ -295,6 +303,18 @@ BGPVarRW<A>::single_read(const Id& id)
     return (this->*cb)();
 }
 
+template <class A>
+const Element*
+BGPVarRW<A>::single_read_typed(const Id& id)
+{
+    TypedReadCallback cb = _callbacks._typed_read_map[id];
+
+    if (!cb)
+	return NULL;
+
+    return (this->*cb)();
+}
+
 template <class A>
 void
 BGPVarRW<A>::write_community(const Element& e)
@@ -690,45 +710,47 @@ BGPVarRWCallbacks<A>::BGPVarRWCallbacks()
     init_rw(VarRW::VAR_FILTER_EX, 
 	    &BGPVarRW<A>::read_filter_ex, &BGPVarRW<A>::write_filter_ex);
 
-    init_rw(BGPVarRW<A>::VAR_NETWORK4, &BGPVarRW<A>::read_network4, NULL);
+    init_typed_rw(BGPVarRW<A>::VAR_NETWORK4,
+		  &BGPVarRW<A>::read_network4, NULL);
     
-    init_rw(BGPVarRW<A>::VAR_NEXTHOP4, 
+    init_typed_rw(BGPVarRW<A>::VAR_NEXTHOP4, 
 	    &BGPVarRW<A>::read_nexthop4, &BGPVarRW<A>::write_nexthop4);
 
-    init_rw(BGPVarRW<A>::VAR_NETWORK6, &BGPVarRW<A>::read_network6, NULL);
+    init_typed_rw(BGPVarRW<A>::VAR_NETWORK6,
+		  &BGPVarRW<A>::read_network6, NULL);
     
-    init_rw(BGPVarRW<A>::VAR_NEXTHOP6, 
+    init_typed_rw(BGPVarRW<A>::VAR_NEXTHOP6, 
 	    &BGPVarRW<A>::read_nexthop6, &BGPVarRW<A>::write_nexthop6);
 
-    init_rw(BGPVarRW<A>::VAR_ASPATH, 
+    init_typed_rw(BGPVarRW<A>::VAR_ASPATH, 
 	    &BGPVarRW<A>::read_aspath, &BGPVarRW<A>::write_aspath);
 
-    init_rw(BGPVarRW<A>::VAR_ORIGIN, 
+    init_typed_rw(BGPVarRW<A>::VAR_ORIGIN, 
 	    &BGPVarRW<A>::read_origin, &BGPVarRW<A>::write_origin);
 
     init_rw(BGPVarRW<A>::VAR_NEIGHBOR, &BGPVarRW<A>::read_neighbor_base_cb, NULL);
 
-    init_rw(BGPVarRW<A>::VAR_LOCALPREF, 
+    init_typed_rw(BGPVarRW<A>::VAR_LOCALPREF, 
 	    &BGPVarRW<A>::read_localpref, &BGPVarRW<A>::write_localpref);
 
     init_rw(BGPVarRW<A>::VAR_COMMUNITY, 
 	    &BGPVarRW<A>::read_community, &BGPVarRW<A>::write_community);
 
-    init_rw(BGPVarRW<A>::VAR_MED, 
+    init_typed_rw(BGPVarRW<A>::VAR_MED, 
 	    &BGPVarRW<A>::read_med, &BGPVarRW<A>::write_med);
 
-    init_rw(BGPVarRW<A>::VAR_MED_REMOVE, 
+    init_typed_rw(BGPVarRW<A>::VAR_MED_REMOVE, 
 	    &BGPVarRW<A>::read_med_remove, &BGPVarRW<A>::write_med_remove);
 
-    init_rw(BGPVarRW<A>::VAR_AGGREGATE_PREFIX_LEN, 
+    init_typed_rw(BGPVarRW<A>::VAR_AGGREGATE_PREFIX_LEN, 
 	    &BGPVarRW<A>::read_aggregate_prefix_len,
 	    &BGPVarRW<A>::write_aggregate_prefix_len);
 
-    init_rw(BGPVarRW<A>::VAR_AGGREGATE_BRIEF_MODE, 
+    init_typed_rw(BGPVarRW<A>::VAR_AGGREGATE_BRIEF_MODE, 
 	    &BGPVarRW<A>::read_aggregate_brief_mode,
 	    &BGPVarRW<A>::write_aggregate_brief_mode);
 
-    init_rw(BGPVarRW<A>::VAR_WAS_AGGREGATED, 
+    init_typed_rw(BGPVarRW<A>::VAR_WAS_AGGREGATED, 
 	    &BGPVarRW<A>::read_was_aggregated,
 	    &BGPVarRW<A>::write_was_aggregated);
 }
@@ -743,6 +765,16 @@ BGPVarRWCallbacks<A>::init_rw(const VarRW::Id& id, RCB rcb, WCB wcb)
 	_write_map[id] = wcb;
 }
 
+template <class A>
+void
+BGPVarRWCallbacks<A>::init_typed_rw(const VarRW::Id& id, TRCB rcb, WCB wcb)
+{
+    if (rcb)
+	_typed_read_map[id] = rcb;
+    if (wcb)
+	_write_map[id] = wcb;
+}
+
 template class BGPVarRW<IPv4>;
 template class BGPVarRW<IPv6>;
 
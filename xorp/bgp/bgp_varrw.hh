@@ -25,6 +25,8 @@
 
 #include "policy/backend/single_varrw.hh"
 #include "policy/common/element_factory.hh"
+#include "policy/common/element.hh"
+#include "policy/common/elem_bgp.hh"
 #include "internal_message.hh"
 
 template <class A>
@@ -63,6 +65,7 @@ public:
     };
 
     typedef Element* (BGPVarRW::*ReadCallback)();
+    typedef const Element* (BGPVarRW::*TypedReadCallback)();
     typedef void (BGPVarRW::*WriteCallback)(const Element& e);
 
     /**
@@ -97,6 +100,7 @@ public:
     
     // SingleVarRW interface
     Element* single_read(const Id& id);
+    const Element* single_read_typed(const Id& id);
 
     void single_write(const Id& id, const Element& e);
     void end_write();
@@ -135,22 +139,23 @@ public:
     Element* read_filter_sm();
     Element* read_filter_ex();
 
-    Element* read_network4();
-    Element* read_network6();
+    // Typed reads, into elements owned by the varrw
+    const Element* read_network4();
+    const Element* read_network6();
 
-    Element* read_nexthop4();
-    Element* read_nexthop6();
-    Element* read_aspath();
-    Element* read_origin();
+    const Element* read_nexthop4();
+    const Element* read_nexthop6();
+    const Element* read_aspath();
+    const Element* read_origin();
 
-    Element* read_localpref();
+    const Element* read_localpref();
     Element* read_community();
-    Element* read_med();
-    Element* read_med_remove();
+    const Element* read_med();
+    const Element* read_med_remove();
 
-    Element* read_aggregate_prefix_len();
-    Element* read_aggregate_brief_mode();
-    Element* read_was_aggregated();
+    const Element* read_aggregate_prefix_len();
+    const Element* read_aggregate_brief_mode();
+    const Element* read_was_aggregated();
 
     Element* read_tag();
 
@@ -201,6 +206,18 @@ private:
     uint32_t			_aggr_prefix_len;
     bool			_aggr_brief_mode;
 
+    // Elements returned by typed reads, valid until the next sync
+    ElemNet<IPNet<A> >		_network_elem;
+    ElemNextHop<A>		_nexthop_elem;
+    ElemASPath			_aspath_elem;
+    ElemU32			_origin_elem;
+    ElemU32			_localpref_elem;
+    ElemU32			_med_elem;
+    ElemBool			_med_remove_elem;
+    ElemU32			_aggr_prefix_len_elem;
+    ElemU32			_aggr_brief_mode_elem;
+    ElemBool			_was_aggregated_elem;
+
     // not impl
     BGPVarRW(const BGPVarRW&);
     BGPVarRW& operator=(const BGPVarRW&);
@@ -213,13 +230,16 @@ class BGPVarRWCallbacks {
 public:
     // XXX don't know how to refer to BGPVarRW<A>::ReadCallback in gcc 2.95
     typedef Element* (BGPVarRW<A>::*RCB)();
+    typedef const Element* (BGPVarRW<A>::*TRCB)();
     typedef void (BGPVarRW<A>::*WCB)(const Element&);
 
     void init_rw(const VarRW::Id&, RCB, WCB);
+    void init_typed_rw(const VarRW::Id&, TRCB, WCB);
 
     BGPVarRWCallbacks();
 
     RCB _read_map[BGPVarRW<A>::VAR_BGPMAX];
+    TRCB _typed_read_map[BGPVarRW<A>::VAR_BGPMAX];
     WCB _write_map[BGPVarRW<A>::VAR_BGPMAX];
 };
 
@@ -80,6 +80,14 @@ class Damping {
 	return merit > _reuse;
     }
 
+    /**
+     * True if a figure of merit last updated at this time has decayed
+     * completely. Forgetting it makes no difference.
+     */
+    bool idle(uint32_t last_time) const {
+	return get_tick() - last_time >= _max_hold_down * 60;
+    }
+
     /**
      * Compute how long the route should be damped in seconds.
      * The time for this figure of merit to decay to the reuse threshold.
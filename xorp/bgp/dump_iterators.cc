@@ -145,6 +145,8 @@ DumpIterator<A>::DumpIterator(const PeerHandler* peer,
     }
     _route_iterator_is_valid = false;
     _routes_dumped_on_current_peer = false;
+    _routes_examined = 0;
+    _routes_reevaluated = 0;
 }
 
 template <class A>
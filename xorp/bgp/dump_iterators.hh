@@ -169,6 +169,27 @@ public:
      * @return true if the iterator got moved since the last delete
      */
     bool iterator_got_moved(IPNet<A> new_net) const;
+
+    /**
+     * Account for a route looked at by a policy route dump.
+     *
+     * @param reevaluated true if the policy filters had to be run again.
+     */
+    void policy_route_examined(bool reevaluated) {
+	_routes_examined++;
+	if (reevaluated)
+	    _routes_reevaluated++;
+    }
+
+    /**
+     * @return number of routes looked at by a policy route dump.
+     */
+    uint32_t routes_examined() const { return _routes_examined; }
+
+    /**
+     * @return number of routes a policy route dump had to filter again.
+     */
+    uint32_t routes_reevaluated() const { return _routes_reevaluated; }
 private:
     const PeerHandler *_peer;
 
@@ -188,6 +209,8 @@ private:
 
     map <const PeerHandler*, PeerDumpState<A>* > _peers;
 
+    uint32_t _routes_examined;
+    uint32_t _routes_reevaluated;
 };
 
 #endif // __BGP_DUMP_ITERATORS_HH__
@@ -0,0 +1,524 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+//
+// Initial convergence benchmark.
+//
+// Replays the UPDATEs of an MRTD file, in the format written by the
+// test_peer "dump" command, from a number of EBGP peers into a BGP
+// process and times how long it takes before every route has been sent
+// on to one more EBGP peer.  There are no sockets: each UPDATE is
+// decoded and handed to the PeerHandler as BGPPeer does when it reads
+// one, so the time is split between decoding and everything after it
+// (import filtering, decision, fanout and export).  Without a RIB every
+// nexthop resolves.
+//
+// With -g a synthetic full table is written to the file first.
+//
+
+#include "bgp/bgp_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+#include "libxorp/timer.hh"
+
+#include "policy/common/filter.hh"
+
+#include "bgp/bgp.hh"
+#include "bgp/bgp_varrw.hh"
+#include "bgp/peer.hh"
+#include "bgp/peer_handler.hh"
+#include "bgp/packet.hh"
+
+#ifdef HAVE_GETOPT_H
+#include <getopt.h>
+#endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+
+namespace {
+
+/**
+ * An EBGP peer without a session.  The UPDATEs sent to it are counted and
+ * the routes it has been sent are tracked.
+ */
+class BenchPeer : public BGPPeer {
+public:
+    BenchPeer(LocalData* ld, BGPPeerData* pd, BGPMain* m)
+	: BGPPeer(ld, pd, NULL, m), _updates(0), _nlri(0), _withdrawn(0) {}
+
+    PeerOutputState send_update_message(const UpdatePacket& p) {
+	_updates++;
+	_nlri += p.nlri_list().size();
+	_withdrawn += p.wr_list().size();
+
+	BGPUpdateAttribList::const_iterator i;
+	for (i = p.wr_list().begin(); i != p.wr_list().end(); ++i)
+	    _routes.erase(i->net());
+	for (i = p.nlri_list().begin(); i != p.nlri_list().end(); ++i)
+	    _routes.insert(i->net());
+	TimerList::system_gettimeofday(&_last_update);
+	return PEER_OUTPUT_OK;
+    }
+
+    uint64_t updates() const { return (_updates); }
+    uint64_t nlri() const { return (_nlri); }
+    uint64_t withdrawn() const { return (_withdrawn); }
+    size_t routes() const { return (_routes.size()); }
+    const TimeVal& last_update() const { return (_last_update); }
+
+private:
+    uint64_t	_updates;
+    uint64_t	_nlri;
+    uint64_t	_withdrawn;
+    TimeVal	_last_update;	// When the last UPDATE was sent
+    set<IPv4Net> _routes;	// The routes this peer has been sent
+};
+
+struct conf {
+    string	c_file;
+    string	c_finder;
+    unsigned	c_peers;
+    bool	c_policy;
+    unsigned	c_generate;
+    unsigned	c_attributes;
+} _conf;
+
+// The MRTD records, as written by mrtd_traffic_dump() in peer.cc.
+struct mrt_header {
+    uint32_t time;
+    uint16_t type;
+    uint16_t subtype;
+    uint32_t length;
+};
+
+struct mrt_update {
+    uint16_t source_as;
+    uint16_t dest_as;
+    uint16_t ifindex;
+    uint16_t af;
+    uint32_t source_ip;
+    uint32_t dest_ip;
+};
+
+typedef vector<vector<uint8_t> > Messages;
+
+const uint32_t LOCAL_AS = 65000;
+const uint32_t PEER_AS = 65001;		// The AS of the replaying peers
+const uint32_t OUT_PEER_AS = 65002;	// The AS of the peer routes go to
+
+void
+usage(const string& progname)
+{
+    cout << "Usage: " << progname << " <opts>" << endl
+	 << "-f\t<MRTD file of UPDATEs>" << endl
+	 << "-g\t<write a table of this many routes to the file first>" << endl
+	 << "-a\t<distinct attribute sets in the generated table>" << endl
+	 << "-n\t<number of peers replaying the file>" << endl
+	 << "-p\tconfigure an import policy" << endl
+	 << "-F\t<xorp_finder to start, empty if one is running>" << endl
+	 << "-h\thelp" << endl;
+
+    exit(1);
+}
+
+void
+get_time(TimeVal& tv)
+{
+    TimerList::system_gettimeofday(&tv);
+}
+
+uint32_t
+next_random(uint32_t& seed)
+{
+    seed = seed * 1103515245U + 12345U;
+    return (seed >> 8);
+}
+
+/**
+ * Write an MRTD file holding a table of @ref routes routes, with one to
+ * four prefixes in each UPDATE and @ref attributes distinct sets of path
+ * attributes.
+ */
+void
+generate(const string& fname, unsigned routes, unsigned attributes)
+{
+    FILE* fp = fopen(fname.c_str(), "w");
+    if (fp == NULL)
+	XLOG_FATAL("fopen of %s failed: %s", fname.c_str(), strerror(errno));
+
+    EventLoop eventloop;
+    LocalData local_data(eventloop);
+    BGPPeerData peer_data(local_data, Iptuple(), AsNum(PEER_AS),
+			  IPv4(), 0);
+    uint32_t seed = 1;
+    unsigned written = 0;
+
+    if (attributes == 0)
+	attributes = 1;
+
+    while (written < routes) {
+	uint32_t set = next_random(seed) % attributes;
+	uint32_t aseed = set + 1;
+	UpdatePacket update;
+
+	update.add_pathatt(OriginAttribute(IGP));
+
+	ASSegment as_seq;
+	as_seq.set_type(AS_SEQUENCE);
+	as_seq.add_as(AsNum(PEER_AS));
+	for (unsigned i = next_random(aseed) % 5; i > 0; i--)
+	    as_seq.add_as(AsNum(1 + next_random(aseed) % 60000));
+	ASPath as_path;
+	as_path.add_segment(as_seq);
+	update.add_pathatt(ASPathAttribute(as_path));
+
+	update.add_pathatt(NextHopAttribute<IPv4>(IPv4("192.168.1.1")));
+
+	if (next_random(aseed) & 1)
+	    update.add_pathatt(MEDAttribute(next_random(aseed) % 200));
+	if (next_random(aseed) & 1) {
+	    CommunityAttribute communities;
+	    for (unsigned i = 1 + next_random(aseed) % 3; i > 0; i--)
+		communities.add_community(next_random(aseed) % 60000 << 16
+					  | next_random(aseed) % 1000);
+	    update.add_pathatt(communities);
+	}
+
+	// Consecutive /24s from 1.0.0.0.
+	for (unsigned i = 1 + next_random(seed) % 4;
+	     i > 0 && written < routes; i--, written++) {
+	    IPv4Net net(IPv4(htonl(0x01000000U + (written << 8))), 24);
+	    update.add_nlri(BGPUpdateAttrib(net));
+	}
+
+	uint8_t buf[BGPPacket::MAXPACKETSIZE];
+	size_t len = BGPPacket::MAXPACKETSIZE;
+	if (!update.encode(buf, len, &peer_data))
+	    XLOG_FATAL("Cannot encode %s", update.str().c_str());
+
+	mrt_header header;
+	header.time = 0;
+	header.type = htons(16);
+	header.subtype = htons(1);
+	header.length = htonl(len + sizeof(mrt_update));
+
+	mrt_update mrt;
+	memset(&mrt, 0, sizeof(mrt));
+	mrt.af = htons(1);	/* IPv4 */
+
+	if (fwrite(&header, sizeof(header), 1, fp) != 1
+	    || fwrite(&mrt, sizeof(mrt), 1, fp) != 1
+	    || fwrite(buf, len, 1, fp) != 1)
+	    XLOG_FATAL("fwrite of %s failed: %s", fname.c_str(),
+		       strerror(errno));
+    }
+
+    fclose(fp);
+}
+
+/**
+ * Read the BGP UPDATEs of an MRTD file.
+ */
+void
+read_updates(const string& fname, Messages& messages)
+{
+    FILE* fp = fopen(fname.c_str(), "r");
+    if (fp == NULL)
+	XLOG_FATAL("fopen of %s failed: %s", fname.c_str(), strerror(errno));
+
+    mrt_header header;
+    mrt_update mrt;
+
+    while (fread(&header, sizeof(header), 1, fp) == 1) {
+	size_t len = ntohl(header.length);
+	if (len < sizeof(mrt) || fread(&mrt, sizeof(mrt), 1, fp) != 1)
+	    XLOG_FATAL("%s: truncated record", fname.c_str());
+	len -= sizeof(mrt);
+
+	vector<uint8_t> buf(len);
+	if (len > 0 && fread(&buf[0], len, 1, fp) != 1)
+	    XLOG_FATAL("%s: truncated record", fname.c_str());
+
+	if (ntohs(header.type) != 16 || ntohs(header.subtype) != 1
+	    || ntohs(mrt.af) != 1)
+	    continue;
+	if (len < BGPPacket::COMMON_HEADER_LEN
+	    || buf[BGPPacket::TYPE_OFFSET] != MESSAGETYPEUPDATE)
+	    continue;
+
+	messages.push_back(vector<uint8_t>());
+	messages.back().swap(buf);
+    }
+
+    fclose(fp);
+}
+
+/**
+ * An import policy of the kind the policy manager compiles: prefer
+ * routes with a low MED and set the MED of the others.
+ */
+string
+import_policy()
+{
+    return (c_format(
+	"POLICY_START bench\n"
+	"TERM_START low-med\n"
+	"LOAD %u\n"
+	"PUSH u32 50\n"
+	"<\n"
+	"ONFALSE_EXIT\n"
+	"PUSH u32 200\n"
+	"STORE %u\n"
+	"TERM_END\n"
+	"TERM_START default-med\n"
+	"LOAD %u\n"
+	"PUSH u32 150\n"
+	">\n"
+	"ONFALSE_EXIT\n"
+	"PUSH u32 150\n"
+	"STORE %u\n"
+	"TERM_END\n"
+	"POLICY_END\n",
+	XORP_UINT_CAST(BGPVarRW<IPv4>::VAR_MED),
+	XORP_UINT_CAST(BGPVarRW<IPv4>::VAR_LOCALPREF),
+	XORP_UINT_CAST(BGPVarRW<IPv4>::VAR_MED),
+	XORP_UINT_CAST(BGPVarRW<IPv4>::VAR_MED)));
+}
+
+/**
+ * Keep EventLoop::run() from sleeping until the next timer of the
+ * XRL router once the routes are out.
+ */
+bool
+tick()
+{
+    return (true);
+}
+
+BenchPeer*
+new_peer(BGPMain& bgp, unsigned i, uint32_t as)
+{
+    IPv4 addr(htonl(0xc0a80101U + i));	// 192.168.1.1
+    Iptuple iptuple("", "127.0.0.1", 179, addr.str().c_str(), 179);
+    BGPPeerData* peer_data = new BGPPeerData(*bgp.get_local_data(), iptuple,
+					     AsNum(as),
+					     IPv4("127.0.0.1"), 0);
+    peer_data->set_id(addr);
+    peer_data->compute_peer_type();
+    // As if the OPEN messages had been exchanged.
+    peer_data->set_multiprotocol<IPv4>(SAFI_UNICAST);
+
+    return (new BenchPeer(bgp.get_local_data(), peer_data, &bgp));
+}
+
+void
+replay(EventLoop& eventloop, const Messages& messages)
+{
+    BGPMain bgp(eventloop);
+
+    bgp.get_local_data()->set_as(AsNum(LOCAL_AS));
+    bgp.get_local_data()->set_id(IPv4("127.0.0.1"));
+    if (_conf.c_policy)
+	bgp.configure_filter(filter::IMPORT, import_policy());
+
+    // The peer all the routes go to.
+    BenchPeer* out = new_peer(bgp, _conf.c_peers, OUT_PEER_AS);
+    PeerHandler* out_handler = new PeerHandler("out", out,
+					       bgp.plumbing_unicast(),
+					       bgp.plumbing_multicast());
+
+    vector<BenchPeer*> peers;
+    vector<PeerHandler*> handlers;
+    for (unsigned i = 0; i < _conf.c_peers; i++) {
+	peers.push_back(new_peer(bgp, i, PEER_AS));
+	handlers.push_back(new PeerHandler(c_format("in%u", i), peers[i],
+					   bgp.plumbing_unicast(),
+					   bgp.plumbing_multicast()));
+    }
+
+    uint64_t prefixes = 0;
+    TimeVal decode, process, start, end, t0, t1, t2;
+    XorpTimer ticker = eventloop.new_periodic_ms(10, callback(tick));
+
+    cout << "Replaying " << messages.size() << " UPDATEs from "
+	 << _conf.c_peers << " peers"
+	 << (_conf.c_policy ? " with an import policy" : "") << endl;
+
+    // The peers send their tables at the same time: interleave them.
+    get_time(start);
+    for (size_t m = 0; m < messages.size(); m++) {
+	const vector<uint8_t>& msg = messages[m];
+
+	for (unsigned i = 0; i < _conf.c_peers; i++) {
+	    get_time(t0);
+	    UpdatePacket p(&msg[0], msg.size(), peers[i]->peerdata(), &bgp,
+			   /*do checks*/true);
+	    get_time(t1);
+	    handlers[i]->process_update_packet(&p);
+	    get_time(t2);
+
+	    prefixes += p.nlri_list().size();
+	    decode += t1 - t0;
+	    process += t2 - t1;
+	}
+    }
+
+    // Anything queued on the way out.  Every peer sends the same prefixes.
+    uint64_t routes = prefixes / _conf.c_peers;
+    while (eventloop.events_pending() && out->nlri() < routes)
+	eventloop.run();
+    end = out->last_update();
+
+    double elapsed = (end - start).get_double() * 1000.0;
+    double total = (decode + process).get_double();
+
+    printf("Converged in %d ms: %10.0f UPDATEs/s, %10.0f prefixes/s\n",
+	   (int) elapsed,
+	   elapsed > 0 ? messages.size() * _conf.c_peers / elapsed * 1000.0
+	   : 0.0,
+	   elapsed > 0 ? prefixes / elapsed * 1000.0 : 0.0);
+    printf("decode  %6d ms (%4.1f%%)\n", (int) decode.to_ms(),
+	   total > 0 ? decode.get_double() / total * 100.0 : 0.0);
+    printf("process %6d ms (%4.1f%%)\n", (int) process.to_ms(),
+	   total > 0 ? process.get_double() / total * 100.0 : 0.0);
+    printf("Sent %llu UPDATEs with %llu prefixes\n",
+	   (unsigned long long) out->updates(),
+	   (unsigned long long) out->nlri());
+
+    // Take the input peerings down and wait for the withdrawals.  The
+    // routes of every peer are withdrawn once the last deletion table has
+    // drained; a handler must not be deleted before then.
+    get_time(start);
+    for (unsigned i = 0; i < _conf.c_peers; i++)
+	handlers[i]->peering_went_down();
+    while (eventloop.events_pending() && out->routes() > 0)
+	eventloop.run();
+    end = out->last_update();
+
+    printf("Withdrawn %llu prefixes in %d ms\n",
+	   (unsigned long long) out->withdrawn(), (int) (end - start).to_ms());
+
+    for (unsigned i = 0; i < _conf.c_peers; i++) {
+	delete handlers[i];
+	delete peers[i];
+    }
+    delete out_handler;
+    delete out;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    int opt;
+
+    _conf.c_finder     = "../../libxipc/xorp_finder";
+    _conf.c_peers      = 1;
+    _conf.c_policy     = false;
+    _conf.c_generate   = 0;
+    _conf.c_attributes = 0;
+
+    while ((opt = getopt(argc, argv, "ha:f:g:n:pF:")) != -1) {
+	switch (opt) {
+	    case 'a':
+		_conf.c_attributes = atoi(optarg);
+		break;
+
+	    case 'f':
+		_conf.c_file = optarg;
+		break;
+
+	    case 'g':
+		_conf.c_generate = atoi(optarg);
+		break;
+
+	    case 'n':
+		_conf.c_peers = atoi(optarg);
+		break;
+
+	    case 'p':
+		_conf.c_policy = true;
+		break;
+
+	    case 'F':
+		_conf.c_finder = optarg;
+		break;
+
+	    case 'h': // fall-through
+	    default:
+		usage(argv[0]);
+		break;
+	}
+    }
+
+    if (_conf.c_file.empty() || _conf.c_peers == 0)
+	usage(argv[0]);
+    if (_conf.c_attributes == 0)
+	_conf.c_attributes = _conf.c_generate / 3;
+
+    xlog_init(argv[0], 0);
+    xlog_set_verbose(XLOG_VERBOSE_HIGH);
+    xlog_disable(XLOG_LEVEL_TRACE);
+    xlog_disable(XLOG_LEVEL_INFO);
+    xlog_add_default_output();
+    xlog_start();
+
+    // The BGP constructor expects to use the finder, so start one.
+    pid_t pid = 0;
+    if (!_conf.c_finder.empty()) {
+	switch (pid = fork()) {
+	case 0:
+	    execl(_conf.c_finder.c_str(), "xorp_finder",
+		  static_cast<char *>(NULL));
+	    exit(1);
+	case -1:
+	    XLOG_FATAL("unable to exec %s", _conf.c_finder.c_str());
+	default:
+	    break;
+	}
+    }
+
+    try {
+	if (_conf.c_generate > 0)
+	    generate(_conf.c_file, _conf.c_generate, _conf.c_attributes);
+
+	Messages messages;
+	read_updates(_conf.c_file, messages);
+
+	EventLoop eventloop;
+	replay(eventloop, messages);
+    } catch (...) {
+	xorp_catch_standard_exceptions();
+    }
+
+    if (pid > 0) {
+	kill(pid, SIGTERM);
+	waitpid(pid, NULL, 0);
+    }
+
+    xlog_stop();
+    xlog_exit();
+
+    exit(0);
+}
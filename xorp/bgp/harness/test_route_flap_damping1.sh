@@ -312,8 +312,96 @@ test3()
     coord peer3 assert established
 }
 
+test4()
+{
+    NETS=2000
+    CHUNK=400
+
+    echo "TEST4 - Damp and release a large number of routes"
+    echo "	1) Enable route flap damping with short timers."
+    echo "	2) Flap $NETS routes on an E-BGP peering until they are damped."
+    echo "	3) Verify that the damped routes are not propagated."
+    echo "	4) Verify that all the routes are released together."
+
+    config_peers_ipv4
+
+    half_life=1
+    max_suppress=1
+    reuse=750
+    suppress=3000
+
+    set_damping $half_life $max_suppress $reuse $suppress false
+
+    # Build the NLRI in chunks that fit in an update packet.
+    UPDATES=
+    WITHDRAWS=
+    NLRI=
+    WITHDRAW=
+    i=0
+    while [ $i -lt $NETS ]
+    do
+	NET=10.$(($i / 256)).$(($i % 256)).0/24
+	NLRI="$NLRI nlri $NET"
+	WITHDRAW="$WITHDRAW withdraw $NET"
+	i=$(($i + 1))
+	if [ $(($i % $CHUNK)) = 0 ]
+	then
+	    UPDATES="$UPDATES
+$NLRI"
+	    WITHDRAWS="$WITHDRAWS
+$WITHDRAW"
+	    NLRI=
+	    WITHDRAW=
+	fi
+    done
+
+    FIRST=10.0.0.0/24
+    LAST=10.$((($NETS - 1) / 256)).$((($NETS - 1) % 256)).0/24
+
+    # The figure of merit passes the cutoff on the fourth announcement.
+    for flap in 1 2 3 4
+    do
+	echo "$WITHDRAWS" | while read chunk
+	do
+	    if [ -n "$chunk" ]
+	    then
+		coord peer1 send packet update $chunk
+	    fi
+	done
+	echo "$UPDATES" | while read chunk
+	do
+	    if [ -n "$chunk" ]
+	    then
+		coord peer1 send packet update \
+		    origin 2 aspath $PEER1_AS nexthop $NEXT_HOP $chunk
+	    fi
+	done
+	sleep 2
+    done
+
+    coord peer2 trie recv lookup $FIRST not
+    coord peer2 trie recv lookup $LAST not
+    coord peer3 trie recv lookup $FIRST not
+    coord peer3 trie recv lookup $LAST not
+
+    # The routes are suppressed for at most max_suppress minutes.
+    sleep 70
+
+    coord peer2 trie recv lookup $FIRST aspath "$AS,$PEER1_AS"
+    coord peer2 trie recv lookup $LAST aspath "$AS,$PEER1_AS"
+    coord peer3 trie recv lookup $FIRST aspath "$PEER1_AS"
+    coord peer3 trie recv lookup $LAST aspath "$PEER1_AS"
+
+# At the end of the test we expect all the peerings to still be established.
+    coord peer1 assert established
+    coord peer2 assert established
+    coord peer3 assert established
+
+    configure_bgp_damping_default
+}
+
 TESTS_NOT_FIXED=''
-TESTS='test1 test2 test3'
+TESTS='test1 test2 test3 test4'
 
 # Include command line
 . ${srcdir}/args.sh
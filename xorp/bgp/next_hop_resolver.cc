@@ -693,7 +693,8 @@ NextHopRibRequest<A>::NextHopRibRequest(XrlStdRouter *xrl_router,
 					BGPMain& bgp)
     : _xrl_router(xrl_router), _next_hop_resolver(next_hop_resolver),
       _next_hop_cache(next_hop_cache), _bgp(bgp), _busy(false),
-      _invalid(false), _tardy_invalid(false)
+      _batch(0), _max_batch(0 == xrl_router ? 1 : MAX_BATCH),
+      _invalid(false)
 {
 }
 
@@ -934,11 +935,37 @@ NextHopRibRequest<A>::register_interest_response(const XrlError& error,
     _next_hop_cache.add_entry(*addr, first_nexthop, *prefix_len, 
 			      *real_prefix_len, *resolves, *metric);
 
+    satisfy_requests(false);
+
+    /*
+    ** A NextHopResolver::register_nexthop caused us to make a request
+    ** of the RIB. In the meantime a NextHopResolver::deregister_nexthop
+    ** call took place. We removed the reference but couldn't stop the
+    ** call to RIB. It may be that this response may satisfy other
+    ** outstanding queries in the queue. If it hasn't then the entry
+    ** will be invalid so deregister interest with the RIB.
+    */
+    if (!_next_hop_cache.validate_entry(*addr, first_nexthop, *prefix_len,
+					*real_prefix_len)) {
+	deregister_from_rib(*addr, *prefix_len);
+    }
+
     /*
-    ** As soon as we come across an entry in the queue that we
-    ** can't lookup in the cache we bail. It may be the case that
-    ** there are other entries later in the queue that may
-    ** resolve. Don't worry about it we will get there eventually.
+    ** There are entries left on the queue, so, fire off another request.
+    */
+    send_next_request();
+}
+
+template<class A>
+void
+NextHopRibRequest<A>::satisfy_requests(bool whole_queue)
+{
+    /*
+    ** Unless asked to traverse the whole queue, as soon as we come
+    ** across an entry in the queue that we can't lookup in the cache
+    ** we bail. It may be the case that there are other entries later
+    ** in the queue that may resolve. Don't worry about it we will get
+    ** there eventually.
     */
     typename list<RibRequestQueueEntry<A> *>::iterator i;
     i = _queue.begin();
@@ -993,6 +1020,8 @@ NextHopRibRequest<A>::register_interest_response(const XrlError& error,
 		}
 		delete rr;
 		i = _queue.erase(i);
+	    } else if (whole_queue) {
+		i++;
 	    } else {
 		break;
 	    }
@@ -1001,24 +1030,21 @@ NextHopRibRequest<A>::register_interest_response(const XrlError& error,
 	    i++;
 	}
     }
+}
 
-    /*
-    ** A NextHopResolver::register_nexthop caused us to make a request
-    ** of the RIB. In the meantime a NextHopResolver::deregister_nexthop
-    ** call took place. We removed the reference but couldn't stop the
-    ** call to RIB. It may be that this response may satisfy other
-    ** outstanding queries in the queue. If it hasn't then the entry
-    ** will be invalid so deregister interest with the RIB.
-    */
-    if (!_next_hop_cache.validate_entry(*addr, first_nexthop, *prefix_len,
-					*real_prefix_len)) {
-	deregister_from_rib(*addr, *prefix_len);
+template<class A>
+size_t
+NextHopRibRequest<A>::batch_size() const
+{
+    bool reg = dynamic_cast<RibRegisterQueueEntry<A> *>(_queue.front()) != 0;
+    size_t n = 0;
+    typename list<RibRequestQueueEntry<A> *>::const_iterator i;
+    for (i = _queue.begin(); i != _queue.end() && n < _max_batch; i++, n++) {
+	if ((dynamic_cast<RibRegisterQueueEntry<A> *>(*i) != 0) != reg)
+	    break;
     }
 
-    /*
-    ** There are entries left on the queue, so, fire off another request.
-    */
-    send_next_request();
+    return n;
 }
 
 template<class A>
@@ -1027,25 +1053,241 @@ NextHopRibRequest<A>::send_next_request()
 {
     if (_queue.empty()) {
 	_busy = false;
+	_batch = 0;
 	return;
     }
     _busy = true;
+    _batch = batch_size();
+    XLOG_ASSERT(_batch > 0);
+
+    typename list<RibRequestQueueEntry<A> *>::iterator i;
     RibRegisterQueueEntry<A> *rr = 
 	dynamic_cast<RibRegisterQueueEntry<A> *>(_queue.front());
     if (rr) {
-	register_interest(rr->nexthop());
+	if (1 == _batch) {
+	    register_interest(rr->nexthop());
+	    return;
+	}
+
+	vector<A> nexthops;
+	i = _queue.begin();
+	for (size_t n = 0; n < _batch; n++, i++) {
+	    rr = dynamic_cast<RibRegisterQueueEntry<A> *>(*i);
+	    XLOG_ASSERT(rr);
+	    nexthops.push_back(rr->nexthop());
+	}
+	register_interest_batch(nexthops);
 	return;
     }
     
     RibDeregisterQueueEntry<A> *rd = 
 	dynamic_cast<RibDeregisterQueueEntry<A> *>(_queue.front());
     if (rd) {
-	deregister_interest(rd->base_addr(), rd->prefix_len());
+	if (1 == _batch) {
+	    deregister_interest(rd->base_addr(), rd->prefix_len());
+	    return;
+	}
+
+	vector<IPNet<A> > nets;
+	i = _queue.begin();
+	for (size_t n = 0; n < _batch; n++, i++) {
+	    rd = dynamic_cast<RibDeregisterQueueEntry<A> *>(*i);
+	    XLOG_ASSERT(rd);
+	    nets.push_back(IPNet<A>(rd->base_addr(), rd->prefix_len()));
+	}
+	deregister_interest_batch(nets);
 	return;
     }
     XLOG_UNREACHABLE();
 }
 
+template<class A>
+void
+NextHopRibRequest<A>::register_interest_batch_response(
+    const XrlError& error,
+    const XrlAtomList *resolves,
+    const XrlAtomList *addrs,
+    const XrlAtomList *prefix_lens,
+    const XrlAtomList *real_prefix_lens,
+    const XrlAtomList *actual_nexthops,
+    const XrlAtomList *metrics,
+    const vector<A> nexthops,
+    const string comment)
+{
+    UNUSED(actual_nexthops);
+
+    switch (error.error_code()) {
+    case OKAY:
+	break;
+
+    case REPLY_TIMED_OUT:
+	XLOG_FATAL("callback: Use a reliable transport %s %s",
+		   comment.c_str(), error.str().c_str());
+	break;
+
+    case RESOLVE_FAILED:
+    case SEND_FAILED:
+    case SEND_FAILED_TRANSIENT:
+    case NO_SUCH_METHOD:
+    case BAD_ARGS:
+    case COMMAND_FAILED:
+    case INTERNAL_ERROR:
+	XLOG_FATAL("callback: %s %s",  comment.c_str(), error.str().c_str());
+	break;
+
+    case NO_FINDER:
+	_bgp.finder_death(__FILE__, __LINE__);
+	break;
+    }
+
+    debug_msg("%s %s\n", comment.c_str(), error.str().c_str());
+    PROFILE(XLOG_TRACE(_bgp.profile().enabled(trace_nexthop_resolution),
+		       "%s %s\n", comment.c_str(), error.str().c_str()));
+
+    XLOG_ASSERT(_busy && _batch == nexthops.size());
+    XLOG_ASSERT(addrs->size() == nexthops.size() &&
+		resolves->size() == nexthops.size() &&
+		prefix_lens->size() == nexthops.size() &&
+		real_prefix_lens->size() == nexthops.size() &&
+		metrics->size() == nexthops.size());
+
+    /*
+    ** Insert all the answers into the NextHopCache, then traverse the
+    ** queue once removing all the entries that are satisfied. As in
+    ** register_interest_response answers which have been invalidated
+    ** while the request was outstanding are dropped, the registration
+    ** stays on the queue and is sent again. Several next hops in the
+    ** batch may be covered by the same answer, only the first one is
+    ** inserted.
+    */
+    vector<size_t> added;
+    for (size_t k = 0; k < nexthops.size(); k++) {
+	A addr;
+	addrs->get(k).ipvx().get(addr);
+	uint32_t prefix_len = prefix_lens->get(k).uint32();
+	uint32_t real_prefix_len = real_prefix_lens->get(k).uint32();
+
+	XLOG_ASSERT(real_prefix_len <= A::addr_bitlen());
+	XLOG_ASSERT(IPNet<A>(addr, prefix_len) ==
+		    IPNet<A>(nexthops[k], prefix_len));
+
+	if (_batch_invalid.find(IPNet<A>(addr, prefix_len))
+	    != _batch_invalid.end())
+	    continue;
+
+	bool lookup_succeeded;
+	uint32_t m;
+	if (_next_hop_cache.lookup_by_nexthop_without_entry(nexthops[k],
+							    lookup_succeeded,
+							    m))
+	    continue;
+
+	_next_hop_cache.add_entry(addr, nexthops[k], prefix_len,
+				  real_prefix_len,
+				  0 != resolves->get(k).uint32(),
+				  metrics->get(k).uint32());
+	added.push_back(k);
+    }
+    _batch_invalid.clear();
+
+    satisfy_requests(true);
+
+    /*
+    ** See register_interest_response, nobody may be interested in an
+    ** answer any more.
+    */
+    vector<size_t>::iterator i;
+    for (i = added.begin(); i != added.end(); i++) {
+	A addr;
+	addrs->get(*i).ipvx().get(addr);
+	uint32_t prefix_len = prefix_lens->get(*i).uint32();
+	if (!_next_hop_cache.validate_entry(addr, nexthops[*i], prefix_len,
+					    real_prefix_lens->get(*i).uint32()))
+	    deregister_from_rib(addr, prefix_len);
+    }
+
+    send_next_request();
+}
+
+template <class A>
+void
+NextHopRibRequest<A>::deregister_interest_batch_response(
+    const XrlError& error,
+    const XrlAtomList *failed,
+    vector<IPNet<A> > nets,
+    string comment)
+{
+    debug_msg("%s %s\n", comment.c_str(), error.str().c_str());
+    switch (error.error_code()) {
+    case OKAY:
+	break;
+
+    case REPLY_TIMED_OUT:
+	XLOG_FATAL("callback: Use a reliable transport %s %s",
+		   comment.c_str(), error.str().c_str());
+	break;
+
+    case NO_FINDER:
+	_bgp.finder_death(__FILE__, __LINE__);
+	break;
+
+    case RESOLVE_FAILED:
+	// See deregister_interest_response.
+	while (!_queue.empty()) {
+	    delete _queue.front();
+	    _queue.pop_front();
+	}
+	_batch_invalid.clear();
+	_busy = false;
+	_batch = 0;
+	return;
+	break;
+    case SEND_FAILED:
+    case SEND_FAILED_TRANSIENT:
+    case NO_SUCH_METHOD:
+    case BAD_ARGS:
+    case COMMAND_FAILED:
+    case INTERNAL_ERROR:
+	XLOG_FATAL("callback: %s %s",  comment.c_str(), error.str().c_str());
+	break;
+    }
+
+    XLOG_ASSERT(_busy && _batch == nets.size());
+
+    /*
+    ** A de-registration fails if the RIB has already invalidated the
+    ** registration. If we haven't yet received the invalid wait for it,
+    ** as in deregister_interest_response.
+    */
+    if (error == XrlError::OKAY()) {
+	for (size_t k = 0; k < failed->size(); k++) {
+	    uint32_t index = failed->get(k).uint32();
+	    XLOG_ASSERT(index < nets.size());
+
+	    typename set<IPNet<A> >::iterator i =
+		_batch_invalid.find(nets[index]);
+	    if (i != _batch_invalid.end())
+		_batch_invalid.erase(i);
+	    else
+		_tardy_invalid.insert(nets[index]);
+	}
+    }
+    _batch_invalid.clear();
+
+    // remove these requests from the queue
+    for (size_t k = 0; k < nets.size(); k++) {
+	XLOG_ASSERT(!_queue.empty());
+	RibDeregisterQueueEntry<A> *rd = 
+	    dynamic_cast<RibDeregisterQueueEntry<A> *>(_queue.front());
+	XLOG_ASSERT(rd != NULL);
+	XLOG_ASSERT(IPNet<A>(rd->base_addr(), rd->prefix_len()) == nets[k]);
+	delete rd;
+	_queue.pop_front();
+    }
+
+    send_next_request();
+}
+
 template<class A>
 bool
 NextHopRibRequest<A>::premature_invalid(const A& addr,
@@ -1067,9 +1309,33 @@ NextHopRibRequest<A>::premature_invalid(const A& addr,
     */
 
     XLOG_ASSERT(!_queue.empty());
+
+    /*
+    ** If a batch is outstanding the invalid may be for any of its
+    ** entries. Save the subnet, the response will be dealt with
+    ** accordingly.
+    */
+    if (_batch > 1) {
+	typename list<RibRequestQueueEntry<A> *>::iterator i = _queue.begin();
+	for (size_t n = 0; n < _batch; n++, i++) {
+	    XLOG_ASSERT(i != _queue.end());
+	    RibRegisterQueueEntry<A> *rr =
+		dynamic_cast<RibRegisterQueueEntry<A> *>(*i);
+	    RibDeregisterQueueEntry<A> *rd =
+		dynamic_cast<RibDeregisterQueueEntry<A> *>(*i);
+	    if ((rr && IPNet<A>(addr, prefix_len) ==
+		 IPNet<A>(rr->nexthop(), prefix_len)) ||
+		(rd && rd->base_addr() == addr &&
+		 rd->prefix_len() == prefix_len)) {
+		_batch_invalid.insert(IPNet<A>(addr, prefix_len));
+		return true;
+	    }
+	}
+    }
+
     RibRegisterQueueEntry<A> *first_rr =
 	dynamic_cast<RibRegisterQueueEntry<A> *>(_queue.front());
-    if (first_rr && 
+    if (_batch == 1 && first_rr && 
 	(IPNet<A>(addr, prefix_len) ==
 	 IPNet<A>(first_rr->nexthop(), prefix_len))) {
 
@@ -1118,17 +1384,18 @@ template<class A>
 bool
 NextHopRibRequest<A>::tardy_invalid(const A& addr, const uint32_t& prefix_len)
 {
-    if (_tardy_invalid) {
-	_tardy_invalid = false;
-	if (addr != _tardy_invalid_net.masked_addr() || 
-	    prefix_len != _tardy_invalid_net.prefix_len())
-	    XLOG_FATAL("Invalidate does not match previous failed "
-		       "de-registration addr %s prefix len %u",
-		       cstring(addr), XORP_UINT_CAST(prefix_len));
-	return true;
-    }
+    if (_tardy_invalid.empty())
+	return false;
 
-    return false;
+    typename set<IPNet<A> >::iterator i =
+	_tardy_invalid.find(IPNet<A>(addr, prefix_len));
+    if (i == _tardy_invalid.end())
+	XLOG_FATAL("Invalidate does not match previous failed "
+		   "de-registration addr %s prefix len %u",
+		   cstring(addr), XORP_UINT_CAST(prefix_len));
+    _tardy_invalid.erase(i);
+
+    return true;
 }
 
 template<class A>
@@ -1276,6 +1543,62 @@ NextHopRibRequest<IPv4>::deregister_interest(IPv4 addr,
 				XORP_UINT_CAST(prefix_len))));
 }
 
+template<>
+void
+NextHopRibRequest<IPv4>::register_interest_batch(const vector<IPv4>& nexthops)
+{
+    debug_msg("%u nexthops\n", XORP_UINT_CAST(nexthops.size()));
+    PROFILE(XLOG_TRACE(_bgp.profile().enabled(trace_nexthop_resolution),
+		       "%u nexthops\n", XORP_UINT_CAST(nexthops.size())));
+    if (0 == _xrl_router)	// The test code sets _xrl_router to zero
+	return;
+
+    XrlAtomList addrs;
+    vector<IPv4>::const_iterator i;
+    for (i = nexthops.begin(); i != nexthops.end(); i++)
+	addrs.append(XrlAtom(*i));
+
+    XrlRibV0p1Client rib(_xrl_router);
+    rib.send_register_interest4_batch(_ribname.c_str(), _xrl_router->name(),
+				      addrs,
+				      ::callback(this,
+		&NextHopRibRequest::register_interest_batch_response,
+		nexthops,
+		c_format("nexthops: %s ... (%u)", nexthops.front().str().c_str(),
+			 XORP_UINT_CAST(nexthops.size()))));
+}
+
+template<>
+void
+NextHopRibRequest<IPv4>::deregister_interest_batch(const vector<IPv4Net>& nets)
+{
+    debug_msg("%u nets\n", XORP_UINT_CAST(nets.size()));
+    PROFILE(XLOG_TRACE(_bgp.profile().enabled(trace_nexthop_resolution),
+		       "%u nets\n", XORP_UINT_CAST(nets.size())));
+    if (0 == _xrl_router)	// The test code sets _xrl_router to zero
+	return;
+
+    XrlAtomList addrs;
+    XrlAtomList prefix_lens;
+    vector<IPv4Net>::const_iterator i;
+    for (i = nets.begin(); i != nets.end(); i++) {
+	addrs.append(XrlAtom(i->masked_addr()));
+	prefix_lens.append(XrlAtom(i->prefix_len()));
+    }
+
+    XrlRibV0p1Client rib(_xrl_router);
+    rib.send_deregister_interest4_batch(_ribname.c_str(),
+					_xrl_router->name(),
+					addrs,
+					prefix_lens,
+	    ::callback(this,
+		       &NextHopRibRequest::deregister_interest_batch_response,
+		       nets,
+		       c_format("deregister_from_rib: %s ... (%u)",
+				nets.front().str().c_str(),
+				XORP_UINT_CAST(nets.size()))));
+}
+
 template <class A>
 void
 NextHopRibRequest<A>::deregister_interest_response(const XrlError& error, 
@@ -1341,8 +1664,7 @@ NextHopRibRequest<A>::deregister_interest_response(const XrlError& error,
 	    // received by BGP. So rather than generate a warning here
 	    // wait until we receive the next invalid. If it does not
 	    // match this net generate an error.
-	    _tardy_invalid = true;
-	    _tardy_invalid_net = IPNet<A>(addr, prefix_len);
+	    _tardy_invalid.insert(IPNet<A>(addr, prefix_len));
 	}
 	break;
     }
@@ -1482,6 +1804,62 @@ NextHopRibRequest<IPv6>::deregister_interest(IPv6 addr,
 				XORP_UINT_CAST(prefix_len))));
 }
 
+template<>
+void
+NextHopRibRequest<IPv6>::register_interest_batch(const vector<IPv6>& nexthops)
+{
+    debug_msg("%u nexthops\n", XORP_UINT_CAST(nexthops.size()));
+    PROFILE(XLOG_TRACE(_bgp.profile().enabled(trace_nexthop_resolution),
+		       "%u nexthops\n", XORP_UINT_CAST(nexthops.size())));
+    if (0 == _xrl_router)	// The test code sets _xrl_router to zero
+	return;
+
+    XrlAtomList addrs;
+    vector<IPv6>::const_iterator i;
+    for (i = nexthops.begin(); i != nexthops.end(); i++)
+	addrs.append(XrlAtom(*i));
+
+    XrlRibV0p1Client rib(_xrl_router);
+    rib.send_register_interest6_batch(_ribname.c_str(), _xrl_router->name(),
+				      addrs,
+				      ::callback(this,
+		&NextHopRibRequest::register_interest_batch_response,
+		nexthops,
+		c_format("nexthops: %s ... (%u)", nexthops.front().str().c_str(),
+			 XORP_UINT_CAST(nexthops.size()))));
+}
+
+template<>
+void
+NextHopRibRequest<IPv6>::deregister_interest_batch(const vector<IPv6Net>& nets)
+{
+    debug_msg("%u nets\n", XORP_UINT_CAST(nets.size()));
+    PROFILE(XLOG_TRACE(_bgp.profile().enabled(trace_nexthop_resolution),
+		       "%u nets\n", XORP_UINT_CAST(nets.size())));
+    if (0 == _xrl_router)	// The test code sets _xrl_router to zero
+	return;
+
+    XrlAtomList addrs;
+    XrlAtomList prefix_lens;
+    vector<IPv6Net>::const_iterator i;
+    for (i = nets.begin(); i != nets.end(); i++) {
+	addrs.append(XrlAtom(i->masked_addr()));
+	prefix_lens.append(XrlAtom(i->prefix_len()));
+    }
+
+    XrlRibV0p1Client rib(_xrl_router);
+    rib.send_deregister_interest6_batch(_ribname.c_str(),
+					_xrl_router->name(),
+					addrs,
+					prefix_lens,
+	    ::callback(this,
+		       &NextHopRibRequest::deregister_interest_batch_response,
+		       nets,
+		       c_format("deregister_from_rib: %s ... (%u)",
+				nets.front().str().c_str(),
+				XORP_UINT_CAST(nets.size()))));
+}
+
 
 template class NextHopResolver<IPv6>;
 
@@ -594,7 +594,10 @@ public:
 			  NhLookupTable<A> *requester);
 
     /**
-     * Send the next queued request
+     * Send the next queued request.
+     *
+     * Consecutive registrations or deregistrations at the front of the
+     * queue are sent to the RIB in a single batch XRL.
      */
     void send_next_request();
 
@@ -621,6 +624,26 @@ public:
 				    const A nexthop_interest,
 				    const string comment);
 
+    /**
+     * Register interest with the RIB about several next hops at once.
+     *
+     * @param nexthops The next hops that we are attempting to resolve.
+     */
+    void register_interest_batch(const vector<A>& nexthops);
+
+    /**
+     * XRL callback from register_interest_batch.
+     */
+    void register_interest_batch_response(const XrlError& error,
+					  const XrlAtomList *resolves,
+					  const XrlAtomList *addrs,
+					  const XrlAtomList *prefix_lens,
+					  const XrlAtomList *real_prefix_lens,
+					  const XrlAtomList *actual_nexthops,
+					  const XrlAtomList *metrics,
+					  const vector<A> nexthops,
+					  const string comment);
+
 
     /**
      * An unmatched invalidate has been received.
@@ -706,7 +729,56 @@ public:
 				      uint32_t prefix_len,
 				      string comment);
 
+    /**
+     * Deregister interest with the RIB about several subnets at once.
+     *
+     * @param nets The subnets we registered with.
+     */
+    void deregister_interest_batch(const vector<IPNet<A> >& nets);
+
+    /**
+     * XRL callback from deregister_interest_batch.
+     *
+     * @param failed The indices of the subnets the RIB did not know about.
+     */
+    void deregister_interest_batch_response(const XrlError& error,
+					    const XrlAtomList *failed,
+					    vector<IPNet<A> > nets,
+					    string comment);
+
+    /**
+     * The maximum number of requests sent to the RIB in a single XRL.
+     */
+    static const size_t MAX_BATCH = 256;
+
+    /**
+     * Set the maximum number of requests sent to the RIB in a single
+     * XRL. Without an XRL router the default is one, the test code sets
+     * it to exercise the batch path.
+     *
+     * @param max_batch the maximum, between 1 and MAX_BATCH.
+     */
+    void set_max_batch(size_t max_batch) {
+	XLOG_ASSERT(max_batch > 0 && max_batch <= MAX_BATCH);
+	_max_batch = max_batch;
+    }
+
 private:
+    /**
+     * Run the callbacks of the queued registrations that the cache can
+     * now answer, and remove them from the queue.
+     *
+     * @param whole_queue if false stop at the first registration that
+     * can't be answered.
+     */
+    void satisfy_requests(bool whole_queue);
+
+    /**
+     * @return the number of entries at the front of the queue that can
+     * be sent in a single request.
+     */
+    size_t batch_size() const;
+
     string _ribname;
     XrlStdRouter *_xrl_router;
     NextHopResolver<A>& _next_hop_resolver;
@@ -718,12 +790,23 @@ private:
      */
     bool _busy;
 
+    /**
+     * The number of entries at the front of the queue covered by the
+     * outstanding request.
+     */
+    size_t _batch;
+
+    size_t _max_batch;		// The largest batch sent to the RIB.
+
     bool _invalid;		// True if received an unmatched invalid call.
     IPNet<A> _invalid_net;	// Saved invalid subnet.
 
-    bool _tardy_invalid;	// True if we are expecting an invalid
-				// from the RIB.
-    IPNet<A> _tardy_invalid_net;// Saved invalid subnet.
+    set<IPNet<A> > _batch_invalid;	// Unmatched invalid subnets received
+					// while a batch was outstanding.
+
+    set<IPNet<A> > _tardy_invalid;	// Invalids we are expecting from
+					// the RIB after failed
+					// de-registrations.
 
     /**
      * The queue of outstanding requests.
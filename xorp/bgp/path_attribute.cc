@@ -659,7 +659,8 @@ string AS4AggregatorAttribute::str() const
  */
 
 CommunityAttribute::CommunityAttribute()
-	: PathAttribute((Flags)(Optional | Transitive), COMMUNITY)
+	: PathAttribute((Flags)(Optional | Transitive), COMMUNITY),
+	  _well_known(0)
 {
 }
 
@@ -667,16 +668,15 @@ PathAttribute *
 CommunityAttribute::clone() const
 {
     CommunityAttribute *ca = new CommunityAttribute();
-    for(const_iterator i = community_set().begin(); 
-	i != community_set().end(); i++)
-	ca->add_community(*i);
+    ca->_communities = _communities;
+    ca->_well_known = _well_known;
 
     return ca;
 }
 
 CommunityAttribute::CommunityAttribute(const uint8_t* d)
 	throw(CorruptMessage)
-	: PathAttribute(d)
+	: PathAttribute(d), _well_known(0)
 {
     if (!optional() || !transitive())
 	xorp_throw(CorruptMessage,
@@ -684,10 +684,24 @@ CommunityAttribute::CommunityAttribute(const uint8_t* d)
 		   UPDATEMSGERR, ATTRFLAGS);
     size_t len = length(d);
     d = payload(d);
+    _communities.reserve(len / 4);
     for (size_t l = len; l >= 4;  d += 4, l -= 4) {
 	uint32_t value;
 	memcpy(&value, d, 4);
-	_communities.insert(ntohl(value));
+	value = ntohl(value);
+	_communities.push_back(value);
+	_well_known |= well_known_bit(value);
+    }
+
+    // Communities usually arrive sorted, only sort if needed.
+    for (size_t i = 1; i < _communities.size(); i++) {
+	if (_communities[i - 1] >= _communities[i]) {
+	    sort(_communities.begin(), _communities.end());
+	    _communities.erase(unique(_communities.begin(),
+				      _communities.end()),
+			       _communities.end());
+	    break;
+	}
     }
 }
 
@@ -738,16 +752,23 @@ CommunityAttribute::str() const
 void
 CommunityAttribute::add_community(uint32_t community)
 {
-    _communities.insert(community);
+    vector<uint32_t>::iterator i = lower_bound(_communities.begin(),
+					       _communities.end(), community);
+    if (i != _communities.end() && *i == community)
+	return;
+
+    _communities.insert(i, community);
+    _well_known |= well_known_bit(community);
 }
 
 bool
 CommunityAttribute::contains(uint32_t community) const
 {
-    const_iterator i = _communities.find(community);
-    if (i == _communities.end())
-	return false;
-    return true;
+    uint8_t bit = well_known_bit(community);
+    if (bit != 0)
+	return (_well_known & bit) != 0;
+
+    return binary_search(_communities.begin(), _communities.end(), community);
 }
 
 
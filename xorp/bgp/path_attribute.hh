@@ -486,21 +486,35 @@ public:
     static const uint32_t NO_ADVERTISE = 0xFFFFFF02;  // RFC 1997
     static const uint32_t NO_EXPORT_SUBCONFED = 0xFFFFFF03;  // RFC 1997
 
-    typedef set <uint32_t>::const_iterator const_iterator;
+    typedef vector <uint32_t>::const_iterator const_iterator;
     CommunityAttribute();
     CommunityAttribute(const uint8_t* d) throw(CorruptMessage);
     PathAttribute *clone() const;
 
     string str() const;
 
-    const set <uint32_t>& community_set() const { return _communities; }
+    /**
+     * @return the communities in ascending order, without duplicates.
+     */
+    const vector <uint32_t>& community_set() const { return _communities; }
     void add_community(uint32_t community);
     bool contains(uint32_t community) const;
 
     bool encode(uint8_t* buf, size_t &wire_size, const BGPPeerData* peerdata) const;
 
 private:
-    set <uint32_t> _communities;
+    /**
+     * @return the bit representing a well-known community, or 0 if the
+     * community is not in the well-known range.
+     */
+    static uint8_t well_known_bit(uint32_t community) {
+	if ((community & 0xFFFFFFF8) != 0xFFFFFF00)
+	    return 0;
+	return 1 << (community & 7);
+    }
+
+    vector <uint32_t> _communities;	// Sorted flat array.
+    uint8_t _well_known;		// Well-known communities present.
 };
 
 /**
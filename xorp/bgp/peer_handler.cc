@@ -353,6 +353,30 @@ PeerHandler::process_update_packet(UpdatePacket *p)
     
     const PathAttribute* pa;
 
+    // Only copy the attributes into the lists of the address families
+    // this packet announces. Most packets carry a single one.
+    bool want_ipv4_unicast = !p->nlri_list().empty();
+    bool want_ipv4_multicast = false;
+#ifdef HAVE_IPV6
+    bool want_ipv6_unicast = false;
+    bool want_ipv6_multicast = false;
+#endif
+    if (!pa_list->is_empty()
+	&& (pa = pa_list->find_attribute_by_type(MP_REACH_NLRI))) {
+	const MPReachNLRIAttribute<IPv4>* mp4 =
+	    dynamic_cast<const MPReachNLRIAttribute<IPv4>*>(pa);
+	if (mp4 && SAFI_MULTICAST == mp4->safi())
+	    want_ipv4_multicast = true;
+#ifdef HAVE_IPV6
+	const MPReachNLRIAttribute<IPv6>* mp6 =
+	    dynamic_cast<const MPReachNLRIAttribute<IPv6>*>(pa);
+	if (mp6 && SAFI_UNICAST == mp6->safi())
+	    want_ipv6_unicast = true;
+	if (mp6 && SAFI_MULTICAST == mp6->safi())
+	    want_ipv6_multicast = true;
+#endif
+    }
+
     // Store a reference to the ASPath here temporarily, as we may
     // need to mess with it before passing it to the final PA lists.
     // It's safe to mess with the ASPath in place, as we won't need
@@ -457,16 +481,20 @@ PeerHandler::process_update_packet(UpdatePacket *p)
 		    {}
 		} /* end of switch */
 
-		pa_ipv4_unicast->add_path_attribute(*pa);
+		if (want_ipv4_unicast)
+		    pa_ipv4_unicast->add_path_attribute(*pa);
 
 		/*
 		** The nexthop path attribute applies only to IPv4 Unicast case.
 		*/
 		if (NEXT_HOP != pa->type()) {
-		    pa_ipv4_multicast->add_path_attribute(*pa);
+		    if (want_ipv4_multicast)
+			pa_ipv4_multicast->add_path_attribute(*pa);
 #ifdef HAVE_IPV6
-		    pa_ipv6_unicast->add_path_attribute(*pa);
-		    pa_ipv6_multicast->add_path_attribute(*pa);
+		    if (want_ipv6_unicast)
+			pa_ipv6_unicast->add_path_attribute(*pa);
+		    if (want_ipv6_multicast)
+			pa_ipv6_multicast->add_path_attribute(*pa);
 #endif
 		}
 	    } /* end of if */
@@ -476,11 +504,15 @@ PeerHandler::process_update_packet(UpdatePacket *p)
     /* finally store the ASPath attribute, now we know we're done messing with it */
     if (as_path) {
 	ASPathAttribute as_path_attr(*as_path);
-	pa_ipv4_unicast->add_path_attribute(as_path_attr);
-	pa_ipv4_multicast->add_path_attribute(as_path_attr);
+	if (want_ipv4_unicast)
+	    pa_ipv4_unicast->add_path_attribute(as_path_attr);
+	if (want_ipv4_multicast)
+	    pa_ipv4_multicast->add_path_attribute(as_path_attr);
 #ifdef HAVE_IPV6
-	pa_ipv6_unicast->add_path_attribute(as_path_attr);
-	pa_ipv6_multicast->add_path_attribute(as_path_attr);
+	if (want_ipv6_unicast)
+	    pa_ipv6_unicast->add_path_attribute(as_path_attr);
+	if (want_ipv6_multicast)
+	    pa_ipv6_multicast->add_path_attribute(as_path_attr);
 #endif
     }
 
@@ -34,7 +34,7 @@ DampingTable<A>::DampingTable(string tablename, Safi safi,
 			      const PeerHandler *peer,
 			      Damping& damping)
     : BGPRouteTable<A>(tablename, safi), _peer(peer), _damping(damping),
-      _damp_count(0)
+      _damp_count(0), _reuse_list(REUSE_LIST_SIZE), _reuse_slot(0)
 {
     this->_parent = parent;
 }
@@ -73,6 +73,11 @@ DampingTable<A>::add_route(InternalMessage<A> &rtmsg,
     if (i == _damp.end()) {
 	Damp damp(_damping.get_tick(), _damping.get_merit());
 	_damp.insert(rtmsg.net(), damp);
+	if (!_aging_timer.scheduled())
+	    _aging_timer = eventloop().
+		new_periodic_ms(AGING_INTERVAL * 1000,
+				callback(this,
+					 &DampingTable<A>::age_damp_entries));
 	return this->_next_table->
 	    add_route(rtmsg, static_cast<BGPRouteTable<A>*>(this));
     }
@@ -133,26 +138,20 @@ DampingTable<A>::replace_route(InternalMessage<A> &old_rtmsg,
 	typename RefTrie<A, DampRoute<A> >::iterator r;
 	r = _damped.lookup_node(old_rtmsg.net());
 	XLOG_ASSERT(r != _damped.end());
-	TimeVal exp;
-	if (!r.payload().timer().time_remaining(exp))
-	    XLOG_FATAL("Route is being damped but no timer is scheduled");
-	r.payload().timer().unschedule();
-	_damped.erase(r);
 	if (damping_global()) {
-		DampRoute<A> damproute(new_rtmsg.route(), new_rtmsg.genid());
-		damproute.timer() = eventloop().
-		    new_oneoff_after(exp,
-				     callback(this,
-					      &DampingTable<A>::undamp,
-					      new_rtmsg.net()));
-		_damped.insert(new_rtmsg.net(), damproute);
+	    // The release time doesn't change so the entry on the reuse
+	    // list remains valid.
+	    uint32_t reuse = r.payload().reuse();
+	    _damped.erase(r);
+	    DampRoute<A> damproute(new_rtmsg.route(), new_rtmsg.genid(),
+				   reuse);
+	    _damped.insert(new_rtmsg.net(), damproute);
 	    return ADD_UNUSED;
 	}
 	
 	// Routes are no longer being damped, but they were previously
 	// send the new route through as an add.
-	damp._damped = false;
-	_damp_count--;
+	undamp_route(r, damp);
 	return this->_next_table->
 	    add_route(new_rtmsg, static_cast<BGPRouteTable<A>*>(this));
     }
@@ -202,11 +201,8 @@ DampingTable<A>::delete_route(InternalMessage<A> &rtmsg,
 	typename RefTrie<A, DampRoute<A> >::iterator r;
 	r = _damped.lookup_node(rtmsg.net());
 	XLOG_ASSERT(r != _damped.end());
-	r.payload().timer().unschedule();	// Not strictly necessary.
-	_damped.erase(r);
-
-	damp._damped = false;
-	_damp_count--;
+	// The entry on the reuse list is skipped when it is reached.
+	undamp_route(r, damp);
 
 	return 0;
     }
@@ -294,14 +290,7 @@ DampingTable<A>::update_figure_of_merit(Damp& damp,
     if (_damping.cutoff(damp._merit)) {
 	debug_msg("Damped\n");
 	damp._damped = true;
-	_damp_count++;
-	DampRoute<A> damproute(rtmsg.route(), rtmsg.genid());
-	damproute.timer() = eventloop().
-	    new_oneoff_after(TimeVal(_damping.get_reuse_time(damp._merit), 0),
-			     callback(this,
-				      &DampingTable<A>::undamp,
-				      rtmsg.net()));
-	_damped.insert(rtmsg.net(), damproute);
+	damp_route(rtmsg, now() + _damping.get_reuse_time(damp._merit));
 
 	return true;
     }
@@ -325,26 +314,142 @@ DampingTable<A>::is_this_route_damped(const IPNet<A> &net) const
 
 template<class A>
 void
-DampingTable<A>::undamp(IPNet<A> net)
+DampingTable<A>::damp_route(const InternalMessage<A> &rtmsg, uint32_t reuse)
 {
-    debug_msg("Released net %s\n", cstring(net));
+    DampRoute<A> damproute(rtmsg.route(), rtmsg.genid(), reuse);
+    _damped.insert(rtmsg.net(), damproute);
+    _damp_count++;
+
+    if (!_reuse_timer.scheduled()) {
+	_reuse_slot = now() / REUSE_INTERVAL;
+	_reuse_timer = eventloop().
+	    new_periodic_ms(REUSE_INTERVAL * 1000,
+			    callback(this, &DampingTable<A>::reuse_list_tick));
+    }
 
-    typename Trie<A, Damp>::iterator i = _damp.lookup_node(net);
-    XLOG_ASSERT(i != _damp.end());
-    Damp& damp = i.payload();
+    reuse_list_insert(rtmsg.net(), reuse);
+}
+
+template<class A>
+void
+DampingTable<A>::undamp_route(typename RefTrie<A, DampRoute<A> >::iterator r,
+			      Damp& damp)
+{
     XLOG_ASSERT(damp._damped);
-    
-    typename RefTrie<A, DampRoute<A> >::iterator r;
-    r = _damped.lookup_node(net);
-    XLOG_ASSERT(r != _damped.end());
-    InternalMessage<A> rtmsg(r.payload().route(), _peer, r.payload().genid());
+
     _damped.erase(r);
     damp._damped = false;
     _damp_count--;
+}
+
+template<class A>
+void
+DampingTable<A>::reuse_list_insert(const IPNet<A>& net, uint32_t reuse)
+{
+    // The first slot which is processed no earlier than the reuse time.
+    uint32_t slot = (reuse + REUSE_INTERVAL - 1) / REUSE_INTERVAL;
+
+    if (slot < _reuse_slot)
+	slot = _reuse_slot;
+
+    // Beyond the end of the ring, this route will be placed again when
+    // the last slot is processed.
+    if (slot - _reuse_slot >= REUSE_LIST_SIZE)
+	slot = _reuse_slot + REUSE_LIST_SIZE - 1;
+
+    _reuse_list[slot % REUSE_LIST_SIZE].push_back(net);
+}
+
+template<class A>
+bool
+DampingTable<A>::reuse_list_tick()
+{
+    uint32_t current = now();
+    uint32_t last_slot = current / REUSE_INTERVAL;
+    bool released = false;
+
+    for (; _reuse_slot <= last_slot && 0 != _damp_count; ) {
+	list<IPNet<A> > bucket;
+	bucket.swap(_reuse_list[_reuse_slot % REUSE_LIST_SIZE]);
+	_reuse_slot++;
+
+	typename list<IPNet<A> >::const_iterator n;
+	for (n = bucket.begin(); n != bucket.end(); n++) {
+	    typename RefTrie<A, DampRoute<A> >::iterator r;
+	    r = _damped.lookup_node(*n);
+
+	    // The route was withdrawn or released while damped.
+	    if (r == _damped.end())
+		continue;
+
+	    if (r.payload().reuse() > current) {
+		reuse_list_insert(*n, r.payload().reuse());
+		continue;
+	    }
+
+	    debug_msg("Released net %s\n", cstring(*n));
+
+	    typename Trie<A, Damp>::iterator i = _damp.lookup_node(*n);
+	    XLOG_ASSERT(i != _damp.end());
+
+	    InternalMessage<A> rtmsg(r.payload().route(), _peer,
+				     r.payload().genid());
+	    undamp_route(r, i.payload());
+
+	    this->_next_table->add_route(rtmsg,
+					 static_cast<BGPRouteTable<A>*>(this));
+	    released = true;
+	}
+    }
+
+    if (released)
+	this->_next_table->push(static_cast<BGPRouteTable<A>*>(this));
+
+    if (0 != _damp_count)
+	return true;
+
+    // Nothing is damped, drop any leftover entries.
+    for (size_t i = 0; i < _reuse_list.size(); i++)
+	_reuse_list[i].clear();
+
+    return false;
+}
+
+template<class A>
+bool
+DampingTable<A>::age_damp_entries()
+{
+    // If damping has been disabled the figures of merit are not
+    // maintained, so forget about all routes that are not damped.
+    bool all = !damping_global();
+
+    list<IPNet<A> > idle;
+    typename Trie<A, Damp>::iterator i;
+    for (i = _damp.begin(); i != _damp.end(); i++) {
+	const Damp& damp = i.payload();
+	if (damp._damped)
+	    continue;
+	if (all || _damping.idle(damp._time))
+	    idle.push_back(i.key());
+    }
+
+    debug_msg("Aged %u entries\n", XORP_UINT_CAST(idle.size()));
+
+    typename list<IPNet<A> >::const_iterator n;
+    for (n = idle.begin(); n != idle.end(); n++)
+	_damp.erase(*n);
+
+    return !_damp.empty();
+}
+
+template<class A>
+uint32_t
+DampingTable<A>::now() const
+{
+    TimeVal tv;
+    eventloop().current_time(tv);
 
-    this->_next_table->add_route(rtmsg,
-				 static_cast<BGPRouteTable<A>*>(this));
-    this->_next_table->push(static_cast<BGPRouteTable<A>*>(this));
+    return tv.sec();
 }
 
 template<class A>
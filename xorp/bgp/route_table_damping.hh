@@ -53,16 +53,15 @@ class Damp {
 template<class A>
 class DampRoute {
 public:
-    DampRoute(const SubnetRoute<A>* route, uint32_t genid) 
-	: _routeref(route), _genid(genid) {}
+    DampRoute(const SubnetRoute<A>* route, uint32_t genid, uint32_t reuse) 
+	: _routeref(route), _genid(genid), _reuse(reuse) {}
     const SubnetRoute<A>* route() const { return _routeref.route(); }
     uint32_t genid() const { return _genid; }
-    XorpTimer& timer() { return _timer; }
+    uint32_t reuse() const { return _reuse; }
 private:
     SubnetRouteConstRef<A> _routeref;
     uint32_t _genid;
-    XorpTimer _timer;   // If this route is damped time when it should
-			// be released. 
+    uint32_t _reuse;	// Time in seconds when the route should be released.
 };
 
 /**
@@ -71,7 +70,13 @@ private:
  * NOTE: If damping was enabled and is then disabled it is possible
  * that some routes may be damped. While damped routes exist the
  * damping code is entered, no more routes are damped but routes are
- * only released as the timers fire.
+ * only released as their time comes.
+ *
+ * Damped routes are not given a timer each. As in RFC 2439 they are
+ * placed on a reuse list, a ring of buckets each REUSE_INTERVAL
+ * seconds wide. A single timer walks the ring and releases all the
+ * routes in a bucket in one go. Routes due beyond the end of the ring
+ * are put in the last bucket and placed again when it is reached.
  */
 template<class A>
 class DampingTable : public BGPRouteTable<A>  {
@@ -129,19 +134,57 @@ public:
     bool is_this_route_damped(const IPNet<A> &net) const;
 
     /**
-     * Callback method called to release damped route.
+     * Damp a route.
+     *
+     * @param reuse time in seconds when the route should be released.
+     */
+    void damp_route(const InternalMessage<A> &rtmsg, uint32_t reuse);
+
+    /**
+     * Stop damping a route, the caller should send it downstream.
      */
-    void undamp(IPNet<A> net);
+    void undamp_route(typename RefTrie<A, DampRoute<A> >::iterator r,
+		      Damp& damp);
+
+    /**
+     * Put a damped route on the reuse list.
+     */
+    void reuse_list_insert(const IPNet<A>& net, uint32_t reuse);
+
+    /**
+     * Timer callback to release the damped routes which are due.
+     */
+    bool reuse_list_tick();
+
+    /**
+     * Timer callback to forget the networks that have not flapped
+     * recently.
+     */
+    bool age_damp_entries();
+
+    /**
+     * The current time in seconds.
+     */
+    uint32_t now() const;
 
     EventLoop& eventloop() const;
 
  private:
+    static const uint32_t REUSE_INTERVAL = 5;		// Seconds per bucket.
+    static const uint32_t REUSE_LIST_SIZE = 1024;	// Number of buckets.
+    static const uint32_t AGING_INTERVAL = 5 * 60;	// Seconds.
+
     const PeerHandler *_peer;
     Damping& _damping;
     
     Trie<A, Damp> _damp;
     RefTrie<A, DampRoute<A> > _damped;
     uint32_t _damp_count;	// Number of damped routes.
+
+    vector<list<IPNet<A> > > _reuse_list;
+    uint32_t _reuse_slot;	// Next slot of the reuse list to be processed.
+    XorpTimer _reuse_timer;	// Walks the reuse list.
+    XorpTimer _aging_timer;	// Removes idle entries from _damp.
 };
 
 #endif // __BGP_ROUTE_TABLE_DAMPING_HH__
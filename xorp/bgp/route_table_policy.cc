@@ -119,6 +119,42 @@ PolicyTable<A>::do_filtering(InternalMessage<A>& rtmsg,
     }
 }
 
+template <class A>
+bool
+PolicyTable<A>::needs_refiltering(InternalMessage<A>& rtmsg) const
+{
+    static const filter::Filter types[] = {
+	filter::IMPORT, filter::EXPORT_SOURCEMATCH, filter::EXPORT
+    };
+    static const size_t ntypes = sizeof(types) / sizeof(types[0]);
+
+    if (!_enable_filtering)
+	return true;
+
+    bool in_scope = false;
+
+    _varrw->attach_route(rtmsg, false);
+
+    try {
+	for (size_t i = 0; i < ntypes && !in_scope; i++)
+	    in_scope = _policy_filters.route_in_scope(types[i], *_varrw);
+
+	// the route is not affected, so the current filters will treat it
+	// exactly like the ones it was filtered with.
+	if (!in_scope) {
+	    for (size_t i = 0; i < ntypes; i++)
+		_policy_filters.refresh_route(types[i], *_varrw);
+	}
+    } catch(const PolicyException& e) {
+	XLOG_FATAL("Policy filter error %s", e.str().c_str());
+	XLOG_UNFINISHED();
+    }
+
+    _varrw->detach_route(rtmsg);
+
+    return in_scope;
+}
+
 template <class A>
 int
 PolicyTable<A>::add_route(InternalMessage<A> &rtmsg,
@@ -94,6 +94,17 @@ public:
 protected:
     virtual void init_varrw();
 
+    /**
+     * Check whether a policy reconfiguration may change how any of the
+     * filters treat a route.  If it may not, the route is marked as filtered
+     * by the current filters, so it is not looked at again until the next
+     * reconfiguration.
+     *
+     * @param rtmsg the route message to check.
+     * @return true if the route needs to be filtered again.
+     */
+    bool needs_refiltering(InternalMessage<A>& rtmsg) const;
+
     const filter::Filter	_filter_type;
     BGPVarRW<A>*		_varrw;
 
@@ -25,6 +25,7 @@
 
 #include "bgp_module.h"
 #include "route_table_policy_im.hh"
+#include "dump_iterators.hh"
 
 template <class A>
 PolicyTableImport<A>::PolicyTableImport(const string& tablename, 
@@ -33,15 +34,24 @@ PolicyTableImport<A>::PolicyTableImport(const string& tablename,
 					PolicyFilters& pfs,
 					const A& peer,
 					const A& self)
-    : PolicyTable<A>(tablename, safi, parent, pfs, filter::IMPORT)
+    : PolicyTable<A>(tablename, safi, parent, pfs, filter::IMPORT),
+      _dump_iter(NULL)
 {
     this->_parent = parent;
     this->_varrw->set_peer(peer);
     this->_varrw->set_self(self);
 }
 
+template <class A>
+bool
+PolicyTableImport<A>::dump_next_route(DumpIterator<A>& dump_iter)
+{
+    _dump_iter = &dump_iter;
+    bool more = PolicyTable<A>::dump_next_route(dump_iter);
+    _dump_iter = NULL;
 
-
+    return more;
+}
 
 template <class A>
 int
@@ -60,6 +70,17 @@ PolicyTableImport<A>::route_dump(InternalMessage<A>& rtmsg,
     
     debug_msg("[BGP] Policy route dump: %s\n\n", rtmsg.str().c_str());
 
+    // routes a policy change can't affect keep their state downstream.
+    bool reevaluate = this->needs_refiltering(rtmsg);
+
+    if (_dump_iter != NULL)
+	_dump_iter->policy_route_examined(reevaluate);
+
+    if (!reevaluate) {
+	debug_msg("[BGP] Policy route dump: route not affected\n");
+	return rtmsg.route()->is_filtered() ? ADD_FILTERED : ADD_USED;
+    }
+
 #if 0
     // "old" filter...
     InternalMessage<A>* fmsg = do_filtering(rtmsg, false);
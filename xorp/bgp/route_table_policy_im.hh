@@ -61,6 +61,18 @@ public:
     int route_dump(InternalMessage<A> &rtmsg,
                    BGPRouteTable<A> *caller,
                    const PeerHandler *dump_peer);
+
+    /**
+     * Keep track of the dump iterator, so policy route dumps can account
+     * for the routes they look at.
+     *
+     * @param dump_iter the dump iterator.
+     * @return true if there are more routes to dump.
+     */
+    bool dump_next_route(DumpIterator<A>& dump_iter);
+
+private:
+    DumpIterator<A>*	_dump_iter;
 };
 
 #endif // __BGP_ROUTE_TABLE_POLICY_IM_HH__
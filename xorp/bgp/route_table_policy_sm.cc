@@ -36,7 +36,8 @@ PolicyTableSourceMatch<A>::PolicyTableSourceMatch(const string& tablename,
 						  PolicyFilters& pfs,
 						  EventLoop& ev)
     : PolicyTable<A>(tablename, safi, parent, pfs, filter::EXPORT_SOURCEMATCH),
-      _pushing_routes(false), _dump_iter(NULL), _ev(ev)
+      _pushing_routes(false), _dump_iter(NULL), _ev(ev),
+      _window_reevaluated(0)
 
 {
     this->_parent = parent;		
@@ -55,17 +56,42 @@ template <class A>
 void
 PolicyTableSourceMatch<A>::push_routes(list<const PeerTableInfo<A>*>& peer_list)
 {
+    // a new configuration arrived while still pushing the previous one.
+    // Routes already dumped are up to date, but start over anyway, as the
+    // peers to dump may have changed.
+    if (_dump_iter != NULL)
+	delete _dump_iter;
+    _resume_timer.unschedule();
+
     _pushing_routes = true;
     
     _dump_iter = new DumpIterator<A>(NULL, peer_list);
 
     debug_msg("[BGP] Push routes\n");
 
+    _window_start = TimeVal::ZERO();
+    _window_reevaluated = 0;
+
+    start_dump_task();
+}
+
+template <class A>
+void
+PolicyTableSourceMatch<A>::start_dump_task()
+{
     _dump_task = eventloop().new_task(
 	callback(this, &PolicyTableSourceMatch<A>::do_background_dump),
 	XorpTask::PRIORITY_BACKGROUND, XorpTask::WEIGHT_DEFAULT);
 }
 
+template <class A>
+void
+PolicyTableSourceMatch<A>::resume_route_dump()
+{
+    if (_pushing_routes)
+	start_dump_task();
+}
+
 template <class A>
 void
 PolicyTableSourceMatch<A>::do_next_route_dump()
@@ -94,10 +120,16 @@ void
 PolicyTableSourceMatch<A>::end_route_dump()
 {
     debug_msg("[BGP] End of push routes\n");
+
+    XLOG_INFO("Policy route push done: %u routes examined, %u re-evaluated",
+	      XORP_UINT_CAST(_dump_iter->routes_examined()),
+	      XORP_UINT_CAST(_dump_iter->routes_reevaluated()));
+
     delete _dump_iter;
     _dump_iter = NULL;
     _pushing_routes = false;
     _dump_task.unschedule();
+    _resume_timer.unschedule();
 }
 
 template <class A>
@@ -117,8 +149,42 @@ PolicyTableSourceMatch<A>::do_background_dump()
     if (!_pushing_routes)
 	return false;
 
-    // do a dump
-    do_next_route_dump();
+    TimeVal now;
+    TimerList::system_gettimeofday(&now);
+
+    TimeVal deadline = now + TimeVal(0, DUMP_SLICE_USEC);
+    TimeVal window_end = _window_start + TimeVal(1, 0);
+
+    if (now >= window_end) {
+	_window_start = now;
+	window_end = now + TimeVal(1, 0);
+	_window_reevaluated = _dump_iter->routes_reevaluated();
+    }
+
+    for (uint32_t i = 0; i < DUMP_BATCH; i++) {
+	// too many routes filtered lately, wait for the window to end.
+	if (_dump_iter->routes_reevaluated() - _window_reevaluated
+	    >= MAX_REEVALUATIONS) {
+	    debug_msg("[BGP] Policy route push rate limited\n");
+
+	    TimeVal wait = window_end > now ? window_end - now
+					    : TimeVal::ZERO();
+
+	    _resume_timer = eventloop().new_oneoff_after(wait,
+		callback(this, &PolicyTableSourceMatch<A>::resume_route_dump));
+	    return false;
+	}
+
+	// do a dump
+	do_next_route_dump();
+
+	if (!_pushing_routes)
+	    return false;
+
+	TimerList::system_gettimeofday(&now);
+	if (now >= deadline)
+	    break;
+    }
 
     // continue in background...
     return true;
@@ -85,10 +85,27 @@ private:
     void end_route_dump();
 
     /**
-     * Do a background route dump
+     * Do a background route dump.
+     *
+     * Each run dumps up to DUMP_BATCH routes, but stops early once
+     * DUMP_SLICE_USEC microseconds have passed.  At most MAX_REEVALUATIONS
+     * routes are filtered again each second; once that limit is reached, the
+     * dump is suspended until the second is over.
+     *
+     * @return true if the task should run again.
      */
     bool do_background_dump();
 
+    /**
+     * Resume a route dump suspended by the rate limit.
+     */
+    void resume_route_dump();
+
+    /**
+     * Schedule the background route dump task.
+     */
+    void start_dump_task();
+
     /**
      * Check whether a policy push is occuring 
      *
@@ -99,10 +116,18 @@ private:
 private:
     EventLoop&		eventloop();
 
+    static const uint32_t DUMP_BATCH = 100;		// routes per task run.
+    static const uint32_t DUMP_SLICE_USEC = 10000;	// time per task run.
+    static const uint32_t MAX_REEVALUATIONS = 20000;	// routes per second.
+
     bool		_pushing_routes;
     DumpIterator<A>*	_dump_iter;
     EventLoop&		_ev;
     XorpTask		_dump_task;
+    XorpTimer		_resume_timer;
+
+    TimeVal		_window_start;		// start of rate limit window.
+    uint32_t		_window_reevaluated;	// count at window start.
 };
 
 #endif // __BGP_ROUTE_TABLE_POLICY_SM_HH__
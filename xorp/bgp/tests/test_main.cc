@@ -192,6 +192,9 @@ main(int argc, char** argv)
 	    {"nhr.test9", callback(nhr_test9<IPv4>, nh4, rnh4, nlri4, iter)},
 	    {"nhr.test9.ipv6", callback(nhr_test9<IPv6>, nh6, rnh6, nlri6,
 					iter)},
+
+	    {"nhr.test10", callback(nhr_test10<IPv4>, nh4, rnh4, nlri4)},
+	    {"nhr.test10.ipv6", callback(nhr_test10<IPv6>, nh6, rnh6, nlri6)},
 	};
 
 	if("" == test_name) {
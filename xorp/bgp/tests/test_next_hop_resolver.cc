@@ -30,6 +30,8 @@
 #include "libxorp/xlog.h"
 #include "libxorp/ipv4.hh"
 
+#include "libxipc/xrl_atom_list.hh"
+
 #include "test_next_hop_resolver.hh"
 #include "next_hop_resolver.hh"
 #include "route_table_nhlookup.hh"
@@ -1167,6 +1169,203 @@ nhr_test9(TestInfo& info, A nexthop, A /*real_nexthop*/, IPNet<A> subnet,
     return true;
 }
 
+/**
+ * Consecutive registrations and de-registrations are sent to the RIB
+ * in batches. Answer a batch and send an invalid for one of its
+ * entries while the batch is outstanding.
+ */
+template <class A>
+bool
+nhr_test10(TestInfo& info, A nexthop, A real_nexthop, IPNet<A> subnet)
+{
+    DOUT(info) << "nexthop: " << nexthop.str() << endl;
+
+    EventLoop eventloop;
+    BGPMain bgp(eventloop);
+    DummyNextHopResolver2<A> nhr = DummyNextHopResolver2<A>(eventloop, bgp);
+
+    NextHopRibRequest<A> *next_hop_rib_request =
+	nhr.get_next_hop_rib_request();
+    next_hop_rib_request->set_max_batch(NextHopRibRequest<A>::MAX_BATCH);
+
+    DummyNhLookupTable<A> nht0(info, &nhr);
+    DummyNhLookupTable<A> nht1(info, &nhr);
+    DummyNhLookupTable<A> nht2(info, &nhr);
+    DummyNhLookupTable<A> nht3(info, &nhr);
+    DummyNhLookupTable<A> *nht[] = {&nht0, &nht1, &nht2, &nht3};
+    const size_t count = sizeof(nht) / sizeof(nht[0]);
+
+    /*
+    ** Four consecutive next hops, each resolved by its own host route.
+    */
+    vector<A> nexthops;
+    A n = nexthop;
+    for (size_t k = 0; k < count; k++, ++n)
+	nexthops.push_back(n);
+
+    bool resolves = true;
+    uint32_t prefix_len = A::addr_bitlen();
+    uint32_t real_prefix_len = A::addr_bitlen();
+    string comment = "testing";
+
+    /*
+    ** The first registration is sent on its own, the others queue up
+    ** behind it.
+    */
+    for (size_t k = 0; k < count; k++)
+	nhr.register_nexthop(nexthops[k], subnet, nht[k]);
+
+    uint32_t metric = 1;
+    next_hop_rib_request->register_interest_response(XrlError::OKAY(),
+						     &resolves,
+						     &nexthops[0],
+						     &prefix_len,
+						     &real_prefix_len,
+						     &real_nexthop,
+						     &metric,
+						     nexthops[0],
+						     comment);
+    if (!nht0.done()) {
+	DOUT(info) << "Callback to next hop table failed\n";
+	return false;
+    }
+
+    /*
+    ** The remaining registrations are now outstanding as a single
+    ** batch. The RIB invalidates the answer for the second entry of the
+    ** batch before the response arrives.
+    */
+    if (!nhr.rib_client_route_info_invalid(nexthops[2], prefix_len)) {
+	DOUT(info) << "Invalid for a batch entry not accepted\n";
+	return false;
+    }
+
+    vector<A> batch(nexthops.begin() + 1, nexthops.end());
+    XrlAtomList resolves_list, addrs, prefix_lens, real_prefix_lens;
+    XrlAtomList actual_nexthops, metrics;
+    for (size_t k = 1; k < count; k++) {
+	resolves_list.append(XrlAtom(static_cast<uint32_t>(resolves)));
+	addrs.append(XrlAtom(nexthops[k]));
+	prefix_lens.append(XrlAtom(prefix_len));
+	real_prefix_lens.append(XrlAtom(real_prefix_len));
+	actual_nexthops.append(XrlAtom(real_nexthop));
+	metrics.append(XrlAtom(static_cast<uint32_t>(k + 1)));
+    }
+    next_hop_rib_request->register_interest_batch_response(XrlError::OKAY(),
+							   &resolves_list,
+							   &addrs,
+							   &prefix_lens,
+							   &real_prefix_lens,
+							   &actual_nexthops,
+							   &metrics,
+							   batch,
+							   comment);
+
+    /*
+    ** The invalidated answer must have been dropped, the others used.
+    */
+    if (!nht1.done() || !nht3.done()) {
+	DOUT(info) << "Callback to next hop table failed\n";
+	return false;
+    }
+    if (nht2.done()) {
+	DOUT(info) << "Invalidated answer was used\n";
+	return false;
+    }
+
+    /*
+    ** The invalidated registration is sent again.
+    */
+    metric = 3;
+    next_hop_rib_request->register_interest_response(XrlError::OKAY(),
+						     &resolves,
+						     &nexthops[2],
+						     &prefix_len,
+						     &real_prefix_len,
+						     &real_nexthop,
+						     &metric,
+						     nexthops[2],
+						     comment);
+    if (!nht2.done()) {
+	DOUT(info) << "Callback to next hop table failed\n";
+	return false;
+    }
+
+    /*
+    ** All the next hops should now be resolvable with their own metric.
+    */
+    bool res;
+    uint32_t met;
+    for (size_t k = 0; k < count; k++) {
+	if (!nhr.lookup(nexthops[k], res, met)) {
+	    DOUT(info) << "Nexthop " << nexthops[k].str() << " not in table?\n";
+	    return false;
+	}
+	if (resolves != res || k + 1 != met) {
+	    DOUT(info) << "Metrics did not match\n";
+	    return false;
+	}
+    }
+
+    /*
+    ** Deregister interest. The first de-registration is sent on its
+    ** own, the others follow as a batch.
+    */
+    for (size_t k = 0; k < count; k++)
+	nhr.deregister_nexthop(nexthops[k], subnet, nht[k]);
+
+    next_hop_rib_request->deregister_interest_response(XrlError::OKAY(),
+						       nexthops[0],
+						       prefix_len,
+						       comment);
+
+    /*
+    ** The RIB invalidates the second entry while the batch is
+    ** outstanding and fails its de-registration. The de-registration
+    ** of the third entry fails too, its invalid arrives later.
+    */
+    if (!nhr.rib_client_route_info_invalid(nexthops[2], prefix_len)) {
+	DOUT(info) << "Invalid for a batch entry not accepted\n";
+	return false;
+    }
+
+    vector<IPNet<A> > nets;
+    for (size_t k = 1; k < count; k++)
+	nets.push_back(IPNet<A>(nexthops[k], prefix_len));
+    XrlAtomList failed;
+    failed.append(XrlAtom(static_cast<uint32_t>(1)));
+    failed.append(XrlAtom(static_cast<uint32_t>(2)));
+    next_hop_rib_request->deregister_interest_batch_response(XrlError::OKAY(),
+							     &failed,
+							     nets,
+							     comment);
+
+    if (!nhr.rib_client_route_info_invalid(nexthops[3], prefix_len)) {
+	DOUT(info) << "Tardy invalid not accepted\n";
+	return false;
+    }
+
+    /*
+    ** The invalid received during the batch must not be expected again.
+    */
+    if (nhr.rib_client_route_info_invalid(nexthops[2], prefix_len)) {
+	DOUT(info) << "Invalid accepted twice\n";
+	return false;
+    }
+
+    /*
+    ** A lookup should fail now.
+    */
+    for (size_t k = 0; k < count; k++) {
+	if (nhr.lookup(nexthops[k], res, met)) {
+	    DOUT(info) << "Nexthop " << nexthops[k].str() << " in table?\n";
+	    return false;
+	}
+    }
+
+    return true;
+}
+
 /*
 ** This function is never called it exists to instantiate the
 ** templatised functions.
@@ -1202,4 +1401,7 @@ dummy()
 
     callback(nhr_test9<IPv4>);
     callback(nhr_test9<IPv6>);
+
+    callback(nhr_test10<IPv4>);
+    callback(nhr_test10<IPv6>);
 }
@@ -588,7 +588,7 @@ test_announce_packet1(TestInfo& info, BGPPeer* peer)
 	case COMMUNITY: {
 	    CommunityAttribute *ca =
 		(CommunityAttribute*)pa;
-	    set <uint32_t>::const_iterator iter;
+	    CommunityAttribute::const_iterator iter;
 	    iter = ca->community_set().begin();
 	    assert(*iter == 57);
 	    ++iter;
@@ -804,7 +804,7 @@ test_announce_packet2(TestInfo& info, BGPPeer* peer)
 	case COMMUNITY: {
 	    CommunityAttribute *ca =
 		(CommunityAttribute*)pa;
-	    set <uint32_t>::const_iterator iter;
+	    CommunityAttribute::const_iterator iter;
 	    iter = ca->community_set().begin();
 	    assert(*iter == 57);
 	    ++iter;
@@ -1193,6 +1193,38 @@ XrlCmdError XrlBgpTarget::rib_client_0_1_route_info_invalid4(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError XrlBgpTarget::rib_client_0_1_route_info_invalid4_batch(
+	// Input values,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens)
+{
+    if (addrs.size() != prefix_lens.size())
+	return XrlCmdError::BAD_ARGS("Invalidation mismatch");
+
+    // Process every entry even if one fails, the RIB has already
+    // dropped all of these registrations.
+    bool ok = true;
+    for (size_t i = 0; i < addrs.size(); i++) {
+	const XrlAtom& atom_addr = addrs.get(i);
+	const XrlAtom& atom_prefix_len = prefix_lens.get(i);
+	if (atom_addr.type() != xrlatom_ipv4
+	    || atom_prefix_len.type() != xrlatom_uint32)
+	    return XrlCmdError::BAD_ARGS("Bad element type in invalidation");
+
+	debug_msg("IGP route into changed for net %s/%u\n",
+		  atom_addr.ipv4().str().c_str(),
+		  XORP_UINT_CAST(atom_prefix_len.uint32()));
+	if (!_bgp.rib_client_route_info_invalid4(atom_addr.ipv4(),
+						  atom_prefix_len.uint32()))
+	    ok = false;
+    }
+
+    if (!ok)
+	return XrlCmdError::COMMAND_FAILED();
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError XrlBgpTarget::bgp_0_3_set_parameter(
 				  // Input values,
 				  const string&	local_ip, 
@@ -1288,6 +1320,19 @@ XrlBgpTarget::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlBgpTarget::policy_backend_0_1_get_statistics(const uint32_t& filter,
+						string& statistics)
+{
+    try {
+	statistics = _bgp.filter_statistics(filter);
+    } catch(const PolicyException& e){ 
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError 
 XrlBgpTarget::policy_redist4_0_1_add_route4(
         const IPv4Net&	    network,
@@ -1599,6 +1644,38 @@ XrlCmdError XrlBgpTarget::rib_client_0_1_route_info_invalid6(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError XrlBgpTarget::rib_client_0_1_route_info_invalid6_batch(
+	// Input values,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens)
+{
+    if (addrs.size() != prefix_lens.size())
+	return XrlCmdError::BAD_ARGS("Invalidation mismatch");
+
+    // Process every entry even if one fails, the RIB has already
+    // dropped all of these registrations.
+    bool ok = true;
+    for (size_t i = 0; i < addrs.size(); i++) {
+	const XrlAtom& atom_addr = addrs.get(i);
+	const XrlAtom& atom_prefix_len = prefix_lens.get(i);
+	if (atom_addr.type() != xrlatom_ipv6
+	    || atom_prefix_len.type() != xrlatom_uint32)
+	    return XrlCmdError::BAD_ARGS("Bad element type in invalidation");
+
+	debug_msg("IGP route into changed for net %s/%u\n",
+		  atom_addr.ipv6().str().c_str(),
+		  XORP_UINT_CAST(atom_prefix_len.uint32()));
+	if (!_bgp.rib_client_route_info_invalid6(atom_addr.ipv6(),
+						  atom_prefix_len.uint32()))
+	    ok = false;
+    }
+
+    if (!ok)
+	return XrlCmdError::COMMAND_FAILED();
+
+    return XrlCmdError::OKAY();
+}
+
 
 XrlCmdError 
 XrlBgpTarget::policy_redist6_0_1_add_route6(
@@ -396,6 +396,11 @@ public:
 	const IPv4&	addr,
 	const uint32_t&	prefix_len);
 
+    XrlCmdError rib_client_0_1_route_info_invalid4_batch(
+	// Input values,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens);
+
     XrlCmdError bgp_0_3_set_parameter(
         // Input values,
 	const string&	local_ip,
@@ -426,6 +431,12 @@ public:
 
     XrlCmdError policy_backend_0_1_push_routes();
 
+    XrlCmdError policy_backend_0_1_get_statistics(
+        // Input values,
+        const uint32_t& filter,
+        // Output values,
+        string&         statistics);
+
     XrlCmdError policy_redist4_0_1_add_route4(
         // Input values,
         const IPv4Net&  network,
@@ -515,6 +526,11 @@ public:
 	// Input values,
 	const IPv6&	addr,
 	const uint32_t&	prefix_len);
+
+    XrlCmdError rib_client_0_1_route_info_invalid6_batch(
+	// Input values,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens);
         
     XrlCmdError policy_redist6_0_1_add_route6(
         // Input values,
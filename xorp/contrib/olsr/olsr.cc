@@ -324,6 +324,12 @@ Olsr::reset_filter(const uint32_t& filter)
     _policy_filters.reset(filter);
 }
 
+string
+Olsr::filter_statistics(const uint32_t& filter)
+{
+    return _policy_filters.statistics(filter);
+}
+
 void
 Olsr::push_routes()
 {
@@ -512,6 +512,14 @@ class Olsr {
      */
     void reset_filter(const uint32_t& filter);
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter Id of filter to report on.
+     * @return human readable statistics of the filter.
+     */
+    string filter_statistics(const uint32_t& filter);
+
     /**
      * Push routes through policy filters for re-filtering.
      */
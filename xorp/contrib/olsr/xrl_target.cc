@@ -272,6 +272,23 @@ XrlOlsr4Target::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlOlsr4Target::policy_backend_0_1_get_statistics(const uint32_t& filter,
+						  string& statistics)
+{
+    debug_msg("policy_backend_0_1_get_statistics %u\n",
+	      XORP_UINT_CAST(filter));
+
+    try {
+	statistics = _olsr.filter_statistics(filter);
+    } catch(const PolicyException& e) {
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 
 /*
  * policy_redist/0.1 target interface.
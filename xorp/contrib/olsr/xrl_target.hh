@@ -198,6 +198,19 @@ public:
      */
     XrlCmdError policy_backend_0_1_push_routes();
 
+    /**
+     * Obtain the per policy and per term counters of a filter, and the
+     * time spent running it, since it was last configured.
+     *
+     * @param filter the identifier of the filter.
+     * @param statistics human readable statistics.
+     */
+    XrlCmdError policy_backend_0_1_get_statistics(
+	// Input values,
+	const uint32_t&	filter,
+	// Output values,
+	string&	statistics);
+
     /**
      * Start route redistribution for an IPv4 route.
      *
@@ -676,6 +676,11 @@ void Wrapper::reset_filter(const uint32_t& filter)
     _policy_filters.reset(filter);
 }
 
+string Wrapper::filter_statistics(const uint32_t& filter)
+{
+    return _policy_filters.statistics(filter);
+}
+
 bool Wrapper::policy_filtering(IPv4Net& net, IPv4& nexthop,
                                uint32_t& metric, IPv4 originator,
                                IPv4 main_addr,uint32_t type,
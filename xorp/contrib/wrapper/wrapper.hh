@@ -87,6 +87,7 @@ public:
 
     void configure_filter(const uint32_t& filter, const string& conf);
     void reset_filter(const uint32_t& filter);
+    string filter_statistics(const uint32_t& filter);
     bool policy_filtering(IPv4Net& net, IPv4& nexthop,
                           uint32_t& metric, IPv4 originator,
                           IPv4 main_addr,uint32_t type,
@@ -195,6 +195,22 @@ XrlCmdError XrlWrapper4Target::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError XrlWrapper4Target::policy_backend_0_1_get_statistics(
+    const uint32_t& filter,
+    string& statistics)
+{
+    debug_msg("policy_backend_0_1_get_statistics %u\n",
+              XORP_UINT_CAST(filter));
+    try {
+        statistics = _wrapper.filter_statistics(filter);
+    } catch(const PolicyException& e) {
+        return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+                                           e.str());
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError XrlWrapper4Target::policy_redist4_0_1_add_route4(
     const IPv4Net&      network,
     const bool&         unicast,
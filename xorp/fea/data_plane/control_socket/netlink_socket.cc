@@ -88,6 +88,7 @@ NetlinkSocket::NetlinkSocket(EventLoop& eventloop, uint32_t table_id)
       _nl_groups(0),		// XXX: no netlink multicast groups
       _table_id(table_id),
       _is_multipart_message_read(false),
+      _is_multipart_message_streaming(false),
       _nlm_count(0)
 {
 
@@ -219,8 +220,17 @@ NetlinkSocket::start(string& error_msg)
     //
     // Increase the receiving buffer size of the socket to avoid
     // loss of data from the kernel.
+    // A full table dump or a burst of route changes can be much larger
+    // than the usual maximum, so try to bypass the system limit first.
     //
-    comm_sock_set_rcvbuf(_fd, SO_RCV_BUF_SIZE_MAX, SO_RCV_BUF_SIZE_MIN);
+#ifdef SO_RCVBUFFORCE
+    int rcvbuf = NETLINK_SOCKET_RCVBUF;
+    if (setsockopt(_fd, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf))
+	< 0)
+#endif
+    {
+	comm_sock_set_rcvbuf(_fd, NETLINK_SOCKET_RCVBUF, SO_RCV_BUF_SIZE_MIN);
+    }
 
     // TODO: do we want to make the socket non-blocking?
 
@@ -327,7 +337,7 @@ NetlinkSocket::force_recvmsg_flgs(int flags, bool only_kernel_messages,
 			     string& error_msg)
 {
     vector<uint8_t> message;
-    vector<uint8_t> buffer(NETLINK_SOCKET_BYTES);
+    vector<uint8_t>& buffer = _rcvbuf;
     size_t off = 0;
     size_t last_mh_off = 0;
     struct iovec	iov;
@@ -338,6 +348,9 @@ NetlinkSocket::force_recvmsg_flgs(int flags, bool only_kernel_messages,
     memset(&snl, 0, sizeof(snl));
     snl.nl_family = AF_NETLINK;
 
+    if (buffer.size() < NETLINK_SOCKET_BYTES)
+	buffer.resize(NETLINK_SOCKET_BYTES);
+
     // Init the recvmsg() arguments
     iov.iov_base = &buffer[0];
     iov.iov_len = buffer.size();
@@ -428,6 +441,19 @@ NetlinkSocket::force_recvmsg_flgs(int flags, bool only_kernel_messages,
 	last_mh_off = (size_t)(mh) - (size_t)(&message[0]);
 	if (is_end_of_message)
 	    break;
+
+	if (_is_multipart_message_streaming) {
+	    //
+	    // Pass on the part, so the whole message is never held in memory
+	    //
+	    XLOG_ASSERT(last_mh_off == message.size());
+	    for (ObserverList::iterator i = _ol.begin(); i != _ol.end(); i++) {
+		(*i)->netlink_socket_data(message);
+	    }
+	    message.clear();
+	    off = 0;
+	    last_mh_off = 0;
+	}
     }
     XLOG_ASSERT(last_mh_off == message.size());
 
@@ -451,12 +477,22 @@ NetlinkSocket::io_event(XorpFd fd, IoEventType type)
 
     XLOG_ASSERT(fd == _fd);
     XLOG_ASSERT(type == IOT_READ);
-    errno = 0;
-    if (force_recvmsg(true, error_msg) != XORP_OK) {
-	if (!(errno == EWOULDBLOCK || errno == EAGAIN)) {
-	    XLOG_ERROR("Error force_recvmsg() from netlink socket: %s",
-		       error_msg.c_str());
+
+    //
+    // Drain a bounded number of messages, so the observers see a burst of
+    // kernel events within the same event loop iteration.
+    //
+    for (size_t i = 0; i < NETLINK_SOCKET_READS_PER_EVENT; i++) {
+	errno = 0;
+	if (force_recvmsg(true, error_msg) != XORP_OK) {
+	    if (!(errno == EWOULDBLOCK || errno == EAGAIN)) {
+		XLOG_ERROR("Error force_recvmsg() from netlink socket: %s",
+			   error_msg.c_str());
+	    }
+	    break;
 	}
+	if (! is_open())
+	    break;		// XXX: an observer has stopped the socket
     }
 }
 
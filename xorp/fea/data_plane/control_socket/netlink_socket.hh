@@ -158,6 +158,22 @@ public:
      */
     void	set_multipart_message_read(bool v) { _is_multipart_message_read = v; }
 
+    /**
+     * Set a flag to pass each part of a multipart message to the observers
+     * as soon as it is received.
+     *
+     * By default the parts are accumulated, and the observers are given
+     * the whole message once NLMSG_DONE is received.  For large messages
+     * such as a full forwarding table dump this needs a temporary buffer
+     * as large as the whole message.
+     *
+     * @param v if true, pass each part of a multipart message to the
+     * observers as it is received.
+     */
+    void	set_multipart_message_streaming(bool v) {
+	_is_multipart_message_streaming = v;
+    }
+
     /** Routing table ID that we are interested in might have changed.
      */
     virtual int notify_table_id_change(uint32_t new_tbl);
@@ -174,7 +190,9 @@ private:
 
     int bind_table_id();
 
-    static const size_t NETLINK_SOCKET_BYTES = 8*1024;	// Initial guess at msg size
+    static const size_t NETLINK_SOCKET_BYTES = 32*1024;	// Initial guess at msg size
+    static const int NETLINK_SOCKET_RCVBUF = 4*1024*1024; // Socket buffer size
+    static const size_t NETLINK_SOCKET_READS_PER_EVENT = 64; // Max reads per event
 
     EventLoop&	 _eventloop;
     int		 _fd;
@@ -189,6 +207,8 @@ private:
     uint32_t	_nl_groups;	// The netlink multicast groups to listen for
     uint32_t _table_id; // routing table.. or 0 if any/all (default behaviour)
     bool	_is_multipart_message_read; // If true, expect to read a multipart message
+    bool	_is_multipart_message_streaming; // If true, pass on each part
+    vector<uint8_t> _rcvbuf;	// The buffer for recvmsg()
 
     uint32_t   _nlm_count; // keep track of how many msgs received.
 
@@ -95,7 +95,7 @@ FibConfigEntryGetClick::stop(string& error_msg)
 int
 FibConfigEntryGetClick::lookup_route_by_dest4(const IPv4& dst, Fte4& fte)
 {
-    list<Fte4> fte_list4;
+    Fte4Batch fte_list4;
     bool found = false;
 
     //
@@ -106,7 +106,7 @@ FibConfigEntryGetClick::lookup_route_by_dest4(const IPv4& dst, Fte4& fte)
     if (fibconfig().get_table4(fte_list4) != XORP_OK)
 	return (XORP_ERROR);
 
-    list<Fte4>::iterator iter4;
+    Fte4Batch::iterator iter4;
     for (iter4 = fte_list4.begin(); iter4 != fte_list4.end(); ++iter4) {
 	Fte4& fte4 = *iter4;
 	if (! fte4.net().contains(dst))
@@ -125,7 +125,7 @@ FibConfigEntryGetClick::lookup_route_by_dest4(const IPv4& dst, Fte4& fte)
 int
 FibConfigEntryGetClick::lookup_route_by_network4(const IPv4Net& dst, Fte4& fte)
 {
-    list<Fte4> fte_list4;
+    Fte4Batch fte_list4;
 
     //
     // XXX: Get the whole table, and then scan it entry-by-entry
@@ -135,7 +135,7 @@ FibConfigEntryGetClick::lookup_route_by_network4(const IPv4Net& dst, Fte4& fte)
     if (fibconfig().get_table4(fte_list4) != XORP_OK)
 	return (XORP_ERROR);
 
-    list<Fte4>::iterator iter4;
+    Fte4Batch::iterator iter4;
     for (iter4 = fte_list4.begin(); iter4 != fte_list4.end(); ++iter4) {
 	Fte4& fte4 = *iter4;
 	if (fte4.net() == dst) {
@@ -150,7 +150,7 @@ FibConfigEntryGetClick::lookup_route_by_network4(const IPv4Net& dst, Fte4& fte)
 int
 FibConfigEntryGetClick::lookup_route_by_dest6(const IPv6& dst, Fte6& fte)
 {
-    list<Fte6> fte_list6;
+    Fte6Batch fte_list6;
     bool found = false;
 
     //
@@ -161,7 +161,7 @@ FibConfigEntryGetClick::lookup_route_by_dest6(const IPv6& dst, Fte6& fte)
     if (fibconfig().get_table6(fte_list6) != XORP_OK)
 	return (XORP_ERROR);
 
-    list<Fte6>::iterator iter6;
+    Fte6Batch::iterator iter6;
     for (iter6 = fte_list6.begin(); iter6 != fte_list6.end(); ++iter6) {
 	Fte6& fte6 = *iter6;
 	if (! fte6.net().contains(dst))
@@ -180,7 +180,7 @@ FibConfigEntryGetClick::lookup_route_by_dest6(const IPv6& dst, Fte6& fte)
 int
 FibConfigEntryGetClick::lookup_route_by_network6(const IPv6Net& dst, Fte6& fte)
 { 
-    list<Fte6> fte_list6;
+    Fte6Batch fte_list6;
 
     //
     // XXX: Get the whole table, and then scan it entry-by-entry
@@ -190,7 +190,7 @@ FibConfigEntryGetClick::lookup_route_by_network6(const IPv6Net& dst, Fte6& fte)
     if (fibconfig().get_table6(fte_list6) != XORP_OK)
 	return (XORP_ERROR);
 
-    list<Fte6>::iterator iter6;
+    Fte6Batch::iterator iter6;
     for (iter6 = fte_list6.begin(); iter6 != fte_list6.end(); ++iter6) {
 	Fte6& fte6 = *iter6;
 	if (fte6.net() == dst) {
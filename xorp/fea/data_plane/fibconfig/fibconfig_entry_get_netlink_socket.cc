@@ -114,12 +114,12 @@ int
 FibConfigEntryGetNetlinkSocket::lookup_route_by_network4(const IPv4Net& dst,
 							 Fte4& fte)
 {
-    list<Fte4> fte_list4;
+    Fte4Batch fte_list4;
 
     if (fibconfig().get_table4(fte_list4) != XORP_OK)
 	return (XORP_ERROR);
 
-    list<Fte4>::iterator iter4;
+    Fte4Batch::iterator iter4;
     for (iter4 = fte_list4.begin(); iter4 != fte_list4.end(); ++iter4) {
 	Fte4& fte4 = *iter4;
 	if (fte4.net() == dst) {
@@ -149,12 +149,12 @@ int
 FibConfigEntryGetNetlinkSocket::lookup_route_by_network6(const IPv6Net& dst,
 							 Fte6& fte)
 { 
-    list<Fte6> fte_list6;
+    Fte6Batch fte_list6;
 
     if (fibconfig().get_table6(fte_list6) != XORP_OK)
 	return (XORP_ERROR);
 
-    list<Fte6>::iterator iter6;
+    Fte6Batch::iterator iter6;
     for (iter6 = fte_list6.begin(); iter6 != fte_list6.end(); ++iter6) {
 	Fte6& fte6 = *iter6;
 	if (fte6.net() == dst) {
@@ -95,7 +95,7 @@ FibConfigTableGetClick::stop(string& error_msg)
 }
 
 int
-FibConfigTableGetClick::get_table4(list<Fte4>& fte_list)
+FibConfigTableGetClick::get_table4(Fte4Batch& fte_list)
 {
     //
     // XXX: Get the table from the FibConfigEntrySetClick instance.
@@ -128,7 +128,7 @@ FibConfigTableGetClick::get_table4(list<Fte4>& fte_list)
 }
 
 int
-FibConfigTableGetClick::get_table6(list<Fte6>& fte_list)
+FibConfigTableGetClick::get_table6(Fte6Batch& fte_list)
 {
 #ifndef HAVE_IPV6
     UNUSED(fte_list);
@@ -81,7 +81,7 @@ FibConfigTableGetDummy::stop(string& error_msg)
 }
 
 int
-FibConfigTableGetDummy::get_table4(list<Fte4>& fte_list)
+FibConfigTableGetDummy::get_table4(Fte4Batch& fte_list)
 {
     Trie4::iterator ti;
     for (ti = fibconfig().trie4().begin(); ti != fibconfig().trie4().end(); ++ti) {
@@ -93,7 +93,7 @@ FibConfigTableGetDummy::get_table4(list<Fte4>& fte_list)
 }
 
 int
-FibConfigTableGetDummy::get_table6(list<Fte6>& fte_list)
+FibConfigTableGetDummy::get_table6(Fte6Batch& fte_list)
 {
     Trie6::iterator ti;
     for (ti = fibconfig().trie6().begin(); ti != fibconfig().trie6().end(); ++ti) {
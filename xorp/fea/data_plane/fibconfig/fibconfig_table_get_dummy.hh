@@ -63,7 +63,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table4(list<Fte4>& fte_list);
+    virtual int get_table4(Fte4Batch& fte_list);
 
     /**
      * Obtain the IPv6 unicast forwarding table.
@@ -72,7 +72,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table6(list<Fte6>& fte_list);
+    virtual int get_table6(Fte6Batch& fte_list);
 
     /** Routing table ID that we are interested in might have changed.
      */
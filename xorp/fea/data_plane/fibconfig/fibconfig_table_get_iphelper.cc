@@ -100,16 +100,16 @@ FibConfigTableGetIPHelper::stop(string& error_msg)
 }
 
 int
-FibConfigTableGetIPHelper::get_table4(list<Fte4>& fte_list)
+FibConfigTableGetIPHelper::get_table4(Fte4Batch& fte_list)
 {
-    list<FteX> ftex_list;
+    FteXBatch ftex_list;
     
     // Get the table
     if (get_table(AF_INET, ftex_list) != XORP_OK)
 	return (XORP_ERROR);
     
     // Copy the result back to the original list
-    list<FteX>::iterator iter;
+    FteXBatch::iterator iter;
     for (iter = ftex_list.begin(); iter != ftex_list.end(); ++iter) {
 	FteX& ftex = *iter;
 	fte_list.push_back(ftex.get_fte4());
@@ -119,14 +119,14 @@ FibConfigTableGetIPHelper::get_table4(list<Fte4>& fte_list)
 }
 
 int
-FibConfigTableGetIPHelper::get_table6(list<Fte6>& fte_list)
+FibConfigTableGetIPHelper::get_table6(Fte6Batch& fte_list)
 {
     UNUSED(fte_list);
     return (XORP_ERROR);
 }
 
 int
-FibConfigTableGetIPHelper::get_table(int family, list<FteX>& fte_list)
+FibConfigTableGetIPHelper::get_table(int family, FteXBatch& fte_list)
 {
     // Check that the family is supported
     switch(family) {
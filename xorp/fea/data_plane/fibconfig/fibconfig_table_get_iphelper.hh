@@ -61,7 +61,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table4(list<Fte4>& fte_list);
+    virtual int get_table4(Fte4Batch& fte_list);
 
     /**
      * Obtain the IPv6 unicast forwarding table.
@@ -70,7 +70,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table6(list<Fte6>& fte_list);
+    virtual int get_table6(Fte6Batch& fte_list);
 
     virtual int notify_table_id_change(uint32_t new_tbl) {
 	UNUSED(new_tbl);
@@ -78,7 +78,7 @@ public:
     }
 
 private:
-    int get_table(int family, list<FteX>& fte_list);
+    int get_table(int family, FteXBatch& fte_list);
 };
 
 #endif // __FEA_DATA_PLANE_FIBCONFIG_FIBCONFIG_TABLE_GET_IPHELPER_HH__
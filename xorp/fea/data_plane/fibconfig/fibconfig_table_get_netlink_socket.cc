@@ -49,7 +49,12 @@ FibConfigTableGetNetlinkSocket::FibConfigTableGetNetlinkSocket(FeaDataPlaneManag
     : FibConfigTableGet(fea_data_plane_manager),
       NetlinkSocket(fea_data_plane_manager.eventloop(),
 		    fea_data_plane_manager.fibconfig().get_netlink_filter_table_id()),
-      _ns_reader(*(NetlinkSocket *)this)
+      NetlinkSocketObserver(*(NetlinkSocket *)this),
+      _dump_family(AF_UNSPEC),
+      _dump_seqno(0),
+      _dump_sink(NULL),
+      _is_dump_done(false),
+      _is_dump_error(false)
 {
 }
 
@@ -93,52 +98,58 @@ FibConfigTableGetNetlinkSocket::stop(string& error_msg)
     return (XORP_OK);
 }
 
+/**
+ * Sink which stores the IPv4 entries in a list.
+ */
+class Fte4ListSink : public FibConfigTableGetNetlinkSocket::FteSink {
+public:
+    Fte4ListSink(Fte4Batch& fte_list) : _fte_list(fte_list) {}
+
+    void add_fte(const FteX& fte) { _fte_list.push_back(fte.get_fte4()); }
+
+private:
+    Fte4Batch&	_fte_list;
+};
+
 int
-FibConfigTableGetNetlinkSocket::get_table4(list<Fte4>& fte_list)
+FibConfigTableGetNetlinkSocket::get_table4(Fte4Batch& fte_list)
 {
-    list<FteX> ftex_list;
+    Fte4ListSink fte_sink(fte_list);
 
-    // Get the table
-    if (get_table(AF_INET, ftex_list) != XORP_OK)
-	return (XORP_ERROR);
-    
-    // Copy the result back to the original list
-    list<FteX>::iterator iter;
-    for (iter = ftex_list.begin(); iter != ftex_list.end(); ++iter) {
-	FteX& ftex = *iter;
-	fte_list.push_back(ftex.get_fte4());
-    }
-    
-    return (XORP_OK);
+    return (get_table(AF_INET, fte_sink));
 }
 
+#ifdef HAVE_IPV6
+/**
+ * Sink which stores the IPv6 entries in a list.
+ */
+class Fte6ListSink : public FibConfigTableGetNetlinkSocket::FteSink {
+public:
+    Fte6ListSink(Fte6Batch& fte_list) : _fte_list(fte_list) {}
+
+    void add_fte(const FteX& fte) { _fte_list.push_back(fte.get_fte6()); }
+
+private:
+    Fte6Batch&	_fte_list;
+};
+#endif // HAVE_IPV6
+
 int
-FibConfigTableGetNetlinkSocket::get_table6(list<Fte6>& fte_list)
+FibConfigTableGetNetlinkSocket::get_table6(Fte6Batch& fte_list)
 {
 #ifndef HAVE_IPV6
     UNUSED(fte_list);
     
     return (XORP_ERROR);
 #else
-    list<FteX> ftex_list;
-    
-    // Get the table
-    if (get_table(AF_INET6, ftex_list) != XORP_OK)
-	return (XORP_ERROR);
-    
-    // Copy the result back to the original list
-    list<FteX>::iterator iter;
-    for (iter = ftex_list.begin(); iter != ftex_list.end(); ++iter) {
-	FteX& ftex = *iter;
-	fte_list.push_back(ftex.get_fte6());
-    }
-    
-    return (XORP_OK);
+    Fte6ListSink fte_sink(fte_list);
+
+    return (get_table(AF_INET6, fte_sink));
 #endif // HAVE_IPV6
 }
 
 int
-FibConfigTableGetNetlinkSocket::get_table(int family, list<FteX>& fte_list)
+FibConfigTableGetNetlinkSocket::get_table(int family, FteSink& fte_sink)
 {
     static const size_t	buffer_size = sizeof(struct nlmsghdr)
 	+ sizeof(struct rtmsg) + 512;
@@ -238,30 +249,91 @@ FibConfigTableGetNetlinkSocket::get_table(int family, list<FteX>& fte_list)
     }
 
     //
-    // Force to receive data from the kernel, and then parse it
+    // Force to receive data from the kernel. Each part is parsed by
+    // netlink_socket_data() as it arrives, so the whole table is never
+    // held in a single buffer.
     //
     //
     // XXX: setting the flag below is a work-around hack because of a
     // Linux kernel bug: when we read the forwarding table the kernel
     // doesn't set the NLM_F_MULTI flag for the multipart messages.
     //
+    _dump_family = family;
+    _dump_seqno = nlh->nlmsg_seq;
+    _dump_sink = &fte_sink;
+    _is_dump_done = false;
+    _is_dump_error = false;
     ns.set_multipart_message_read(true);
+    ns.set_multipart_message_streaming(true);
+
     string error_msg;
-    if (_ns_reader.receive_data(ns, nlh->nlmsg_seq, error_msg)
-	!= XORP_OK) {
-	ns.set_multipart_message_read(false);
-	XLOG_ERROR("Error reading from netlink socket: %s", error_msg.c_str());
-	return (XORP_ERROR);
+    int ret_value = XORP_OK;
+    errno = 0;
+    while (! _is_dump_done) {
+	if (ns.force_recvmsg(true, error_msg) != XORP_OK) {
+	    XLOG_ERROR("Error reading from netlink socket: %s",
+		       error_msg.c_str());
+	    ret_value = XORP_ERROR;
+	    break;
+	}
     }
+
     // XXX: reset the multipart message read hackish flag
     ns.set_multipart_message_read(false);
+    ns.set_multipart_message_streaming(false);
+    _dump_sink = NULL;
+
+    if (_is_dump_error)
+	ret_value = XORP_ERROR;
+
+    return (ret_value);
+}
+
+void
+FibConfigTableGetNetlinkSocket::netlink_socket_data(vector<uint8_t>& buffer)
+{
+    size_t buffer_bytes = buffer.size();
+    struct nlmsghdr* nlh;
 
-    if (parse_buffer_netlink_socket(family, fibconfig().system_config_iftree(),
-				    fte_list, _ns_reader.buffer(), true, fibconfig())
+    if (_dump_sink == NULL)
+	return;			// XXX: no table dump in progress
+
+    //
+    // Check whether the data is the reply to our request, and whether
+    // it completes the reply.
+    //
+    bool is_reply = false;
+    for (nlh = (struct nlmsghdr*)(&buffer[0]);
+	 NLMSG_OK(nlh, buffer_bytes);
+	 nlh = NLMSG_NEXT(nlh, buffer_bytes)) {
+	if ((nlh->nlmsg_seq != _dump_seqno)
+	    || (nlh->nlmsg_pid != netlink_socket().nl_pid())) {
+	    continue;
+	}
+	is_reply = true;
+	if (nlh->nlmsg_type == NLMSG_DONE)
+	    _is_dump_done = true;
+	if (nlh->nlmsg_type == NLMSG_ERROR) {
+	    // The kernel aborted the dump: the table is incomplete
+	    const struct nlmsgerr* err;
+
+	    err = reinterpret_cast<const struct nlmsgerr*>(NLMSG_DATA(nlh));
+	    if ((nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*err)))
+		|| (err->error != 0)) {
+		_is_dump_error = true;
+	    }
+	    _is_dump_done = true;
+	}
+    }
+    if (! is_reply)
+	return;
+
+    if (parse_buffer_netlink_socket(_dump_family,
+				    fibconfig().system_config_iftree(),
+				    *_dump_sink, buffer, true, fibconfig())
 	!= XORP_OK) {
-	return (XORP_ERROR);
+	_is_dump_error = true;
     }
-    return (XORP_OK);
 }
 
 #endif // HAVE_NETLINK_SOCKETS
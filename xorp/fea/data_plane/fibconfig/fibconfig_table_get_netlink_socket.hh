@@ -29,8 +29,24 @@
 
 
 class FibConfigTableGetNetlinkSocket : public FibConfigTableGet,
-				       public NetlinkSocket {
+				       public NetlinkSocket,
+				       public NetlinkSocketObserver {
 public:
+    /**
+     * A receiver of the entries parsed from netlink(7) data.
+     */
+    class FteSink {
+    public:
+	virtual ~FteSink() {}
+
+	/**
+	 * Receive a parsed entry.
+	 *
+	 * @param fte the entry.
+	 */
+	virtual void add_fte(const FteX& fte) = 0;
+    };
+
     /**
      * Constructor.
      *
@@ -67,7 +83,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table4(list<Fte4>& fte_list);
+    virtual int get_table4(Fte4Batch& fte_list);
 
     /**
      * Obtain the IPv6 unicast forwarding table.
@@ -76,7 +92,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table6(list<Fte6>& fte_list);
+    virtual int get_table6(Fte6Batch& fte_list);
 
     /**
      * Parse information about routing table information received from
@@ -96,7 +112,28 @@ public:
      * @see FteX.
      */
     static int parse_buffer_netlink_socket(int family, const IfTree& iftree,
-					   list<FteX>& fte_list,
+					   FteXBatch& fte_list,
+					   vector<uint8_t>& buffer,
+					   bool is_nlm_get_only, const FibConfig& fibconfig);
+
+    /**
+     * Parse information about routing table information received from
+     * the underlying system.
+     *
+     * Same as above, except that each entry is passed to a sink instead
+     * of being stored in a list.
+     *
+     * @param family the address family to consider only ((e.g., AF_INET
+     * or AF_INET6 for IPv4 and IPv6 respectively).
+     * @param iftree the interface tree to use.
+     * @param fte_sink the sink to pass the entries to.
+     * @param buffer the buffer with the data to parse.
+     * @param is_nlm_get_only if true, consider only the entries obtained
+     * by RTM_GETROUTE.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    static int parse_buffer_netlink_socket(int family, const IfTree& iftree,
+					   FteSink& fte_sink,
 					   vector<uint8_t>& buffer,
 					   bool is_nlm_get_only, const FibConfig& fibconfig);
 
@@ -106,10 +143,26 @@ public:
 	return NetlinkSocket::notify_table_id_change(new_tbl);
     }
 
-private:
-    int get_table(int family, list<FteX>& fte_list);
+    /**
+     * Receive data from the netlink socket.
+     *
+     * Each part of the table dump is parsed as soon as it arrives.
+     *
+     * @param buffer the buffer with the received data.
+     */
+    virtual void netlink_socket_data(vector<uint8_t>& buffer);
 
-    NetlinkSocketReader	_ns_reader;
+private:
+    int get_table(int family, FteSink& fte_sink);
+
+    //
+    // The state of the table dump in progress
+    //
+    int		_dump_family;
+    uint32_t	_dump_seqno;
+    FteSink*	_dump_sink;
+    bool	_is_dump_done;
+    bool	_is_dump_error;	// The dump failed or is incomplete
 };
 
 #endif
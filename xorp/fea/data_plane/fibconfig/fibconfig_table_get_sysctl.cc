@@ -86,16 +86,16 @@ FibConfigTableGetSysctl::stop(string& error_msg)
 }
 
 int
-FibConfigTableGetSysctl::get_table4(list<Fte4>& fte_list)
+FibConfigTableGetSysctl::get_table4(Fte4Batch& fte_list)
 {
-    list<FteX> ftex_list;
+    FteXBatch ftex_list;
     
     // Get the table
     if (get_table(AF_INET, ftex_list) != XORP_OK)
 	return (XORP_ERROR);
     
     // Copy the result back to the original list
-    list<FteX>::iterator iter;
+    FteXBatch::iterator iter;
     for (iter = ftex_list.begin(); iter != ftex_list.end(); ++iter) {
 	FteX& ftex = *iter;
 	fte_list.push_back(ftex.get_fte4());
@@ -105,21 +105,21 @@ FibConfigTableGetSysctl::get_table4(list<Fte4>& fte_list)
 }
 
 int
-FibConfigTableGetSysctl::get_table6(list<Fte6>& fte_list)
+FibConfigTableGetSysctl::get_table6(Fte6Batch& fte_list)
 {
 #ifndef HAVE_IPV6
     UNUSED(fte_list);
     
     return (XORP_ERROR);
 #else
-    list<FteX> ftex_list;
+    FteXBatch ftex_list;
     
     // Get the table
     if (get_table(AF_INET6, ftex_list) != XORP_OK)
 	return (XORP_ERROR);
     
     // Copy the result back to the original list
-    list<FteX>::iterator iter;
+    FteXBatch::iterator iter;
     for (iter = ftex_list.begin(); iter != ftex_list.end(); ++iter) {
 	FteX& ftex = *iter;
 	fte_list.push_back(ftex.get_fte6());
@@ -130,7 +130,7 @@ FibConfigTableGetSysctl::get_table6(list<Fte6>& fte_list)
 }
 
 int
-FibConfigTableGetSysctl::get_table(int family, list<FteX>& fte_list)
+FibConfigTableGetSysctl::get_table(int family, FteXBatch& fte_list)
 {
     int mib[6];
 
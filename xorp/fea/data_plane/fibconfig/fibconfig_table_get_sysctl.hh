@@ -63,7 +63,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table4(list<Fte4>& fte_list);
+    virtual int get_table4(Fte4Batch& fte_list);
 
     /**
      * Obtain the IPv6 unicast forwarding table.
@@ -72,7 +72,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table6(list<Fte6>& fte_list);
+    virtual int get_table6(Fte6Batch& fte_list);
 
     /**
      * Flag values used to tell underlying FIB message parsing routines
@@ -104,7 +104,7 @@ public:
      * @see FteX.
      */
     static int parse_buffer_routing_socket(int family, const IfTree& iftree,
-					   list<FteX>& fte_list,
+					   FteXBatch& fte_list,
 					   const vector<uint8_t>& buffer,
 					   FibMsgSet filter);
 
@@ -117,7 +117,7 @@ public:
     }
 
 private:
-    int get_table(int family, list<FteX>& fte_list);
+    int get_table(int family, FteXBatch& fte_list);
 };
 
 #endif // __FEA_DATA_PLANE_FIBCONFIG_FIBCONFIG_TABLE_GET_SYSCTL_HH__
@@ -114,6 +114,9 @@ FibConfigTableObserverNetlinkSocket::stop(string& error_msg)
     if (NetlinkSocket::stop(error_msg) != XORP_OK)
 	return (XORP_ERROR);
 
+    _propagate_timer.unschedule();
+    _fte_list.clear();
+
     _is_running = false;
 
     return (XORP_OK);
@@ -122,8 +125,6 @@ FibConfigTableObserverNetlinkSocket::stop(string& error_msg)
 void
 FibConfigTableObserverNetlinkSocket::receive_data(vector<uint8_t>& buffer)
 {
-    list<FteX> fte_list;
-
     //
     // Get the IPv4 routes
     //
@@ -131,13 +132,9 @@ FibConfigTableObserverNetlinkSocket::receive_data(vector<uint8_t>& buffer)
 	FibConfigTableGetNetlinkSocket::parse_buffer_netlink_socket(
 	    AF_INET,
 	    fibconfig().system_config_iftree(),
-	    fte_list,
+	    _fte_list,
 	    buffer,
 	    false, fibconfig());
-	if (! fte_list.empty()) {
-	    fibconfig().propagate_fib_changes(fte_list, this);
-	    fte_list.clear();
-	}
     }
 
 #ifdef HAVE_IPV6
@@ -148,15 +145,28 @@ FibConfigTableObserverNetlinkSocket::receive_data(vector<uint8_t>& buffer)
 	FibConfigTableGetNetlinkSocket::parse_buffer_netlink_socket(
 	    AF_INET6,
 	    fibconfig().system_config_iftree(),
-	    fte_list,
+	    _fte_list,
 	    buffer,
 	    false, fibconfig());
-	if (! fte_list.empty()) {
-	    fibconfig().propagate_fib_changes(fte_list, this);
-	    fte_list.clear();
-	}
     }
 #endif // HAVE_IPV6
+
+    if (_fte_list.empty() || _propagate_timer.scheduled())
+	return;
+
+    _propagate_timer = fea_data_plane_manager().eventloop().new_oneoff_after(
+	TimeVal::ZERO(),
+	callback(this, &FibConfigTableObserverNetlinkSocket::propagate_fib_changes));
+}
+
+void
+FibConfigTableObserverNetlinkSocket::propagate_fib_changes()
+{
+    FteXBatch fte_list;
+
+    // XXX: the observers may cause more changes to be queued
+    fte_list.swap(_fte_list);
+    fibconfig().propagate_fib_changes(fte_list, this);
 }
 
 void
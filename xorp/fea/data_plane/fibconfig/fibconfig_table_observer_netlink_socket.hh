@@ -25,6 +25,8 @@
 #ifdef HAVE_NETLINK_SOCKETS
 
 
+#include "libxorp/timer.hh"
+
 #include "fea/fibconfig_table_observer.hh"
 #include "fea/data_plane/control_socket/netlink_socket.hh"
 
@@ -64,6 +66,9 @@ public:
     
     /**
      * Receive data from the underlying system.
+     *
+     * The changes are queued, and all changes received within the same
+     * event loop iteration are propagated together.
      * 
      * @param buffer the buffer with the received data.
      */
@@ -79,6 +84,13 @@ public:
     }
     
 private:
+    /**
+     * Propagate the queued changes to the FIB table observers.
+     */
+    void propagate_fib_changes();
+
+    FteXBatch	_fte_list;		// The queued changes
+    XorpTimer	_propagate_timer;	// Timer to propagate the changes
 };
 
 #endif
@@ -93,7 +93,7 @@ FibConfigTableObserverRoutingSocket::stop(string& error_msg)
 void
 FibConfigTableObserverRoutingSocket::receive_data(vector<uint8_t>& buffer)
 {
-    list<FteX> fte_list;
+    FteXBatch fte_list;
     FibConfigTableGetSysctl::FibMsgSet filter;
     filter = FibConfigTableGetSysctl::FibMsg::UPDATES | FibConfigTableGetSysctl::FibMsg::GETS | FibConfigTableGetSysctl::FibMsg::RESOLVES;
 
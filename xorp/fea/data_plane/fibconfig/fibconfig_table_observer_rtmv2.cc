@@ -134,7 +134,7 @@ FibConfigTableObserverRtmV2::stop(string& error_msg)
 void
 FibConfigTableObserverRtmV2::receive_data(vector<uint8_t>& buffer)
 {
-    list<FteX> fte_list;
+    FteXBatch fte_list;
     FibConfigTableGetSysctl::FibMsgSet filter;
     filter = FibConfigTableGetSysctl::FibMsg::UPDATES | FibConfigTableGetSysctl::FibMsg::GETS;
 
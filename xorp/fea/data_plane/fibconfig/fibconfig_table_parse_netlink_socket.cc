@@ -49,11 +49,38 @@
 // Reading netlink(3) manual page is a good start for understanding this
 //
 
+/**
+ * Sink which stores the entries in a list.
+ */
+class FteListSink : public FibConfigTableGetNetlinkSocket::FteSink {
+public:
+    FteListSink(FteXBatch& fte_list) : _fte_list(fte_list) {}
+
+    void add_fte(const FteX& fte) { _fte_list.push_back(fte); }
+
+private:
+    FteXBatch&	_fte_list;
+};
+
+int
+FibConfigTableGetNetlinkSocket::parse_buffer_netlink_socket(
+    int family,
+    const IfTree& iftree,
+    FteXBatch& fte_list,
+    vector<uint8_t>& buffer,
+    bool is_nlm_get_only, const FibConfig& fibconfig)
+{
+    FteListSink fte_sink(fte_list);
+
+    return (parse_buffer_netlink_socket(family, iftree, fte_sink, buffer,
+					is_nlm_get_only, fibconfig));
+}
+
 int
 FibConfigTableGetNetlinkSocket::parse_buffer_netlink_socket(
     int family,
     const IfTree& iftree,
-    list<FteX>& fte_list,
+    FteSink& fte_sink,
     vector<uint8_t>& buffer,
     bool is_nlm_get_only, const FibConfig& fibconfig)
 {
@@ -128,7 +155,7 @@ FibConfigTableGetNetlinkSocket::parse_buffer_netlink_socket(
 	    string err_msg;
 	    if (NlmUtils::nlm_get_to_fte_cfg(iftree, fte, nlh, rtmsg, rta_len, fibconfig, err_msg)
 		== XORP_OK) {
-		fte_list.push_back(fte);
+		fte_sink.add_fte(fte);
 	    }
 	    else {
 		//XLOG_INFO("nlm_get_to_fte_cfg had error: %s", err_msg.c_str());
@@ -59,7 +59,7 @@
 int
 FibConfigTableGetSysctl::parse_buffer_routing_socket(int family,
 						     const IfTree& iftree,
-						     list<FteX>& fte_list,
+						     FteXBatch& fte_list,
 						     const vector<uint8_t>& buffer,
 						     FibMsgSet filter)
 {
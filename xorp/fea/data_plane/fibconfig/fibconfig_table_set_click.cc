@@ -82,7 +82,7 @@ FibConfigTableSetClick::start(string& error_msg)
     //
     // XXX: Push the current config into the new method
     //
-    list<Fte4> fte_list4;
+    Fte4Batch fte_list4;
     if (fibconfig().get_table4(fte_list4) == XORP_OK) {
 	if (set_table4(fte_list4) != XORP_OK) {
 	    XLOG_ERROR("Cannot push the current IPv4 forwarding table "
@@ -92,7 +92,7 @@ FibConfigTableSetClick::start(string& error_msg)
     }
 
 #ifdef HAVE_IPV6
-    list<Fte6> fte_list6;
+    Fte6Batch fte_list6;
     if (fibconfig().get_table6(fte_list6) == XORP_OK) {
 	if (set_table6(fte_list6) != XORP_OK) {
 	    XLOG_ERROR("Cannot push the current IPv6 forwarding table "
@@ -127,9 +127,9 @@ FibConfigTableSetClick::stop(string& error_msg)
 }
 
 int
-FibConfigTableSetClick::set_table4(const list<Fte4>& fte_list)
+FibConfigTableSetClick::set_table4(const Fte4Batch& fte_list)
 {
-    list<Fte4>::const_iterator iter;
+    Fte4Batch::const_iterator iter;
 
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -143,8 +143,8 @@ FibConfigTableSetClick::set_table4(const list<Fte4>& fte_list)
 int
 FibConfigTableSetClick::delete_all_entries4()
 {
-    list<Fte4> fte_list;
-    list<Fte4>::const_iterator iter;
+    Fte4Batch fte_list;
+    Fte4Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table4(fte_list);
@@ -160,9 +160,9 @@ FibConfigTableSetClick::delete_all_entries4()
 }
 
 int
-FibConfigTableSetClick::set_table6(const list<Fte6>& fte_list)
+FibConfigTableSetClick::set_table6(const Fte6Batch& fte_list)
 {
-    list<Fte6>::const_iterator iter;
+    Fte6Batch::const_iterator iter;
     
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -176,8 +176,8 @@ FibConfigTableSetClick::set_table6(const list<Fte6>& fte_list)
 int
 FibConfigTableSetClick::delete_all_entries6()
 {
-    list<Fte6> fte_list;
-    list<Fte6>::const_iterator iter;
+    Fte6Batch fte_list;
+    Fte6Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table6(fte_list);
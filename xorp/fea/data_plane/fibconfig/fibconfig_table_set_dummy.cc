@@ -81,9 +81,9 @@ FibConfigTableSetDummy::stop(string& error_msg)
 }
 
 int
-FibConfigTableSetDummy::set_table4(const list<Fte4>& fte_list)
+FibConfigTableSetDummy::set_table4(const Fte4Batch& fte_list)
 {
-    list<Fte4>::const_iterator iter;
+    Fte4Batch::const_iterator iter;
 
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -106,9 +106,9 @@ FibConfigTableSetDummy::delete_all_entries4()
 }
 
 int
-FibConfigTableSetDummy::set_table6(const list<Fte6>& fte_list)
+FibConfigTableSetDummy::set_table6(const Fte6Batch& fte_list)
 {
-    list<Fte6>::const_iterator iter;
+    Fte6Batch::const_iterator iter;
     
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
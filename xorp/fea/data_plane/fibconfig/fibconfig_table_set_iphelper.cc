@@ -115,9 +115,9 @@ FibConfigTableSetIPHelper::stop(string& error_msg)
 }
 
 int
-FibConfigTableSetIPHelper::set_table4(const list<Fte4>& fte_list)
+FibConfigTableSetIPHelper::set_table4(const Fte4Batch& fte_list)
 {
-    list<Fte4>::const_iterator iter;
+    Fte4Batch::const_iterator iter;
 
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -131,8 +131,8 @@ FibConfigTableSetIPHelper::set_table4(const list<Fte4>& fte_list)
 int
 FibConfigTableSetIPHelper::delete_all_entries4()
 {
-    list<Fte4> fte_list;
-    list<Fte4>::const_iterator iter;
+    Fte4Batch fte_list;
+    Fte4Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table4(fte_list);
@@ -148,9 +148,9 @@ FibConfigTableSetIPHelper::delete_all_entries4()
 }
 
 int
-FibConfigTableSetIPHelper::set_table6(const list<Fte6>& fte_list)
+FibConfigTableSetIPHelper::set_table6(const Fte6Batch& fte_list)
 {
-    list<Fte6>::const_iterator iter;
+    Fte6Batch::const_iterator iter;
     
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -164,8 +164,8 @@ FibConfigTableSetIPHelper::set_table6(const list<Fte6>& fte_list)
 int
 FibConfigTableSetIPHelper::delete_all_entries6()
 {
-    list<Fte6> fte_list;
-    list<Fte6>::const_iterator iter;
+    Fte6Batch fte_list;
+    Fte6Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table6(fte_list);
@@ -105,9 +105,9 @@ FibConfigTableSetRoutingSocket::stop(string& error_msg)
 }
 
 int
-FibConfigTableSetRoutingSocket::set_table4(const list<Fte4>& fte_list)
+FibConfigTableSetRoutingSocket::set_table4(const Fte4Batch& fte_list)
 {
-    list<Fte4>::const_iterator iter;
+    Fte4Batch::const_iterator iter;
 
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -121,8 +121,8 @@ FibConfigTableSetRoutingSocket::set_table4(const list<Fte4>& fte_list)
 int
 FibConfigTableSetRoutingSocket::delete_all_entries4()
 {
-    list<Fte4> fte_list;
-    list<Fte4>::const_iterator iter;
+    Fte4Batch fte_list;
+    Fte4Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table4(fte_list);
@@ -138,9 +138,9 @@ FibConfigTableSetRoutingSocket::delete_all_entries4()
 }
 
 int
-FibConfigTableSetRoutingSocket::set_table6(const list<Fte6>& fte_list)
+FibConfigTableSetRoutingSocket::set_table6(const Fte6Batch& fte_list)
 {
-    list<Fte6>::const_iterator iter;
+    Fte6Batch::const_iterator iter;
     
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -154,8 +154,8 @@ FibConfigTableSetRoutingSocket::set_table6(const list<Fte6>& fte_list)
 int
 FibConfigTableSetRoutingSocket::delete_all_entries6()
 {
-    list<Fte6> fte_list;
-    list<Fte6>::const_iterator iter;
+    Fte6Batch fte_list;
+    Fte6Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table6(fte_list);
@@ -104,9 +104,9 @@ FibConfigTableSetRtmV2::stop(string& error_msg)
 }
 
 int
-FibConfigTableSetRtmV2::set_table4(const list<Fte4>& fte_list)
+FibConfigTableSetRtmV2::set_table4(const Fte4Batch& fte_list)
 {
-    list<Fte4>::const_iterator iter;
+    Fte4Batch::const_iterator iter;
 
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -120,8 +120,8 @@ FibConfigTableSetRtmV2::set_table4(const list<Fte4>& fte_list)
 int
 FibConfigTableSetRtmV2::delete_all_entries4()
 {
-    list<Fte4> fte_list;
-    list<Fte4>::const_iterator iter;
+    Fte4Batch fte_list;
+    Fte4Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table4(fte_list);
@@ -137,9 +137,9 @@ FibConfigTableSetRtmV2::delete_all_entries4()
 }
 
 int
-FibConfigTableSetRtmV2::set_table6(const list<Fte6>& fte_list)
+FibConfigTableSetRtmV2::set_table6(const Fte6Batch& fte_list)
 {
-    list<Fte6>::const_iterator iter;
+    Fte6Batch::const_iterator iter;
     
     // Add the entries one-by-one
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
@@ -153,8 +153,8 @@ FibConfigTableSetRtmV2::set_table6(const list<Fte6>& fte_list)
 int
 FibConfigTableSetRtmV2::delete_all_entries6()
 {
-    list<Fte6> fte_list;
-    list<Fte6>::const_iterator iter;
+    Fte6Batch fte_list;
+    Fte6Batch::const_iterator iter;
     
     // Get the list of all entries
     fibconfig().get_table6(fte_list);
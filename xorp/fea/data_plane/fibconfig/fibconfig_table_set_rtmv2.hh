@@ -63,7 +63,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int set_table4(const list<Fte4>& fte_list);
+    virtual int set_table4(const Fte4Batch& fte_list);
 
     /**
      * Delete all entries in the IPv4 unicast forwarding table.
@@ -81,7 +81,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int set_table6(const list<Fte6>& fte_list);
+    virtual int set_table6(const Fte6Batch& fte_list);
 
     /**
      * Delete all entries in the IPv6 unicast forwarding table.
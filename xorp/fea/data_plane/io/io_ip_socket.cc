@@ -103,6 +103,8 @@
 //
 #define IO_BUF_SIZE		(64*1024)  // I/O buffer(s) size
 #define CMSG_BUF_SIZE		(10*1024)  // 'rcvcmsgbuf' and 'sndcmsgbuf'
+#define IO_RCV_BATCH_SIZE	8	   // Max. packets per recvmmsg()
+#define IO_SND_BATCH_SIZE	64	   // Max. packets per sendmmsg()
 #define SO_RCV_BUF_SIZE_MIN	(48*1024)  // Min. rcv socket buffer size
 #define SO_RCV_BUF_SIZE_MAX	(256*1024) // Desired rcv socket buffer size
 #define SO_SND_BUF_SIZE_MIN	(48*1024)  // Min. snd socket buffer size
@@ -240,6 +242,14 @@ IoIpSocket::IoIpSocket(FeaDataPlaneManager& fea_data_plane_manager,
     : IoIp(fea_data_plane_manager, ift, family, ip_protocol),
       _is_ip_hdr_included(false),
       _ip_id(xorp_random())
+#ifdef HAVE_RECVMMSG
+      , _is_recvmmsg_supported(true)
+#endif
+#ifdef HAVE_SENDMMSG
+      , _is_sendmmsg_supported(true),
+      _sndmmsg_n(0),
+      _sndm_is_multicast(false)
+#endif
 {
     // Init Router Alert related option stuff
     ra_opt4 = htonl((IPOPT_RA << 24) | (0x04 << 16));
@@ -1195,6 +1205,9 @@ IoIpSocket::close_proto_sockets(string& error_msg)
     // Close the outgoing protocol socket
     //
     if (_proto_socket_out.is_valid()) {
+	// Send the queued packets
+	proto_socket_transmit_flush();
+
 	// It probably wasn't added...but just in case code changes,
 	// keep the cleanup logic here.
 	eventloop().remove_ioevent_cb(_proto_socket_out);
@@ -1530,24 +1543,16 @@ void
 IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
 {
     ssize_t	nbytes;
-    size_t	ip_hdr_len = 0;
-    size_t	ip_data_len = 0;
-    IPvX	src_address(family());
-    IPvX	dst_address(family());
-    int		int_val;
-    int32_t	ip_ttl = -1;		// a.k.a. Hop-Limit in IPv6
-    int32_t	ip_tos = -1;
-    bool	ip_router_alert = false;	// Router Alert option received
-    bool	ip_internet_control = false;	// IP Internet Control pkt rcvd
-    uint32_t	pif_index = 0;
-    vector<uint8_t> ext_headers_type;
-    vector<vector<uint8_t> > ext_headers_payload;
-    void*	cmsg_data;	// XXX: CMSG_DATA() is aligned, hence void ptr
 
     UNUSED(fd);
     UNUSED(type);
-    UNUSED(int_val);
-    UNUSED(cmsg_data);
+
+#ifdef HAVE_RECVMMSG
+    if (_is_recvmmsg_supported) {
+	proto_socket_read_batch(fd);
+	return;
+    }
+#endif
 
 #ifndef HOST_OS_WINDOWS
     // Zero and reset various fields
@@ -1642,6 +1647,112 @@ IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
     }
 #endif // HOST_OS_WINDOWS
 
+    proto_socket_process(_rcvbuf, nbytes);
+}
+
+#ifdef HAVE_RECVMMSG
+void
+IoIpSocket::proto_socket_read_batch(XorpFd fd)
+{
+    struct msghdr rcvmh = _rcvmh;
+    int n;
+
+    //
+    // Allocate the receive buffers the first time they are needed:
+    // most protocols never receive a burst.
+    //
+    if (_rcvmmsg.empty()) {
+	_rcvmbufs.resize(IO_RCV_BATCH_SIZE * IO_BUF_SIZE);
+	_rcvmcmsgbufs.resize(IO_RCV_BATCH_SIZE * CMSG_BUF_SIZE);
+	_rcvmfrom.resize(IO_RCV_BATCH_SIZE);
+	_rcvmiov.resize(IO_RCV_BATCH_SIZE);
+	_rcvmmsg.resize(IO_RCV_BATCH_SIZE);
+	for (size_t i = 0; i < IO_RCV_BATCH_SIZE; i++) {
+	    _rcvmiov[i].iov_base = (caddr_t)&_rcvmbufs[i * IO_BUF_SIZE];
+	    _rcvmiov[i].iov_len = IO_BUF_SIZE;
+	    memset(&_rcvmmsg[i], 0, sizeof(_rcvmmsg[i]));
+	    _rcvmmsg[i].msg_hdr.msg_iov = &_rcvmiov[i];
+	    _rcvmmsg[i].msg_hdr.msg_iovlen = 1;
+	}
+    }
+
+    // Zero and reset various fields
+    for (size_t i = 0; i < IO_RCV_BATCH_SIZE; i++) {
+	struct msghdr& mh = _rcvmmsg[i].msg_hdr;
+
+	memset(&_rcvmfrom[i], 0, sizeof(_rcvmfrom[i]));
+	mh.msg_name = (caddr_t)&_rcvmfrom[i];
+	mh.msg_namelen = sizeof(_rcvmfrom[i]);
+	mh.msg_control = (caddr_t)&_rcvmcmsgbufs[i * CMSG_BUF_SIZE];
+	mh.msg_controllen = CMSG_BUF_SIZE;
+	mh.msg_flags = 0;
+	_rcvmmsg[i].msg_len = 0;
+    }
+
+    // Read all packets which are already queued on the socket
+    n = recvmmsg(fd, &_rcvmmsg[0], IO_RCV_BATCH_SIZE, MSG_DONTWAIT, NULL);
+    if (n < 0) {
+	if ((errno == EINTR) || (errno == EAGAIN) || (errno == EWOULDBLOCK))
+	    return;		// OK: restart receiving
+	if (errno == ENOSYS) {
+	    // The kernel is too old: fall back to one packet per call
+	    _is_recvmmsg_supported = false;
+	    proto_socket_read(fd, IOT_READ);
+	    return;
+	}
+	XLOG_ERROR("recvmmsg() on socket %s failed: %s",
+		   fd.str().c_str(), XSTRERROR);
+	return;			// Error
+    }
+
+    //
+    // Process the packets one after the other.  Each of them is presented
+    // to proto_socket_process() as if it was received by recvmsg().
+    //
+    for (int i = 0; i < n; i++) {
+	struct msghdr& mh = _rcvmmsg[i].msg_hdr;
+
+	switch (family()) {
+	case AF_INET:
+	    memcpy(&_from4, &_rcvmfrom[i], sizeof(_from4));
+	    break;
+#ifdef HAVE_IPV6
+	case AF_INET6:
+	    memcpy(&_from6, &_rcvmfrom[i], sizeof(_from6));
+	    break;
+#endif // HAVE_IPV6
+	default:
+	    XLOG_UNREACHABLE();
+	    break;
+	}
+	_rcvmh = mh;
+	proto_socket_process(reinterpret_cast<uint8_t*>(mh.msg_iov[0].iov_base),
+			     _rcvmmsg[i].msg_len);
+    }
+    _rcvmh = rcvmh;
+}
+#endif // HAVE_RECVMMSG
+
+void
+IoIpSocket::proto_socket_process(uint8_t* rcvbuf, ssize_t nbytes)
+{
+    size_t	ip_hdr_len = 0;
+    size_t	ip_data_len = 0;
+    IPvX	src_address(family());
+    IPvX	dst_address(family());
+    int		int_val;
+    int32_t	ip_ttl = -1;		// a.k.a. Hop-Limit in IPv6
+    int32_t	ip_tos = -1;
+    bool	ip_router_alert = false;	// Router Alert option received
+    bool	ip_internet_control = false;	// IP Internet Control pkt rcvd
+    uint32_t	pif_index = 0;
+    vector<uint8_t> ext_headers_type;
+    vector<vector<uint8_t> > ext_headers_payload;
+    void*	cmsg_data;	// XXX: CMSG_DATA() is aligned, hence void ptr
+
+    UNUSED(int_val);
+    UNUSED(cmsg_data);
+
     //
     // Check whether this is a multicast forwarding related upcall from the
     // system to the user-level.
@@ -1662,14 +1773,14 @@ IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
 	}
 	struct igmpmsg* igmpmsg;
 	// XXX: "void" casting to fix alignment warning that can be ignored
-	igmpmsg = reinterpret_cast<struct igmpmsg *>((void *)_rcvbuf);
+	igmpmsg = reinterpret_cast<struct igmpmsg *>((void *)rcvbuf);
 	if (igmpmsg->im_mbz == 0) {
 	    //
 	    // XXX: Packets sent up from system to daemon have
 	    //      igmpmsg->im_mbz = ip->ip_p = 0
 	    //
 	    vector<uint8_t> payload(nbytes);
-	    memcpy(&payload[0], _rcvbuf, nbytes);
+	    memcpy(&payload[0], rcvbuf, nbytes);
 	    recv_system_multicast_upcall(payload);
 	    return;		// OK
 	}
@@ -1690,7 +1801,7 @@ IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
 	}
 	struct mrt6msg* mrt6msg;
 	// XXX: "void" casting to fix alignment warning that can be ignored
-	mrt6msg = reinterpret_cast<struct mrt6msg *>((void *)_rcvbuf);
+	mrt6msg = reinterpret_cast<struct mrt6msg *>((void *)rcvbuf);
 	if ((mrt6msg->im6_mbz == 0) || (_rcvmh.msg_controllen == 0)) {
 	    //
 	    // XXX: Packets sent up from system to daemon have
@@ -1706,7 +1817,7 @@ IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
 	    //     'icmp6_type = 0' mechanism.
 	    //
 	    vector<uint8_t> payload(nbytes);
-	    memcpy(&payload[0], _rcvbuf, nbytes);
+	    memcpy(&payload[0], rcvbuf, nbytes);
 	    recv_system_multicast_upcall(payload);
 	    return;		// OK
 	}
@@ -1732,7 +1843,7 @@ IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
     switch (family()) {
     case AF_INET:
     {
-	IpHeader4 ip4(_rcvbuf);
+	IpHeader4 ip4(rcvbuf);
 	bool is_datalen_error = false;
 
 	// Input check
@@ -2156,7 +2267,7 @@ IoIpSocket::proto_socket_read(XorpFd fd, IoEventType type)
 
     // Process the result
     vector<uint8_t> payload(nbytes - ip_hdr_len);
-    memcpy(&payload[0], _rcvbuf + ip_hdr_len, nbytes - ip_hdr_len);
+    memcpy(&payload[0], rcvbuf + ip_hdr_len, nbytes - ip_hdr_len);
     recv_packet(ifp->ifname(),
 		vifp->vifname(),
 		src_address, dst_address,
@@ -2361,6 +2472,8 @@ IoIpSocket::send_packet(const string& if_name,
 	} while (false);
 
 	if (do_ip_hdr_include != _is_ip_hdr_included) {
+	    // The queued packets were prepared with the old setting
+	    proto_socket_transmit_flush();
 	    if (enable_ip_hdr_include(do_ip_hdr_include, error_msg)
 		!= XORP_OK) {
 		XLOG_ERROR("%s", error_msg.c_str());
@@ -2862,8 +2975,24 @@ IoIpSocket::proto_socket_transmit(const IfTreeInterface* ifp,
     // table ID is configured.
     //
     FibConfig& fibconfig = fea_data_plane_manager().fibconfig();
-    if (fibconfig.unicast_forwarding_table_id_is_configured(family())
-	&& (! vifp->vifname().empty())) {
+    bool need_bind = (fibconfig.unicast_forwarding_table_id_is_configured(family())
+		      && (! vifp->vifname().empty()));
+
+#ifdef HAVE_SENDMMSG
+    //
+    // Queue the packet, so all packets sent within the same event loop
+    // iteration go out with a single system call.  Packets which need
+    // socket settings of their own (non-raw IPv4 packets and packets
+    // bound to an interface) are sent right away, after the queued ones.
+    //
+    if (_is_sendmmsg_supported && (! need_bind)
+	&& ((family() != AF_INET) || _is_ip_hdr_included)) {
+	return (proto_socket_transmit_enqueue(ifp, vifp, dst_address));
+    }
+    proto_socket_transmit_flush();
+#endif // HAVE_SENDMMSG
+
+    if (need_bind) {
 	ret_value = comm_set_bindtodevice_quiet(_proto_socket_out,
 						vifp->vifname().c_str());
 	if (ret_value == XORP_ERROR)
@@ -3016,4 +3145,216 @@ IoIpSocket::proto_socket_transmit(const IfTreeInterface* ifp,
     return (ret_value);
 }
 
+#ifdef HAVE_SENDMMSG
+int
+IoIpSocket::proto_socket_transmit_enqueue(const IfTreeInterface* ifp,
+					  const IfTreeVif* vifp,
+					  const IPvX& dst_address)
+{
+    bool is_multicast = dst_address.is_multicast();
+    string ifname, vifname;
+
+    if (is_multicast) {
+	//
+	// The outgoing interface of a multicast packet is chosen with
+	// set_default_multicast_interface(), unless the pktinfo ancillary
+	// data carries the interface index.  In the latter case packets
+	// for different interfaces can be sent together.
+	//
+	bool has_ifindex = false;
+
+	switch (family()) {
+	case AF_INET:
+#ifdef IP_PKTINFO
+	    if ((vifp->pif_index() != 0)
+		&& (_sndmh.msg_controllen
+		    >= CMSG_SPACE(sizeof(struct in_pktinfo)))) {
+		struct cmsghdr *cmsgp = CMSG_FIRSTHDR(&_sndmh);
+		if ((cmsgp != NULL)
+		    && (cmsgp->cmsg_level == SOL_IP)
+		    && (cmsgp->cmsg_type == IP_PKTINFO)) {
+		    struct in_pktinfo *sndpktinfo;
+		    sndpktinfo = reinterpret_cast<struct in_pktinfo *>(CMSG_DATA(cmsgp));
+		    sndpktinfo->ipi_ifindex = vifp->pif_index();
+		    has_ifindex = true;
+		}
+	    }
+#endif // IP_PKTINFO
+	    break;
+#ifdef HAVE_IPV6
+	case AF_INET6:
+	    // XXX: the IPV6_PKTINFO of a multicast packet carries the index
+	    has_ifindex = (vifp->pif_index() != 0);
+	    break;
+#endif // HAVE_IPV6
+	default:
+	    XLOG_UNREACHABLE();
+	    break;
+	}
+	if (! has_ifindex) {
+	    ifname = ifp->ifname();
+	    vifname = vifp->vifname();
+	}
+    }
+
+    if ((_sndmmsg_n > 0)
+	&& ((is_multicast != _sndm_is_multicast)
+	    || (ifname != _sndm_ifname)
+	    || (vifname != _sndm_vifname))) {
+	proto_socket_transmit_flush();
+    }
+
+    if (_sndmmsg.empty()) {
+	_sndmbufs.resize(IO_SND_BATCH_SIZE);
+	_sndmcmsgbufs.resize(IO_SND_BATCH_SIZE);
+	_sndmto.resize(IO_SND_BATCH_SIZE);
+	_sndmiov.resize(IO_SND_BATCH_SIZE);
+	_sndmmsg.resize(IO_SND_BATCH_SIZE);
+    }
+
+    _sndm_is_multicast = is_multicast;
+    _sndm_ifname = ifname;
+    _sndm_vifname = vifname;
+
+    //
+    // Copy the packet, its ancillary data and its destination
+    //
+    size_t i = _sndmmsg_n;
+    vector<uint8_t>& buf = _sndmbufs[i];
+    vector<uint8_t>& cmsgbuf = _sndmcmsgbufs[i];
+    struct msghdr& mh = _sndmmsg[i].msg_hdr;
+
+    buf.assign(_sndbuf, _sndbuf + _sndiov[0].iov_len);
+    cmsgbuf.assign(_sndcmsgbuf, _sndcmsgbuf + _sndmh.msg_controllen);
+    memset(&_sndmto[i], 0, sizeof(_sndmto[i]));
+    memset(&_sndmmsg[i], 0, sizeof(_sndmmsg[i]));
+
+    switch (family()) {
+    case AF_INET:
+    {
+	struct sockaddr_in& to4 = reinterpret_cast<struct sockaddr_in&>(_sndmto[i]);
+	dst_address.copy_out(to4);
+	mh.msg_namelen = sizeof(to4);
+	break;
+    }
+#ifdef HAVE_IPV6
+    case AF_INET6:
+    {
+	struct sockaddr_in6& to6 = reinterpret_cast<struct sockaddr_in6&>(_sndmto[i]);
+	dst_address.copy_out(to6);
+	system_adjust_sockaddr_in6_send(to6, vifp->pif_index());
+	mh.msg_namelen = sizeof(to6);
+	break;
+    }
+#endif // HAVE_IPV6
+    default:
+	XLOG_UNREACHABLE();
+	break;
+    }
+
+    _sndmiov[i].iov_base = buf.empty() ? NULL : (caddr_t)&buf[0];
+    _sndmiov[i].iov_len = buf.size();
+    mh.msg_name = (caddr_t)&_sndmto[i];
+    mh.msg_iov = &_sndmiov[i];
+    mh.msg_iovlen = 1;
+    mh.msg_control = cmsgbuf.empty() ? NULL : (caddr_t)&cmsgbuf[0];
+    mh.msg_controllen = cmsgbuf.size();
+    _sndmmsg_n++;
+
+    if (_sndmmsg_n >= IO_SND_BATCH_SIZE) {
+	proto_socket_transmit_flush();
+    } else if (! _sndmmsg_timer.scheduled()) {
+	_sndmmsg_timer = eventloop().new_oneoff_after(
+	    TimeVal::ZERO(),
+	    callback(this, &IoIpSocket::proto_socket_transmit_flush));
+    }
+
+    return (XORP_OK);
+}
+#endif // HAVE_SENDMMSG
+
+void
+IoIpSocket::proto_socket_transmit_flush()
+{
+#ifdef HAVE_SENDMMSG
+    string error_msg;
+    bool setloop = false;
+    size_t sent = 0;
+
+    _sndmmsg_timer.unschedule();
+    if (_sndmmsg_n == 0)
+	return;
+
+    //
+    // Multicast-related setting
+    //
+    if (! _sndm_ifname.empty()) {
+	if (set_default_multicast_interface(_sndm_ifname, _sndm_vifname,
+					    error_msg)
+	    != XORP_OK) {
+	    XLOG_ERROR("Cannot send %u queued packets: %s",
+		       XORP_UINT_CAST(_sndmmsg_n), error_msg.c_str());
+	    _sndmmsg_n = 0;
+	    return;
+	}
+    }
+    if (_sndm_is_multicast) {
+	//
+	// XXX: we need to enable the multicast loopback so other processes
+	// on the same host can receive the multicast packets.
+	//
+	if (enable_multicast_loopback(true, error_msg) != XORP_OK) {
+	    XLOG_ERROR("Cannot send %u queued packets: %s",
+		       XORP_UINT_CAST(_sndmmsg_n), error_msg.c_str());
+	    _sndmmsg_n = 0;
+	    return;
+	}
+	setloop = true;
+    }
+
+    //
+    // Transmit the packets.  The packet on which sending fails is
+    // dropped, and the rest are sent.
+    //
+    while (sent < _sndmmsg_n) {
+	int n;
+
+	if (_is_sendmmsg_supported) {
+	    n = sendmmsg(_proto_socket_out, &_sndmmsg[sent], _sndmmsg_n - sent,
+			 0);
+	} else {
+	    n = sendmsg(_proto_socket_out, &_sndmmsg[sent].msg_hdr, 0);
+	    if (n >= 0)
+		n = 1;
+	}
+	if (n > 0) {
+	    sent += n;
+	    continue;
+	}
+	if (n < 0) {
+	    if (errno == EINTR)
+		continue;
+	    if ((errno == ENOSYS) && _is_sendmmsg_supported) {
+		// The kernel is too old: fall back to one packet per call
+		_is_sendmmsg_supported = false;
+		continue;
+	    }
+	}
+	XLOG_ERROR("sendmmsg(proto %d size %u) on socket %i failed: %s",
+		   ip_protocol(), XORP_UINT_CAST(_sndmiov[sent].iov_len),
+		   (int)(_proto_socket_out), XSTRERROR);
+	sent++;
+    }
+    _sndmmsg_n = 0;
+
+    //
+    // Restore some settings
+    //
+    if (setloop) {
+	// Disable multicast loopback
+	enable_multicast_loopback(false, error_msg);
+    }
+#endif // HAVE_SENDMMSG
+}
+
 #endif // HAVE_IP_RAW_SOCKETS
@@ -311,6 +311,27 @@ private:
      */
     void	proto_socket_read(XorpFd fd, IoEventType type);
 
+#ifdef HAVE_RECVMMSG
+    /**
+     * Read all pending packets from a protocol socket with a single
+     * recvmmsg() call, and process each of them.
+     *
+     * @param fd the file descriptor to read from.
+     */
+    void	proto_socket_read_batch(XorpFd fd);
+#endif
+
+    /**
+     * Process a packet that has been received on a protocol socket.
+     *
+     * The source address and control data of the packet are in
+     * _from4/_from6 and _rcvmh.
+     *
+     * @param rcvbuf the packet data.
+     * @param nbytes the packet length.
+     */
+    void	proto_socket_process(uint8_t* rcvbuf, ssize_t nbytes);
+
     /**
      * Transmit a packet on a protocol socket.
      *
@@ -327,6 +348,26 @@ private:
 				      const IPvX&	dst_address,
 				      string&		error_msg);
 
+#ifdef HAVE_SENDMMSG
+    /**
+     * Queue the packet prepared by proto_socket_transmit() so it is sent
+     * with other packets by a single sendmmsg() call.
+     *
+     * @param ifp the interface to send the packet on.
+     * @param vifp the vif to send the packet on.
+     * @param dst_address the IP destination address.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		proto_socket_transmit_enqueue(const IfTreeInterface* ifp,
+					      const IfTreeVif* vifp,
+					      const IPvX& dst_address);
+#endif
+
+    /**
+     * Send all queued packets.
+     */
+    void	proto_socket_transmit_flush();
+
     // Private state
     // The key is "if_name vif_name"
     map<string, XorpFd*> _proto_sockets_in;
@@ -354,6 +395,33 @@ private:
     struct sockaddr_in6	_from6;	// The source addr of recvmsg() msg (IPv6)
     struct sockaddr_in6	_to6;	// The dest.  addr of sendmsg() msg (IPv6)
 #endif
+
+#ifdef HAVE_RECVMMSG
+    bool			_is_recvmmsg_supported;
+    vector<uint8_t>		_rcvmbufs;	// Data buffers for recvmmsg()
+    vector<uint8_t>		_rcvmcmsgbufs;	// Control buffers for recvmmsg()
+    vector<struct sockaddr_storage> _rcvmfrom;	// Source addresses
+    vector<struct iovec>	_rcvmiov;
+    vector<struct mmsghdr>	_rcvmmsg;
+#endif
+
+#ifdef HAVE_SENDMMSG
+    //
+    // Packets queued for sendmmsg().  All queued packets share the
+    // same outgoing interface settings, kept in _sndm_*.
+    //
+    bool			_is_sendmmsg_supported;
+    size_t			_sndmmsg_n;	// Number of queued packets
+    vector<vector<uint8_t> >	_sndmbufs;	// Queued packet data
+    vector<vector<uint8_t> >	_sndmcmsgbufs;	// Queued control data
+    vector<struct sockaddr_storage> _sndmto;	// Queued dest. addresses
+    vector<struct iovec>	_sndmiov;
+    vector<struct mmsghdr>	_sndmmsg;
+    bool			_sndm_is_multicast;
+    string			_sndm_ifname;
+    string			_sndm_vifname;
+    XorpTimer			_sndmmsg_timer;	// Flushes the queue
+#endif
 };
 
 #endif // __FEA_DATA_PLANE_IO_IO_IP_SOCKET_HH__
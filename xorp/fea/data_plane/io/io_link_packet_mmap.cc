@@ -0,0 +1,532 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+//
+// I/O link raw communication support.
+//
+// The mechanism is a Linux AF_PACKET socket with a TPACKET_V3
+// memory-mapped receive ring.
+//
+
+#include "fea/fea_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/debug.h"
+#include "libxorp/mac.hh"
+
+#if defined(HAVE_TPACKET_V3) && defined(HAVE_PCAP_H)
+
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <net/ethernet.h>
+#include <linux/if_packet.h>
+#include <linux/filter.h>
+
+extern "C" {
+#include <pcap.h>
+}
+
+#include "fea/iftree.hh"
+
+#include "io_link_packet_mmap.hh"
+
+
+IoLinkPacketMmap::IoLinkPacketMmap(FeaDataPlaneManager& fea_data_plane_manager,
+				   const IfTree& iftree, const string& if_name,
+				   const string& vif_name, uint16_t ether_type,
+				   const string& filter_program)
+    : IoLink(fea_data_plane_manager, iftree, if_name, vif_name, ether_type,
+	     filter_program),
+      _ifindex(0),
+      _ring(NULL),
+      _ring_size(0),
+      _ring_block(0),
+      _ring_generation(0)
+{
+}
+
+IoLinkPacketMmap::~IoLinkPacketMmap()
+{
+    string error_msg;
+
+    if (stop(error_msg) != XORP_OK) {
+	XLOG_ERROR("Cannot stop the I/O Link raw packet ring mechanism: %s",
+		   error_msg.c_str());
+    }
+}
+
+int
+IoLinkPacketMmap::start(string& error_msg)
+{
+    if (_is_running)
+	return (XORP_OK);
+
+    if (open_packet_access(error_msg) != XORP_OK)
+	return (XORP_ERROR);
+
+    _is_running = true;
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::stop(string& error_msg)
+{
+    if (! _is_running)
+	return (XORP_OK);
+
+    if (close_packet_access(error_msg) != XORP_OK)
+	return (XORP_ERROR);
+
+    _joined_groups.clear();
+    _is_running = false;
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::join_multicast_group(const Mac& group, string& error_msg)
+{
+    if (join_leave_multicast_group(true, group, error_msg) != XORP_OK)
+	return (XORP_ERROR);
+
+    _joined_groups.insert(group);
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::leave_multicast_group(const Mac& group, string& error_msg)
+{
+    multiset<Mac>::iterator iter = _joined_groups.find(group);
+    if (iter != _joined_groups.end())
+	_joined_groups.erase(iter);
+
+    return (join_leave_multicast_group(false, group, error_msg));
+}
+
+int
+IoLinkPacketMmap::open_packet_access(string& error_msg)
+{
+    string dummy_error_msg;
+
+    if (_packet_fd.is_valid())
+	return (XORP_OK);
+
+    _ifindex = if_nametoindex(vif_name().c_str());
+    if (_ifindex == 0) {
+	error_msg = c_format("Cannot find the index of interface %s vif %s",
+			     if_name().c_str(), vif_name().c_str());
+	return (XORP_ERROR);
+    }
+
+    //
+    // Open the socket.  The protocol is set when the socket is bound, so
+    // that no packet is queued before the filter is in place.
+    //
+    _packet_fd = socket(AF_PACKET, SOCK_RAW, 0);
+    if (! _packet_fd.is_valid()) {
+	error_msg = c_format("Cannot open a packet socket for "
+			     "interface %s vif %s: %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	return (XORP_ERROR);
+    }
+
+    //
+    // Check the data link type
+    //
+    struct ifreq ifreq;
+    memset(&ifreq, 0, sizeof(ifreq));
+    strlcpy(ifreq.ifr_name, vif_name().c_str(), sizeof(ifreq.ifr_name));
+    if (ioctl(_packet_fd, SIOCGIFHWADDR, &ifreq) < 0) {
+	error_msg = c_format("Cannot get the data link type of "
+			     "interface %s vif %s: %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+    switch (ifreq.ifr_hwaddr.sa_family) {
+    case ARPHRD_ETHER:		// Ethernet (10Mb, 100Mb, 1000Mb, and up)
+    case ARPHRD_LOOPBACK:	// XXX: Linux loopback uses Ethernet framing
+	break;
+
+    default:
+	error_msg = c_format("Data link type %u on interface %s vif %s "
+			     "is not supported",
+			     XORP_UINT_CAST(ifreq.ifr_hwaddr.sa_family),
+			     if_name().c_str(), vif_name().c_str());
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+
+    if (attach_filter(error_msg) != XORP_OK) {
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+
+    //
+    // Set up the receive ring
+    //
+    int version = TPACKET_V3;
+    if (setsockopt(_packet_fd, SOL_PACKET, PACKET_VERSION, &version,
+		   sizeof(version)) < 0) {
+	error_msg = c_format("Cannot use TPACKET_V3 on interface %s vif %s: %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = RING_BLOCK_SIZE;
+    req.tp_block_nr = RING_BLOCK_NR;
+    req.tp_frame_size = RING_FRAME_SIZE;
+    req.tp_frame_nr = (RING_BLOCK_SIZE * RING_BLOCK_NR) / RING_FRAME_SIZE;
+    req.tp_retire_blk_tov = RING_BLOCK_TIMEOUT_MS;
+    if (setsockopt(_packet_fd, SOL_PACKET, PACKET_RX_RING, &req,
+		   sizeof(req)) < 0) {
+	error_msg = c_format("Cannot set up the receive ring on "
+			     "interface %s vif %s: %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+
+    _ring_size = RING_BLOCK_SIZE * RING_BLOCK_NR;
+    void* ring = mmap(NULL, _ring_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		      _packet_fd, 0);
+    if (ring == MAP_FAILED) {
+	error_msg = c_format("Cannot map the receive ring of "
+			     "interface %s vif %s: %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+    _ring = static_cast<uint8_t*>(ring);
+    _ring_block = 0;
+    _ring_generation++;
+
+    //
+    // Bind to the vif.  From now on the kernel fills the ring.
+    //
+    struct sockaddr_ll sll;
+    memset(&sll, 0, sizeof(sll));
+    sll.sll_family = AF_PACKET;
+    sll.sll_protocol = htons(ETH_P_ALL);
+    sll.sll_ifindex = _ifindex;
+    if (::bind(_packet_fd, reinterpret_cast<struct sockaddr*>(&sll),
+	       sizeof(sll)) < 0) {
+	error_msg = c_format("Cannot bind the packet socket to "
+			     "interface %s vif %s: %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+
+    //
+    // Join again the groups, if the socket was reopened
+    //
+    multiset<Mac>::const_iterator iter;
+    for (iter = _joined_groups.begin(); iter != _joined_groups.end(); ++iter) {
+	if (join_leave_multicast_group(true, *iter, error_msg) != XORP_OK) {
+	    close_packet_access(dummy_error_msg);
+	    return (XORP_ERROR);
+	}
+    }
+
+    //
+    // Assign a method to read from this descriptor
+    //
+    if (eventloop().add_ioevent_cb(_packet_fd, IOT_READ,
+				   callback(this,
+					    &IoLinkPacketMmap::ioevent_read_cb))
+	== false) {
+	error_msg = c_format("Cannot add a packet socket to the set of "
+			     "sockets to read from in the event loop");
+	close_packet_access(dummy_error_msg);
+	return (XORP_ERROR);
+    }
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::close_packet_access(string& error_msg)
+{
+    error_msg = "";
+
+    if (_ring != NULL) {
+	munmap(_ring, _ring_size);
+	_ring = NULL;
+	_ring_size = 0;
+    }
+
+    if (_packet_fd.is_valid()) {
+	// Remove it just in case, even though it may not be select()-ed
+	eventloop().remove_ioevent_cb(_packet_fd);
+	close(_packet_fd);
+	_packet_fd.clear();
+    }
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::reopen_packet_access(string& error_msg)
+{
+    if (close_packet_access(error_msg) != XORP_OK)
+	return (XORP_ERROR);
+
+    if (open_packet_access(error_msg) != XORP_OK)
+	return (XORP_ERROR);
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::attach_filter(string& error_msg)
+{
+    string expression = filter_expression();
+
+    if (expression.empty())
+	return (XORP_OK);		// XXX: receive everything
+
+    //
+    // XXX: libpcap is used only to compile the expression.  The classic
+    // BPF program it produces is what the kernel socket filter expects.
+    //
+    pcap_t* pcap = pcap_open_dead(DLT_EN10MB, L2_MAX_PACKET_SIZE);
+    if (pcap == NULL) {
+	error_msg = c_format("Cannot allocate a pcap descriptor to compile "
+			     "the filter program");
+	return (XORP_ERROR);
+    }
+
+    vector<char> program_buf(expression.begin(), expression.end());
+    program_buf.push_back('\0');
+    struct bpf_program bpf_program;
+    if (pcap_compile(pcap, &bpf_program, &program_buf[0], 1, 0) < 0) {
+	error_msg = c_format("Cannot compile pcap program '%s': %s",
+			     expression.c_str(), pcap_geterr(pcap));
+	pcap_close(pcap);
+	return (XORP_ERROR);
+    }
+
+    struct sock_fprog sock_fprog;
+    sock_fprog.len = bpf_program.bf_len;
+    sock_fprog.filter = reinterpret_cast<struct sock_filter*>(
+	bpf_program.bf_insns);
+    int ret = setsockopt(_packet_fd, SOL_SOCKET, SO_ATTACH_FILTER,
+			 &sock_fprog, sizeof(sock_fprog));
+    pcap_freecode(&bpf_program);
+    pcap_close(pcap);
+
+    if (ret < 0) {
+	error_msg = c_format("Cannot set the socket filter for "
+			     "interface %s vif %s for program '%s': %s",
+			     if_name().c_str(), vif_name().c_str(),
+			     expression.c_str(), strerror(errno));
+	return (XORP_ERROR);
+    }
+
+    return (XORP_OK);
+}
+
+int
+IoLinkPacketMmap::join_leave_multicast_group(bool is_join, const Mac& group,
+					     string& error_msg)
+{
+    const IfTreeVif* vifp;
+
+    // Find the vif
+    vifp = iftree().find_vif(if_name(), vif_name());
+    if (vifp == NULL) {
+	error_msg = c_format("%s multicast group %s failed: "
+			     "interface %s vif %s not found",
+			     (is_join)? "Joining" : "Leaving",
+			     cstring(group),
+			     if_name().c_str(),
+			     vif_name().c_str());
+	return (XORP_ERROR);
+    }
+
+    if (! _packet_fd.is_valid()) {
+	error_msg = c_format("Cannot %s group %s on interface %s vif %s: "
+			     "the packet socket is not open",
+			     (is_join)? "join" : "leave",
+			     cstring(group),
+			     if_name().c_str(), vif_name().c_str());
+	return (XORP_ERROR);
+    }
+
+    //
+    // XXX: the membership belongs to the socket, and the kernel drops it
+    // when the socket is closed.
+    //
+    struct packet_mreq mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = _ifindex;
+    mreq.mr_type = PACKET_MR_MULTICAST;
+    mreq.mr_alen = Mac::ADDR_BYTELEN;
+    group.copy_out(mreq.mr_address);
+
+    int optname = (is_join)? PACKET_ADD_MEMBERSHIP : PACKET_DROP_MEMBERSHIP;
+    if (setsockopt(_packet_fd, SOL_PACKET, optname, &mreq, sizeof(mreq)) < 0) {
+	error_msg = c_format("Cannot %s group %s on interface %s vif %s: %s",
+			     (is_join)? "join" : "leave",
+			     cstring(group),
+			     if_name().c_str(), vif_name().c_str(),
+			     strerror(errno));
+	return (XORP_ERROR);
+    }
+
+    return (XORP_OK);
+}
+
+void
+IoLinkPacketMmap::ioevent_read_cb(XorpFd fd, IoEventType type)
+{
+    UNUSED(fd);
+    UNUSED(type);
+
+    recv_data();
+}
+
+void
+IoLinkPacketMmap::recv_data()
+{
+    //
+    // A receiver may close or reopen the socket while a frame is
+    // dispatched.  The ring is unmapped then, and the pointers into it
+    // must not be used any more.
+    //
+    const uint8_t* ring = _ring;
+    uint32_t ring_generation = _ring_generation;
+
+    if (ring == NULL)
+	return;
+
+    //
+    // Process the blocks in ring order, at most one pass over the ring.
+    // A block belongs to us once the kernel sets TP_STATUS_USER.
+    //
+    for (size_t n = 0; n < RING_BLOCK_NR; n++) {
+	struct tpacket_block_desc* bd;
+	bd = reinterpret_cast<struct tpacket_block_desc*>(
+	    _ring + _ring_block * RING_BLOCK_SIZE);
+	if ((bd->hdr.bh1.block_status & TP_STATUS_USER) == 0) {
+	    XLOG_TRACE(is_log_trace(), "No packet");
+	    return;			// OK
+	}
+	__sync_synchronize();
+
+	uint32_t num_pkts = bd->hdr.bh1.num_pkts;
+	const uint8_t* ptr = reinterpret_cast<const uint8_t*>(bd)
+	    + bd->hdr.bh1.offset_to_first_pkt;
+
+	for (uint32_t i = 0; i < num_pkts; i++) {
+	    const struct tpacket3_hdr* ppd =
+		reinterpret_cast<const struct tpacket3_hdr*>(ptr);
+
+	    if (ppd->tp_snaplen < ppd->tp_len) {
+		XLOG_WARNING("Received packet on interface %s vif %s: "
+			     "data is too short (captured %u expecting %u "
+			     "octets)",
+			     if_name().c_str(),
+			     vif_name().c_str(),
+			     XORP_UINT_CAST(ppd->tp_snaplen),
+			     XORP_UINT_CAST(ppd->tp_len));
+	    } else {
+		// XXX: the frame is read in place, straight from the ring
+		recv_ethernet_packet(ptr + ppd->tp_mac, ppd->tp_snaplen);
+		if ((_ring != ring) || (_ring_generation != ring_generation))
+		    return;		// XXX: closed or remapped by a receiver
+	    }
+	    ptr += ppd->tp_next_offset;
+	}
+
+	// Return the block to the kernel
+	__sync_synchronize();
+	bd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+	_ring_block = (_ring_block + 1) % RING_BLOCK_NR;
+    }
+}
+
+int
+IoLinkPacketMmap::send_packet(const Mac& src_address,
+			      const Mac& dst_address,
+			      uint16_t ether_type,
+			      const vector<uint8_t>& payload,
+			      string& error_msg)
+{
+    vector<uint8_t> packet;
+
+    //
+    // Prepare the packet for transmission
+    //
+    if (prepare_ethernet_packet(src_address, dst_address, ether_type,
+				payload, packet, error_msg)
+	!= XORP_OK) {
+	return (XORP_ERROR);
+    }
+
+    //
+    // Transmit the packet.  The socket is bound to the vif, so the
+    // frame is sent as it is.
+    //
+    if (send(_packet_fd, &packet[0], packet.size(), 0) < 0) {
+	error_msg = c_format("Sending packet from %s to %s EtherType %u"
+			     "on interface %s vif %s failed: %s",
+			     src_address.str().c_str(),
+			     dst_address.str().c_str(),
+			     ether_type,
+			     if_name().c_str(),
+			     vif_name().c_str(),
+			     strerror(errno));
+
+	//
+	// XXX: Maybe the device was brought down invalidating the
+	// socket - try to reopen.
+	//
+	string dummy_error_msg;
+	if ((reopen_packet_access(dummy_error_msg) == XORP_OK)
+	    && (send(_packet_fd, &packet[0], packet.size(), 0) >= 0)) {
+	    // Success
+	    error_msg = "";
+	} else {
+	    return (XORP_ERROR);
+	}
+    }
+
+    return (XORP_OK);
+}
+
+#endif // HAVE_TPACKET_V3 && HAVE_PCAP_H
@@ -0,0 +1,202 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __FEA_DATA_PLANE_IO_IO_LINK_PACKET_MMAP_HH__
+#define __FEA_DATA_PLANE_IO_IO_LINK_PACKET_MMAP_HH__
+
+//
+// I/O link raw communication support.
+//
+// The mechanism is a Linux AF_PACKET socket with a TPACKET_V3
+// memory-mapped receive ring.
+//
+
+#include "libxorp/xorp.h"
+#include "libxorp/eventloop.hh"
+#include "libxorp/mac.hh"
+
+#include "fea/io_link.hh"
+
+
+/**
+ * @short A base class for I/O link raw communication over a Linux
+ * AF_PACKET socket with a memory-mapped receive ring.
+ *
+ * The kernel fills the ring in blocks of frames, and a block is handed
+ * over once it is full or after a short timeout.  All frames in a block
+ * are processed in place, without a system call or a copy per frame.
+ * The packets to receive are selected in the kernel with a BPF filter
+ * compiled from the EtherType and the filter program.
+ *
+ * Each protocol 'registers' for link raw I/O per interface and vif
+ * and gets assigned one object (per interface and vif) of this class.
+ */
+class IoLinkPacketMmap : public IoLink {
+public:
+    /**
+     * Constructor for link-level access for a given interface and vif.
+     *
+     * @param fea_data_plane_manager the corresponding data plane manager
+     * (@ref FeaDataPlaneManager).
+     * @param iftree the interface tree to use.
+     * @param if_name the interface name.
+     * @param vif_name the vif name.
+     * @param ether_type the EtherType protocol number. If it is 0 then
+     * it is unused.
+     * @param filter_program the optional filter program to be applied on the
+     * received packets. The program uses tcpdump(1) style expression.
+     */
+    IoLinkPacketMmap(FeaDataPlaneManager& fea_data_plane_manager,
+		     const IfTree& iftree, const string& if_name,
+		     const string& vif_name, uint16_t ether_type,
+		     const string& filter_program);
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~IoLinkPacketMmap();
+
+    /**
+     * Start operation.
+     *
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		start(string& error_msg);
+
+    /**
+     * Stop operation.
+     *
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		stop(string& error_msg);
+
+    /**
+     * Join a multicast group on an interface.
+     *
+     * @param group the multicast group to join.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		join_multicast_group(const Mac& group, string& error_msg);
+
+    /**
+     * Leave a multicast group on an interface.
+     *
+     * @param group the multicast group to leave.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		leave_multicast_group(const Mac& group, string& error_msg);
+
+    /**
+     * Send a link-level packet.
+     *
+     * @param src_address the MAC source address.
+     * @param dst_address the MAC destination address.
+     * @param ether_type the EtherType protocol number.
+     * @param payload the payload, everything after the MAC header.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		send_packet(const Mac&		src_address,
+			    const Mac&		dst_address,
+			    uint16_t		ether_type,
+			    const vector<uint8_t>& payload,
+			    string&		error_msg);
+
+private:
+    /**
+     * Open the packet socket and map its receive ring.
+     *
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		open_packet_access(string& error_msg);
+
+    /**
+     * Unmap the receive ring and close the packet socket.
+     *
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		close_packet_access(string& error_msg);
+
+    /**
+     * Reopen the packet socket.
+     *
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		reopen_packet_access(string& error_msg);
+
+    /**
+     * Compile the filter expression and attach it to the packet socket.
+     *
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		attach_filter(string& error_msg);
+
+    /**
+     * Add or drop a multicast group membership on the packet socket.
+     *
+     * @param is_join if true, then join the group, otherwise leave.
+     * @param group the multicast group to join/leave.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int		join_leave_multicast_group(bool is_join, const Mac& group,
+					   string& error_msg);
+
+    /**
+     * Callback that is called when there data to read from the system.
+     *
+     * This is called as a IoEventCb callback.
+     * @param fd file descriptor that with event caused this method to be
+     * called.
+     * @param type the event type.
+     */
+    void	ioevent_read_cb(XorpFd fd, IoEventType type);
+
+    /**
+     * Process all blocks the kernel has handed over, and return them
+     * to the kernel.
+     */
+    void	recv_data();
+
+    // Receive ring geometry
+    static const size_t RING_BLOCK_SIZE = 128 * 1024;	// Multiple of pages
+    static const size_t RING_BLOCK_NR = 8;
+    static const size_t RING_FRAME_SIZE = 2048;
+    static const unsigned int RING_BLOCK_TIMEOUT_MS = 2; // Block retire time
+
+    // Private state
+    XorpFd	_packet_fd;	// The AF_PACKET socket
+    int		_ifindex;	// The index of the vif
+    uint8_t*	_ring;		// The mapped receive ring
+    size_t	_ring_size;	// The size of the mapped ring
+    size_t	_ring_block;	// The next block to process
+    uint32_t	_ring_generation; // Incremented each time the ring is mapped
+    multiset<Mac> _joined_groups; // Groups to join again after a reopen
+};
+
+#endif // __FEA_DATA_PLANE_IO_IO_LINK_PACKET_MMAP_HH__
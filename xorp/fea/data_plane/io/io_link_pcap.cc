@@ -258,26 +258,7 @@ IoLinkPcap::open_pcap_access(string& error_msg)
     //
     // Set the pcap filter
     //
-    // XXX: The filter is logical AND of the EtherType/DSAP with the
-    // user's optional filter program.
-    //
-    string pcap_filter_program;
-    if (ether_type() > 0) {
-	if (ether_type() < ETHERNET_LENGTH_TYPE_THRESHOLD) {
-	    // A filter using the DSAP in IEEE 802.2 LLC frame
-	    pcap_filter_program = c_format("(ether[%u] = %u)",
-					   ETHERNET_HEADER_SIZE,
-					   ether_type());
-	} else {
-	    // A filter using the EtherType
-	    pcap_filter_program = c_format("(ether proto %u)", ether_type());
-	}
-    }
-    if (! filter_program().empty()) {
-	if (! pcap_filter_program.empty())
-	    pcap_filter_program += " and ";
-	pcap_filter_program += c_format("(%s)", filter_program().c_str());
-    }
+    string pcap_filter_program = filter_expression();
 
     //
     // XXX: We can't use pcap_filter_program.c_str() as an argument
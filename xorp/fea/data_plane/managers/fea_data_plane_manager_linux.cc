@@ -47,6 +47,7 @@
 #include "fea/data_plane/fibconfig/fibconfig_table_set_netlink_socket.hh"
 #include "fea/data_plane/fibconfig/fibconfig_table_observer_netlink_socket.hh"
 #include "fea/data_plane/io/io_link_pcap.hh"
+#include "fea/data_plane/io/io_link_packet_mmap.hh"
 #include "fea/data_plane/io/io_ip_socket.hh"
 #include "fea/data_plane/io/io_tcpudp_socket.hh"
 
@@ -220,7 +221,11 @@ FeaDataPlaneManagerLinux::allocate_io_link(const IfTree& iftree,
     UNUSED(ether_type);
     UNUSED(filter_program);
 
-#ifdef HAVE_PCAP_H
+#if defined(HAVE_TPACKET_V3) && defined(HAVE_PCAP_H)
+    io_link = new IoLinkPacketMmap(*this, iftree, if_name, vif_name,
+				   ether_type, filter_program);
+    _io_link_list.push_back(io_link);
+#elif defined(HAVE_PCAP_H)
     io_link = new IoLinkPcap(*this, iftree, if_name, vif_name, ether_type,
 			     filter_program);
     _io_link_list.push_back(io_link);
@@ -56,6 +56,8 @@ FibConfig::FibConfig(FeaNode& fea_node, const IfTree& system_config_iftree,
       _unicast_forwarding_entries_retain_on_shutdown4(false),
       _unicast_forwarding_entries_retain_on_startup6(false),
       _unicast_forwarding_entries_retain_on_shutdown6(false),
+      _unicast_forwarding_entries_reconcile_hold_time4(0),
+      _unicast_forwarding_entries_reconcile_hold_time6(0),
       _unicast_forwarding_table_id4(0),
       _unicast_forwarding_table_id4_is_configured(false),
       _unicast_forwarding_table_id6(0),
@@ -521,7 +523,7 @@ FibConfig::register_fibconfig_table_set(FibConfigTableSet* fibconfig_table_set,
 	// XXX: Push the current config into the new method
 	//
 	if (fibconfig_table_set->is_running()) {
-	    list<Fte4> fte_list4;
+	    Fte4Batch fte_list4;
 
 	    if (get_table4(fte_list4) == XORP_OK) {
 		if (fibconfig_table_set->set_table4(fte_list4) != XORP_OK) {
@@ -532,7 +534,7 @@ FibConfig::register_fibconfig_table_set(FibConfigTableSet* fibconfig_table_set,
 	    }
 
 #ifdef HAVE_IPV6
-	    list<Fte6> fte_list6;
+	    Fte6Batch fte_list6;
 
 	    if (get_table6(fte_list6) == XORP_OK) {
 		if (fibconfig_table_set->set_table6(fte_list6) != XORP_OK) {
@@ -745,6 +747,11 @@ FibConfig::stop(string& error_msg)
 
     error_msg.erase();
 
+    _reconcile_timer4.unschedule();
+    _reconcile_timer6.unschedule();
+    _reconcile_table4.clear();
+    _reconcile_table6.clear();
+
     //
     // Stop the FibConfigTableObserver methods
     //
@@ -979,6 +986,189 @@ FibConfig::set_unicast_forwarding_entries_retain_on_shutdown6(bool retain,
     return (XORP_OK);
 }
 
+int
+FibConfig::set_unicast_forwarding_entries_reconcile_hold_time4(uint32_t hold_time,
+							       string& error_msg)
+{
+    _unicast_forwarding_entries_reconcile_hold_time4 = hold_time;
+
+    // Disabling the reconciliation keeps the remaining entries
+    if (hold_time == 0) {
+	_reconcile_timer4.unschedule();
+	_reconcile_table4.clear();
+    }
+
+    error_msg = "";		// XXX: reset
+    return (XORP_OK);
+}
+
+int
+FibConfig::set_unicast_forwarding_entries_reconcile_hold_time6(uint32_t hold_time,
+							       string& error_msg)
+{
+    _unicast_forwarding_entries_reconcile_hold_time6 = hold_time;
+
+    // Disabling the reconciliation keeps the remaining entries
+    if (hold_time == 0) {
+	_reconcile_timer6.unschedule();
+	_reconcile_table6.clear();
+    }
+
+    error_msg = "";		// XXX: reset
+    return (XORP_OK);
+}
+
+/**
+ * Test whether an installed entry forwards the same way as a new entry.
+ */
+template <typename F>
+static bool
+is_same_forwarding_entry(const F& installed, const F& fte)
+{
+    return ((installed.nexthop() == fte.nexthop())
+	    && (installed.ifname() == fte.ifname())
+	    && (installed.vifname() == fte.vifname())
+	    && (installed.metric() == fte.metric()));
+}
+
+void
+FibConfig::start_reconciliation()
+{
+    if (! _is_running)
+	return;
+
+    if (_unicast_forwarding_entries_reconcile_hold_time4 != 0)
+	start_reconciliation4();
+#ifdef HAVE_IPV6
+    if (_unicast_forwarding_entries_reconcile_hold_time6 != 0)
+	start_reconciliation6();
+#endif
+}
+
+void
+FibConfig::start_reconciliation4()
+{
+    Fte4Batch fte_list;
+    Fte4Batch::const_iterator iter;
+
+    _reconcile_timer4.unschedule();
+    _reconcile_table4.clear();
+
+    if (get_table4(fte_list) != XORP_OK) {
+	XLOG_ERROR("Cannot reconcile the IPv4 forwarding table: "
+		   "cannot get the table");
+	return;
+    }
+
+    for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
+	const Fte4& fte = *iter;
+	if (fte.xorp_route())
+	    _reconcile_table4.insert(make_pair(fte.net(), fte));
+    }
+
+    XLOG_INFO("Reconciling %u IPv4 forwarding entries for %u seconds",
+	      XORP_UINT_CAST(_reconcile_table4.size()),
+	      XORP_UINT_CAST(_unicast_forwarding_entries_reconcile_hold_time4));
+
+    _reconcile_timer4 = _eventloop.new_oneoff_after(
+	TimeVal(_unicast_forwarding_entries_reconcile_hold_time4, 0),
+	callback(this, &FibConfig::end_reconciliation4));
+}
+
+void
+FibConfig::end_reconciliation4()
+{
+    map<IPv4Net, Fte4> stale_table;
+    map<IPv4Net, Fte4>::iterator iter;
+    string error_msg;
+
+    // XXX: delete_entry4() erases from the reconciliation table
+    stale_table.swap(_reconcile_table4);
+    if (stale_table.empty())
+	return;
+
+    XLOG_INFO("Deleting %u stale IPv4 forwarding entries",
+	      XORP_UINT_CAST(stale_table.size()));
+
+    if (start_configuration(error_msg) != XORP_OK) {
+	XLOG_ERROR("Cannot start configuration: %s", error_msg.c_str());
+	return;
+    }
+
+    for (iter = stale_table.begin(); iter != stale_table.end(); ++iter) {
+	const Fte4& fte = iter->second;
+	if (delete_entry4(fte) != XORP_OK) {
+	    XLOG_ERROR("Cannot delete stale forwarding entry %s",
+		       fte.str().c_str());
+	}
+    }
+
+    if (end_configuration(error_msg) != XORP_OK)
+	XLOG_ERROR("Cannot end configuration: %s", error_msg.c_str());
+}
+
+void
+FibConfig::start_reconciliation6()
+{
+    Fte6Batch fte_list;
+    Fte6Batch::const_iterator iter;
+
+    _reconcile_timer6.unschedule();
+    _reconcile_table6.clear();
+
+    if (get_table6(fte_list) != XORP_OK) {
+	XLOG_ERROR("Cannot reconcile the IPv6 forwarding table: "
+		   "cannot get the table");
+	return;
+    }
+
+    for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
+	const Fte6& fte = *iter;
+	if (fte.xorp_route())
+	    _reconcile_table6.insert(make_pair(fte.net(), fte));
+    }
+
+    XLOG_INFO("Reconciling %u IPv6 forwarding entries for %u seconds",
+	      XORP_UINT_CAST(_reconcile_table6.size()),
+	      XORP_UINT_CAST(_unicast_forwarding_entries_reconcile_hold_time6));
+
+    _reconcile_timer6 = _eventloop.new_oneoff_after(
+	TimeVal(_unicast_forwarding_entries_reconcile_hold_time6, 0),
+	callback(this, &FibConfig::end_reconciliation6));
+}
+
+void
+FibConfig::end_reconciliation6()
+{
+    map<IPv6Net, Fte6> stale_table;
+    map<IPv6Net, Fte6>::iterator iter;
+    string error_msg;
+
+    // XXX: delete_entry6() erases from the reconciliation table
+    stale_table.swap(_reconcile_table6);
+    if (stale_table.empty())
+	return;
+
+    XLOG_INFO("Deleting %u stale IPv6 forwarding entries",
+	      XORP_UINT_CAST(stale_table.size()));
+
+    if (start_configuration(error_msg) != XORP_OK) {
+	XLOG_ERROR("Cannot start configuration: %s", error_msg.c_str());
+	return;
+    }
+
+    for (iter = stale_table.begin(); iter != stale_table.end(); ++iter) {
+	const Fte6& fte = iter->second;
+	if (delete_entry6(fte) != XORP_OK) {
+	    XLOG_ERROR("Cannot delete stale forwarding entry %s",
+		       fte.str().c_str());
+	}
+    }
+
+    if (end_configuration(error_msg) != XORP_OK)
+	XLOG_ERROR("Cannot end configuration: %s", error_msg.c_str());
+}
+
 bool
 FibConfig::unicast_forwarding_table_id_is_configured(int family) const
 {
@@ -1192,6 +1382,16 @@ FibConfig::add_entry4(const Fte4& fte)
     if (_fibconfig_entry_sets.empty())
 	return (XORP_ERROR);
 
+    if (_reconcile_timer4.scheduled()) {
+	map<IPv4Net, Fte4>::iterator iter = _reconcile_table4.find(fte.net());
+	if (iter != _reconcile_table4.end()) {
+	    bool is_same = is_same_forwarding_entry(iter->second, fte);
+	    _reconcile_table4.erase(iter);
+	    if (is_same)
+		return (XORP_OK);	// XXX: already installed
+	}
+    }
+
     PROFILE(if (_profile.enabled(profile_route_out))
 		_profile.log(profile_route_out,
 			     c_format("add %s", fte.net().str().c_str())));
@@ -1215,6 +1415,8 @@ FibConfig::delete_entry4(const Fte4& fte)
     if (_fibconfig_entry_sets.empty())
 	return (XORP_ERROR);
 
+    _reconcile_table4.erase(fte.net());
+
     PROFILE(if (_profile.enabled(profile_route_out))
 		_profile.log(profile_route_out,
 			     c_format("delete %s", fte.net().str().c_str())));
@@ -1231,7 +1433,7 @@ FibConfig::delete_entry4(const Fte4& fte)
 }
 
 int
-FibConfig::set_table4(const list<Fte4>& fte_list)
+FibConfig::set_table4(const Fte4Batch& fte_list)
 {
     list<FibConfigTableSet*>::iterator fibconfig_table_set_iter;
 
@@ -1257,6 +1459,8 @@ FibConfig::delete_all_entries4()
     if (_fibconfig_table_sets.empty())
 	return (XORP_ERROR);
 
+    _reconcile_table4.clear();
+
     for (fibconfig_table_set_iter = _fibconfig_table_sets.begin();
 	 fibconfig_table_set_iter != _fibconfig_table_sets.end();
 	 ++fibconfig_table_set_iter) {
@@ -1305,7 +1509,7 @@ FibConfig::lookup_route_by_network4(const IPv4Net& dst, Fte4& fte)
 }
 
 int
-FibConfig::get_table4(list<Fte4>& fte_list)
+FibConfig::get_table4(Fte4Batch& fte_list)
 {
     if (_fibconfig_table_gets.empty())
 	return (XORP_ERROR);
@@ -1328,6 +1532,16 @@ FibConfig::add_entry6(const Fte6& fte)
     if (_fibconfig_entry_sets.empty())
 	return (XORP_ERROR);
 
+    if (_reconcile_timer6.scheduled()) {
+	map<IPv6Net, Fte6>::iterator iter = _reconcile_table6.find(fte.net());
+	if (iter != _reconcile_table6.end()) {
+	    bool is_same = is_same_forwarding_entry(iter->second, fte);
+	    _reconcile_table6.erase(iter);
+	    if (is_same)
+		return (XORP_OK);	// XXX: already installed
+	}
+    }
+
     PROFILE(if (_profile.enabled(profile_route_out))
 		_profile.log(profile_route_out,
 			     c_format("add %s", fte.net().str().c_str())));
@@ -1351,6 +1565,8 @@ FibConfig::delete_entry6(const Fte6& fte)
     if (_fibconfig_entry_sets.empty())
 	return (XORP_ERROR);
 
+    _reconcile_table6.erase(fte.net());
+
     PROFILE(if (_profile.enabled(profile_route_out))
 		_profile.log(profile_route_out,
 			     c_format("delete %s", fte.net().str().c_str())));
@@ -1367,7 +1583,7 @@ FibConfig::delete_entry6(const Fte6& fte)
 }
 
 int
-FibConfig::set_table6(const list<Fte6>& fte_list)
+FibConfig::set_table6(const Fte6Batch& fte_list)
 {
     list<FibConfigTableSet*>::iterator fibconfig_table_set_iter;
 
@@ -1393,6 +1609,8 @@ FibConfig::delete_all_entries6()
     if (_fibconfig_table_sets.empty())
 	return (XORP_ERROR);
 
+    _reconcile_table6.clear();
+
     for (fibconfig_table_set_iter = _fibconfig_table_sets.begin();
 	 fibconfig_table_set_iter != _fibconfig_table_sets.end();
 	 ++fibconfig_table_set_iter) {
@@ -1441,7 +1659,7 @@ FibConfig::lookup_route_by_network6(const IPv6Net& dst, Fte6& fte)
 }
 
 int
-FibConfig::get_table6(list<Fte6>& fte_list)
+FibConfig::get_table6(Fte6Batch& fte_list)
 {
     if (_fibconfig_table_gets.empty())
 	return (XORP_ERROR);
@@ -1491,14 +1709,14 @@ FibConfig::delete_fib_table_observer(FibTableObserverBase* fib_table_observer)
 }
 
 void
-FibConfig::propagate_fib_changes(const list<FteX>& fte_list,
+FibConfig::propagate_fib_changes(const FteXBatch& fte_list,
 				 const FibConfigTableObserver* fibconfig_table_observer)
 {
-    list<Fte4> fte_list4;
+    Fte4Batch fte_list4;
 #ifdef HAVE_IPV6
-    list<Fte6> fte_list6;
+    Fte6Batch fte_list6;
 #endif
-    list<FteX>::const_iterator ftex_iter;
+    FteXBatch::const_iterator ftex_iter;
 
     //
     // XXX: propagate the changes only from the first method.
@@ -27,6 +27,7 @@
 #include "libxorp/ipv4net.hh"
 #include "libxorp/ipv6net.hh"
 #include "libxorp/status_codes.h"
+#include "libxorp/timer.hh"
 #include "libxorp/transaction.hh"
 #include "libxorp/trie.hh"
 
@@ -410,6 +411,74 @@ public:
     int set_unicast_forwarding_entries_retain_on_shutdown6(bool retain,
 							   string& error_msg);
 
+    /**
+     * Get the hold time of the IPv4 forwarding table reconciliation.
+     *
+     * @return the hold time in seconds, or zero if the reconciliation
+     * is disabled.
+     */
+    uint32_t unicast_forwarding_entries_reconcile_hold_time4() const {
+	return (_unicast_forwarding_entries_reconcile_hold_time4);
+    }
+
+    /**
+     * Get the hold time of the IPv6 forwarding table reconciliation.
+     *
+     * @return the hold time in seconds, or zero if the reconciliation
+     * is disabled.
+     */
+    uint32_t unicast_forwarding_entries_reconcile_hold_time6() const {
+	return (_unicast_forwarding_entries_reconcile_hold_time6);
+    }
+
+    /**
+     * Set the hold time of the IPv4 forwarding table reconciliation.
+     *
+     * @param hold_time the hold time in seconds. If zero, then
+     * the reconciliation is disabled.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int set_unicast_forwarding_entries_reconcile_hold_time4(uint32_t hold_time,
+							    string& error_msg);
+
+    /**
+     * Set the hold time of the IPv6 forwarding table reconciliation.
+     *
+     * @param hold_time the hold time in seconds. If zero, then
+     * the reconciliation is disabled.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int set_unicast_forwarding_entries_reconcile_hold_time6(uint32_t hold_time,
+							    string& error_msg);
+
+    /**
+     * Start reconciling the forwarding table with the routes added
+     * by the RIB.
+     *
+     * The XORP entries in the forwarding table are recorded.  Until the
+     * hold time expires, adding an entry that is already installed
+     * does not touch the underlying system.  After the hold time any
+     * recorded entry that was not added or deleted again is deleted.
+     * Nothing happens for an address family whose hold time is zero.
+     */
+    void start_reconciliation();
+
+    /**
+     * Test whether the IPv4 forwarding table is being reconciled.
+     *
+     * @return true if the IPv4 forwarding table is being reconciled.
+     */
+    bool is_reconciling4() const { return (_reconcile_timer4.scheduled()); }
+
+    /**
+     * Test whether the IPv6 forwarding table is being reconciled.
+     *
+     * @return true if the IPv6 forwarding table is being reconciled.
+     */
+    bool is_reconciling6() const { return (_reconcile_timer6.scheduled()); }
+
     /**
      * Test whether the unicast forwarding table ID for a given address family
      * is configured.
@@ -594,7 +663,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int set_table4(const list<Fte4>& fte_list);
+    virtual int set_table4(const Fte4Batch& fte_list);
 
     /**
      * Delete all entries in the IPv4 unicast forwarding table.
@@ -630,7 +699,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table4(list<Fte4>& fte_list);
+    virtual int get_table4(Fte4Batch& fte_list);
 
     /**
      * Add a single IPv6 forwarding entry.
@@ -649,7 +718,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int set_table6(const list<Fte6>& fte_list);
+    virtual int set_table6(const Fte6Batch& fte_list);
 
     /**
      * Delete a single IPv6 forwarding entry.
@@ -695,7 +764,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int get_table6(list<Fte6>& fte_list);
+    virtual int get_table6(Fte6Batch& fte_list);
 
     /**
      * Add a FIB table observer.
@@ -719,7 +788,7 @@ public:
      * @param fte_list the list with the FIB changes.
      * @param fibconfig_table_observer the method that reports the FIB changes.
      */
-    void propagate_fib_changes(const list<FteX>& fte_list,
+    void propagate_fib_changes(const FteXBatch& fte_list,
 			       const FibConfigTableObserver* fibconfig_table_observer);
 
     /**
@@ -743,6 +812,28 @@ protected:
     Trie6	_trie6;		// IPv6 trie (used for testing purpose)
 
 private:
+    /**
+     * Start reconciling the IPv4 forwarding table.
+     */
+    void start_reconciliation4();
+
+    /**
+     * Start reconciling the IPv6 forwarding table.
+     */
+    void start_reconciliation6();
+
+    /**
+     * Delete the IPv4 entries that were not added again within
+     * the reconciliation hold time.
+     */
+    void end_reconciliation4();
+
+    /**
+     * Delete the IPv6 entries that were not added again within
+     * the reconciliation hold time.
+     */
+    void end_reconciliation6();
+
     mutable bool vrf_queried;
     mutable string vrf_name;
 
@@ -777,6 +868,8 @@ private:
     bool	_unicast_forwarding_entries_retain_on_shutdown4;
     bool	_unicast_forwarding_entries_retain_on_startup6;
     bool	_unicast_forwarding_entries_retain_on_shutdown6;
+    uint32_t	_unicast_forwarding_entries_reconcile_hold_time4;
+    uint32_t	_unicast_forwarding_entries_reconcile_hold_time6;
     uint32_t	_unicast_forwarding_table_id4;
     bool	_unicast_forwarding_table_id4_is_configured;
     uint32_t	_unicast_forwarding_table_id6;
@@ -787,6 +880,15 @@ private:
     //
     bool	_is_running;
     list<FibTableObserverBase*>	_fib_table_observers;
+
+    //
+    // The XORP entries which are not yet known to be wanted by the RIB
+    // while the forwarding table is reconciled.
+    //
+    map<IPv4Net, Fte4>	_reconcile_table4;
+    map<IPv6Net, Fte6>	_reconcile_table6;
+    XorpTimer		_reconcile_timer4;
+    XorpTimer		_reconcile_timer6;
 };
 
 /**
@@ -805,7 +907,7 @@ public:
      * 
      * @param fte_list the list of Fte entries to add or delete.
      */
-    virtual void process_fib_changes(const list<Fte4>& fte_list) = 0;
+    virtual void process_fib_changes(const Fte4Batch& fte_list) = 0;
 
 #ifdef HAVE_IPV6
     /**
@@ -815,7 +917,7 @@ public:
      * 
      * @param fte_list the list of Fte entries to add or delete.
      */
-    virtual void process_fib_changes(const list<Fte6>& fte_list) = 0;
+    virtual void process_fib_changes(const Fte6Batch& fte_list) = 0;
 #endif
 
 private:
@@ -127,7 +127,7 @@ public:
      * the IPv4 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int set_table4(const list<Fte4>& fte_list) = 0;
+    virtual int set_table4(const Fte4Batch& fte_list) = 0;
 
     /**
      * Delete all entries in the IPv4 unicast forwarding table.
@@ -145,7 +145,7 @@ public:
      * the IPv6 unicast forwarding table.
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
-    virtual int set_table6(const list<Fte6>& fte_list) = 0;
+    virtual int set_table6(const Fte6Batch& fte_list) = 0;
     
     /**
      * Delete all entries in the IPv6 unicast forwarding table.
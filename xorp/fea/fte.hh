@@ -30,6 +30,43 @@
 #include "libxorp/ipvxnet.hh"
 
 
+/**
+ * @short Interned interface or vif name.
+ *
+ * A forwarding table has many entries but few interface names, so
+ * each distinct name is stored once and the entries only point to it.
+ * Copying or comparing a name does not touch the string.  Interned
+ * names are never released; the set of names in an interface tree
+ * is small and changes rarely.
+ */
+class IfName {
+public:
+    IfName() : _name(intern(string())) {}
+    IfName(const string& name) : _name(intern(name)) {}
+
+    /**
+     * @return the name.
+     */
+    const string& str() const { return (*_name); }
+
+    bool operator==(const IfName& other) const {
+	return (_name == other._name);
+    }
+    bool operator!=(const IfName& other) const {
+	return (_name != other._name);
+    }
+
+private:
+    static const string* intern(const string& name) {
+	static set<string> names;
+
+	return (&*names.insert(name).first);
+    }
+
+    const string*	_name;
+};
+
+
 /**
  * @short Forwarding Table Entry.
  *
@@ -42,8 +79,8 @@ public:
     explicit Fte(int family) : _net(family), _nexthop(family) { zero(); }
     Fte(const N&	net,
 	const A&	nexthop,
-	const string&	ifname,
-	const string&	vifname,
+	const IfName&	ifname,
+	const IfName&	vifname,
 	uint32_t	metric,
 	uint32_t	admin_distance,
 	bool		xorp_route)
@@ -59,8 +96,10 @@ public:
 
     const N&	net() const		{ return _net; }
     const A&	nexthop() const 	{ return _nexthop; }
-    const string& ifname() const	{ return _ifname; }
-    const string& vifname() const	{ return _vifname; }
+    const string& ifname() const	{ return _ifname.str(); }
+    const string& vifname() const	{ return _vifname.str(); }
+    const IfName& interned_ifname() const	{ return _ifname; }
+    const IfName& interned_vifname() const	{ return _vifname; }
     uint32_t	metric() const		{ return _metric; }
     uint32_t	admin_distance() const	{ return _admin_distance; }
     bool	xorp_route() const 	{ return _xorp_route; }
@@ -77,8 +116,8 @@ public:
     void zero() {
 	_net = N(A::ZERO(_net.af()), 0);
 	_nexthop = A::ZERO(_nexthop.af());
-	_ifname.erase();
-	_vifname.erase();
+	_ifname = IfName();
+	_vifname = IfName();
 	_metric = 0;
 	_admin_distance = 0;
 	_xorp_route = false;
@@ -103,7 +142,7 @@ public:
 			"is_deleted = %s is_unresolved = %s "
 			"is_connected_route = %s",
 			_net.str().c_str(), _nexthop.str().c_str(),
-			_ifname.c_str(), _vifname.c_str(),
+			ifname().c_str(), vifname().c_str(),
 			XORP_UINT_CAST(_metric),
 			XORP_UINT_CAST(_admin_distance),
 			bool_c_str(_xorp_route),
@@ -115,8 +154,8 @@ public:
 private:
     N		_net;			// Network
     A		_nexthop;		// Nexthop address
-    string	_ifname;		// Interface name
-    string	_vifname;		// Virtual interface name
+    IfName	_ifname;		// Interface name
+    IfName	_vifname;		// Virtual interface name
     uint32_t	_metric;		// Route metric
     uint32_t	_admin_distance;	// Route admin distance
     bool	_xorp_route;		// This route was installed by XORP
@@ -147,8 +186,8 @@ public:
      */
     FteX(const IPvXNet&	net,
 	 const IPvX&	nexthop,
-	 const string&	ifname,
-	 const string&	vifname,
+	 const IfName&	ifname,
+	 const IfName&	vifname,
 	 uint32_t	metric,
 	 uint32_t	admin_distance,
 	 bool		xorp_route)
@@ -175,8 +214,8 @@ public:
     FteX(const Fte4& fte4)
 	: BaseFteX(IPvXNet(fte4.net()),
 		   IPvX(fte4.nexthop()),
-		   fte4.ifname(),
-		   fte4.vifname(),
+		   fte4.interned_ifname(),
+		   fte4.interned_vifname(),
 		   fte4.metric(),
 		   fte4.admin_distance(),
 		   fte4.xorp_route()) {
@@ -194,8 +233,8 @@ public:
     FteX(const Fte6& fte6)
 	: BaseFteX(IPvXNet(fte6.net()),
 		   IPvX(fte6.nexthop()),
-		   fte6.ifname(),
-		   fte6.vifname(),
+		   fte6.interned_ifname(),
+		   fte6.interned_vifname(),
 		   fte6.metric(),
 		   fte6.admin_distance(),
 		   fte6.xorp_route()) {
@@ -215,8 +254,8 @@ public:
     Fte4 get_fte4() const throw (InvalidCast) {
 	Fte4 fte4(net().get_ipv4net(),
 		  nexthop().get_ipv4(),
-		  ifname(),
-		  vifname(),
+		  interned_ifname(),
+		  interned_vifname(),
 		  metric(),
 		  admin_distance(),
 		  xorp_route());
@@ -237,8 +276,8 @@ public:
     Fte6 get_fte6() const throw (InvalidCast) {
 	Fte6 fte6(net().get_ipv6net(),
 		  nexthop().get_ipv6(),
-		  ifname(),
-		  vifname(),
+		  interned_ifname(),
+		  interned_vifname(),
 		  metric(),
 		  admin_distance(),
 		  xorp_route());
@@ -252,4 +291,11 @@ public:
     }
 };
 
+//
+// Contiguous batches of entries for whole-table transfers.
+//
+typedef vector<Fte4> Fte4Batch;
+typedef vector<Fte6> Fte6Batch;
+typedef vector<FteX> FteXBatch;
+
 #endif	// __FEA_FTE_HH__
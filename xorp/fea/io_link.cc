@@ -163,9 +163,34 @@ IoLink::recv_ethernet_packet(const uint8_t* packet, size_t packet_size)
 
     // Process the result
     // TODO:  get rid of this memory copy somehow.
-    vector<uint8_t> payload(payload_size);
-    memcpy(&payload[0], packet + payload_offset, payload_size);
-    recv_packet(src_address, dst_address, ether_type, payload);
+    // XXX: the buffer keeps its capacity, so this doesn't allocate.
+    _recv_payload.assign(packet + payload_offset,
+			 packet + payload_offset + payload_size);
+    recv_packet(src_address, dst_address, ether_type, _recv_payload);
+}
+
+string
+IoLink::filter_expression() const
+{
+    string expression;
+
+    if (ether_type() > 0) {
+	if (ether_type() < ETHERNET_LENGTH_TYPE_THRESHOLD) {
+	    // A filter using the DSAP in IEEE 802.2 LLC frame
+	    expression = c_format("(ether[%u] = %u)",
+				  ETHERNET_HEADER_SIZE, ether_type());
+	} else {
+	    // A filter using the EtherType
+	    expression = c_format("(ether proto %u)", ether_type());
+	}
+    }
+    if (! filter_program().empty()) {
+	if (! expression.empty())
+	    expression += " and ";
+	expression += c_format("(%s)", filter_program().c_str());
+    }
+
+    return (expression);
 }
 
 int
@@ -248,6 +248,17 @@ protected:
      */
     void recv_ethernet_packet(const uint8_t* packet, size_t packet_size);
 
+    /**
+     * Get the tcpdump(1) style expression for the packets to receive.
+     *
+     * The expression is the logical AND of the EtherType/DSAP with the
+     * user's optional filter program.
+     *
+     * @return the filter expression, or an empty string if all packets
+     * should be received.
+     */
+    string filter_expression() const;
+
     /**
      * Prepare an Ethernet packet for transmission.
      *
@@ -285,6 +296,7 @@ private:
     const uint16_t	_ether_type;	// The EtherType protocol number
     const string	_filter_program;	// The filter program
     IoLinkReceiver*	_io_link_receiver;	// The registered receiver
+    vector<uint8_t>	_recv_payload;	// Reused for each received payload
 
     bool		_is_log_trace;		// True if trace log is enabled
 };
@@ -1539,6 +1539,35 @@ MfeaMrouter::delete_multicast_vif(uint32_t vif_index)
 }
 
 
+#if defined(HAVE_IPV4_MULTICAST_ROUTING) || defined(HAVE_IPV6_MULTICAST_ROUTING)
+//
+// Test whether the kernel MFC entry can hold the first @kernel_vifs vifs
+// only, and all the vifs of the entry to install are among them.
+// MAX_VIFS may be larger than what the kernel supports.
+//
+static bool
+oifs_fit_kernel(const IPvX& source, const IPvX& group,
+		uint32_t iif_vif_index, const uint8_t *oifs_ttl,
+		uint32_t max_vifs, uint32_t kernel_vifs)
+{
+    uint32_t i = iif_vif_index;
+
+    if (i < kernel_vifs) {
+	for (i = kernel_vifs; i < max_vifs; i++) {
+	    if (oifs_ttl[i] > 0)
+		break;
+	}
+	if (i >= max_vifs)
+	    return (true);
+    }
+
+    XLOG_ERROR("add_mfc() failed: (%s, %s) vif index %u is beyond "
+	       "the %u vifs supported by the kernel",
+	       cstring(source), cstring(group), i, kernel_vifs);
+    return (false);
+}
+#endif
+
 /**
  * MfeaMrouter::add_mfc:
  * @source: The MFC source address.
@@ -1567,7 +1596,12 @@ MfeaMrouter::add_mfc(const IPvX& source, const IPvX& group,
     //       source.str().c_str(), group.str().c_str(), iif_vif_index,
     //       rp_addr.str().c_str());
 
-    if (iif_vif_index >= mfea_node().maxvifs())
+    // XXX: the oifs arrays cover MAX_VIFS vifs
+    uint32_t max_vifs = min(mfea_node().maxvifs(),
+			    static_cast<uint32_t>(MAX_VIFS));
+    uint32_t kernel_vifs = max_vifs;	// The vifs the kernel entry can hold
+
+    if (iif_vif_index >= max_vifs)
 	return (XORP_ERROR);
     
     oifs_ttl[iif_vif_index] = 0;		// Pre-caution
@@ -1575,6 +1609,7 @@ MfeaMrouter::add_mfc(const IPvX& source, const IPvX& group,
 #if !defined(HAVE_IPV4_MULTICAST_ROUTING) && !defined(HAVE_IPV6_MULTICAST_ROUTING)
     UNUSED(source);
     UNUSED(group);
+    UNUSED(kernel_vifs);
 #endif
 
     UNUSED(oifs_flags);
@@ -1582,7 +1617,7 @@ MfeaMrouter::add_mfc(const IPvX& source, const IPvX& group,
 
     if (mfea_node().is_log_trace()) {
 	string res;
-	for (uint32_t i = 0; i < mfea_node().maxvifs(); i++) {
+	for (uint32_t i = 0; i < max_vifs; i++) {
 	    if (oifs_ttl[i] > 0)
 		res += "O";
 	    else
@@ -1633,8 +1668,13 @@ MfeaMrouter::add_mfc(const IPvX& source, const IPvX& group,
 	
 	source.copy_out(mcp->mfcc_origin);
 	group.copy_out(mcp->mfcc_mcastgrp);
+	kernel_vifs = min(kernel_vifs, static_cast<uint32_t>(
+			      sizeof(mcp->mfcc_ttls) / sizeof(mcp->mfcc_ttls[0])));
+	if (! oifs_fit_kernel(source, group, iif_vif_index, oifs_ttl,
+			      max_vifs, kernel_vifs))
+	    return (XORP_ERROR);
 	mcp->mfcc_parent = iif_vif_index;
-	for (uint32_t i = 0; i < mfea_node().maxvifs(); i++) {
+	for (uint32_t i = 0; i < kernel_vifs; i++) {
 	    mcp->mfcc_ttls[i] = oifs_ttl[i];
 #if defined(HAVE_STRUCT_MFCCTL2_MFCC_FLAGS) && defined(ENABLE_ADVANCED_MULTICAST_API)
 	    mcp->mfcc_flags[i] = oifs_flags[i];
@@ -1674,8 +1714,17 @@ MfeaMrouter::add_mfc(const IPvX& source, const IPvX& group,
 	IF_ZERO(&mc.mf6cc_ifset);	
 	source.copy_out(mc.mf6cc_origin);
 	group.copy_out(mc.mf6cc_mcastgrp);
+	kernel_vifs = min(kernel_vifs, static_cast<uint32_t>(
+			      sizeof(mc.mf6cc_ifset) * 8));
+#if defined(HAVE_STRUCT_MF6CCTL2_MF6CC_FLAGS) && defined(ENABLE_ADVANCED_MULTICAST_API)
+	kernel_vifs = min(kernel_vifs, static_cast<uint32_t>(
+			      sizeof(mc.mf6cc_flags) / sizeof(mc.mf6cc_flags[0])));
+#endif
+	if (! oifs_fit_kernel(source, group, iif_vif_index, oifs_ttl,
+			      max_vifs, kernel_vifs))
+	    return (XORP_ERROR);
 	mc.mf6cc_parent = iif_vif_index;
-	for (uint32_t i = 0; i < mfea_node().maxvifs(); i++) {
+	for (uint32_t i = 0; i < kernel_vifs; i++) {
 	    if (oifs_ttl[i] > 0)
 		IF_SET(i, &mc.mf6cc_ifset);
 #if defined(HAVE_STRUCT_MF6CCTL2_MF6CC_FLAGS) && defined(ENABLE_ADVANCED_MULTICAST_API)
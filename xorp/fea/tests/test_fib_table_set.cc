@@ -0,0 +1,158 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+//
+// Time and memory taken to install a full table with set_table4()
+// on the dummy data plane.
+//
+
+#include "fea_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+#include "libxorp/timeval.hh"
+
+#ifdef HAVE_GETOPT_H
+#include <getopt.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include "fea/fea_node.hh"
+#include "fea/fibconfig.hh"
+
+#include "test_utils.hh"
+
+static const uint32_t DEFAULT_ROUTE_COUNT = 500000;
+
+/**
+ * @return the maximum resident set size in kilobytes, or 0 if unknown.
+ */
+static long
+max_rss_kb()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+    struct rusage ru;
+
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+	return (ru.ru_maxrss);
+#endif
+    return (0);
+}
+
+static int
+run_test(uint32_t route_count)
+{
+    EventLoop eventloop;
+    FeaIoDummy fea_io(eventloop);
+    FeaNode fea_node(eventloop, fea_io, true);
+    string error_msg;
+
+    if (fea_node.startup() != XORP_OK) {
+	cerr << "Failed Test: cannot start the FEA" << endl;
+	return (1);
+    }
+
+    FibConfig& fibconfig = fea_node.fibconfig();
+    long rss_before = max_rss_kb();
+
+    //
+    // Build the table.  All routes share one interface, which is the
+    // common case for a full table learned from a single peer.
+    //
+    TimeVal start, built, installed;
+    TimerList::system_gettimeofday(&start);
+
+    Fte4Batch fte_list;
+    fte_list.reserve(route_count);
+    IfName ifname("eth0");
+    IPv4 nexthop("10.0.0.1");
+    for (uint32_t i = 0; i < route_count; i++) {
+	// 16.0.0.0 upwards in /24 steps.
+	IPv4Net net(IPv4(htonl((16U << 24) + (i << 8))), 24);
+	fte_list.push_back(Fte4(net, nexthop, ifname, ifname, 1, 1,
+				true));
+    }
+    TimerList::system_gettimeofday(&built);
+
+    if (fibconfig.start_configuration(error_msg) != XORP_OK) {
+	cerr << "Failed Test: cannot start configuration: " << error_msg
+	     << endl;
+	return (1);
+    }
+    fibconfig.set_table4(fte_list);
+    if (fibconfig.end_configuration(error_msg) != XORP_OK) {
+	cerr << "Failed Test: cannot end configuration: " << error_msg
+	     << endl;
+	return (1);
+    }
+    TimerList::system_gettimeofday(&installed);
+
+    long rss_after = max_rss_kb();
+
+    if (fibconfig.trie4().route_count() != static_cast<int>(route_count)) {
+	cerr << "Failed Test: expected " << route_count << " routes, found "
+	     << fibconfig.trie4().route_count() << endl;
+	return (1);
+    }
+
+    cout << "Routes:          " << route_count << endl;
+    cout << "Build time:      " << (built - start).str() << " s" << endl;
+    cout << "set_table4 time: " << (installed - built).str() << " s" << endl;
+    cout << "Max RSS growth:  " << (rss_after - rss_before) << " KB" << endl;
+
+    fea_node.shutdown();
+
+    cout << "Passed Test: set_table4 of " << route_count << " routes" << endl;
+
+    return (0);
+}
+
+static void
+usage(const char* argv0)
+{
+    fprintf(stderr, "usage: %s [-n <routes>]\n", argv0);
+    fprintf(stderr, "       -n <routes> : number of routes [default %u]\n",
+	    XORP_UINT_CAST(DEFAULT_ROUTE_COUNT));
+    exit(1);
+}
+
+int
+main(int argc, char *argv[])
+{
+    uint32_t route_count = DEFAULT_ROUTE_COUNT;
+    int ch;
+    while ((ch = getopt(argc, argv, "n:h")) != -1) {
+	switch (ch) {
+	case 'n':
+	    route_count = strtoul(optarg, NULL, 10);
+	    break;
+	case 'h':
+	default:
+	    usage(argv[0]);
+	}
+    }
+
+    return (run_fea_test(argv[0], callback(run_test, route_count)));
+}
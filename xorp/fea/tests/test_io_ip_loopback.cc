@@ -0,0 +1,249 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+//
+// Packet rate of the raw IP socket I/O over the loopback interface.
+// Raw sockets need privileges: without them the test is skipped.
+//
+
+#include "fea_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+
+#ifdef HAVE_GETOPT_H
+#include <getopt.h>
+#endif
+#ifdef HAVE_NET_IF_H
+#include <net/if.h>
+#endif
+
+#include "fea/fea_node.hh"
+#include "fea/iftree.hh"
+#include "fea/data_plane/managers/fea_data_plane_manager_dummy.hh"
+#include "fea/data_plane/io/io_ip_socket.hh"
+
+#include "test_utils.hh"
+
+#ifdef HAVE_IP_RAW_SOCKETS
+
+static const uint32_t DEFAULT_PACKET_COUNT = 100000;
+static const uint8_t TEST_IP_PROTOCOL = 253;	// RFC 3692 experimentation
+static const size_t PAYLOAD_SIZE = 64;
+static const size_t SEND_BURST = 32;		// Packets sent per callback
+
+/**
+ * Counts the received test packets.
+ */
+class CountingReceiver : public IoIpReceiver {
+public:
+    CountingReceiver() : _received(0) {}
+
+    void recv_packet(const string&	,
+		     const string&	,
+		     const IPvX&	,
+		     const IPvX&	,
+		     int32_t		,
+		     int32_t		,
+		     bool		,
+		     bool		,
+		     const vector<uint8_t>& ,
+		     const vector<vector<uint8_t> >& ,
+		     const vector<uint8_t>& payload) {
+	if (payload.size() == PAYLOAD_SIZE)
+	    _received++;
+    }
+
+    void recv_system_multicast_upcall(const vector<uint8_t>& ) {}
+
+    uint32_t received() const { return (_received); }
+
+private:
+    uint32_t	_received;
+};
+
+/**
+ * Sends the test packets in bursts, one burst per event loop iteration,
+ * the way a protocol sending to many neighbors does.
+ */
+class Sender {
+public:
+    Sender(EventLoop& eventloop, IoIpSocket& io_ip, uint32_t count)
+	: _eventloop(eventloop), _io_ip(io_ip), _count(count), _sent(0),
+	  _errors(0), _payload(PAYLOAD_SIZE, 0xa5) {}
+
+    void start() {
+	_timer = _eventloop.new_periodic(TimeVal::ZERO(),
+					 callback(this, &Sender::send_burst));
+    }
+
+    bool send_burst() {
+	vector<uint8_t> ext_headers_type;
+	vector<vector<uint8_t> > ext_headers_payload;
+	string error_msg;
+
+	for (size_t i = 0; (i < SEND_BURST) && (_sent < _count); i++) {
+	    if (_io_ip.send_packet("lo", "lo",
+				   IPvX(IPv4::LOOPBACK()),
+				   IPvX(IPv4::LOOPBACK()),
+				   64, -1, false, false,
+				   ext_headers_type, ext_headers_payload,
+				   _payload, error_msg)
+		!= XORP_OK) {
+		_errors++;
+	    }
+	    _sent++;
+	}
+	return (_sent < _count);
+    }
+
+    uint32_t sent() const { return (_sent); }
+    uint32_t errors() const { return (_errors); }
+
+private:
+    EventLoop&		_eventloop;
+    IoIpSocket&		_io_ip;
+    uint32_t		_count;
+    uint32_t		_sent;
+    uint32_t		_errors;
+    vector<uint8_t>	_payload;
+    XorpTimer		_timer;
+};
+
+static int
+run_test(uint32_t packet_count)
+{
+    EventLoop eventloop;
+    FeaIoDummy fea_io(eventloop);
+    FeaNode fea_node(eventloop, fea_io, true);
+    FeaDataPlaneManagerDummy fea_data_plane_manager(fea_node);
+    IfTree iftree("test");
+    string error_msg;
+
+    //
+    // The loopback interface
+    //
+    uint32_t pif_index = if_nametoindex("lo");
+    if (pif_index == 0) {
+	cout << "Skipped Test: no loopback interface" << endl;
+	return (0);
+    }
+    iftree.add_interface("lo");
+    IfTreeInterface* ifp = iftree.find_interface("lo");
+    ifp->set_pif_index(pif_index);
+    ifp->set_mtu(65536);
+    ifp->set_enabled(true);
+    ifp->add_vif("lo");
+    IfTreeVif* vifp = ifp->find_vif("lo");
+    vifp->set_pif_index(pif_index);
+    vifp->set_loopback(true);
+    vifp->set_enabled(true);
+    vifp->add_addr(IPv4::LOOPBACK());
+    vifp->find_addr(IPv4::LOOPBACK())->set_enabled(true);
+
+    IoIpSocket io_ip(fea_data_plane_manager, iftree, AF_INET,
+		     TEST_IP_PROTOCOL);
+    CountingReceiver receiver;
+
+    io_ip.register_io_ip_receiver(&receiver);
+    if (io_ip.start(error_msg) != XORP_OK) {
+	cout << "Skipped Test: cannot open raw socket: " << error_msg << endl;
+	return (0);
+    }
+    if (io_ip.create_input_socket("lo", "lo", error_msg) != XORP_OK) {
+	cerr << "Failed Test: cannot open input socket: " << error_msg << endl;
+	return (1);
+    }
+
+    //
+    // Send the packets and wait until all of them are received, or
+    // nothing has been received for a while.
+    //
+    Sender sender(eventloop, io_ip, packet_count);
+
+    sender.start();
+    TimeVal elapsed = run_until_received(
+	eventloop, packet_count, callback(&sender, &Sender::sent),
+	callback(&receiver, &CountingReceiver::received));
+
+    io_ip.stop(error_msg);
+    io_ip.unregister_io_ip_receiver();
+
+    print_rate("packets", sender.sent(), sender.errors(), receiver.received(),
+	       elapsed);
+
+    //
+    // XXX: the kernel may drop packets when the socket buffer is full,
+    // so only a lossy run with no packet at all is a failure.
+    //
+    if (receiver.received() == 0) {
+	cerr << "Failed Test: no packet received" << endl;
+	return (1);
+    }
+
+    cout << "Passed Test: raw IP loopback of " << packet_count << " packets"
+	 << endl;
+
+    return (0);
+}
+
+#else // ! HAVE_IP_RAW_SOCKETS
+
+static const uint32_t DEFAULT_PACKET_COUNT = 0;
+
+static int
+run_test(uint32_t )
+{
+    cout << "Skipped Test: no raw IP sockets" << endl;
+    return (0);
+}
+
+#endif // ! HAVE_IP_RAW_SOCKETS
+
+static void
+usage(const char* argv0)
+{
+    fprintf(stderr, "usage: %s [-n <packets>]\n", argv0);
+    fprintf(stderr, "       -n <packets> : number of packets [default %u]\n",
+	    XORP_UINT_CAST(DEFAULT_PACKET_COUNT));
+    exit(1);
+}
+
+int
+main(int argc, char *argv[])
+{
+    uint32_t packet_count = DEFAULT_PACKET_COUNT;
+    int ch;
+    while ((ch = getopt(argc, argv, "n:h")) != -1) {
+	switch (ch) {
+	case 'n':
+	    packet_count = strtoul(optarg, NULL, 10);
+	    break;
+	case 'h':
+	default:
+	    usage(argv[0]);
+	}
+    }
+
+    return (run_fea_test(argv[0], callback(run_test, packet_count)));
+}
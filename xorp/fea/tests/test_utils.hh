@@ -0,0 +1,151 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __FEA_TESTS_TEST_UTILS_HH__
+#define __FEA_TESTS_TEST_UTILS_HH__
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/c_format.hh"
+#include "libxorp/callback.hh"
+#include "libxorp/eventloop.hh"
+#include "libxorp/timeval.hh"
+
+#include "fea/fea_io.hh"
+
+
+/**
+ * FeaIo without a Finder: nobody else is running.
+ */
+class FeaIoDummy : public FeaIo {
+public:
+    FeaIoDummy(EventLoop& eventloop) : FeaIo(eventloop) {}
+
+protected:
+    int register_instance_event_interest(const string& , string& ) {
+	return (XORP_OK);
+    }
+    int deregister_instance_event_interest(const string& , string& ) {
+	return (XORP_OK);
+    }
+};
+
+/**
+ * Run the event loop until all packets have been received, or until
+ * none has arrived for two seconds after the last one was sent.
+ *
+ * @param eventloop the event loop.
+ * @param count the number of packets to send.
+ * @param sent returns the number of packets sent so far.
+ * @param received returns the number of packets received so far.
+ * @return the time it took.
+ */
+inline TimeVal
+run_until_received(EventLoop& eventloop, uint32_t count,
+		   XorpCallback0<uint32_t>::RefPtr sent,
+		   XorpCallback0<uint32_t>::RefPtr received)
+{
+    TimeVal start, now, last_progress;
+    uint32_t last_received = 0;
+
+    TimerList::system_gettimeofday(&start);
+    last_progress = start;
+    while (received->dispatch() < count) {
+	eventloop.run();
+	TimerList::system_gettimeofday(&now);
+	if (received->dispatch() != last_received) {
+	    last_received = received->dispatch();
+	    last_progress = now;
+	} else if ((sent->dispatch() == count)
+		   && (now - last_progress > TimeVal(2, 0))) {
+	    break;
+	}
+    }
+    TimerList::system_gettimeofday(&now);
+
+    return (now - start);
+}
+
+/**
+ * Print the counters and the receive rate of a packet test.
+ *
+ * @param unit what is counted, e.g. "packets".
+ * @param sent the number of packets sent.
+ * @param errors the number of send errors.
+ * @param received the number of packets received.
+ * @param elapsed the time it took.
+ */
+inline void
+print_rate(const string& unit, uint32_t sent, uint32_t errors,
+	   uint32_t received, const TimeVal& elapsed)
+{
+    string label = unit;
+
+    label[0] = toupper(label[0]);
+    cout << c_format("%-18s", (label + " sent:").c_str()) << sent << endl;
+    cout << c_format("%-18s", "Send errors:") << errors << endl;
+    cout << c_format("%-18s", (label + " received:").c_str()) << received
+	 << endl;
+    cout << c_format("%-18s", "Time:") << elapsed.str() << " s" << endl;
+    if (elapsed.get_double() > 0) {
+	cout << c_format("%-18s", "Rate:")
+	     << static_cast<uint32_t>(received / elapsed.get_double())
+	     << " " << unit << "/s" << endl;
+    }
+}
+
+/**
+ * Run a test with xlog started, catching the standard exceptions.
+ *
+ * @param argv0 the name of the program.
+ * @param test the test to run.
+ * @return the result of the test, or 1 if it threw an exception.
+ */
+inline int
+run_fea_test(const char* argv0, XorpCallback0<int>::RefPtr test)
+{
+    //
+    // Initialize and start xlog
+    //
+    xlog_init(argv0, NULL);
+    xlog_set_verbose(XLOG_VERBOSE_LOW);		// Least verbose messages
+    // XXX: verbosity of the error messages temporary increased
+    xlog_level_set_verbose(XLOG_LEVEL_ERROR, XLOG_VERBOSE_HIGH);
+    xlog_add_default_output();
+    xlog_start();
+
+    int r = 1;
+    XorpUnexpectedHandler x(xorp_unexpected_handler);
+    try {
+	r = test->dispatch();
+    } catch (...) {
+	xorp_catch_standard_exceptions();
+    }
+
+    //
+    // Gracefully stop and exit xlog
+    //
+    xlog_stop();
+    xlog_exit();
+
+    return (r);
+}
+
+#endif // __FEA_TESTS_TEST_UTILS_HH__
@@ -36,6 +36,7 @@
 #include "libproto/packet.hh"
 #include "libxipc/xrl_std_router.hh"
 
+#include "xrl/interfaces/finder_event_notifier_xif.hh"
 #ifndef XORP_DISABLE_PROFILE
 #include "xrl/interfaces/profile_client_xif.hh"
 #endif
@@ -104,11 +105,29 @@ XrlFeaTarget::~XrlFeaTarget()
 int
 XrlFeaTarget::startup()
 {
+    //
+    // Watch the RIB so the forwarding table can be reconciled with
+    // the routes a restarted RIB adds.
+    //
+    XrlFinderEventNotifierV0p1Client finder(&_xrl_router);
+    finder.send_register_class_event_interest(
+	"finder", _xrl_router.instance_name(), "rib",
+	callback(this, &XrlFeaTarget::register_rib_interest_cb));
+
     _is_running = true;
 
     return (XORP_OK);
 }
 
+void
+XrlFeaTarget::register_rib_interest_cb(const XrlError& xrl_error)
+{
+    if (xrl_error != XrlError::OKAY()) {
+	XLOG_ERROR("Failed to register interest in the RIB: %s",
+		   xrl_error.str().c_str());
+    }
+}
+
 int
 XrlFeaTarget::shutdown()
 {
@@ -200,6 +219,9 @@ XrlFeaTarget::finder_event_observer_0_1_xrl_target_birth(
 
     _fea_node.fea_io().instance_birth(target_instance);
 
+    if (target_class == "rib")
+	_fibconfig.start_reconciliation();
+
     return XrlCmdError::OKAY();
 }
 
@@ -2026,6 +2048,23 @@ XrlFeaTarget::fti_0_2_set_unicast_forwarding_entries_retain_on_shutdown6(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlFeaTarget::fti_0_2_set_unicast_forwarding_entries_reconcile_hold_time6(
+    // Input values,
+    const uint32_t&	hold_time)
+{
+    string error_msg;
+
+    if (_fibconfig.set_unicast_forwarding_entries_reconcile_hold_time6(
+	    hold_time,
+	    error_msg)
+	!= XORP_OK) {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlFeaTarget::fti_0_2_set_unicast_forwarding_table_id6(
     // Input values,
@@ -3362,6 +3401,23 @@ XrlFeaTarget::fti_0_2_set_unicast_forwarding_entries_retain_on_shutdown4(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlFeaTarget::fti_0_2_set_unicast_forwarding_entries_reconcile_hold_time4(
+    // Input values,
+    const uint32_t&	hold_time)
+{
+    string error_msg;
+
+    if (_fibconfig.set_unicast_forwarding_entries_reconcile_hold_time4(
+	    hold_time,
+	    error_msg)
+	!= XORP_OK) {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlFeaTarget::fti_0_2_set_unicast_forwarding_table_id4(
     // Input values,
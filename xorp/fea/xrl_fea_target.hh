@@ -1302,6 +1302,17 @@ public:
 	// Input values,
 	const bool&	retain);
 
+    /**
+     *  Set the hold time of the IPv4 unicast forwarding table
+     *  reconciliation.
+     *
+     *  @param hold_time the hold time in seconds. If zero, then the
+     *  reconciliation is disabled.
+     */
+    XrlCmdError fti_0_2_set_unicast_forwarding_entries_reconcile_hold_time4(
+	// Input values,
+	const uint32_t&	hold_time);
+
     /**
      *  Set the IPv4 unicast forwarding table ID to be used.
      *
@@ -1374,6 +1385,17 @@ public:
 	// Input values,
 	const bool&	retain);
 
+    /**
+     *  Set the hold time of the IPv6 unicast forwarding table
+     *  reconciliation.
+     *
+     *  @param hold_time the hold time in seconds. If zero, then the
+     *  reconciliation is disabled.
+     */
+    XrlCmdError fti_0_2_set_unicast_forwarding_entries_reconcile_hold_time6(
+	// Input values,
+	const uint32_t&	hold_time);
+
     /**
      *  Set the IPv6 unicast forwarding table ID to be used.
      *
@@ -2736,6 +2758,13 @@ public:
 #endif
 
 private:
+    /**
+     * Completion callback for registering interest in the RIB.
+     *
+     * @param xrl_error the XRL error status.
+     */
+    void register_rib_interest_cb(const XrlError& xrl_error);
+
     /**
      * Add/remove a multicast MAC address on an interface.
      *
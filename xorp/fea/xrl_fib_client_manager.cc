@@ -25,8 +25,16 @@
 #include "libxorp/xlog.h"
 #include "libxorp/debug.h"
 
+#include "xrl/interfaces/fea_fib_client_route_changes.hh"
+
 #include "xrl_fib_client_manager.hh"
 
+//
+// The maximum number of route changes sent to a FIB client in one XRL.
+// Only one XRL is in flight per client, so this also bounds the number
+// of route changes the client has to take at once.
+//
+static const size_t FIB_CLIENT_ROUTE_CHANGES_MAX = 256;
 
 /**
  * Process a list of IPv4 FIB route changes.
@@ -36,7 +44,7 @@
  * @param fte_list the list of Fte entries to add or delete.
  */
 void
-XrlFibClientManager::process_fib_changes(const list<Fte4>& fte_list)
+XrlFibClientManager::process_fib_changes(const Fte4Batch& fte_list)
 {
     map<string, FibClient4>::iterator iter;
 
@@ -68,7 +76,7 @@ XrlFibClientManager::add_fib_client4(const string& client_target_name,
     fib_client.set_send_resolves(send_resolves);
 
     // Activate the client
-    list<Fte4> fte_list;
+    Fte4Batch fte_list;
     if (_fibconfig.get_table4(fte_list) != XORP_OK) {
 	static const string error_msg("Cannot get the IPv4 FIB");
 	return XrlCmdError::COMMAND_FAILED(error_msg);
@@ -162,6 +170,50 @@ XrlFibClientManager::send_fib_client_resolve_route(const string& target_name,
 	return XORP_ERROR;
 }
 
+int
+XrlFibClientManager::send_fib_client_route_changes(const string& target_name,
+						   const Fte4Batch& fte_list)
+{
+    XrlAtomList changes, networks, nexthops, ifnames, vifnames;
+    XrlAtomList metrics, admin_distances, xorp_routes;
+    Fte4Batch::const_iterator iter;
+    bool success;
+
+    for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
+	const Fte4& fte = *iter;
+	uint32_t change = (fte.is_deleted())? FIB_CLIENT_ROUTE_DELETE
+	    : FIB_CLIENT_ROUTE_ADD;
+
+	changes.append(XrlAtom(change));
+	networks.append(XrlAtom(fte.net()));
+	nexthops.append(XrlAtom(fte.nexthop()));
+	ifnames.append(XrlAtom(fte.ifname()));
+	vifnames.append(XrlAtom(fte.vifname()));
+	metrics.append(XrlAtom(fte.metric()));
+	admin_distances.append(XrlAtom(fte.admin_distance()));
+	xorp_routes.append(XrlAtom(static_cast<uint32_t>(fte.xorp_route())));
+    }
+
+    success = _xrl_fea_fib_client.send_route_changes4(
+	target_name.c_str(),
+	changes,
+	networks,
+	nexthops,
+	ifnames,
+	vifnames,
+	metrics,
+	admin_distances,
+	xorp_routes,
+	callback(this,
+		 &XrlFibClientManager::send_fib_client_route_changes4_cb,
+		 target_name));
+
+    if (success)
+	return XORP_OK;
+    else
+	return XORP_ERROR;
+}
+
 void
 XrlFibClientManager::send_fib_client_add_route4_cb(const XrlError& xrl_error,
 						   string target_name)
@@ -212,9 +264,26 @@ XrlFibClientManager::send_fib_client_resolve_route4_cb(
     fib_client.send_fib_client_route_change_cb(xrl_error);
 }
 
+void
+XrlFibClientManager::send_fib_client_route_changes4_cb(
+    const XrlError& xrl_error,
+    string target_name)
+{
+    map<string, FibClient4>::iterator iter;
+
+    iter = _fib_clients4.find(target_name);
+    if (iter == _fib_clients4.end()) {
+	// The client has probably gone. Silently ignore.
+	return;
+    }
+
+    FibClient4& fib_client = iter->second;
+    fib_client.send_fib_client_route_changes_cb(xrl_error);
+}
+
 template<class F>
 void
-XrlFibClientManager::FibClient<F>::activate(const list<F>& fte_list)
+XrlFibClientManager::FibClient<F>::activate(const vector<F>& fte_list)
 {
     bool queue_was_empty = _inform_fib_client_queue.empty();
 
@@ -222,7 +291,7 @@ XrlFibClientManager::FibClient<F>::activate(const list<F>& fte_list)
 	return;
 
     // Create the queue with the entries to add
-    typename list<F>::const_iterator iter;
+    typename vector<F>::const_iterator iter;
     for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
 	const F& fte = *iter;
 	_inform_fib_client_queue.push_back(fte);
@@ -233,12 +302,21 @@ XrlFibClientManager::FibClient<F>::activate(const list<F>& fte_list)
 	send_fib_client_route_change();
 }
 
+template<class F>
+bool
+XrlFibClientManager::FibClient<F>::is_update(const F& fte) const
+{
+    return (_send_updates && !fte.is_unresolved());
+}
+
 template<class F>
 void
 XrlFibClientManager::FibClient<F>::send_fib_client_route_change()
 {
     int success = XORP_ERROR;
 
+    _inform_fib_client_sent_n = 0;
+
     do {
 	bool ignore_fte = true;
 
@@ -254,13 +332,35 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change()
 	if (_send_resolves && fte.is_unresolved()) {
 	    ignore_fte = false;
 	    success = _xfcm->send_fib_client_resolve_route(_target_name, fte);
+	    _inform_fib_client_sent_n = 1;
 	}
 
 	//
 	// If FIB updates were requested by the client, then send notification
-	// of a route being added or deleted.
+	// of the routes being added or deleted.  If the client supports it,
+	// all updates at the front of the queue are sent in one XRL, skipping
+	// the entries which would be ignored anyway.
 	//
-	if (_send_updates && !fte.is_unresolved()) {
+	if (is_update(fte) && _is_batch_supported) {
+	    vector<F> fte_list;
+	    typename deque<F>::const_iterator iter;
+
+	    ignore_fte = false;
+	    for (iter = _inform_fib_client_queue.begin();
+		 iter != _inform_fib_client_queue.end();
+		 ++iter) {
+		if (is_update(*iter)) {
+		    if (fte_list.size() >= FIB_CLIENT_ROUTE_CHANGES_MAX)
+			break;
+		    fte_list.push_back(*iter);
+		} else if (_send_resolves) {
+		    break;
+		}
+		_inform_fib_client_sent_n++;
+	    }
+	    success = _xfcm->send_fib_client_route_changes(_target_name,
+							   fte_list);
+	} else if (is_update(fte)) {
 	    ignore_fte = false;
 	    if (!fte.is_deleted()) {
 		// Send notification of a route being added
@@ -270,6 +370,7 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change()
 		success = _xfcm->send_fib_client_delete_route(_target_name,
 							     fte);
 	    }
+	    _inform_fib_client_sent_n = 1;
 	}
 
 	if (ignore_fte) {
@@ -289,12 +390,25 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change()
 	// If an error, then start a timer to try again
 	// TODO: XXX: the timer value is hardcoded here!!
 	//
+	_inform_fib_client_sent_n = 0;
 	_inform_fib_client_queue_timer = eventloop().new_oneoff_after(
 	    TimeVal(1, 0),
 	    callback(this, &XrlFibClientManager::FibClient<F>::send_fib_client_route_change));
     }
 }
 
+template<class F>
+void
+XrlFibClientManager::FibClient<F>::pop_sent_route_changes()
+{
+    while (_inform_fib_client_sent_n > 0
+	   && !_inform_fib_client_queue.empty()) {
+	_inform_fib_client_queue.pop_front();
+	_inform_fib_client_sent_n--;
+    }
+    _inform_fib_client_sent_n = 0;
+}
+
 template<class F>
 void
 XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
@@ -302,7 +416,7 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
 {
     // If success, then send the next route change
     if (xrl_error == XrlError::OKAY()) {
-	_inform_fib_client_queue.pop_front();
+	pop_sent_route_changes();
 	send_fib_client_route_change();
 	return;
     }
@@ -314,7 +428,7 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
     if (xrl_error == XrlError::COMMAND_FAILED()) {
 	XLOG_ERROR("Error sending route change to %s: %s",
 		   _target_name.c_str(), xrl_error.str().c_str());
-	_inform_fib_client_queue.pop_front();
+	pop_sent_route_changes();
 	send_fib_client_route_change();
 	return;
     }
@@ -331,6 +445,29 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
 	callback(this, &XrlFibClientManager::FibClient<F>::send_fib_client_route_change));
 }
 
+template<class F>
+void
+XrlFibClientManager::FibClient<F>::send_fib_client_route_changes_cb(
+    const XrlError& xrl_error)
+{
+    //
+    // If the client does not implement the route_changes XRL, then
+    // fall back to sending the route changes one by one.
+    //
+    if ((xrl_error == XrlError::NO_SUCH_METHOD())
+	|| (xrl_error == XrlError::RESOLVE_FAILED())) {
+	XLOG_INFO("FIB client %s does not accept batched route changes: %s. "
+		  "Sending route changes one by one.",
+		  _target_name.c_str(), xrl_error.str().c_str());
+	_is_batch_supported = false;
+	_inform_fib_client_sent_n = 0;
+	send_fib_client_route_change();
+	return;
+    }
+
+    send_fib_client_route_change_cb(xrl_error);
+}
+
 template class XrlFibClientManager::FibClient<Fte4>;
 
 
@@ -344,7 +481,7 @@ template class XrlFibClientManager::FibClient<Fte4>;
  * @param fte_list the list of Fte entries to add or delete.
  */
 void
-XrlFibClientManager::process_fib_changes(const list<Fte6>& fte_list)
+XrlFibClientManager::process_fib_changes(const Fte6Batch& fte_list)
 {
     map<string, FibClient6>::iterator iter;
 
@@ -375,7 +512,7 @@ XrlFibClientManager::add_fib_client6(const string& client_target_name,
     fib_client.set_send_resolves(send_resolves);
 
     // Activate the client
-    list<Fte6> fte_list;
+    Fte6Batch fte_list;
     if (_fibconfig.get_table6(fte_list) != XORP_OK) {
 	string error_msg = "Cannot get the IPv6 FIB";
 	return XrlCmdError::COMMAND_FAILED(error_msg);
@@ -472,6 +609,50 @@ XrlFibClientManager::send_fib_client_resolve_route(const string& target_name,
 }
 
 
+int
+XrlFibClientManager::send_fib_client_route_changes(const string& target_name,
+						   const Fte6Batch& fte_list)
+{
+    XrlAtomList changes, networks, nexthops, ifnames, vifnames;
+    XrlAtomList metrics, admin_distances, xorp_routes;
+    Fte6Batch::const_iterator iter;
+    bool success;
+
+    for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) {
+	const Fte6& fte = *iter;
+	uint32_t change = (fte.is_deleted())? FIB_CLIENT_ROUTE_DELETE
+	    : FIB_CLIENT_ROUTE_ADD;
+
+	changes.append(XrlAtom(change));
+	networks.append(XrlAtom(fte.net()));
+	nexthops.append(XrlAtom(fte.nexthop()));
+	ifnames.append(XrlAtom(fte.ifname()));
+	vifnames.append(XrlAtom(fte.vifname()));
+	metrics.append(XrlAtom(fte.metric()));
+	admin_distances.append(XrlAtom(fte.admin_distance()));
+	xorp_routes.append(XrlAtom(static_cast<uint32_t>(fte.xorp_route())));
+    }
+
+    success = _xrl_fea_fib_client.send_route_changes6(
+	target_name.c_str(),
+	changes,
+	networks,
+	nexthops,
+	ifnames,
+	vifnames,
+	metrics,
+	admin_distances,
+	xorp_routes,
+	callback(this,
+		 &XrlFibClientManager::send_fib_client_route_changes6_cb,
+		 target_name));
+
+    if (success)
+	return XORP_OK;
+    else
+	return XORP_ERROR;
+}
+
 void
 XrlFibClientManager::send_fib_client_add_route6_cb(const XrlError& xrl_error,
 						   string target_name)
@@ -524,6 +705,23 @@ XrlFibClientManager::send_fib_client_resolve_route6_cb(
     fib_client.send_fib_client_route_change_cb(xrl_error);
 }
 
+void
+XrlFibClientManager::send_fib_client_route_changes6_cb(
+    const XrlError& xrl_error,
+    string target_name)
+{
+    map<string, FibClient6>::iterator iter;
+
+    iter = _fib_clients6.find(target_name);
+    if (iter == _fib_clients6.end()) {
+	// The client has probably gone. Silently ignore.
+	return;
+    }
+
+    FibClient6& fib_client = iter->second;
+    fib_client.send_fib_client_route_changes_cb(xrl_error);
+}
+
 template class XrlFibClientManager::FibClient<Fte6>;
 
 #endif
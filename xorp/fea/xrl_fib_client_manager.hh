@@ -21,6 +21,8 @@
 #ifndef __FEA_XRL_FIB_CLIENT_MANAGER_HH__
 #define __FEA_XRL_FIB_CLIENT_MANAGER_HH__
 
+#include <deque>
+
 #include "libxipc/xrl_router.hh"
 
 #include "xrl/interfaces/fea_fib_client_xif.hh"
@@ -64,7 +66,7 @@ public:
      * 
      * @param fte_list the list of Fte entries to add or delete.
      */
-    void process_fib_changes(const list<Fte4>& fte_list);
+    void process_fib_changes(const Fte4Batch& fte_list);
 
     /**
      * Add an IPv4 FIB client.
@@ -119,6 +121,17 @@ public:
     int send_fib_client_resolve_route(const string& target_name,
 				     const Fte4& fte);
 
+    /**
+     * Send an XRL to a FIB client to add or delete several IPv4 routes.
+     *
+     * @param target_name the target name of the FIB client.
+     * @param fte_list the Fte entries with the routes to add or delete.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     * @see Fte4.
+     */
+    int send_fib_client_route_changes(const string& target_name,
+				      const Fte4Batch& fte_list);
+
 
 #ifdef HAVE_IPV6
 
@@ -129,7 +142,7 @@ public:
      * 
      * @param fte_list the list of Fte entries to add or delete.
      */
-    void process_fib_changes(const list<Fte6>& fte_list);
+    void process_fib_changes(const Fte6Batch& fte_list);
 
     /**
      * Add an IPv6 FIB client.
@@ -185,6 +198,17 @@ public:
     int send_fib_client_resolve_route(const string& target_name,
 				     const Fte6& fte);
 
+    /**
+     * Send an XRL to a FIB client to add or delete several IPv6 routes.
+     *
+     * @param target_name the target name of the FIB client.
+     * @param fte_list the Fte entries with the routes to add or delete.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     * @see Fte6.
+     */
+    int send_fib_client_route_changes(const string& target_name,
+				      const Fte6Batch& fte_list);
+
 #endif
 
 protected:
@@ -198,6 +222,8 @@ private:
 					  string target_name);
     void send_fib_client_resolve_route4_cb(const XrlError& xrl_error,
 					  string target_name);
+    void send_fib_client_route_changes4_cb(const XrlError& xrl_error,
+					   string target_name);
 #ifdef HAVE_IPV6
     void send_fib_client_delete_route6_cb(const XrlError& xrl_error,
 					  string target_name);
@@ -205,6 +231,8 @@ private:
 				       string target_name);
     void send_fib_client_resolve_route6_cb(const XrlError& xrl_error,
 					  string target_name);
+    void send_fib_client_route_changes6_cb(const XrlError& xrl_error,
+					   string target_name);
 #endif
 
     /**
@@ -214,14 +242,20 @@ private:
     class FibClient {
     public:
 	FibClient(const string& target_name, XrlFibClientManager& xfcm)
-	    : _target_name(target_name), _xfcm(&xfcm),
-	      _send_updates(false), _send_resolves(false) {}
-
-	FibClient() { _xfcm = NULL; }
+	    : _inform_fib_client_sent_n(0), _target_name(target_name),
+	      _xfcm(&xfcm), _send_updates(false), _send_resolves(false),
+	      _is_batch_supported(true) {}
+
+	FibClient()
+	    : _inform_fib_client_sent_n(0), _xfcm(NULL),
+	      _send_updates(false), _send_resolves(false),
+	      _is_batch_supported(true) {}
 	FibClient& operator=(const FibClient& rhs) {
 	    if (this != &rhs) {
 		_inform_fib_client_queue = rhs._inform_fib_client_queue;
 		_inform_fib_client_queue_timer = rhs._inform_fib_client_queue_timer;
+		_inform_fib_client_sent_n = rhs._inform_fib_client_sent_n;
+		_is_batch_supported = rhs._is_batch_supported;
 		_target_name = rhs._target_name;
 		_send_updates = rhs._send_updates;
 		_send_resolves = rhs._send_resolves;
@@ -229,8 +263,9 @@ private:
 	    return *this;
 	}
 
-	void	activate(const list<F>& fte_list);
+	void	activate(const vector<F>& fte_list);
 	void	send_fib_client_route_change_cb(const XrlError& xrl_error);
+	void	send_fib_client_route_changes_cb(const XrlError& xrl_error);
 
 	bool get_send_updates() const { return _send_updates; }
 	bool get_send_resolves() const { return _send_resolves; }
@@ -240,15 +275,19 @@ private:
     private:
 	EventLoop& eventloop() { return _xfcm->eventloop(); }
 	void	send_fib_client_route_change();
+	bool	is_update(const F& fte) const;
+	void	pop_sent_route_changes();
 
-	list<F>			_inform_fib_client_queue;
+	deque<F>		_inform_fib_client_queue;
 	XorpTimer		_inform_fib_client_queue_timer;
+	size_t			_inform_fib_client_sent_n; // Entries in flight
 
 	string			_target_name;	// Target name of the client
 	XrlFibClientManager*	_xfcm;
 
 	bool			_send_updates;	// Event filters
 	bool			_send_resolves;
+	bool			_is_batch_supported; // Client has route_changes
     };
 
     typedef FibClient<Fte4>	FibClient4;
@@ -34,6 +34,17 @@
 
 #include "xrl_io_ip_manager.hh"
 
+//
+// The maximum number of packets queued for a receiver.  Packets arriving
+// when the queue is full are dropped.
+//
+static const size_t PACKET_QUEUE_MAX = 1024;
+
+//
+// The maximum number of packets sent by a single recv_batch XRL.
+//
+static const size_t PACKET_BATCH_MAX = 64;
+
 XrlIoIpManager::XrlIoIpManager(IoIpManager&	io_ip_manager,
 			       XrlRouter&	xrl_router)
     : IoIpManagerReceiver(),
@@ -53,13 +64,91 @@ XrlIoIpManager::recv_event(const string& receiver_name,
 			   const struct IPvXHeaderInfo& header,
 			   const vector<uint8_t>& payload)
 {
+    XLOG_ASSERT(header.ext_headers_type.size()
+		== header.ext_headers_payload.size());
+
+    PacketQueue& queue = _packet_queues[receiver_name];
+
+    if (queue.packets.size() >= PACKET_QUEUE_MAX) {
+	// XXX: the receiver can't keep up
+	queue.dropped_n++;
+	return;
+    }
+    queue.packets.push_back(make_pair(header, payload));
+
+    if (queue.sent_n == 0)
+	send_packets(receiver_name);
+}
+
+void
+XrlIoIpManager::send_packets(const string& receiver_name)
+{
+    map<string, PacketQueue>::iterator iter;
+
+    iter = _packet_queues.find(receiver_name);
+    if (iter == _packet_queues.end())
+	return;
+
+    PacketQueue& queue = iter->second;
+    if (queue.packets.empty()) {
+	_packet_queues.erase(iter);
+	return;
+    }
+
+    if (queue.dropped_n > 0) {
+	XLOG_WARNING("Dropped %u packets for receiver %s: "
+		     "the receiver is too slow",
+		     XORP_UINT_CAST(queue.dropped_n), receiver_name.c_str());
+	queue.dropped_n = 0;
+    }
+
+    //
+    // Send the packets of the same address family at the front of
+    // the queue.
+    //
+    int family = queue.packets.front().first.src_address.af();
+    size_t n = 1;
+
+    if (queue.is_batch_supported) {
+	while ((n < queue.packets.size()) && (n < PACKET_BATCH_MAX)
+	       && (queue.packets[n].first.src_address.af() == family)) {
+	    n++;
+	}
+    }
+
+    bool success;
+    queue.sent_n = n;
+    if (n == 1) {
+	success = send_packet(receiver_name, queue.packets.front().first,
+			      queue.packets.front().second);
+    } else {
+	success = send_packet_batch(receiver_name, queue, n);
+    }
+    if (success)
+	return;
+
+    //
+    // The XRL could not be sent and its callback won't be invoked.
+    // Treat it as an XRL error: remove all filters associated with this
+    // receiver.
+    //
+    XLOG_ERROR("Cannot send %u packets to receiver %s",
+	       XORP_UINT_CAST(n), receiver_name.c_str());
+    _packet_queues.erase(iter);
+    _io_ip_manager.instance_death(receiver_name);
+}
+
+bool
+XrlIoIpManager::send_packet(const string& receiver_name,
+			    const IPvXHeaderInfo& header,
+			    const vector<uint8_t>& payload)
+{
+    bool success = false;
     size_t i;
 
     //
     // Create the extention headers info
     //
-    XLOG_ASSERT(header.ext_headers_type.size()
-		== header.ext_headers_payload.size());
     XrlAtomList ext_headers_type_list, ext_headers_payload_list;
     for (i = 0; i < header.ext_headers_type.size(); i++) {
 	ext_headers_type_list.append(XrlAtom(static_cast<uint32_t>(header.ext_headers_type[i])));
@@ -75,20 +164,20 @@ XrlIoIpManager::recv_event(const string& receiver_name,
 	//
 	// Send notification
 	//
-	cl.send_recv(receiver_name.c_str(),
-		     header.if_name,
-		     header.vif_name,
-		     header.src_address.get_ipv4(),
-		     header.dst_address.get_ipv4(),
-		     header.ip_protocol,
-		     header.ip_ttl,
-		     header.ip_tos,
-		     header.ip_router_alert,
-		     header.ip_internet_control,
-		     payload,
-		     callback(this,
-			      &XrlIoIpManager::xrl_send_recv_cb,
-			      header.src_address.af(), receiver_name));
+	success = cl.send_recv(receiver_name.c_str(),
+			       header.if_name,
+			       header.vif_name,
+			       header.src_address.get_ipv4(),
+			       header.dst_address.get_ipv4(),
+			       header.ip_protocol,
+			       header.ip_ttl,
+			       header.ip_tos,
+			       header.ip_router_alert,
+			       header.ip_internet_control,
+			       payload,
+			       callback(this,
+					&XrlIoIpManager::xrl_send_recv_cb,
+					header.src_address.af(), receiver_name));
     }
 
 #ifdef HAVE_IPV6
@@ -101,24 +190,113 @@ XrlIoIpManager::recv_event(const string& receiver_name,
 	//
 	// Send notification
 	//
-	cl.send_recv(receiver_name.c_str(),
-		     header.if_name,
-		     header.vif_name,
-		     header.src_address.get_ipv6(),
-		     header.dst_address.get_ipv6(),
-		     header.ip_protocol,
-		     header.ip_ttl,
-		     header.ip_tos,
-		     header.ip_router_alert,
-		     header.ip_internet_control,
-		     ext_headers_type_list,
-		     ext_headers_payload_list,
-		     payload,
-		     callback(this,
-			      &XrlIoIpManager::xrl_send_recv_cb,
-			      header.src_address.af(), receiver_name));
+	success = cl.send_recv(receiver_name.c_str(),
+			       header.if_name,
+			       header.vif_name,
+			       header.src_address.get_ipv6(),
+			       header.dst_address.get_ipv6(),
+			       header.ip_protocol,
+			       header.ip_ttl,
+			       header.ip_tos,
+			       header.ip_router_alert,
+			       header.ip_internet_control,
+			       ext_headers_type_list,
+			       ext_headers_payload_list,
+			       payload,
+			       callback(this,
+					&XrlIoIpManager::xrl_send_recv_cb,
+					header.src_address.af(), receiver_name));
     }
 #endif
+
+    return (success);
+}
+
+bool
+XrlIoIpManager::send_packet_batch(const string& receiver_name,
+				  const PacketQueue& queue, size_t n)
+{
+    bool success = false;
+    XrlAtomList if_names, vif_names, src_addresses, dst_addresses;
+    XrlAtomList ip_protocols, ip_ttls, ip_toses;
+    XrlAtomList ip_router_alerts, ip_internet_controls, payloads;
+    XrlAtomList ext_headers_counts, ext_headers_type, ext_headers_payload;
+    int family = queue.packets.front().first.src_address.af();
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+	const IPvXHeaderInfo& header = queue.packets[i].first;
+
+	if_names.append(XrlAtom(header.if_name));
+	vif_names.append(XrlAtom(header.vif_name));
+	ip_protocols.append(XrlAtom(static_cast<uint32_t>(header.ip_protocol)));
+	ip_ttls.append(XrlAtom(header.ip_ttl));
+	ip_toses.append(XrlAtom(header.ip_tos));
+	ip_router_alerts.append(XrlAtom(header.ip_router_alert));
+	ip_internet_controls.append(XrlAtom(header.ip_internet_control));
+	payloads.append(XrlAtom(queue.packets[i].second));
+
+	if (family == AF_INET) {
+	    src_addresses.append(XrlAtom(header.src_address.get_ipv4()));
+	    dst_addresses.append(XrlAtom(header.dst_address.get_ipv4()));
+	    continue;
+	}
+
+#ifdef HAVE_IPV6
+	src_addresses.append(XrlAtom(header.src_address.get_ipv6()));
+	dst_addresses.append(XrlAtom(header.dst_address.get_ipv6()));
+	ext_headers_counts.append(XrlAtom(static_cast<uint32_t>(header.ext_headers_type.size())));
+	for (size_t j = 0; j < header.ext_headers_type.size(); j++) {
+	    ext_headers_type.append(XrlAtom(static_cast<uint32_t>(header.ext_headers_type[j])));
+	    ext_headers_payload.append(XrlAtom(header.ext_headers_payload[j]));
+	}
+#endif
+    }
+
+    if (family == AF_INET) {
+	XrlRawPacket4ClientV0p1Client cl(&xrl_router());
+
+	success = cl.send_recv_batch(receiver_name.c_str(),
+				     if_names,
+				     vif_names,
+				     src_addresses,
+				     dst_addresses,
+				     ip_protocols,
+				     ip_ttls,
+				     ip_toses,
+				     ip_router_alerts,
+				     ip_internet_controls,
+				     payloads,
+				     callback(this,
+					      &XrlIoIpManager::xrl_send_recv_cb,
+					      family, receiver_name));
+    }
+
+#ifdef HAVE_IPV6
+    if (family == AF_INET6) {
+	XrlRawPacket6ClientV0p1Client cl(&xrl_router());
+
+	success = cl.send_recv_batch(receiver_name.c_str(),
+				     if_names,
+				     vif_names,
+				     src_addresses,
+				     dst_addresses,
+				     ip_protocols,
+				     ip_ttls,
+				     ip_toses,
+				     ip_router_alerts,
+				     ip_internet_controls,
+				     ext_headers_counts,
+				     ext_headers_type,
+				     ext_headers_payload,
+				     payloads,
+				     callback(this,
+					      &XrlIoIpManager::xrl_send_recv_cb,
+					      family, receiver_name));
+    }
+#endif
+
+    return (success);
 }
 
 void
@@ -127,8 +305,29 @@ XrlIoIpManager::xrl_send_recv_cb(const XrlError& xrl_error, int family,
 {
     UNUSED(family);
 
-    if (xrl_error == XrlError::OKAY())
+    map<string, PacketQueue>::iterator iter;
+
+    iter = _packet_queues.find(receiver_name);
+    if (iter == _packet_queues.end())
+	return;			// XXX: the receiver is gone
+
+    PacketQueue& queue = iter->second;
+    size_t sent_n = queue.sent_n;
+    queue.sent_n = 0;
+
+    if (xrl_error == XrlError::OKAY()) {
+	for ( ; (sent_n > 0) && (! queue.packets.empty()); sent_n--)
+	    queue.packets.pop_front();
+	send_packets(receiver_name);
 	return;
+    }
+
+    if ((sent_n > 1) && (xrl_error == XrlError::NO_SUCH_METHOD())) {
+	// An older receiver: send the packets one by one
+	queue.is_batch_supported = false;
+	send_packets(receiver_name);
+	return;
+    }
 
     debug_msg("xrl_send_recv_cb: error %s\n", xrl_error.str().c_str());
 
@@ -137,5 +336,6 @@ XrlIoIpManager::xrl_send_recv_cb(const XrlError& xrl_error, int family,
     //
     // Remove all filters associated with this receiver.
     //
+    _packet_queues.erase(iter);
     _io_ip_manager.instance_death(receiver_name);
 }
@@ -56,8 +56,49 @@ public:
 		    const vector<uint8_t>&		payload);
 
 private:
+    /**
+     * The packets waiting to be sent to a receiver.  At most one XRL is
+     * in flight per receiver, and the packets which arrive meanwhile are
+     * sent together by the next one.
+     */
+    struct PacketQueue {
+	PacketQueue() : sent_n(0), is_batch_supported(true), dropped_n(0) {}
+
+	deque<pair<IPvXHeaderInfo, vector<uint8_t> > > packets;
+	size_t		sent_n;		// Packets in flight; 0 if idle
+	bool		is_batch_supported;
+	uint32_t	dropped_n;	// Packets dropped since last logged
+    };
+
     XrlRouter&		xrl_router() { return _xrl_router; }
 
+    /**
+     * Send the packets at the front of a receiver queue.
+     *
+     * @param receiver_name the name of the receiver.
+     */
+    void send_packets(const string& receiver_name);
+
+    /**
+     * Send one packet with the recv XRL.
+     *
+     * @return true if the XRL was sent, otherwise false.
+     */
+    bool send_packet(const string& receiver_name,
+		     const IPvXHeaderInfo& header,
+		     const vector<uint8_t>& payload);
+
+    /**
+     * Send the first packets of a queue with the recv_batch XRL.
+     *
+     * @param receiver_name the name of the receiver.
+     * @param queue the receiver queue.
+     * @param n the number of packets to send.
+     * @return true if the XRL was sent, otherwise false.
+     */
+    bool send_packet_batch(const string& receiver_name,
+			   const PacketQueue& queue, size_t n);
+
     /**
      * Method to be called by XRL sending filter invoker
      */
@@ -66,6 +107,7 @@ private:
 
     IoIpManager&	_io_ip_manager;
     XrlRouter&		_xrl_router;
+    map<string, PacketQueue> _packet_queues;	// Key: receiver name
 };
 
 #endif // __FEA_XRL_IO_IP_MANAGER_HH__
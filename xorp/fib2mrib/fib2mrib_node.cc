@@ -654,6 +654,45 @@ Fib2mribNode::delete_route6(const IPv6Net& network, const string& ifname,
     return (delete_route(fib2mrib_route, error_msg));
 }
 
+/**
+ * Apply several route changes at once.
+ *
+ * @param fib2mrib_routes the routes, each marked as a route to add,
+ * replace or delete.
+ * @param error_msg the error messages of the changes which failed.
+ * @return XORP_OK if all changes were applied, otherwise XORP_ERROR.
+ */
+int
+Fib2mribNode::route_changes(const list<Fib2mribRoute>& fib2mrib_routes,
+			    string& error_msg)
+{
+    list<Fib2mribRoute>::const_iterator iter;
+    int ret_value = XORP_OK;
+
+    for (iter = fib2mrib_routes.begin(); iter != fib2mrib_routes.end();
+	 ++iter) {
+	const Fib2mribRoute& fib2mrib_route = *iter;
+	string route_error_msg;
+	int ret = XORP_ERROR;
+
+	if (fib2mrib_route.is_add_route())
+	    ret = add_route(fib2mrib_route, route_error_msg);
+	else if (fib2mrib_route.is_replace_route())
+	    ret = replace_route(fib2mrib_route, route_error_msg);
+	else if (fib2mrib_route.is_delete_route())
+	    ret = delete_route(fib2mrib_route, route_error_msg);
+
+	if (ret != XORP_OK) {
+	    if (! error_msg.empty())
+		error_msg += "; ";
+	    error_msg += route_error_msg;
+	    ret_value = XORP_ERROR;
+	}
+    }
+
+    return (ret_value);
+}
+
 /**
  * Add an IPvX route.
  *
@@ -968,6 +1007,11 @@ Fib2mribNode::reset_filter(const uint32_t& filter) {
     _policy_filters.reset(filter);
 }
 
+string
+Fib2mribNode::filter_statistics(const uint32_t& filter) {
+    return _policy_filters.statistics(filter);
+}
+
 void
 Fib2mribNode::push_routes()
 {
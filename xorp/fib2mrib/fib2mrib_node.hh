@@ -557,6 +557,20 @@ public:
     int delete_route6(const IPv6Net& network, const string& ifname,
 		      const string& vifname, string& error_msg);
 
+    /**
+     * Apply several route changes at once.
+     *
+     * The changes are applied in order, and a change which fails does
+     * not prevent the following ones from being applied.
+     *
+     * @param fib2mrib_routes the routes, each marked as a route to add,
+     * replace or delete.
+     * @param error_msg the error messages of the changes which failed.
+     * @return XORP_OK if all changes were applied, otherwise XORP_ERROR.
+     */
+    int route_changes(const list<Fib2mribRoute>& fib2mrib_routes,
+		      string& error_msg);
+
     //
     // Debug-related methods
     //
@@ -598,6 +612,14 @@ public:
      */
     void reset_filter(const uint32_t& filter);
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter identifier of filter to report on.
+     * @return human readable statistics of the filter.
+     */
+    string filter_statistics(const uint32_t& filter);
+
     /**
      * Push all the routes through the policy filters for re-filtering.
      */
@@ -27,11 +27,82 @@
 #include "libxorp/ipvx.hh"
 #include "libxorp/status_codes.h"
 
+#include "xrl/interfaces/fea_fib_client_route_changes.hh"
+
 #include "fib2mrib_node.hh"
 #include "xrl_fib2mrib_node.hh"
 
 const TimeVal XrlFib2mribNode::RETRY_TIMEVAL = TimeVal(1, 0);
 
+/**
+ * Check the lists of a route_changes XRL, apart from the type of the
+ * networks and the next-hops.
+ *
+ * @param n the number of route changes.
+ * @param error_msg the error message (if error).
+ * @return XORP_OK if the lists are consistent, otherwise XORP_ERROR.
+ */
+static int
+check_route_changes(const XrlAtomList& changes, const XrlAtomList& networks,
+		    const XrlAtomList& nexthops, const XrlAtomList& ifnames,
+		    const XrlAtomList& vifnames, const XrlAtomList& metrics,
+		    const XrlAtomList& admin_distances,
+		    const XrlAtomList& xorp_routes, size_t& n,
+		    string& error_msg)
+{
+    n = changes.size();
+
+    if ((networks.size() != n) || (nexthops.size() != n)
+	|| (ifnames.size() != n) || (vifnames.size() != n)
+	|| (metrics.size() != n) || (admin_distances.size() != n)
+	|| (xorp_routes.size() != n)) {
+	error_msg = c_format("Route changes mismatch: %u change(s) "
+			     "but the lists have different sizes",
+			     XORP_UINT_CAST(n));
+	return (XORP_ERROR);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+	if ((changes.get(i).type() != xrlatom_uint32)
+	    || (ifnames.get(i).type() != xrlatom_text)
+	    || (vifnames.get(i).type() != xrlatom_text)
+	    || (metrics.get(i).type() != xrlatom_uint32)
+	    || (admin_distances.get(i).type() != xrlatom_uint32)
+	    || (xorp_routes.get(i).type() != xrlatom_uint32)) {
+	    error_msg = c_format("Route change %u has an element of "
+				 "the wrong type", XORP_UINT_CAST(i));
+	    return (XORP_ERROR);
+	}
+	if (changes.get(i).uint32() > FIB_CLIENT_ROUTE_DELETE) {
+	    error_msg = c_format("Route change %u has invalid type %u",
+				 XORP_UINT_CAST(i),
+				 XORP_UINT_CAST(changes.get(i).uint32()));
+	    return (XORP_ERROR);
+	}
+    }
+
+    return (XORP_OK);
+}
+
+/**
+ * Set the type of a route from the code of a route_changes XRL.
+ */
+static void
+set_route_change(Fib2mribRoute& fib2mrib_route, uint32_t change)
+{
+    switch (change) {
+    case FIB_CLIENT_ROUTE_ADD:
+	fib2mrib_route.set_add_route();
+	break;
+    case FIB_CLIENT_ROUTE_REPLACE:
+	fib2mrib_route.set_replace_route();
+	break;
+    case FIB_CLIENT_ROUTE_DELETE:
+	fib2mrib_route.set_delete_route();
+	break;
+    }
+}
+
 XrlFib2mribNode::XrlFib2mribNode(EventLoop&	eventloop,
 				 const string&	class_name,
 				 const string&	finder_hostname,
@@ -1458,6 +1529,64 @@ XrlFib2mribNode::fea_fib_client_0_1_resolve_route4(
     return XrlCmdError::OKAY();
 }
 
+/**
+ *  Notification of several route changes at once.
+ *
+ *  The whole batch is checked before any of it is applied, so a
+ *  malformed batch changes nothing.
+ */
+XrlCmdError
+XrlFib2mribNode::fea_fib_client_0_1_route_changes4(
+    // Input values,
+    const XrlAtomList&	changes,
+    const XrlAtomList&	networks,
+    const XrlAtomList&	nexthops,
+    const XrlAtomList&	ifnames,
+    const XrlAtomList&	vifnames,
+    const XrlAtomList&	metrics,
+    const XrlAtomList&	admin_distances,
+    const XrlAtomList&	xorp_routes)
+{
+    list<Fib2mribRoute> fib2mrib_routes;
+    string error_msg;
+    size_t n;
+
+    if (check_route_changes(changes, networks, nexthops, ifnames, vifnames,
+			    metrics, admin_distances, xorp_routes, n,
+			    error_msg) != XORP_OK) {
+	return XrlCmdError::BAD_ARGS(error_msg);
+    }
+
+    debug_msg("fea_fib_client_0_1_route_changes4(): %u change(s)\n",
+	      XORP_UINT_CAST(n));
+
+    for (size_t i = 0; i < n; i++) {
+	if ((networks.get(i).type() != xrlatom_ipv4net)
+	    || (nexthops.get(i).type() != xrlatom_ipv4)) {
+	    error_msg = c_format("Route change %u is not an IPv4 route",
+				 XORP_UINT_CAST(i));
+	    return XrlCmdError::BAD_ARGS(error_msg);
+	}
+
+	Fib2mribRoute fib2mrib_route(networks.get(i).ipv4net(),
+				     nexthops.get(i).ipv4(),
+				     ifnames.get(i).text(),
+				     vifnames.get(i).text(),
+				     metrics.get(i).uint32(),
+				     admin_distances.get(i).uint32(),
+				     "NOT_SUPPORTED",
+				     xorp_routes.get(i).uint32() != 0);
+	set_route_change(fib2mrib_route, changes.get(i).uint32());
+	fib2mrib_routes.push_back(fib2mrib_route);
+    }
+
+    if (Fib2mribNode::route_changes(fib2mrib_routes, error_msg) != XORP_OK) {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 /**
  *  Enable/disable/start/stop Fib2mrib.
  *
@@ -1871,6 +2000,20 @@ XrlFib2mribNode::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlFib2mribNode::policy_backend_0_1_get_statistics(const uint32_t& filter,
+                                                   string& statistics)
+{
+    try {
+	statistics = Fib2mribNode::filter_statistics(filter);
+    } catch(const PolicyException& e) {
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 
 /** IPv6 stuff */
 
@@ -1983,6 +2126,64 @@ XrlFib2mribNode::fea_fib_client_0_1_resolve_route6(
     return XrlCmdError::OKAY();
 }
 
+/**
+ *  Notification of several route changes at once.
+ *
+ *  The whole batch is checked before any of it is applied, so a
+ *  malformed batch changes nothing.
+ */
+XrlCmdError
+XrlFib2mribNode::fea_fib_client_0_1_route_changes6(
+    // Input values,
+    const XrlAtomList&	changes,
+    const XrlAtomList&	networks,
+    const XrlAtomList&	nexthops,
+    const XrlAtomList&	ifnames,
+    const XrlAtomList&	vifnames,
+    const XrlAtomList&	metrics,
+    const XrlAtomList&	admin_distances,
+    const XrlAtomList&	xorp_routes)
+{
+    list<Fib2mribRoute> fib2mrib_routes;
+    string error_msg;
+    size_t n;
+
+    if (check_route_changes(changes, networks, nexthops, ifnames, vifnames,
+			    metrics, admin_distances, xorp_routes, n,
+			    error_msg) != XORP_OK) {
+	return XrlCmdError::BAD_ARGS(error_msg);
+    }
+
+    debug_msg("fea_fib_client_0_1_route_changes6(): %u change(s)\n",
+	      XORP_UINT_CAST(n));
+
+    for (size_t i = 0; i < n; i++) {
+	if ((networks.get(i).type() != xrlatom_ipv6net)
+	    || (nexthops.get(i).type() != xrlatom_ipv6)) {
+	    error_msg = c_format("Route change %u is not an IPv6 route",
+				 XORP_UINT_CAST(i));
+	    return XrlCmdError::BAD_ARGS(error_msg);
+	}
+
+	Fib2mribRoute fib2mrib_route(networks.get(i).ipv6net(),
+				     nexthops.get(i).ipv6(),
+				     ifnames.get(i).text(),
+				     vifnames.get(i).text(),
+				     metrics.get(i).uint32(),
+				     admin_distances.get(i).uint32(),
+				     "NOT_SUPPORTED",
+				     xorp_routes.get(i).uint32() != 0);
+	set_route_change(fib2mrib_route, changes.get(i).uint32());
+	fib2mrib_routes.push_back(fib2mrib_route);
+    }
+
+    if (Fib2mribNode::route_changes(fib2mrib_routes, error_msg) != XORP_OK) {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 void
 XrlFib2mribNode::fea_fti_client_send_have_ipv6_cb(const XrlError& xrl_error,
 						  const bool* result)
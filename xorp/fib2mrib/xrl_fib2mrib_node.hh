@@ -233,6 +233,39 @@ protected:
 	// Input values,
 	const IPv4Net&	network);
 
+    /**
+     *  Notification of several route changes at once.
+     *
+     *  @param changes the type of each change: 0 if the route is added,
+     *  1 if it is replaced, and 2 if it is deleted.
+     *
+     *  @param networks the network address prefix of each route.
+     *
+     *  @param nexthops the next-hop router of each route.
+     *
+     *  @param ifnames the name of the physical interface of each route.
+     *
+     *  @param vifnames the name of the virtual interface of each route.
+     *
+     *  @param metrics the routing metric of each route.
+     *
+     *  @param admin_distances the administratively defined distance of
+     *  each route.
+     *
+     *  @param xorp_routes 1 if the route was installed by XORP,
+     *  otherwise 0.
+     */
+    XrlCmdError fea_fib_client_0_1_route_changes4(
+	// Input values,
+	const XrlAtomList&	changes,
+	const XrlAtomList&	networks,
+	const XrlAtomList&	nexthops,
+	const XrlAtomList&	ifnames,
+	const XrlAtomList&	vifnames,
+	const XrlAtomList&	metrics,
+	const XrlAtomList&	admin_distances,
+	const XrlAtomList&	xorp_routes);
+
     /**
      *  Enable/disable/start/stop Fib2mrib.
      *
@@ -280,6 +313,18 @@ protected:
      */
     XrlCmdError policy_backend_0_1_push_routes();
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter identifier of filter to report on.
+     * @param statistics human readable statistics of the filter.
+     */
+    XrlCmdError policy_backend_0_1_get_statistics(
+        // Input values,
+        const uint32_t& filter,
+        // Output values,
+        string&         statistics);
+
 
 #ifdef HAVE_IPV6
     XrlCmdError fea_fib_client_0_1_add_route6(
@@ -315,6 +360,17 @@ protected:
 	// Input values,
 	const IPv6Net&	network);
 
+    XrlCmdError fea_fib_client_0_1_route_changes6(
+	// Input values,
+	const XrlAtomList&	changes,
+	const XrlAtomList&	networks,
+	const XrlAtomList&	nexthops,
+	const XrlAtomList&	ifnames,
+	const XrlAtomList&	vifnames,
+	const XrlAtomList&	metrics,
+	const XrlAtomList&	admin_distances,
+	const XrlAtomList&	xorp_routes);
+
 #endif
 
 private:
@@ -27,6 +27,7 @@
 #include "ifmgr_atoms.hh"
 #include "ifmgr_cmds.hh"
 #include "ifmgr_cmd_queue.hh"
+#include "ifmgr_snapshot.hh"
 
 // ----------------------------------------------------------------------------
 // IfMgrCommandSinkBase
@@ -227,6 +228,19 @@ IfMgrIfTreeToCommands::convert(IfMgrCommandSinkBase& s) const
     s.push(new IfMgrHintTreeComplete());
 }
 
+void
+IfMgrIfTreeToSnapshot::convert(IfMgrCommandSinkBase& s) const
+{
+    list<IfMgrIfTreeSnapshot::Data> chunks;
+    IfMgrIfTreeSnapshot::encode(_tree, chunks);
+
+    list<IfMgrIfTreeSnapshot::Data>::const_iterator ci;
+    for (ci = chunks.begin(); ci != chunks.end(); ++ci) {
+	s.push(new IfMgrIfTreeSnapshotAdd(*ci));
+    }
+    s.push(new IfMgrHintTreeComplete());
+}
+
 void
 IfMgrIfAtomToCommands::convert(IfMgrCommandSinkBase& s) const
 {
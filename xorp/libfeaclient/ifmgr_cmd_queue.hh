@@ -281,6 +281,35 @@ protected:
     const IfMgrIfTree& _tree;
 };
 
+/**
+ * @short Class to convert an IfMgrIfTree object into a sequence of
+ * snapshot commands.
+ *
+ * The sequence has the same effect as the one produced by @ref
+ * IfMgrIfTreeToCommands, but it holds a few large commands instead of
+ * one command per attribute.
+ */
+class IfMgrIfTreeToSnapshot {
+public:
+    /**
+     * Constructor
+     */
+    IfMgrIfTreeToSnapshot(const IfMgrIfTree& tree)
+	: _tree(tree)
+    {}
+
+    /**
+     * Convert the entire contents of IfMgrIfTree object to a sequence of
+     * snapshot commands, followed by a tree complete hint.
+     *
+     * @param sink output target for commands that would generate tree.
+     */
+    void convert(IfMgrCommandSinkBase& sink) const;
+
+protected:
+    const IfMgrIfTree& _tree;
+};
+
 /**
  * @short Class to convert an IfMgrIfAtom object into a sequence of commands.
  */
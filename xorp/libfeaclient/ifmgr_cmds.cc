@@ -24,6 +24,7 @@
 #include "libxorp/c_format.hh"
 #include "ifmgr_atoms.hh"
 #include "ifmgr_cmds.hh"
+#include "ifmgr_snapshot.hh"
 #include "libxipc/xrl_sender.hh"
 #include "xrl/interfaces/fea_ifmgr_mirror_xif.hh"
 
@@ -1401,6 +1402,32 @@ IfMgrIPv6SetEndpoint::str() const
 }
 #endif
 
+// ----------------------------------------------------------------------------
+// IfMgrIfTreeSnapshotAdd
+
+bool
+IfMgrIfTreeSnapshotAdd::execute(IfMgrIfTree& t) const
+{
+    return IfMgrIfTreeSnapshot::decode(_data, t);
+}
+
+bool
+IfMgrIfTreeSnapshotAdd::forward(XrlSender&		sender,
+				const string&		xrl_target,
+				const IfMgrXrlSendCB&	xcb) const
+{
+    XrlFeaIfmgrMirrorV0p1Client c(&sender);
+    const char* xt = xrl_target.c_str();
+    return c.send_tree_snapshot(xt, _data, xcb);
+}
+
+string
+IfMgrIfTreeSnapshotAdd::str() const
+{
+    return c_format("IfMgrIfTreeSnapshotAdd(%u bytes)",
+		    XORP_UINT_CAST(_data.size()));
+}
+
 
 // ----------------------------------------------------------------------------
 //
@@ -1040,6 +1040,34 @@ protected:
 #endif
 
 
+/**
+ * @short Command to add interfaces from a binary snapshot.
+ *
+ * The snapshot is built by @ref IfMgrIfTreeSnapshot and holds a number
+ * of whole interfaces.  It is used to send the configuration tree to a
+ * new mirror with a few Xrls instead of one Xrl per attribute.
+ */
+class IfMgrIfTreeSnapshotAdd : public IfMgrCommandBase {
+public:
+    IfMgrIfTreeSnapshotAdd(const vector<uint8_t>& data)
+	: _data(data)
+    {}
+
+    const vector<uint8_t>& data() const	{ return _data; }
+
+    bool execute(IfMgrIfTree& tree) const;
+
+    bool forward(XrlSender&		sender,
+		 const string&		xrl_target,
+		 const IfMgrXrlSendCB&	xscb) const;
+
+    string str() const;
+
+protected:
+    vector<uint8_t>	_data;
+};
+
+
 /**
  * @short Base class for configuration events.
  *
@@ -0,0 +1,448 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+#include "libfeaclient_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+
+#include "ifmgr_snapshot.hh"
+
+const uint8_t IfMgrIfTreeSnapshot::VERSION;
+const size_t IfMgrIfTreeSnapshot::DEFAULT_CHUNK_BYTES;
+
+//
+// Flag bits
+//
+enum {
+    IF_ENABLED		= 0x01,
+    IF_DISCARD		= 0x02,
+    IF_UNREACHABLE	= 0x04,
+    IF_MANAGEMENT	= 0x08,
+    IF_NO_CARRIER	= 0x10
+};
+
+enum {
+    VIF_ENABLED		= 0x01,
+    VIF_MULTICAST	= 0x02,
+    VIF_BROADCAST	= 0x04,
+    VIF_P2P		= 0x08,
+    VIF_LOOPBACK	= 0x10,
+    VIF_PIM_REGISTER	= 0x20
+};
+
+enum {
+    ADDR_ENABLED	= 0x01,
+    ADDR_MULTICAST	= 0x02,
+    ADDR_LOOPBACK	= 0x04,
+    ADDR_BROADCAST	= 0x08,
+    ADDR_P2P		= 0x10
+};
+
+// ----------------------------------------------------------------------------
+// Encoding
+
+static void
+put_u8(IfMgrIfTreeSnapshot::Data& d, uint8_t v)
+{
+    d.push_back(v);
+}
+
+static void
+put_u32(IfMgrIfTreeSnapshot::Data& d, uint32_t v)
+{
+    d.push_back((v >> 24) & 0xff);
+    d.push_back((v >> 16) & 0xff);
+    d.push_back((v >> 8) & 0xff);
+    d.push_back(v & 0xff);
+}
+
+static void
+put_u64(IfMgrIfTreeSnapshot::Data& d, uint64_t v)
+{
+    put_u32(d, v >> 32);
+    put_u32(d, v & 0xffffffffU);
+}
+
+static void
+put_string(IfMgrIfTreeSnapshot::Data& d, const string& s)
+{
+    put_u32(d, s.size());
+    d.insert(d.end(), s.begin(), s.end());
+}
+
+template <typename A>
+static void
+put_addr(IfMgrIfTreeSnapshot::Data& d, const A& a)
+{
+    size_t pos = d.size();
+    d.resize(pos + A::addr_bytelen());
+    a.copy_out(&d[pos]);
+}
+
+static void
+encode_ipv4(IfMgrIfTreeSnapshot::Data& d, const IfMgrIPv4Atom& a)
+{
+    uint8_t flags = 0;
+
+    if (a.enabled())
+	flags |= ADDR_ENABLED;
+    if (a.multicast_capable())
+	flags |= ADDR_MULTICAST;
+    if (a.loopback())
+	flags |= ADDR_LOOPBACK;
+    if (a.has_broadcast())
+	flags |= ADDR_BROADCAST;
+    if (a.has_endpoint())
+	flags |= ADDR_P2P;
+
+    put_addr(d, a.addr());
+    put_u8(d, a.prefix_len());
+    put_u8(d, flags);
+    if (a.has_broadcast())
+	put_addr(d, a.broadcast_addr());
+    if (a.has_endpoint())
+	put_addr(d, a.endpoint_addr());
+}
+
+static void
+encode_ipv6(IfMgrIfTreeSnapshot::Data& d, const IfMgrIPv6Atom& a)
+{
+    uint8_t flags = 0;
+
+    if (a.enabled())
+	flags |= ADDR_ENABLED;
+    if (a.multicast_capable())
+	flags |= ADDR_MULTICAST;
+    if (a.loopback())
+	flags |= ADDR_LOOPBACK;
+    if (a.has_endpoint())
+	flags |= ADDR_P2P;
+
+    put_addr(d, a.addr());
+    put_u8(d, a.prefix_len());
+    put_u8(d, flags);
+    if (a.has_endpoint())
+	put_addr(d, a.endpoint_addr());
+}
+
+static void
+encode_vif(IfMgrIfTreeSnapshot::Data& d, const IfMgrVifAtom& v)
+{
+    uint8_t flags = 0;
+
+    if (v.enabled())
+	flags |= VIF_ENABLED;
+    if (v.multicast_capable())
+	flags |= VIF_MULTICAST;
+    if (v.broadcast_capable())
+	flags |= VIF_BROADCAST;
+    if (v.p2p_capable())
+	flags |= VIF_P2P;
+    if (v.loopback())
+	flags |= VIF_LOOPBACK;
+    if (v.pim_register())
+	flags |= VIF_PIM_REGISTER;
+
+    put_string(d, v.name());
+    put_u8(d, flags);
+    put_u32(d, v.pif_index());
+    put_u32(d, v.vif_index());
+
+    put_u32(d, v.ipv4addrs().size());
+    IfMgrVifAtom::IPv4Map::const_iterator a4;
+    for (a4 = v.ipv4addrs().begin(); a4 != v.ipv4addrs().end(); ++a4)
+	encode_ipv4(d, a4->second);
+
+    put_u32(d, v.ipv6addrs().size());
+    IfMgrVifAtom::IPv6Map::const_iterator a6;
+    for (a6 = v.ipv6addrs().begin(); a6 != v.ipv6addrs().end(); ++a6)
+	encode_ipv6(d, a6->second);
+}
+
+static void
+encode_interface(IfMgrIfTreeSnapshot::Data& d, const IfMgrIfAtom& i)
+{
+    uint8_t flags = 0;
+
+    if (i.enabled())
+	flags |= IF_ENABLED;
+    if (i.discard())
+	flags |= IF_DISCARD;
+    if (i.unreachable())
+	flags |= IF_UNREACHABLE;
+    if (i.management())
+	flags |= IF_MANAGEMENT;
+    if (i.no_carrier())
+	flags |= IF_NO_CARRIER;
+
+    put_string(d, i.name());
+    put_u8(d, flags);
+    put_u32(d, i.mtu());
+    put_addr(d, i.mac());
+    put_u32(d, i.pif_index());
+    put_u64(d, i.baudrate());
+    put_string(d, i.parent_ifname());
+    put_string(d, i.iface_type());
+    put_string(d, i.vid());
+
+    put_u32(d, i.vifs().size());
+    IfMgrIfAtom::VifMap::const_iterator vi;
+    for (vi = i.vifs().begin(); vi != i.vifs().end(); ++vi)
+	encode_vif(d, vi->second);
+}
+
+// Offset of the interface count in a snapshot.
+static const size_t COUNT_OFFSET = 1;
+static const size_t HEADER_BYTES = 5;
+
+static void
+set_count(IfMgrIfTreeSnapshot::Data& d, uint32_t count)
+{
+    d[COUNT_OFFSET]     = (count >> 24) & 0xff;
+    d[COUNT_OFFSET + 1] = (count >> 16) & 0xff;
+    d[COUNT_OFFSET + 2] = (count >> 8) & 0xff;
+    d[COUNT_OFFSET + 3] = count & 0xff;
+}
+
+void
+IfMgrIfTreeSnapshot::encode(const IfMgrIfTree& tree, list<Data>& chunks,
+			    size_t chunk_bytes)
+{
+    Data* d = NULL;
+    uint32_t count = 0;
+
+    IfMgrIfTree::IfMap::const_iterator ii;
+    for (ii = tree.interfaces().begin(); ii != tree.interfaces().end(); ++ii) {
+	if (d != NULL && d->size() >= chunk_bytes) {
+	    set_count(*d, count);
+	    d = NULL;
+	}
+	if (d == NULL) {
+	    chunks.push_back(Data());
+	    d = &chunks.back();
+	    d->reserve(chunk_bytes);
+	    put_u8(*d, VERSION);
+	    put_u32(*d, 0);
+	    count = 0;
+	}
+	encode_interface(*d, ii->second);
+	count++;
+    }
+
+    if (d != NULL)
+	set_count(*d, count);
+}
+
+// ----------------------------------------------------------------------------
+// Decoding
+
+namespace {
+
+/**
+ * Bounds checked reader of a snapshot.  Once a read runs past the end
+ * of the data all further reads fail.
+ */
+class SnapshotReader {
+public:
+    SnapshotReader(const IfMgrIfTreeSnapshot::Data& d)
+	: _d(d), _pos(0), _ok(true) {}
+
+    bool ok() const			{ return _ok; }
+    bool at_end() const			{ return _pos == _d.size(); }
+
+    uint8_t get_u8() {
+	if (! need(1))
+	    return 0;
+	return _d[_pos++];
+    }
+
+    uint32_t get_u32() {
+	if (! need(4))
+	    return 0;
+	uint32_t v = (uint32_t(_d[_pos]) << 24)
+	    | (uint32_t(_d[_pos + 1]) << 16)
+	    | (uint32_t(_d[_pos + 2]) << 8) | uint32_t(_d[_pos + 3]);
+	_pos += 4;
+	return v;
+    }
+
+    uint64_t get_u64() {
+	uint64_t hi = get_u32();
+	uint64_t lo = get_u32();
+	return (hi << 32) | lo;
+    }
+
+    string get_string() {
+	uint32_t len = get_u32();
+	if (! need(len))
+	    return string();
+	string s(_d.begin() + _pos, _d.begin() + _pos + len);
+	_pos += len;
+	return s;
+    }
+
+    template <typename A>
+    A get_addr() {
+	A a;
+	if (! need(A::addr_bytelen()))
+	    return a;
+	a.copy_in(&_d[_pos]);
+	_pos += A::addr_bytelen();
+	return a;
+    }
+
+private:
+    bool need(size_t n) {
+	if (_ok && _d.size() - _pos < n)
+	    _ok = false;
+	return _ok;
+    }
+
+    const IfMgrIfTreeSnapshot::Data& _d;
+    size_t	_pos;
+    bool	_ok;
+};
+
+} // anonymous namespace
+
+static bool
+decode_vif(SnapshotReader& r, IfMgrIfAtom& i)
+{
+    string name = r.get_string();
+    uint8_t flags = r.get_u8();
+    if (! r.ok())
+	return false;
+
+    IfMgrVifAtom& v = i.vifs().insert(make_pair(name,
+						IfMgrVifAtom(name))).first->second;
+    v.set_enabled(flags & VIF_ENABLED);
+    v.set_multicast_capable(flags & VIF_MULTICAST);
+    v.set_broadcast_capable(flags & VIF_BROADCAST);
+    v.set_p2p_capable(flags & VIF_P2P);
+    v.set_loopback(flags & VIF_LOOPBACK);
+    v.set_pim_register(flags & VIF_PIM_REGISTER);
+    v.set_pif_index(r.get_u32());
+    v.set_vif_index(r.get_u32());
+
+    uint32_t n = r.get_u32();
+    for (uint32_t k = 0; k < n && r.ok(); k++) {
+	IPv4 addr = r.get_addr<IPv4>();
+	IfMgrIPv4Atom a(addr);
+	a.set_prefix_len(r.get_u8());
+	uint8_t aflags = r.get_u8();
+	a.set_enabled(aflags & ADDR_ENABLED);
+	a.set_multicast_capable(aflags & ADDR_MULTICAST);
+	a.set_loopback(aflags & ADDR_LOOPBACK);
+	if (aflags & ADDR_BROADCAST)
+	    a.set_broadcast_addr(r.get_addr<IPv4>());
+	if (aflags & ADDR_P2P)
+	    a.set_endpoint_addr(r.get_addr<IPv4>());
+	v.ipv4addrs().insert(make_pair(addr, a));
+    }
+
+    n = r.get_u32();
+    for (uint32_t k = 0; k < n && r.ok(); k++) {
+	IPv6 addr = r.get_addr<IPv6>();
+	IfMgrIPv6Atom a(addr);
+	a.set_prefix_len(r.get_u8());
+	uint8_t aflags = r.get_u8();
+	a.set_enabled(aflags & ADDR_ENABLED);
+	a.set_multicast_capable(aflags & ADDR_MULTICAST);
+	a.set_loopback(aflags & ADDR_LOOPBACK);
+	if (aflags & ADDR_P2P)
+	    a.set_endpoint_addr(r.get_addr<IPv6>());
+	v.ipv6addrs().insert(make_pair(addr, a));
+    }
+
+    return r.ok();
+}
+
+static bool
+decode_interface(SnapshotReader& r, IfMgrIfTree& tree)
+{
+    string name = r.get_string();
+    uint8_t flags = r.get_u8();
+    if (! r.ok())
+	return false;
+
+    IfMgrIfAtom i(name);
+    i.set_enabled(flags & IF_ENABLED);
+    i.set_discard(flags & IF_DISCARD);
+    i.set_unreachable(flags & IF_UNREACHABLE);
+    i.set_management(flags & IF_MANAGEMENT);
+    i.set_no_carrier(flags & IF_NO_CARRIER);
+    i.set_mtu(r.get_u32());
+    i.set_mac(r.get_addr<Mac>());
+    i.set_pif_index(r.get_u32());
+    i.set_baudrate(r.get_u64());
+    i.set_parent_ifname(r.get_string());
+    i.set_iface_type(r.get_string());
+    i.set_vid(r.get_string());
+
+    uint32_t n = r.get_u32();
+    for (uint32_t k = 0; k < n; k++) {
+	if (! decode_vif(r, i))
+	    return false;
+    }
+    if (! r.ok())
+	return false;
+
+    IfMgrIfTree::IfMap& interfaces = tree.interfaces();
+    interfaces.erase(name);
+    interfaces.insert(make_pair(name, i));
+    return true;
+}
+
+bool
+IfMgrIfTreeSnapshot::decode(const Data& data, IfMgrIfTree& tree)
+{
+    SnapshotReader r(data);
+
+    if (data.size() < HEADER_BYTES || r.get_u8() != VERSION) {
+	XLOG_WARNING("Interface tree snapshot has unknown version");
+	return false;
+    }
+
+    // Decode into a scratch tree so a bad snapshot changes nothing.
+    IfMgrIfTree decoded;
+    uint32_t n = r.get_u32();
+    for (uint32_t k = 0; k < n; k++) {
+	if (! decode_interface(r, decoded)) {
+	    XLOG_WARNING("Interface tree snapshot is truncated");
+	    return false;
+	}
+    }
+    if (! r.at_end()) {
+	XLOG_WARNING("Interface tree snapshot has trailing data");
+	return false;
+    }
+
+    IfMgrIfTree::IfMap::const_iterator ii;
+    for (ii = decoded.interfaces().begin();
+	 ii != decoded.interfaces().end(); ++ii) {
+	tree.interfaces().erase(ii->first);
+	tree.interfaces().insert(*ii);
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __LIBFEACLIENT_IFMGR_SNAPSHOT_HH__
+#define __LIBFEACLIENT_IFMGR_SNAPSHOT_HH__
+
+#include "ifmgr_atoms.hh"
+
+/**
+ * @short Binary encoding of interface configuration state.
+ *
+ * A snapshot holds a number of whole interfaces, including their vifs
+ * and addresses.  A large configuration tree is split into several
+ * snapshots, each of which can be decoded on its own.
+ *
+ * All values are stored in network byte order.  A snapshot starts
+ * with a version octet and the number of interfaces that follow.
+ */
+class IfMgrIfTreeSnapshot {
+public:
+    typedef vector<uint8_t> Data;
+
+    static const uint8_t VERSION = 1;
+
+    /**
+     * Preferred size of a snapshot.  A snapshot is only larger if it
+     * holds a single interface which does not fit.
+     */
+    static const size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+    /**
+     * Encode a configuration tree.
+     *
+     * @param tree the tree to encode.
+     * @param chunks list the snapshots are appended to.
+     * @param chunk_bytes preferred size of each snapshot.
+     */
+    static void encode(const IfMgrIfTree& tree, list<Data>& chunks,
+		       size_t chunk_bytes = DEFAULT_CHUNK_BYTES);
+
+    /**
+     * Decode a snapshot and add its interfaces to a configuration tree.
+     * Interfaces already in the tree are replaced.
+     *
+     * @param data the snapshot.
+     * @param tree the tree to add the interfaces to.
+     * @return true on success, false if the snapshot is malformed, in
+     * which case the tree is left unchanged.
+     */
+    static bool decode(const Data& data, IfMgrIfTree& tree);
+};
+
+#endif // __LIBFEACLIENT_IFMGR_SNAPSHOT_HH__
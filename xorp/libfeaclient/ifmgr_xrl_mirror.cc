@@ -307,6 +307,10 @@ protected:
 	const IPv6&	endpoint_addr);
 #endif
 
+    XrlCmdError fea_ifmgr_mirror_0_1_tree_snapshot(
+	// Input values,
+	const vector<uint8_t>&	data);
+
     XrlCmdError fea_ifmgr_mirror_0_1_hint_tree_complete();
 
     XrlCmdError fea_ifmgr_mirror_0_1_hint_updates_made();
@@ -910,6 +914,18 @@ IfMgrXrlMirrorTarget::fea_ifmgr_mirror_0_1_ipv6_set_endpoint(
 }
 #endif //ipv6
 
+XrlCmdError
+IfMgrXrlMirrorTarget::fea_ifmgr_mirror_0_1_tree_snapshot(
+	const vector<uint8_t>&	data
+)
+{
+    _dispatcher.push(new IfMgrIfTreeSnapshotAdd(data));
+    if (_dispatcher.execute() == true) {
+	return XrlCmdError::OKAY();
+    }
+    return XrlCmdError::COMMAND_FAILED(DISPATCH_FAILED);
+}
+
 bool
 IfMgrXrlMirrorTarget::attach(IfMgrHintObserver* ho)
 {
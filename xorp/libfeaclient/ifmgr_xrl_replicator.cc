@@ -29,6 +29,7 @@
 
 #include "libxipc/xrl_router.hh"
 
+#include "ifmgr_cmds.hh"
 #include "ifmgr_xrl_replicator.hh"
 
 
@@ -85,6 +86,17 @@ IfMgrXrlReplicator::xrl_cb(const XrlError& err)
 	return;
     }
 
+    if (err == XrlError::NO_SUCH_METHOD()
+	&& dynamic_cast<const IfMgrIfTreeSnapshotAdd*>(c.get()) != NULL) {
+	//
+	// The remote mirror does not understand tree snapshots, hence
+	// send the same state one attribute at a time.
+	//
+	snapshot_fallback(c);
+	crank_manager_cb();
+	return;
+    }
+
     if (err == XrlError::COMMAND_FAILED()) {
 	//
 	// If command failed then we're out of sync with remote tree
@@ -95,6 +107,51 @@ IfMgrXrlReplicator::xrl_cb(const XrlError& err)
     xrl_error_event(err);
 }
 
+void
+IfMgrXrlReplicator::snapshot_fallback(const Cmd& failed)
+{
+    //
+    // Collect the state held by the failed snapshot and by the
+    // snapshots that are still queued behind it.
+    //
+    IfMgrIfTree tree;
+    failed->execute(tree);
+    while (_queue.empty() == false) {
+	Cmd c = _queue.front();
+	if (dynamic_cast<const IfMgrIfTreeSnapshotAdd*>(c.get()) == NULL)
+	    break;
+	c->execute(tree);
+	_queue.pop_front();
+    }
+
+    //
+    // Put the equivalent commands at the front of the queue.  The
+    // commands already queued keep their place in the manager's queue.
+    //
+    IfMgrCommandFifoQueue rest;
+    while (_queue.empty() == false) {
+	rest.push(_queue.front());
+	_queue.pop_front();
+    }
+
+    IfMgrCommandFifoQueue fresh;
+    const IfMgrIfTree::IfMap& interfaces = tree.interfaces();
+    IfMgrIfTree::IfMap::const_iterator ii;
+    for (ii = interfaces.begin(); ii != interfaces.end(); ++ii) {
+	IfMgrIfAtomToCommands(ii->second).convert(fresh);
+    }
+    while (fresh.empty() == false) {
+	_queue.push(fresh.front());
+	fresh.pop_front();
+	push_manager_queue();
+    }
+
+    while (rest.empty() == false) {
+	_queue.push(rest.front());
+	rest.pop_front();
+    }
+}
+
 //
 // XXX: note that this method may be overwritten by
 // IfMgrManagedXrlReplicator::crank_manager()
@@ -198,8 +255,12 @@ IfMgrXrlReplicationManager::add_mirror(const string& target_name)
     _outputs.push_back(new
 		       IfMgrManagedXrlReplicator(*this, _rtr, target_name));
 
-    IfMgrIfTreeToCommands config_commands(_iftree);
-    config_commands.convert(*_outputs.back());
+    //
+    // Send the tree as a few snapshots.  If the mirror cannot handle
+    // them the replicator falls back to one command per attribute.
+    //
+    IfMgrIfTreeToSnapshot config_snapshot(_iftree);
+    config_snapshot.convert(*_outputs.back());
     return true;
 }
 
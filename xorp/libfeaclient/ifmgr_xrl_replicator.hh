@@ -124,6 +124,14 @@ protected:
 private:
     void xrl_cb(const XrlError& e);
 
+    /**
+     * Replace the tree snapshot commands at the front of the queue
+     * with the equivalent per-attribute commands.
+     *
+     * @param failed the snapshot command the remote target rejected.
+     */
+    void snapshot_fallback(const Cmd& failed);
+
 protected:
     XrlSender&		  _s;
     string		  _tgt;
@@ -0,0 +1,201 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+#include "libfeaclient_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+
+#include "raw_packet_batch.hh"
+
+// The extention headers of an IPv4 batch
+static const XrlAtomList no_ext_headers;
+
+RawPacketBatch::RawPacketBatch(const XrlAtomList& if_names,
+			       const XrlAtomList& vif_names,
+			       const XrlAtomList& src_addresses,
+			       const XrlAtomList& dst_addresses,
+			       const XrlAtomList& ip_protocols,
+			       const XrlAtomList& ip_ttls,
+			       const XrlAtomList& ip_toses,
+			       const XrlAtomList& ip_router_alerts,
+			       const XrlAtomList& ip_internet_controls,
+			       const XrlAtomList& payloads)
+    : _if_names(if_names),
+      _vif_names(vif_names),
+      _src_addresses(src_addresses),
+      _dst_addresses(dst_addresses),
+      _ip_protocols(ip_protocols),
+      _ip_ttls(ip_ttls),
+      _ip_toses(ip_toses),
+      _ip_router_alerts(ip_router_alerts),
+      _ip_internet_controls(ip_internet_controls),
+      _ext_headers_counts(no_ext_headers),
+      _ext_headers_type(no_ext_headers),
+      _ext_headers_payload(no_ext_headers),
+      _payloads(payloads)
+{
+}
+
+RawPacketBatch::RawPacketBatch(const XrlAtomList& if_names,
+			       const XrlAtomList& vif_names,
+			       const XrlAtomList& src_addresses,
+			       const XrlAtomList& dst_addresses,
+			       const XrlAtomList& ip_protocols,
+			       const XrlAtomList& ip_ttls,
+			       const XrlAtomList& ip_toses,
+			       const XrlAtomList& ip_router_alerts,
+			       const XrlAtomList& ip_internet_controls,
+			       const XrlAtomList& ext_headers_counts,
+			       const XrlAtomList& ext_headers_type,
+			       const XrlAtomList& ext_headers_payload,
+			       const XrlAtomList& payloads)
+    : _if_names(if_names),
+      _vif_names(vif_names),
+      _src_addresses(src_addresses),
+      _dst_addresses(dst_addresses),
+      _ip_protocols(ip_protocols),
+      _ip_ttls(ip_ttls),
+      _ip_toses(ip_toses),
+      _ip_router_alerts(ip_router_alerts),
+      _ip_internet_controls(ip_internet_controls),
+      _ext_headers_counts(ext_headers_counts),
+      _ext_headers_type(ext_headers_type),
+      _ext_headers_payload(ext_headers_payload),
+      _payloads(payloads)
+{
+}
+
+IPvX
+RawPacketBatch::src_address(size_t i) const
+{
+    return (address(_src_addresses.get(i)));
+}
+
+IPvX
+RawPacketBatch::dst_address(size_t i) const
+{
+    return (address(_dst_addresses.get(i)));
+}
+
+IPvX
+RawPacketBatch::address(const XrlAtom& atom) const
+{
+    if (atom.type() == xrlatom_ipv6)
+	return (IPvX(atom.ipv6()));
+    return (IPvX(atom.ipv4()));
+}
+
+bool
+RawPacketBatch::is_list_of(const XrlAtomList& list, XrlAtomType type,
+			   size_t n) const
+{
+    // XXX: all elements of a list have the same type
+    if (list.size() != n)
+	return (false);
+    return ((n == 0) || (list.get(0).type() == type));
+}
+
+int
+RawPacketBatch::check(int family, string& error_msg)
+{
+    size_t n = _payloads.size();
+    XrlAtomType addr_type = xrlatom_ipv4;
+
+    switch (family) {
+    case AF_INET:
+	addr_type = xrlatom_ipv4;
+	break;
+    case AF_INET6:
+	addr_type = xrlatom_ipv6;
+	break;
+    default:
+	error_msg = c_format("Invalid address family %d", family);
+	return (XORP_ERROR);
+    }
+
+    if ((! is_list_of(_if_names, xrlatom_text, n))
+	|| (! is_list_of(_vif_names, xrlatom_text, n))
+	|| (! is_list_of(_src_addresses, addr_type, n))
+	|| (! is_list_of(_dst_addresses, addr_type, n))
+	|| (! is_list_of(_ip_protocols, xrlatom_uint32, n))
+	|| (! is_list_of(_ip_ttls, xrlatom_int32, n))
+	|| (! is_list_of(_ip_toses, xrlatom_int32, n))
+	|| (! is_list_of(_ip_router_alerts, xrlatom_boolean, n))
+	|| (! is_list_of(_ip_internet_controls, xrlatom_boolean, n))
+	|| (! is_list_of(_payloads, xrlatom_binary, n))) {
+	error_msg = c_format("Batch of %u packets has a list of the wrong "
+			     "size or type", XORP_UINT_CAST(n));
+	return (XORP_ERROR);
+    }
+
+    //
+    // Find the extention headers of each packet
+    //
+    _ext_headers_start.clear();
+    if (family == AF_INET)
+	return (XORP_OK);
+
+    size_t ext_headers_n = _ext_headers_type.size();
+    size_t start = 0;
+
+    if ((! is_list_of(_ext_headers_counts, xrlatom_uint32, n))
+	|| (! is_list_of(_ext_headers_type, xrlatom_uint32, ext_headers_n))
+	|| (! is_list_of(_ext_headers_payload, xrlatom_binary,
+			 ext_headers_n))) {
+	error_msg = c_format("Batch of %u packets has an extention header "
+			     "list of the wrong size or type",
+			     XORP_UINT_CAST(n));
+	return (XORP_ERROR);
+    }
+    _ext_headers_start.reserve(n + 1);
+    for (size_t i = 0; i < n; i++) {
+	_ext_headers_start.push_back(start);
+	start += _ext_headers_counts.get(i).uint32();
+    }
+    _ext_headers_start.push_back(start);
+    if (start != ext_headers_n) {
+	error_msg = c_format("Batch of %u packets has %u extention headers, "
+			     "but the packets have %u",
+			     XORP_UINT_CAST(n),
+			     XORP_UINT_CAST(ext_headers_n),
+			     XORP_UINT_CAST(start));
+	return (XORP_ERROR);
+    }
+
+    return (XORP_OK);
+}
+
+void
+RawPacketBatch::ext_headers(size_t i, XrlAtomList& ext_headers_type,
+			    XrlAtomList& ext_headers_payload) const
+{
+    if (_ext_headers_start.empty())
+	return;		// IPv4
+
+    for (size_t j = _ext_headers_start[i]; j < _ext_headers_start[i + 1];
+	 j++) {
+	ext_headers_type.append(_ext_headers_type.get(j));
+	ext_headers_payload.append(_ext_headers_payload.get(j));
+    }
+}
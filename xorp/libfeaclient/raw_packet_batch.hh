@@ -0,0 +1,157 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __LIBFEACLIENT_RAW_PACKET_BATCH_HH__
+#define __LIBFEACLIENT_RAW_PACKET_BATCH_HH__
+
+#include "libxorp/ipvx.hh"
+#include "libxipc/xrl_atom.hh"
+#include "libxipc/xrl_atom_list.hh"
+
+/**
+ * @short Accessor for the packets of a raw_packet4_client or
+ * raw_packet6_client recv_batch XRL.
+ *
+ * The packets of a batch are carried as parallel lists, one entry per
+ * packet.  The IPv6 extention headers of all packets are concatenated,
+ * and a separate list has the number of extention headers of each packet.
+ * The lists are not copied, so they must outlive the batch.
+ */
+class RawPacketBatch {
+public:
+    /**
+     * Constructor for a batch of IPv4 packets.
+     */
+    RawPacketBatch(const XrlAtomList& if_names,
+		   const XrlAtomList& vif_names,
+		   const XrlAtomList& src_addresses,
+		   const XrlAtomList& dst_addresses,
+		   const XrlAtomList& ip_protocols,
+		   const XrlAtomList& ip_ttls,
+		   const XrlAtomList& ip_toses,
+		   const XrlAtomList& ip_router_alerts,
+		   const XrlAtomList& ip_internet_controls,
+		   const XrlAtomList& payloads);
+
+    /**
+     * Constructor for a batch of IPv6 packets.
+     */
+    RawPacketBatch(const XrlAtomList& if_names,
+		   const XrlAtomList& vif_names,
+		   const XrlAtomList& src_addresses,
+		   const XrlAtomList& dst_addresses,
+		   const XrlAtomList& ip_protocols,
+		   const XrlAtomList& ip_ttls,
+		   const XrlAtomList& ip_toses,
+		   const XrlAtomList& ip_router_alerts,
+		   const XrlAtomList& ip_internet_controls,
+		   const XrlAtomList& ext_headers_counts,
+		   const XrlAtomList& ext_headers_type,
+		   const XrlAtomList& ext_headers_payload,
+		   const XrlAtomList& payloads);
+
+    /**
+     * Verify the lists are consistent.  No other method may be used
+     * unless this one succeeds.
+     *
+     * @param family the address family of the packets.
+     * @param error_msg the error message (if error).
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int check(int family, string& error_msg);
+
+    /**
+     * @return the number of packets.
+     */
+    size_t size() const { return (_payloads.size()); }
+
+    const string& if_name(size_t i) const {
+	return (_if_names.get(i).text());
+    }
+    const string& vif_name(size_t i) const {
+	return (_vif_names.get(i).text());
+    }
+    const IPv4& src_address4(size_t i) const {
+	return (_src_addresses.get(i).ipv4());
+    }
+    const IPv4& dst_address4(size_t i) const {
+	return (_dst_addresses.get(i).ipv4());
+    }
+    const IPv6& src_address6(size_t i) const {
+	return (_src_addresses.get(i).ipv6());
+    }
+    const IPv6& dst_address6(size_t i) const {
+	return (_dst_addresses.get(i).ipv6());
+    }
+    IPvX src_address(size_t i) const;
+    IPvX dst_address(size_t i) const;
+    const uint32_t& ip_protocol(size_t i) const {
+	return (_ip_protocols.get(i).uint32());
+    }
+    const int32_t& ip_ttl(size_t i) const {
+	return (_ip_ttls.get(i).int32());
+    }
+    const int32_t& ip_tos(size_t i) const {
+	return (_ip_toses.get(i).int32());
+    }
+    const bool& ip_router_alert(size_t i) const {
+	return (_ip_router_alerts.get(i).boolean());
+    }
+    const bool& ip_internet_control(size_t i) const {
+	return (_ip_internet_controls.get(i).boolean());
+    }
+    const vector<uint8_t>& payload(size_t i) const {
+	return (_payloads.get(i).binary());
+    }
+
+    /**
+     * Get the IPv6 extention headers of a packet.
+     *
+     * @param i the packet index.
+     * @param ext_headers_type the list to store the header types.
+     * @param ext_headers_payload the list to store the header payloads.
+     */
+    void ext_headers(size_t i, XrlAtomList& ext_headers_type,
+		     XrlAtomList& ext_headers_payload) const;
+
+private:
+    IPvX address(const XrlAtom& atom) const;
+    bool is_list_of(const XrlAtomList& list, XrlAtomType type,
+		    size_t n) const;
+
+    const XrlAtomList&	_if_names;
+    const XrlAtomList&	_vif_names;
+    const XrlAtomList&	_src_addresses;
+    const XrlAtomList&	_dst_addresses;
+    const XrlAtomList&	_ip_protocols;
+    const XrlAtomList&	_ip_ttls;
+    const XrlAtomList&	_ip_toses;
+    const XrlAtomList&	_ip_router_alerts;
+    const XrlAtomList&	_ip_internet_controls;
+    const XrlAtomList&	_ext_headers_counts;
+    const XrlAtomList&	_ext_headers_type;
+    const XrlAtomList&	_ext_headers_payload;
+    const XrlAtomList&	_payloads;
+
+    vector<size_t>	_ext_headers_start;	// First header of each packet
+};
+
+#endif // __LIBFEACLIENT_RAW_PACKET_BATCH_HH__
@@ -31,6 +31,7 @@
 #include "ifmgr_atoms.hh"
 #include "ifmgr_cmds.hh"
 #include "ifmgr_cmd_queue.hh"
+#include "ifmgr_snapshot.hh"
 
 #ifdef HAVE_GETOPT_H
 #include <getopt.h>
@@ -271,6 +272,61 @@ test_main()
 	return 1;
     }
 
+    // Convert tree to snapshot commands and compare
+    IfMgrIfTreeToSnapshot snapshot_converter(t);
+    snapshot_converter.convert(fifo);
+
+    IfMgrIfTree w;
+    while (fifo.empty() == false) {
+	if (fifo.front()->execute(w) == false) {
+	    verbose_log("Failed to apply %s\n", fifo.front()->str().c_str());
+	    return 1;
+	}
+	verbose_log("Executing %s\n", fifo.front()->str().c_str());
+	fifo.pop_front();
+    }
+    if (w != u) {
+	verbose_log("Convert to snapshot and apply to empty tree failed.");
+	return 1;
+    }
+
+    // Split a larger tree across several snapshots
+    for (uint32_t i = 1; i < 100; i++) {
+	string ifname = c_format("if%u", XORP_UINT_CAST(i));
+	IfMgrIfAtom ifa(ifname);
+	ifa.set_mtu(1500 + i);
+	t.interfaces().insert(make_pair(ifname, ifa));
+    }
+    list<IfMgrIfTreeSnapshot::Data> chunks;
+    IfMgrIfTreeSnapshot::encode(t, chunks, 256);
+    if (chunks.size() < 2) {
+	verbose_log("Tree was not split into several snapshots\n");
+	return 1;
+    }
+
+    IfMgrIfTree x;
+    list<IfMgrIfTreeSnapshot::Data>::const_iterator ci;
+    for (ci = chunks.begin(); ci != chunks.end(); ++ci) {
+	if (IfMgrIfTreeSnapshot::decode(*ci, x) == false) {
+	    verbose_log("Failed to decode snapshot\n");
+	    return 1;
+	}
+    }
+    if (x != t) {
+	verbose_log("Decoding split snapshots failed.");
+	return 1;
+    }
+
+    // A truncated snapshot must be rejected and leave the tree alone
+    IfMgrIfTreeSnapshot::Data bad = chunks.front();
+    bad.resize(bad.size() - 1);
+    IfMgrIfTree y;
+    if (IfMgrIfTreeSnapshot::decode(bad, y) == true
+	|| y.interfaces().empty() == false) {
+	verbose_log("Accepted truncated snapshot\n");
+	return 1;
+    }
+
     return 0;
 }
 
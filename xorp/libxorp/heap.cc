@@ -77,6 +77,10 @@ Heap::resize(int new_size)
 		   _size, new_size);
         return 0;
     }
+    // Grow geometrically, so that filling a large heap copies each entry
+    // a bounded number of times instead of once every HEAP_INCREMENT pushes.
+    if (new_size < 2 * _size)
+	new_size = 2 * _size;
     new_size = (new_size + HEAP_INCREMENT ) & ~HEAP_INCREMENT ;
     p = new struct heap_entry[new_size];
     if (p == NULL) {
@@ -937,7 +937,7 @@ public:
      * longest matching prefix.
      */
     iterator find(const Key &k) const		{
-	return iterator(this, _root->find(k));
+	return (_root) ? iterator(this, _root->find(k)) : end();
     }
 
     /**
@@ -954,7 +954,7 @@ public:
 	if (i != end())
 	    return i;
 #endif
-	return iterator(this, _root->lower_bound(k));
+	return (_root) ? iterator(this, _root->lower_bound(k)) : end();
     }
 
     iterator begin() const
@@ -979,7 +979,7 @@ public:
      *
      */
     iterator lookup_node(const Key & k) const	{
-	Node *n = _root->find(k);
+	Node *n = (_root) ? _root->find(k) : NULL;
 	return (n && n->k() == k) ? iterator(this, n) : end();
     }
 
@@ -988,7 +988,7 @@ public:
      * the key passed as parameter.
      */
     iterator search_subtree(const Key &key) const {
-	return iterator(this, _root->find_subtree(key), key);
+	return (_root) ? iterator(this, _root->find_subtree(key), key) : end();
     }
 
     /**
@@ -1004,7 +1004,7 @@ public:
 
 	Key x(key.masked_addr(), key.prefix_len() - 1);
 
-	return iterator(this, _root->find(x));
+	return (_root) ? iterator(this, _root->find(x)) : end();
     }
 
     /**
@@ -1012,6 +1012,11 @@ public:
      * and would map to the same route.
      */
     void find_bounds(const A& a, A &lo, A &hi) const	{
+	if (_root == NULL) {	// the whole address space maps to no route
+	    lo = A::ZERO();
+	    hi = A::ALL_ONES();
+	    return;
+	}
 	_root->find_bounds(a, lo, hi);
     }
 #if 0	// compatibility stuff, has to go
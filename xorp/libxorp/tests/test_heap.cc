@@ -91,6 +91,7 @@ public:
 
     void test_heap_push();
     void test_heap_push_same_value();
+    void test_heap_grow();
 };
 
 /**
@@ -168,6 +169,47 @@ TestHeap::test_heap_push_same_value()
     verbose_assert(size() == 0, "heap size");
 }
 
+/**
+ * Fill a large heap and empty it again.  The entries must come out in
+ * order, and the heap must have been reallocated only a few times.
+ */
+void
+TestHeap::test_heap_grow()
+{
+    const int n = 100000;
+    vector<int> values(n);
+    struct heap_entry* array = NULL;
+    int reallocs = 0;
+
+    for (int i = 0; i < n; i++) {
+	// the keys in a scrambled order
+	values[i] = (i * 7919) % n;
+	push(TimeVal(0, values[i]), reinterpret_cast<HeapBase *>(&values[i]));
+
+	// the top is the first entry of the array
+	if (top() != array) {
+	    array = top();
+	    reallocs++;
+	}
+    }
+
+    verbose_assert(size() == static_cast<size_t>(n), "heap size");
+    verbose_log("%d entries in %d allocations\n", n, reallocs);
+    verbose_assert(reallocs < 32, "heap grows geometrically");
+
+    bool ordered = true;
+    for (int i = 0; i < n; i++) {
+	struct heap_entry* he = top();
+
+	if (he == NULL || he->key != TimeVal(0, i)
+	    || *reinterpret_cast<int *>(he->object) != i)
+	    ordered = false;
+	pop();
+    }
+    verbose_assert(ordered, "heap pops in key order");
+    verbose_assert(size() == 0, "heap size");
+}
+
 int
 main(int argc, char * const argv[])
 {
@@ -211,6 +253,7 @@ main(int argc, char * const argv[])
 	test_heap_invalid_constructors();
 	heap.test_heap_push();
 	heap.test_heap_push_same_value();
+	heap.test_heap_grow();
 	ret_value = failures() ? 1 : 0;
     } catch (...) {
 	// Internal error
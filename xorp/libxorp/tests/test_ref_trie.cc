@@ -264,8 +264,28 @@ void test_equals_postorder()
     print_passed("");
 }
 
+void test_empty() {
+    printf("-----------------------------------------------\n");
+    printf("looking up in an empty trie\n");
+    RefTrie<IPv4, IPv4RouteEntry*> empty_trie;
+    IPv4Net net(IPv4("1.2.1.0"), 24);
+    if (empty_trie.lookup_node(net) != empty_trie.end()
+	|| empty_trie.find(net) != empty_trie.end()
+	|| empty_trie.find(IPv4("1.2.1.1")) != empty_trie.end()
+	|| empty_trie.find_less_specific(net) != empty_trie.end()
+	|| empty_trie.search_subtree(net) != empty_trie.end()
+	|| empty_trie.lower_bound(net) != empty_trie.end()) {
+	print_failed("empty trie lookup");
+	abort();
+    }
+    print_passed("empty trie lookup");
+    printf("-----------\n");
+}
+
 int main() {
 
+    test_empty();
+
     IPv4RouteEntry d1;
     IPv4Net n1(IPv4("1.2.1.0"), 24);
     printf("adding n1: %s route: %p\n", n1.str().c_str(), &d1);
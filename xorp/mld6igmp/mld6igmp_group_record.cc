@@ -36,6 +36,12 @@
 #include "mld6igmp_vif.hh"
 
 
+// The minimum number of buckets of the hash table of group records
+static const size_t GROUP_HASH_MIN_SIZE = 64;
+
+// The index of a group record without Queries to retransmit
+static const size_t GROUP_QUERY_NOT_SCHEDULED = ~static_cast<size_t>(0);
+
 /**
  * Mld6igmpGroupRecord::Mld6igmpGroupRecord:
  * @mld6igmp_vif: The vif interface this entry belongs to.
@@ -51,7 +57,10 @@ Mld6igmpGroupRecord::Mld6igmpGroupRecord(Mld6igmpVif& mld6igmp_vif,
       _do_forward_sources(*this),
       _dont_forward_sources(*this),
       _last_reported_host(IPvX::ZERO(family())),
-      _query_retransmission_count(0)
+      _query_retransmission_count(0),
+      _hash_next(NULL),
+      _group_query_index(GROUP_QUERY_NOT_SCHEDULED),
+      _group_query_due(TimeVal::ZERO())
 {
     
 }
@@ -714,7 +723,7 @@ Mld6igmpGroupRecord::source_expired(Mld6igmpSourceRecord* source_record)
 	// If no more source records, then delete the group record
 	if (_do_forward_sources.empty()) {
 	    XLOG_ASSERT(_dont_forward_sources.empty());
-	    mld6igmp_vif().group_records().erase(group());
+	    mld6igmp_vif().group_records().erase_group_record(this);
 	    delete this;
 	}
 	return;
@@ -797,7 +806,7 @@ Mld6igmpGroupRecord::group_timer_timeout()
 	// No sources with running source timers.
 	// Delete the group record and return immediately.
 	//
-	mld6igmp_vif().group_records().erase(group());
+	mld6igmp_vif().group_records().erase_group_record(this);
 	delete this;
 	return;
     }
@@ -858,16 +867,10 @@ Mld6igmpGroupRecord::schedule_periodic_group_query(const set<IPvX>& sources)
     }
 
     //
-    // Set the periodic timer for SSM Group-Specific and
+    // Schedule the periodic SSM Group-Specific and
     // Group-and-Source-Specific Queries.
     //
-    // Note that we set the timer only if it wasn't running already.
-    //
-    if (! _group_query_timer.scheduled()) {
-	_group_query_timer = eventloop().new_periodic(
-	    _mld6igmp_vif.query_last_member_interval().get(),
-	    callback(this, &Mld6igmpGroupRecord::group_query_periodic_timeout));
-    }
+    _mld6igmp_vif.group_records().schedule_group_query(this);
 }
 
 /**
@@ -1151,7 +1154,6 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
     bool new_is_include_mode = is_include_mode();
     set<IPvX> new_do_forward_sources = _do_forward_sources.extract_source_addresses();
     set<IPvX> new_dont_forward_sources = _dont_forward_sources.extract_source_addresses();
-    set<IPvX>::const_iterator iter;
 
     if (old_is_include_mode) {
 	if (new_is_include_mode) {
@@ -1160,30 +1162,12 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
 	    XLOG_ASSERT(new_dont_forward_sources.empty());
 
 	    // Join all new sources that are to be forwarded
-	    for (iter = new_do_forward_sources.begin();
-		 iter != new_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (old_do_forward_sources.find(ipvx)
-		    == old_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_JOIN);
-		}
-	    }
+	    notify_routing_difference(new_do_forward_sources,
+				      old_do_forward_sources, ACTION_JOIN);
 
 	    // Prune all old sources that were forwarded
-	    for (iter = old_do_forward_sources.begin();
-		 iter != old_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (new_do_forward_sources.find(ipvx)
-		    == new_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_PRUNE);
-		}
-	    }
+	    notify_routing_difference(old_do_forward_sources,
+				      new_do_forward_sources, ACTION_PRUNE);
 	}
 
 	if (! new_is_include_mode) {
@@ -1191,17 +1175,8 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
 	    XLOG_ASSERT(old_dont_forward_sources.empty());
 
 	    // Prune the old sources that were forwarded
-	    for (iter = old_do_forward_sources.begin();
-		 iter != old_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (new_do_forward_sources.find(ipvx)
-		    == new_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_PRUNE);
-		}
-	    }
+	    notify_routing_difference(old_do_forward_sources,
+				      new_do_forward_sources, ACTION_PRUNE);
 
 	    // Join the group itself
 	    mld6igmp_vif().join_prune_notify_routing(IPvX::ZERO(family()),
@@ -1209,30 +1184,12 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
 						     ACTION_JOIN);
 
 	    // Join all new sources that are to be forwarded
-	    for (iter = new_do_forward_sources.begin();
-		 iter != new_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (old_do_forward_sources.find(ipvx)
-		    == old_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_JOIN);
-		}
-	    }
+	    notify_routing_difference(new_do_forward_sources,
+				      old_do_forward_sources, ACTION_JOIN);
 
 	    // Prune all new sources that are not to be forwarded
-	    for (iter = new_dont_forward_sources.begin();
-		 iter != new_dont_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (old_dont_forward_sources.find(ipvx)
-		    == old_dont_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_PRUNE);
-		}
-	    }
+	    notify_routing_difference(new_dont_forward_sources,
+				      old_dont_forward_sources, ACTION_PRUNE);
 	}
     }
 
@@ -1242,17 +1199,8 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
 	    XLOG_ASSERT(new_dont_forward_sources.empty());
 
 	    // Join all old sources that were not to be forwarded
-	    for (iter = old_dont_forward_sources.begin();
-		 iter != old_dont_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (new_dont_forward_sources.find(ipvx)
-		    == new_dont_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_JOIN);
-		}
-	    }
+	    notify_routing_difference(old_dont_forward_sources,
+				      new_dont_forward_sources, ACTION_JOIN);
 
 	    // Prune the group itself
 	    mld6igmp_vif().join_prune_notify_routing(IPvX::ZERO(family()),
@@ -1260,77 +1208,66 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
 						     ACTION_PRUNE);
 
 	    // Join all new sources that are to be forwarded
-	    for (iter = new_do_forward_sources.begin();
-		 iter != new_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (old_do_forward_sources.find(ipvx)
-		    == old_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_JOIN);
-		}
-	    }
+	    notify_routing_difference(new_do_forward_sources,
+				      old_do_forward_sources, ACTION_JOIN);
 	}
 
 	if (! new_is_include_mode) {
 	    // EXCLUDE -> EXCLUDE
 
 	    // Join all new sources that are to be forwarded
-	    for (iter = new_do_forward_sources.begin();
-		 iter != new_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (old_do_forward_sources.find(ipvx)
-		    == old_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_JOIN);
-		}
-	    }
+	    notify_routing_difference(new_do_forward_sources,
+				      old_do_forward_sources, ACTION_JOIN);
 
 	    // Prune all old sources that were forwarded
-	    for (iter = old_do_forward_sources.begin();
-		 iter != old_do_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (new_do_forward_sources.find(ipvx)
-		    == new_do_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_PRUNE);
-		}
-	    }
+	    notify_routing_difference(old_do_forward_sources,
+				      new_do_forward_sources, ACTION_PRUNE);
 
 	    // Join all old sources that were not to be forwarded
-	    for (iter = old_dont_forward_sources.begin();
-		 iter != old_dont_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (new_dont_forward_sources.find(ipvx)
-		    == new_dont_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_JOIN);
-		}
-	    }
+	    notify_routing_difference(old_dont_forward_sources,
+				      new_dont_forward_sources, ACTION_JOIN);
 
 	    // Prune all new sources that are not to be forwarded
-	    for (iter = new_dont_forward_sources.begin();
-		 iter != new_dont_forward_sources.end();
-		 ++iter) {
-		const IPvX& ipvx = *iter;
-		if (old_dont_forward_sources.find(ipvx)
-		    == old_dont_forward_sources.end()) {
-		    mld6igmp_vif().join_prune_notify_routing(ipvx,
-							     group(),
-							     ACTION_PRUNE);
-		}
-	    }
+	    notify_routing_difference(new_dont_forward_sources,
+				      old_dont_forward_sources, ACTION_PRUNE);
 	}
     }
 }
 
+/**
+ * Notify the interested parties about the sources in a set that are not
+ * in a second set.
+ *
+ * Both sets are walked together in address order.
+ *
+ * @param sources the set of sources to notify about.
+ * @param except_sources the sources to skip.
+ * @param action_jp the action to notify.
+ */
+void
+Mld6igmpGroupRecord::notify_routing_difference(
+    const set<IPvX>& sources,
+    const set<IPvX>& except_sources,
+    action_jp_t action_jp) const
+{
+    set<IPvX>::const_iterator iter = sources.begin();
+    set<IPvX>::const_iterator except_iter = except_sources.begin();
+
+    while (iter != sources.end()) {
+	if ((except_iter == except_sources.end()) || (*iter < *except_iter)) {
+	    mld6igmp_vif().join_prune_notify_routing(*iter, group(),
+						     action_jp);
+	    ++iter;
+	    continue;
+	}
+	if (*except_iter < *iter) {
+	    ++except_iter;
+	    continue;
+	}
+	++iter;
+	++except_iter;
+    }
+}
 
 /**
  * Constructor for a given vif.
@@ -1338,7 +1275,8 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
  * @param mld6igmp_vif the interface this set belongs to.
  */
 Mld6igmpGroupSet::Mld6igmpGroupSet(Mld6igmpVif& mld6igmp_vif)
-    : _mld6igmp_vif(mld6igmp_vif)
+    : _mld6igmp_vif(mld6igmp_vif),
+      _hash(GROUP_HASH_MIN_SIZE, static_cast<Mld6igmpGroupRecord *>(NULL))
 {
     
 }
@@ -1361,14 +1299,280 @@ Mld6igmpGroupSet::~Mld6igmpGroupSet()
 Mld6igmpGroupRecord*
 Mld6igmpGroupSet::find_group_record(const IPvX& group)
 {
-    Mld6igmpGroupSet::iterator iter = this->find(group);
+    Mld6igmpGroupRecord* group_record = _hash[hash_index(group)];
 
-    if (iter != this->end())
-	return (iter->second);
+    while (group_record != NULL) {
+	if (group_record->group() == group)
+	    return (group_record);
+	group_record = group_record->_hash_next;
+    }
 
     return (NULL);
 }
 
+/**
+ * Find a group record, and create it if it does not exist.
+ *
+ * @param group the group address.
+ * @return the group record.
+ */
+Mld6igmpGroupRecord*
+Mld6igmpGroupSet::find_or_create_group_record(const IPvX& group)
+{
+    Mld6igmpGroupRecord* group_record = find_group_record(group);
+
+    if (group_record == NULL) {
+	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
+	this->insert(make_pair(group, group_record));
+	hash_insert(group_record);
+    }
+
+    return (group_record);
+}
+
+/**
+ * Remove a group record from the set.
+ *
+ * Note that the group record itself is not deleted.
+ *
+ * @param group_record the group record to remove.
+ */
+void
+Mld6igmpGroupSet::erase_group_record(Mld6igmpGroupRecord* group_record)
+{
+    unschedule_group_query(group_record);
+    hash_remove(group_record);
+    this->erase(group_record->group());
+}
+
+/**
+ * Delete a group record if it is not used anymore.
+ *
+ * @param group_record the group record.
+ */
+void
+Mld6igmpGroupSet::delete_group_record_if_unused(
+    Mld6igmpGroupRecord* group_record)
+{
+    if (group_record->is_unused()) {
+	erase_group_record(group_record);
+	delete group_record;
+    }
+}
+
+size_t
+Mld6igmpGroupSet::hash_index(const IPvX& group) const
+{
+    uint32_t words[sizeof(IPvX) / sizeof(uint32_t)];
+    size_t n = group.copy_out(reinterpret_cast<uint8_t *>(words))
+	/ sizeof(words[0]);
+    uint32_t h = 0;
+
+    for (size_t i = 0; i < n; i++)
+	h = (h ^ words[i]) * 2654435761U;	// Multiplicative hashing
+    h ^= (h >> 16);
+
+    return (h & (_hash.size() - 1));
+}
+
+void
+Mld6igmpGroupSet::hash_insert(Mld6igmpGroupRecord* group_record)
+{
+    //
+    // Double the number of buckets when there are more records than
+    // buckets.
+    //
+    if (this->size() > _hash.size()) {
+	vector<Mld6igmpGroupRecord *> old_hash(
+	    2 * _hash.size(), static_cast<Mld6igmpGroupRecord *>(NULL));
+
+	old_hash.swap(_hash);
+	for (size_t i = 0; i < old_hash.size(); i++) {
+	    Mld6igmpGroupRecord* r = old_hash[i];
+	    while (r != NULL) {
+		Mld6igmpGroupRecord* next_r = r->_hash_next;
+		size_t j = hash_index(r->group());
+		r->_hash_next = _hash[j];
+		_hash[j] = r;
+		r = next_r;
+	    }
+	}
+    }
+
+    size_t i = hash_index(group_record->group());
+    group_record->_hash_next = _hash[i];
+    _hash[i] = group_record;
+}
+
+void
+Mld6igmpGroupSet::hash_remove(Mld6igmpGroupRecord* group_record)
+{
+    Mld6igmpGroupRecord** r = &_hash[hash_index(group_record->group())];
+
+    while (*r != group_record) {
+	XLOG_ASSERT(*r != NULL);
+	r = &(*r)->_hash_next;
+    }
+    *r = group_record->_hash_next;
+    group_record->_hash_next = NULL;
+}
+
+/**
+ * Schedule the periodic Group-Specific and Group-and-Source-Specific
+ * Query retransmissions of a group record.
+ *
+ * @param group_record the group record.
+ */
+void
+Mld6igmpGroupSet::schedule_group_query(Mld6igmpGroupRecord* group_record)
+{
+    EventLoop& eventloop = _mld6igmp_vif.mld6igmp_node().eventloop();
+    TimeVal now;
+
+    if (group_record->_group_query_index == GROUP_QUERY_NOT_SCHEDULED) {
+	group_record->_group_query_index = _group_query_records.size();
+	_group_query_records.push_back(group_record);
+    }
+
+    //
+    // The first retransmission is due one Last Member Query Interval
+    // after the query that was just sent.
+    //
+    eventloop.current_time(now);
+    group_record->_group_query_due
+	= now + _mld6igmp_vif.query_last_member_interval().get();
+
+    //
+    // Set the timer for SSM Group-Specific and Group-and-Source-Specific
+    // Queries if it wasn't running already or it expires too late.
+    //
+    if ((! _group_query_timer.scheduled())
+	|| (_group_query_timer.expiry() > group_record->_group_query_due)) {
+	_group_query_timer = eventloop.new_oneoff_at(
+	    group_record->_group_query_due,
+	    callback(this, &Mld6igmpGroupSet::group_query_timer_timeout));
+    }
+}
+
+void
+Mld6igmpGroupSet::unschedule_group_query(Mld6igmpGroupRecord* group_record)
+{
+    size_t i = group_record->_group_query_index;
+
+    if (i == GROUP_QUERY_NOT_SCHEDULED)
+	return;
+
+    // Move the last record into the place of the removed one
+    XLOG_ASSERT(_group_query_records[i] == group_record);
+    _group_query_records[i] = _group_query_records.back();
+    _group_query_records[i]->_group_query_index = i;
+    _group_query_records.pop_back();
+    group_record->_group_query_index = GROUP_QUERY_NOT_SCHEDULED;
+
+    if (_group_query_records.empty())
+	_group_query_timer.unschedule();
+}
+
+/**
+ * Reschedule the pending Group-Specific and Group-and-Source-Specific
+ * Query retransmissions after the Last Member Query Interval has changed.
+ *
+ * A shorter interval takes effect immediately, while a longer interval
+ * takes effect after the next retransmission of each group record.
+ */
+void
+Mld6igmpGroupSet::reschedule_group_queries()
+{
+    EventLoop& eventloop = _mld6igmp_vif.mld6igmp_node().eventloop();
+    TimeVal interval = _mld6igmp_vif.query_last_member_interval().get();
+    TimeVal now, due;
+    size_t i;
+
+    if (_group_query_records.empty())
+	return;
+
+    if (interval == TimeVal::ZERO()) {
+	//
+	// No retransmissions with zero interval: same as when the queries
+	// are scheduled (see Mld6igmpGroupRecord::schedule_periodic_group_query)
+	//
+	while (! _group_query_records.empty())
+	    unschedule_group_query(_group_query_records.back());
+	return;
+    }
+
+    eventloop.current_time(now);
+    due = now + interval;
+    for (i = 0; i < _group_query_records.size(); i++) {
+	Mld6igmpGroupRecord* group_record = _group_query_records[i];
+	if (group_record->_group_query_due > due)
+	    group_record->_group_query_due = due;
+    }
+
+    group_query_timer_schedule();
+}
+
+/**
+ * Schedule the timer for Group-Specific and Group-and-Source-Specific
+ * Queries to expire when the earliest of them is due.
+ */
+void
+Mld6igmpGroupSet::group_query_timer_schedule()
+{
+    EventLoop& eventloop = _mld6igmp_vif.mld6igmp_node().eventloop();
+    TimeVal due = TimeVal::MAXIMUM();
+    size_t i;
+
+    if (_group_query_records.empty()) {
+	_group_query_timer.unschedule();
+	return;
+    }
+
+    for (i = 0; i < _group_query_records.size(); i++) {
+	if (_group_query_records[i]->_group_query_due < due)
+	    due = _group_query_records[i]->_group_query_due;
+    }
+
+    _group_query_timer = eventloop.new_oneoff_at(
+	due,
+	callback(this, &Mld6igmpGroupSet::group_query_timer_timeout));
+}
+
+/**
+ * Timeout: time to send the next Group-Specific and
+ * Group-and-Source-Specific Queries for the group records that are due.
+ */
+void
+Mld6igmpGroupSet::group_query_timer_timeout()
+{
+    EventLoop& eventloop = _mld6igmp_vif.mld6igmp_node().eventloop();
+    TimeVal interval = _mld6igmp_vif.query_last_member_interval().get();
+    TimeVal now;
+    size_t i = 0;
+
+    eventloop.current_time(now);
+
+    while (i < _group_query_records.size()) {
+	Mld6igmpGroupRecord* group_record = _group_query_records[i];
+
+	if (group_record->_group_query_due > now) {
+	    i++;			// Not due yet
+	    continue;
+	}
+
+	if (group_record->group_query_periodic_timeout()) {
+	    group_record->_group_query_due = now + interval;
+	    i++;
+	    continue;
+	}
+
+	// No more queries to send: the last record takes its place
+	unschedule_group_query(group_record);
+    }
+
+    group_query_timer_schedule();
+}
+
 /**
  * Delete the payload of the set, and clear the set itself.
  */
@@ -1377,6 +1581,9 @@ Mld6igmpGroupSet::delete_payload_and_clear()
 {
     Mld6igmpGroupSet::iterator iter;
 
+    _group_query_timer.unschedule();
+    _group_query_records.clear();
+
     //
     // Delete the payload of the set
     //
@@ -1389,6 +1596,8 @@ Mld6igmpGroupSet::delete_payload_and_clear()
     // Clear the set itself
     //
     this->clear();
+    _hash.assign(GROUP_HASH_MIN_SIZE,
+		 static_cast<Mld6igmpGroupRecord *>(NULL));
 }
 
 /**
@@ -1404,27 +1613,14 @@ Mld6igmpGroupSet::process_mode_is_include(const IPvX& group,
 					  const set<IPvX>& sources,
 					  const IPvX& last_reported_host)
 {
-    Mld6igmpGroupSet::iterator iter;
-    Mld6igmpGroupRecord* group_record = NULL;
-
-    iter = this->find(group);
-    if (iter != this->end()) {
-	group_record = iter->second;
-    } else {
-	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-	this->insert(make_pair(group, group_record));
-    }
-    XLOG_ASSERT(group_record != NULL);
+    Mld6igmpGroupRecord* group_record = find_or_create_group_record(group);
 
     group_record->process_mode_is_include(sources, last_reported_host);
 
     //
     // If the group record is not used anymore, then delete it
     //
-    if (group_record->is_unused()) {
-	this->erase(group);
-	delete group_record;
-    }
+    delete_group_record_if_unused(group_record);
 }
 
 /**
@@ -1440,27 +1636,14 @@ Mld6igmpGroupSet::process_mode_is_exclude(const IPvX& group,
 					  const set<IPvX>& sources,
 					  const IPvX& last_reported_host)
 {
-    Mld6igmpGroupSet::iterator iter;
-    Mld6igmpGroupRecord* group_record = NULL;
-
-    iter = this->find(group);
-    if (iter != this->end()) {
-	group_record = iter->second;
-    } else {
-	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-	this->insert(make_pair(group, group_record));
-    }
-    XLOG_ASSERT(group_record != NULL);
+    Mld6igmpGroupRecord* group_record = find_or_create_group_record(group);
 
     group_record->process_mode_is_exclude(sources, last_reported_host);
 
     //
     // If the group record is not used anymore, then delete it
     //
-    if (group_record->is_unused()) {
-	this->erase(group);
-	delete group_record;
-    }
+    delete_group_record_if_unused(group_record);
 }
 
 /**
@@ -1476,17 +1659,7 @@ Mld6igmpGroupSet::process_change_to_include_mode(const IPvX& group,
 						 const set<IPvX>& sources,
 						 const IPvX& last_reported_host)
 {
-    Mld6igmpGroupSet::iterator iter;
-    Mld6igmpGroupRecord* group_record = NULL;
-
-    iter = this->find(group);
-    if (iter != this->end()) {
-	group_record = iter->second;
-    } else {
-	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-	this->insert(make_pair(group, group_record));
-    }
-    XLOG_ASSERT(group_record != NULL);
+    Mld6igmpGroupRecord* group_record = find_or_create_group_record(group);
 
     if (_mld6igmp_vif.is_igmpv1_mode(group_record)) {
 	//
@@ -1501,10 +1674,7 @@ Mld6igmpGroupSet::process_change_to_include_mode(const IPvX& group,
     //
     // If the group record is not used anymore, then delete it
     //
-    if (group_record->is_unused()) {
-	this->erase(group);
-	delete group_record;
-    }
+    delete_group_record_if_unused(group_record);
 }
 
 /**
@@ -1520,17 +1690,7 @@ Mld6igmpGroupSet::process_change_to_exclude_mode(const IPvX& group,
 						 const set<IPvX>& sources,
 						 const IPvX& last_reported_host)
 {
-    Mld6igmpGroupSet::iterator iter;
-    Mld6igmpGroupRecord* group_record = NULL;
-
-    iter = this->find(group);
-    if (iter != this->end()) {
-	group_record = iter->second;
-    } else {
-	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-	this->insert(make_pair(group, group_record));
-    }
-    XLOG_ASSERT(group_record != NULL);
+    Mld6igmpGroupRecord* group_record = find_or_create_group_record(group);
 
     if (_mld6igmp_vif.is_igmpv1_mode(group_record)
 	|| _mld6igmp_vif.is_igmpv2_mode(group_record)
@@ -1550,10 +1710,7 @@ Mld6igmpGroupSet::process_change_to_exclude_mode(const IPvX& group,
     //
     // If the group record is not used anymore, then delete it
     //
-    if (group_record->is_unused()) {
-	this->erase(group);
-	delete group_record;
-    }
+    delete_group_record_if_unused(group_record);
 }
 
 /**
@@ -1569,27 +1726,14 @@ Mld6igmpGroupSet::process_allow_new_sources(const IPvX& group,
 					    const set<IPvX>& sources,
 					    const IPvX& last_reported_host)
 {
-    Mld6igmpGroupSet::iterator iter;
-    Mld6igmpGroupRecord* group_record = NULL;
-
-    iter = this->find(group);
-    if (iter != this->end()) {
-	group_record = iter->second;
-    } else {
-	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-	this->insert(make_pair(group, group_record));
-    }
-    XLOG_ASSERT(group_record != NULL);
+    Mld6igmpGroupRecord* group_record = find_or_create_group_record(group);
 
     group_record->process_allow_new_sources(sources, last_reported_host);
 
     //
     // If the group record is not used anymore, then delete it
     //
-    if (group_record->is_unused()) {
-	this->erase(group);
-	delete group_record;
-    }
+    delete_group_record_if_unused(group_record);
 }
 
 /**
@@ -1605,17 +1749,7 @@ Mld6igmpGroupSet::process_block_old_sources(const IPvX& group,
 					    const set<IPvX>& sources,
 					    const IPvX& last_reported_host)
 {
-    Mld6igmpGroupSet::iterator iter;
-    Mld6igmpGroupRecord* group_record = NULL;
-
-    iter = this->find(group);
-    if (iter != this->end()) {
-	group_record = iter->second;
-    } else {
-	group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-	this->insert(make_pair(group, group_record));
-    }
-    XLOG_ASSERT(group_record != NULL);
+    Mld6igmpGroupRecord* group_record = find_or_create_group_record(group);
 
     if (_mld6igmp_vif.is_igmpv1_mode(group_record)
 	|| _mld6igmp_vif.is_igmpv2_mode(group_record)
@@ -1631,10 +1765,7 @@ Mld6igmpGroupSet::process_block_old_sources(const IPvX& group,
     //
     // If the group record is not used anymore, then delete it
     //
-    if (group_record->is_unused()) {
-	this->erase(group);
-	delete group_record;
-    }
+    delete_group_record_if_unused(group_record);
 }
 
 /**
@@ -1647,13 +1778,10 @@ void
 Mld6igmpGroupSet::lower_group_timer(const IPvX& group,
 				    const TimeVal& timeval)
 {
-    Mld6igmpGroupSet::iterator iter;
+    Mld6igmpGroupRecord* group_record = find_group_record(group);
 
-    iter = this->find(group);
-    if (iter != this->end()) {
-	Mld6igmpGroupRecord* group_record = iter->second;
+    if (group_record != NULL)
 	group_record->lower_group_timer(timeval);
-    }
 }
 
 /**
@@ -1668,11 +1796,8 @@ Mld6igmpGroupSet::lower_source_timer(const IPvX& group,
 				     const set<IPvX>& sources,
 				     const TimeVal& timeval)
 {
-    Mld6igmpGroupSet::iterator iter;
+    Mld6igmpGroupRecord* group_record = find_group_record(group);
 
-    iter = this->find(group);
-    if (iter != this->end()) {
-	Mld6igmpGroupRecord* group_record = iter->second;
+    if (group_record != NULL)
 	group_record->lower_source_timer(sources, timeval);
-    }
 }
@@ -28,6 +28,7 @@
 
 #include "libxorp/ipvx.hh"
 #include "libxorp/timer.hh"
+#include "mrt/multicast_defs.h"
 
 #include "mld6igmp_source_record.hh"
 
@@ -321,6 +322,18 @@ private:
 				      const set<IPvX>& old_do_forward_sources,
 				      const set<IPvX>& old_dont_forward_sources) const;
 
+    /**
+     * Notify the interested parties about the sources in a set that are
+     * not in a second set.
+     *
+     * @param sources the set of sources to notify about.
+     * @param except_sources the sources to skip.
+     * @param action_jp the action to notify.
+     */
+    void notify_routing_difference(const set<IPvX>& sources,
+				   const set<IPvX>& except_sources,
+				   action_jp_t action_jp) const;
+
     /**
      * Timeout: one of the older version host present timers has expired.
      */
@@ -359,8 +372,13 @@ private:
     XorpTimer	_igmpv2_mldv1_host_present_timer;
 
     XorpTimer	_group_timer;		// Group timer for filter mode switch
-    XorpTimer	_group_query_timer;	// Timer for periodic Queries
     size_t	_query_retransmission_count; // Count for periodic Queries
+
+    // State kept by the group set
+    friend class Mld6igmpGroupSet;
+    Mld6igmpGroupRecord* _hash_next;	// Next record in the hash bucket
+    size_t	_group_query_index;	// Index among the records to query
+    TimeVal	_group_query_due;	// When the next Queries are due
 };
 
 /**
@@ -389,11 +407,39 @@ public:
      */
     Mld6igmpGroupRecord* find_group_record(const IPvX& group);
 
+    /**
+     * Remove a group record from the set.
+     *
+     * Note that the group record itself is not deleted.
+     *
+     * @param group_record the group record to remove.
+     */
+    void erase_group_record(Mld6igmpGroupRecord* group_record);
+
     /**
      * Delete the payload of the set, and clear the set itself.
      */
     void delete_payload_and_clear();
 
+    /**
+     * Schedule the periodic Group-Specific and Group-and-Source-Specific
+     * Query retransmissions of a group record.
+     *
+     * The queries of all group records are sent by a single timer that
+     * expires when the earliest of them is due.  Each group record is
+     * retransmitted one Last Member Query Interval after its previous
+     * query.
+     *
+     * @param group_record the group record.
+     */
+    void schedule_group_query(Mld6igmpGroupRecord* group_record);
+
+    /**
+     * Reschedule the pending Group-Specific and Group-and-Source-Specific
+     * Query retransmissions after the Last Member Query Interval has changed.
+     */
+    void reschedule_group_queries();
+
     /**
      * Process MODE_IS_INCLUDE report.
      *
@@ -483,7 +529,43 @@ public:
 			    const TimeVal& timeval);
 
 private:
+    /**
+     * Find a group record, and create it if it does not exist.
+     *
+     * @param group the group address.
+     * @return the group record.
+     */
+    Mld6igmpGroupRecord* find_or_create_group_record(const IPvX& group);
+
+    /**
+     * Delete a group record if it is not used anymore.
+     *
+     * @param group_record the group record.
+     */
+    void delete_group_record_if_unused(Mld6igmpGroupRecord* group_record);
+
+    size_t hash_index(const IPvX& group) const;
+    void hash_insert(Mld6igmpGroupRecord* group_record);
+    void hash_remove(Mld6igmpGroupRecord* group_record);
+
+    void unschedule_group_query(Mld6igmpGroupRecord* group_record);
+    void group_query_timer_schedule();
+
+    /**
+     * Timeout: time to send the next Group-Specific and
+     * Group-and-Source-Specific Queries for the group records that are due.
+     */
+    void group_query_timer_timeout();
+
     Mld6igmpVif& _mld6igmp_vif;		// The interface this set belongs to
+
+    // Hash table of the group records, chained through their _hash_next.
+    // The map is kept for walking the records in address order.
+    vector<Mld6igmpGroupRecord *> _hash;
+
+    // The group records with Queries to retransmit
+    vector<Mld6igmpGroupRecord *> _group_query_records;
+    XorpTimer	_group_query_timer;	// Timer for periodic Queries
 };
 
 //
@@ -856,6 +856,7 @@ Mld6igmpVif::set_query_last_member_interval_cb(TimeVal v)
 {
     UNUSED(v);
     recalculate_last_member_query_time();
+    _group_records.reschedule_group_queries();
 }
 
 void
@@ -228,22 +228,101 @@ Mld6igmpSourceSet::Mld6igmpSourceSet(const Mld6igmpSourceSet& other) :
 Mld6igmpSourceSet&
 Mld6igmpSourceSet::operator=(const Mld6igmpSourceSet& other)
 {
-    Mld6igmpSourceSet::const_iterator iter;
-
     XLOG_ASSERT(&_group_record == &(other._group_record));
 
-    this->clear();
-
     //
     // Copy the payload of the set
     //
-    for (iter = other.begin(); iter != other.end(); ++iter) {
-	insert(make_pair(iter->first, iter->second));
-    }
+    map<IPvX, Mld6igmpSourceRecord *>::operator=(other);
 
     return (*this);
 }
 
+//
+// The set operations below walk both sets together in address order, and
+// build the result in the same order, so each element is added at the end
+// of the result.  If one set is much smaller than the other, its elements
+// are looked up in the larger set instead.
+//
+static const size_t SOURCE_SET_MERGE_RATIO = 8;
+
+static inline const IPvX&
+source_key(Mld6igmpSourceSet::const_iterator iter)
+{
+    return (iter->first);
+}
+
+static inline const IPvX&
+source_key(set<IPvX>::const_iterator iter)
+{
+    return (*iter);
+}
+
+static inline void
+source_set_append(Mld6igmpSourceSet& result,
+		  const Mld6igmpSourceSet::value_type& value)
+{
+    result.insert(result.end(), value);
+}
+
+static inline void
+source_set_append(vector<Mld6igmpSourceRecord *>& result,
+		  const Mld6igmpSourceSet::value_type& value)
+{
+    result.push_back(value.second);
+}
+
+static inline bool
+source_set_lookup_is_cheaper(size_t small_size, size_t large_size)
+{
+    return (small_size * SOURCE_SET_MERGE_RATIO < large_size);
+}
+
+/**
+ * Add to a result set the elements of a set that are (or are not) in a
+ * second set.
+ *
+ * @param a the set with the elements to add.
+ * @param b the second set.
+ * @param in_b if true, add the elements that are in @ref b, otherwise
+ * the elements that are not in @ref b.
+ * @param result the set (or vector of records) to add the elements to.
+ */
+template <class S, class R>
+static void
+source_set_select(const Mld6igmpSourceSet& a, const S& b, bool in_b,
+		  R& result)
+{
+    Mld6igmpSourceSet::const_iterator a_iter = a.begin();
+    typename S::const_iterator b_iter = b.begin();
+
+    if (in_b && source_set_lookup_is_cheaper(b.size(), a.size())) {
+	for ( ; b_iter != b.end(); ++b_iter) {
+	    a_iter = a.find(source_key(b_iter));
+	    if (a_iter != a.end())
+		source_set_append(result, *a_iter);
+	}
+	return;
+    }
+
+    while (a_iter != a.end()) {
+	if ((b_iter == b.end()) || (a_iter->first < source_key(b_iter))) {
+	    if (! in_b)
+		source_set_append(result, *a_iter);
+	    ++a_iter;
+	    continue;
+	}
+	if (source_key(b_iter) < a_iter->first) {
+	    ++b_iter;
+	    continue;
+	}
+	if (in_b)
+	    source_set_append(result, *a_iter);
+	++a_iter;
+	++b_iter;
+    }
+}
+
 /**
  * UNION operator for sets.
  *
@@ -254,16 +333,29 @@ Mld6igmpSourceSet::operator=(const Mld6igmpSourceSet& other)
 Mld6igmpSourceSet
 Mld6igmpSourceSet::operator+(const Mld6igmpSourceSet& other)
 {
-    Mld6igmpSourceSet result(*this);	// XXX: all elements from the first set
-    Mld6igmpSourceSet::const_iterator iter;
+    Mld6igmpSourceSet result(_group_record);
+    Mld6igmpSourceSet::const_iterator iter1 = this->begin();
+    Mld6igmpSourceSet::const_iterator iter2 = other.begin();
 
     //
-    // Insert all elements from the second set that are not in the first set
+    // Insert all elements from the first set, and the elements from
+    // the second set that are not in the first set.
     //
-    for (iter = other.begin(); iter != other.end(); ++iter) {
-	const IPvX& ipvx = iter->first;
-	if (result.find(ipvx) == result.end())
-	    result.insert(make_pair(iter->first, iter->second));
+    while ((iter1 != this->end()) || (iter2 != other.end())) {
+	if ((iter2 == other.end())
+	    || ((iter1 != this->end()) && (iter1->first < iter2->first))) {
+	    result.insert(result.end(), *iter1);
+	    ++iter1;
+	    continue;
+	}
+	if ((iter1 == this->end()) || (iter2->first < iter1->first)) {
+	    result.insert(result.end(), *iter2);
+	    ++iter2;
+	    continue;
+	}
+	result.insert(result.end(), *iter1);
+	++iter1;
+	++iter2;
     }
 
     return (result);
@@ -280,19 +372,32 @@ Mld6igmpSourceSet::operator+(const Mld6igmpSourceSet& other)
 Mld6igmpSourceSet
 Mld6igmpSourceSet::operator+(const set<IPvX>& other)
 {
-    Mld6igmpSourceSet result(*this);	// XXX: all elements from the first set
-    set<IPvX>::const_iterator iter;
+    Mld6igmpSourceSet result(_group_record);
+    Mld6igmpSourceSet::const_iterator iter1 = this->begin();
+    set<IPvX>::const_iterator iter2 = other.begin();
     Mld6igmpSourceRecord* source_record;
 
     //
-    // Insert all elements from the second set that are not in the first set
+    // Insert all elements from the first set, and create the elements from
+    // the second set that are not in the first set.
     //
-    for (iter = other.begin(); iter != other.end(); ++iter) {
-	const IPvX& ipvx = *iter;
-	if (result.find(ipvx) == result.end()) {
+    while ((iter1 != this->end()) || (iter2 != other.end())) {
+	if ((iter2 == other.end())
+	    || ((iter1 != this->end()) && (iter1->first < *iter2))) {
+	    result.insert(result.end(), *iter1);
+	    ++iter1;
+	    continue;
+	}
+	if ((iter1 == this->end()) || (*iter2 < iter1->first)) {
+	    const IPvX& ipvx = *iter2;
 	    source_record = new Mld6igmpSourceRecord(_group_record, ipvx);
-	    result.insert(make_pair(ipvx, source_record));
+	    result.insert(result.end(), make_pair(ipvx, source_record));
+	    ++iter2;
+	    continue;
 	}
+	result.insert(result.end(), *iter1);
+	++iter1;
+	++iter2;
     }
 
     return (result);
@@ -309,16 +414,11 @@ Mld6igmpSourceSet
 Mld6igmpSourceSet::operator*(const Mld6igmpSourceSet& other)
 {
     Mld6igmpSourceSet result(_group_record);
-    Mld6igmpSourceSet::const_iterator iter;
 
     //
     // Insert all elements from the first set that are also in the second set
     //
-    for (iter = this->begin(); iter != this->end(); ++iter) {
-	const IPvX& ipvx = iter->first;
-	if (other.find(ipvx) != other.end())
-	    result.insert(make_pair(iter->first, iter->second));
-    }
+    source_set_select(*this, other, true, result);
 
     return (result);
 }
@@ -335,16 +435,11 @@ Mld6igmpSourceSet
 Mld6igmpSourceSet::operator*(const set<IPvX>& other)
 {
     Mld6igmpSourceSet result(_group_record);
-    Mld6igmpSourceSet::const_iterator iter;
 
     //
     // Insert all elements from the first set that are also in the second set
     //
-    for (iter = this->begin(); iter != this->end(); ++iter) {
-	const IPvX& ipvx = iter->first;
-	if (other.find(ipvx) != other.end())
-	    result.insert(make_pair(iter->first, iter->second));
-    }
+    source_set_select(*this, other, true, result);
 
     return (result);
 }
@@ -360,16 +455,11 @@ Mld6igmpSourceSet
 Mld6igmpSourceSet::operator-(const Mld6igmpSourceSet& other)
 {
     Mld6igmpSourceSet result(_group_record);
-    Mld6igmpSourceSet::const_iterator iter;
 
     //
     // Insert all elements from the first set that are not in the second set
     //
-    for (iter = this->begin(); iter != this->end(); ++iter) {
-	const IPvX& ipvx = iter->first;
-	if (other.find(ipvx) == other.end())
-	    result.insert(make_pair(iter->first, iter->second));
-    }
+    source_set_select(*this, other, false, result);
 
     return (result);
 }
@@ -386,20 +476,30 @@ Mld6igmpSourceSet
 Mld6igmpSourceSet::operator-(const set<IPvX>& other)
 {
     Mld6igmpSourceSet result(_group_record);
-    Mld6igmpSourceSet::const_iterator iter;
 
     //
     // Insert all elements from the first set that are not in the second set
     //
-    for (iter = this->begin(); iter != this->end(); ++iter) {
-	const IPvX& ipvx = iter->first;
-	if (other.find(ipvx) == other.end())
-	    result.insert(make_pair(iter->first, iter->second));
-    }
+    source_set_select(*this, other, false, result);
 
     return (result);
 }
 
+/**
+ * Find the source records for a set of source addresses.
+ *
+ * @param sources the source addresses.
+ * @param source_records the vector to add the source records to, in
+ * address order.
+ */
+void
+Mld6igmpSourceSet::find_source_records(
+    const set<IPvX>& sources,
+    vector<Mld6igmpSourceRecord *>& source_records) const
+{
+    source_set_select(*this, sources, true, source_records);
+}
+
 /**
  * Set the source timer for a set of source addresses.
  *
@@ -411,16 +511,13 @@ void
 Mld6igmpSourceSet::set_source_timer(const set<IPvX>& sources,
 				    const TimeVal& timeval)
 {
-    set<IPvX>::const_iterator iter;
-    Mld6igmpSourceSet::iterator record_iter;
-
-    for (iter = sources.begin(); iter != sources.end(); ++iter) {
-	const IPvX& ipvx = *iter;
-	record_iter = this->find(ipvx);
-	if (record_iter != this->end()) {
-	    Mld6igmpSourceRecord* source_record = record_iter->second;
-	    source_record->set_source_timer(timeval);
-	}
+    vector<Mld6igmpSourceRecord *> source_records;
+    vector<Mld6igmpSourceRecord *>::iterator iter;
+
+    find_source_records(sources, source_records);
+    for (iter = source_records.begin(); iter != source_records.end(); ++iter) {
+	Mld6igmpSourceRecord* source_record = *iter;
+	source_record->set_source_timer(timeval);
     }
 }
 
@@ -449,16 +546,13 @@ Mld6igmpSourceSet::set_source_timer(const TimeVal& timeval)
 void
 Mld6igmpSourceSet::cancel_source_timer(const set<IPvX>& sources)
 {
-    set<IPvX>::const_iterator iter;
-    Mld6igmpSourceSet::iterator record_iter;
-
-    for (iter = sources.begin(); iter != sources.end(); ++iter) {
-	const IPvX& ipvx = *iter;
-	record_iter = this->find(ipvx);
-	if (record_iter != this->end()) {
-	    Mld6igmpSourceRecord* source_record = record_iter->second;
-	    source_record->cancel_source_timer();
-	}
+    vector<Mld6igmpSourceRecord *> source_records;
+    vector<Mld6igmpSourceRecord *>::iterator iter;
+
+    find_source_records(sources, source_records);
+    for (iter = source_records.begin(); iter != source_records.end(); ++iter) {
+	Mld6igmpSourceRecord* source_record = *iter;
+	source_record->cancel_source_timer();
     }
 }
 
@@ -487,16 +581,13 @@ void
 Mld6igmpSourceSet::lower_source_timer(const set<IPvX>& sources,
 				      const TimeVal& timeval)
 {
-    set<IPvX>::const_iterator iter;
-    Mld6igmpSourceSet::iterator record_iter;
-
-    for (iter = sources.begin(); iter != sources.end(); ++iter) {
-	const IPvX& ipvx = *iter;
-	record_iter = this->find(ipvx);
-	if (record_iter != this->end()) {
-	    Mld6igmpSourceRecord* source_record = record_iter->second;
-	    source_record->lower_source_timer(timeval);
-	}
+    vector<Mld6igmpSourceRecord *> source_records;
+    vector<Mld6igmpSourceRecord *>::iterator iter;
+
+    find_source_records(sources, source_records);
+    for (iter = source_records.begin(); iter != source_records.end(); ++iter) {
+	Mld6igmpSourceRecord* source_record = *iter;
+	source_record->lower_source_timer(timeval);
     }
 }
 
@@ -516,7 +607,7 @@ Mld6igmpSourceSet::extract_source_addresses() const
 	 ++record_iter) {
 	const Mld6igmpSourceRecord* source_record = record_iter->second;
 	const IPvX& ipvx = source_record->source();
-	sources.insert(ipvx);
+	sources.insert(sources.end(), ipvx);	// XXX: in address order
     }
 
     return (sources);
@@ -174,6 +174,16 @@ public:
      */
     Mld6igmpSourceRecord* find_source_record(const IPvX& source);
 
+    /**
+     * Find the source records for a set of source addresses.
+     *
+     * @param sources the source addresses.
+     * @param source_records the vector to add the source records to, in
+     * address order. Addresses that are not in this set are skipped.
+     */
+    void find_source_records(const set<IPvX>& sources,
+			     vector<Mld6igmpSourceRecord *>& source_records) const;
+
     /**
      * Delete the payload of the set, and clear the set itself.
      */
@@ -700,7 +700,8 @@ Mld6igmpVif::mld6igmp_group_source_query_send(const IPvX& group_address,
     const TimeVal& max_resp_time = query_last_member_interval().get();
     Mld6igmpGroupRecord* group_record = NULL;
     set<IPvX> selected_sources;
-    set<IPvX>::const_iterator source_iter;
+    vector<Mld6igmpSourceRecord *> source_records;
+    vector<Mld6igmpSourceRecord *>::const_iterator source_iter;
     int ret_value;
 
     //
@@ -721,20 +722,20 @@ Mld6igmpVif::mld6igmp_group_source_query_send(const IPvX& group_address,
     // Select only the sources with source timer larger than the
     // Last Member Query Time.
     //
-    for (source_iter = sources.begin();
-	 source_iter != sources.end();
+    group_record->do_forward_sources().find_source_records(sources,
+							   source_records);
+    for (source_iter = source_records.begin();
+	 source_iter != source_records.end();
 	 ++source_iter) {
-	const IPvX& ipvx = *source_iter;
-	Mld6igmpSourceRecord* source_record;
-	source_record = group_record->find_do_forward_source(ipvx);
-	if (source_record == NULL)
-	    continue;
+	Mld6igmpSourceRecord* source_record = *source_iter;
 
 	TimeVal timeval_remaining;
 	source_record->source_timer().time_remaining(timeval_remaining);
 	if (timeval_remaining <= last_member_query_time())
 	    continue;
-	selected_sources.insert(ipvx);
+	// XXX: the records are in address order
+	selected_sources.insert(selected_sources.end(),
+				source_record->source());
     }
     if (selected_sources.empty())
 	return (XORP_OK);		// No selected sources to query
@@ -0,0 +1,289 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+//
+// IGMPv3/MLDv2 report processing benchmark.
+//
+// Runs the group and source state of a single interface through the
+// records of Membership Reports: many groups with many sources each, as on
+// an edge router with many subscribers.  Each kind of record is timed
+// separately.  Only the state is updated: no packets are sent, and the
+// membership changes are counted instead of being sent to the routing
+// protocols.
+//
+
+#include "mld6igmp/mld6igmp_module.h"
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+#include "libxorp/timer.hh"
+#include "libfeaclient/ifmgr_atoms.hh"
+#include "mld6igmp/mld6igmp_node.hh"
+#include "mld6igmp/mld6igmp_vif.hh"
+#include "mld6igmp/mld6igmp_group_record.hh"
+
+#ifdef HAVE_GETOPT_H
+#include <getopt.h>
+#endif
+
+namespace {
+
+/**
+ * A node that only keeps the state.
+ */
+class BenchNode : public Mld6igmpNode {
+public:
+    BenchNode(EventLoop& eventloop)
+	: Mld6igmpNode(AF_INET, XORP_MODULE_MLD6IGMP, eventloop),
+	  _joins(0), _prunes(0) {}
+
+    int proto_send(const string&, const string&, const IPvX&, const IPvX&,
+		   uint8_t, int32_t, int32_t, bool, bool, const uint8_t*,
+		   size_t, string&) {
+	return (XORP_OK);
+    }
+    int register_receiver(const string&, const string&, uint8_t, bool) {
+	return (XORP_OK);
+    }
+    int unregister_receiver(const string&, const string&, uint8_t) {
+	return (XORP_OK);
+    }
+    int join_multicast_group(const string&, const string&, uint8_t,
+			     const IPvX&) {
+	return (XORP_OK);
+    }
+    int leave_multicast_group(const string&, const string&, uint8_t,
+			      const IPvX&) {
+	return (XORP_OK);
+    }
+    int send_add_membership(const string&, xorp_module_id, uint32_t,
+			    const IPvX&, const IPvX&) {
+	_joins++;
+	return (XORP_OK);
+    }
+    int send_delete_membership(const string&, xorp_module_id, uint32_t,
+			       const IPvX&, const IPvX&) {
+	_prunes++;
+	return (XORP_OK);
+    }
+    const ServiceBase* ifmgr_mirror_service_base() const { return (NULL); }
+    const IfMgrIfTree& ifmgr_iftree() const { return (_iftree); }
+    void fea_register_startup() {}
+    void mfea_register_startup() {}
+    void fea_register_shutdown() {}
+    void mfea_register_shutdown() {}
+
+    uint64_t joins() const { return (_joins); }
+    uint64_t prunes() const { return (_prunes); }
+
+private:
+    IfMgrIfTree	_iftree;
+    uint64_t	_joins;
+    uint64_t	_prunes;
+};
+
+struct conf {
+    unsigned	    c_iterations;
+    unsigned	    c_groups;
+    unsigned	    c_sources;
+} _conf;
+
+void
+usage(const string& progname)
+{
+    cout << "Usage: " << progname << " <opts>" << endl
+	 << "-g\t<number of groups>" << endl
+	 << "-s\t<number of sources in each record>" << endl
+	 << "-i\t<iterations>" << endl
+	 << "-h\thelp" << endl;
+
+    exit(1);
+}
+
+void
+get_time(TimeVal& tv)
+{
+    TimerList::system_gettimeofday(&tv);
+}
+
+IPvX
+group_addr(unsigned i)
+{
+    return (IPvX(IPv4(htonl(0xe8000000U | i))));	// 232.0.0.0/8
+}
+
+/**
+ * The sources of a record: @ref count sources starting from the
+ * @ref first one, so records that start close to each other overlap.
+ */
+set<IPvX>
+sources(unsigned first, unsigned count)
+{
+    set<IPvX> s;
+
+    for (unsigned i = first; i < first + count; i++)
+	s.insert(s.end(), IPvX(IPv4(htonl(0x0a000000U | i))));	// 10/8
+
+    return (s);
+}
+
+typedef void (Mld6igmpGroupSet::*Process)(const IPvX&, const set<IPvX>&,
+					  const IPvX&);
+
+/**
+ * Apply one kind of record to all groups, and print the time it took.
+ */
+void
+benchmark(Mld6igmpGroupSet& groups, const char* name, Process process,
+	  unsigned first, unsigned count, TimeVal& total)
+{
+    set<IPvX> s = sources(first, count);
+    IPvX host(IPv4("192.168.0.2"));
+    TimeVal start, end;
+
+    get_time(start);
+
+    for (unsigned g = 0; g < _conf.c_groups; g++)
+	(groups.*process)(group_addr(g), s, host);
+
+    get_time(end);
+
+    double elapsed = (end - start).to_ms();
+
+    printf("%-10s %10.0f records/s, %10.0f sources/s (%d ms)\n", name,
+	   elapsed > 0 ? _conf.c_groups / elapsed * 1000.0 : 0.0,
+	   elapsed > 0 ? double(_conf.c_groups) * count / elapsed * 1000.0
+	   : 0.0,
+	   (int) elapsed);
+
+    total += end - start;
+}
+
+void
+own()
+{
+    EventLoop eventloop;
+    BenchNode node(eventloop);
+    Vif vif("bench0");
+    string error_msg;
+
+    vif.set_vif_index(1);
+    vif.set_underlying_vif_up(true);
+    vif.set_multicast_capable(true);
+    if (node.add_vif(vif, error_msg) != XORP_OK)
+	XLOG_FATAL("Cannot add vif: %s", error_msg.c_str());
+    if (node.add_protocol("bench", XORP_MODULE_PIMSM, 1) != XORP_OK)
+	XLOG_FATAL("Cannot add protocol");
+
+    Mld6igmpVif* mld6igmp_vif = node.vif_find_by_vif_index(1);
+    XLOG_ASSERT(mld6igmp_vif != NULL);
+    Mld6igmpGroupSet& groups = mld6igmp_vif->group_records();
+    unsigned n = _conf.c_sources;
+    TimeVal total;
+
+    cout << "Processing records for " << _conf.c_groups << " groups with "
+	 << n << " sources each, " << _conf.c_iterations << " times" << endl;
+
+    for (unsigned it = 0; it < _conf.c_iterations; it++) {
+	// INCLUDE (A)
+	benchmark(groups, "IS_IN", &Mld6igmpGroupSet::process_mode_is_include,
+		  0, n, total);
+	// INCLUDE (A + B), with half of B in A
+	benchmark(groups, "ALLOW",
+		  &Mld6igmpGroupSet::process_allow_new_sources,
+		  n / 2, n, total);
+	// Refresh the timers of the same sources
+	benchmark(groups, "IS_IN", &Mld6igmpGroupSet::process_mode_is_include,
+		  n / 2, n, total);
+	// INCLUDE (A - B)
+	benchmark(groups, "BLOCK",
+		  &Mld6igmpGroupSet::process_block_old_sources,
+		  0, n / 2, total);
+	// EXCLUDE (A * B, B - A)
+	benchmark(groups, "TO_EX",
+		  &Mld6igmpGroupSet::process_change_to_exclude_mode,
+		  n / 4, n, total);
+	// EXCLUDE (A - Y, Y * A)
+	benchmark(groups, "IS_EX", &Mld6igmpGroupSet::process_mode_is_exclude,
+		  n / 2, n, total);
+	// EXCLUDE (X + A, Y - A)
+	benchmark(groups, "TO_IN",
+		  &Mld6igmpGroupSet::process_change_to_include_mode,
+		  0, n, total);
+
+	groups.delete_payload_and_clear();
+    }
+
+    printf("Total %d ms, %llu joins, %llu prunes\n", (int) total.to_ms(),
+	   (unsigned long long) node.joins(),
+	   (unsigned long long) node.prunes());
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    int opt;
+
+    _conf.c_iterations = 10;
+    _conf.c_groups     = 1000;
+    _conf.c_sources    = 100;
+
+    while ((opt = getopt(argc, argv, "hg:i:s:")) != -1) {
+	switch (opt) {
+	    case 'g':
+		_conf.c_groups = atoi(optarg);
+		break;
+
+	    case 'i':
+		_conf.c_iterations = atoi(optarg);
+		break;
+
+	    case 's':
+		_conf.c_sources = atoi(optarg);
+		break;
+
+	    case 'h': // fall-through
+	    default:
+		usage(argv[0]);
+		break;
+	}
+    }
+
+    xlog_init(argv[0], 0);
+    xlog_set_verbose(XLOG_VERBOSE_HIGH);
+    xlog_disable(XLOG_LEVEL_TRACE);
+    xlog_disable(XLOG_LEVEL_INFO);
+    xlog_add_default_output();
+    xlog_start();
+
+    try {
+	own();
+    } catch (const XorpReasonedException& e) {
+	cout << "Death: " << e.str() << endl;
+	exit(1);
+    }
+
+    xlog_stop();
+    xlog_exit();
+
+    exit(0);
+}
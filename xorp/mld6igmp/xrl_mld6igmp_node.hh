@@ -236,6 +236,22 @@ protected:
 	const bool&	ip_internet_control,
 	const vector<uint8_t>&	payload);
 
+    /**
+     *  Receive several IPv4 packets from a raw socket.
+     */
+    XrlCmdError raw_packet4_client_0_1_recv_batch(
+	// Input values,
+	const XrlAtomList&	if_names,
+	const XrlAtomList&	vif_names,
+	const XrlAtomList&	src_addresses,
+	const XrlAtomList&	dst_addresses,
+	const XrlAtomList&	ip_protocols,
+	const XrlAtomList&	ip_ttls,
+	const XrlAtomList&	ip_toses,
+	const XrlAtomList&	ip_router_alerts,
+	const XrlAtomList&	ip_internet_controls,
+	const XrlAtomList&	payloads);
+
     /**
      *  Receive an IPv6 packet from a raw socket.
      *
@@ -281,6 +297,25 @@ protected:
 	const XrlAtomList&	ext_headers_type,
 	const XrlAtomList&	ext_headers_payload,
 	const vector<uint8_t>&	payload);
+
+    /**
+     *  Receive several IPv6 packets from a raw socket.
+     */
+    XrlCmdError raw_packet6_client_0_1_recv_batch(
+	// Input values,
+	const XrlAtomList&	if_names,
+	const XrlAtomList&	vif_names,
+	const XrlAtomList&	src_addresses,
+	const XrlAtomList&	dst_addresses,
+	const XrlAtomList&	ip_protocols,
+	const XrlAtomList&	ip_ttls,
+	const XrlAtomList&	ip_toses,
+	const XrlAtomList&	ip_router_alerts,
+	const XrlAtomList&	ip_internet_controls,
+	const XrlAtomList&	ext_headers_counts,
+	const XrlAtomList&	ext_headers_type,
+	const XrlAtomList&	ext_headers_payload,
+	const XrlAtomList&	payloads);
     
     /**
      *  Enable/disable/start/stop a MLD6IGMP vif interface.
@@ -52,6 +52,194 @@
 // Local functions prototypes
 //
 
+// Words in a set of MAX_VIFS interfaces, and the bits used in the last one
+static const size_t MIFSET_WORDS = (MAX_VIFS + Mifset::WORD_BITS - 1)
+    / Mifset::WORD_BITS;
+static const size_t MIFSET_LAST_BITS = MAX_VIFS
+    - (MIFSET_WORDS - 1) * Mifset::WORD_BITS;
+
+static inline Mifset::Word
+mifset_word_mask(size_t w)
+{
+    if (w + 1 < MIFSET_WORDS)
+	return ~static_cast<Mifset::Word>(0);
+    return ~static_cast<Mifset::Word>(0)
+	>> (Mifset::WORD_BITS - MIFSET_LAST_BITS);
+}
+
+static inline size_t
+mifset_word_count(Mifset::Word word)
+{
+    size_t n = 0;
+
+    for (; word != 0; word &= word - 1)
+	n++;
+    return n;
+}
+
+Mifset&
+Mifset::set()
+{
+    _word0 = mifset_word_mask(0);
+    if (MIFSET_WORDS > 1) {
+	grow_more(MIFSET_WORDS - 1);
+	for (size_t w = 1; w < MIFSET_WORDS; w++)
+	    more()[w] = mifset_word_mask(w);
+    }
+    return *this;
+}
+
+Mifset&
+Mifset::flip()
+{
+    _word0 = ~_word0 & mifset_word_mask(0);
+    if (MIFSET_WORDS > 1) {
+	grow_more(MIFSET_WORDS - 1);
+	for (size_t w = 1; w < MIFSET_WORDS; w++)
+	    more()[w] = ~more()[w] & mifset_word_mask(w);
+	trim_more();
+    }
+    return *this;
+}
+
+size_t
+Mifset::count() const
+{
+    size_t n = mifset_word_count(_word0);
+
+    for (size_t w = 1; w <= more_words(); w++)
+	n += mifset_word_count(more()[w]);
+    return n;
+}
+
+size_t
+Mifset::find_from(size_t vif_index) const
+{
+    size_t w = vif_index / WORD_BITS;
+    size_t last = more_words();
+
+    if (vif_index >= size())
+	return size();
+
+    for (Word word; w <= last; w++, vif_index = w * WORD_BITS) {
+	word = (w == 0) ? _word0 : more()[w];
+	word >>= vif_index % WORD_BITS;
+	if (word == 0)
+	    continue;
+	while (! (word & 1)) {
+	    word >>= 1;
+	    vif_index++;
+	}
+	return vif_index;
+    }
+    return size();
+}
+
+Mifset&
+Mifset::operator&=(const Mifset& other)
+{
+    size_t n = min(more_words(), other.more_words());
+
+    _word0 &= other._word0;
+    if (more() == NULL)
+	return *this;
+    for (size_t w = 1; w <= n; w++)
+	more()[w] &= other.more()[w];
+    for (size_t w = n + 1; w <= more_words(); w++)
+	more()[w] = 0;
+    trim_more();
+    return *this;
+}
+
+Mifset&
+Mifset::operator|=(const Mifset& other)
+{
+    size_t n = other.more_words();
+
+    _word0 |= other._word0;
+    if (n == 0)
+	return *this;
+    if (n > more_words())
+	grow_more(n);
+    for (size_t w = 1; w <= n; w++)
+	more()[w] |= other.more()[w];
+    return *this;
+}
+
+Mifset&
+Mifset::operator^=(const Mifset& other)
+{
+    size_t n = other.more_words();
+
+    _word0 ^= other._word0;
+    if (n == 0)
+	return *this;
+    if (n > more_words())
+	grow_more(n);
+    for (size_t w = 1; w <= n; w++)
+	more()[w] ^= other.more()[w];
+    trim_more();
+    return *this;
+}
+
+bool
+Mifset::operator==(const Mifset& other) const
+{
+    // Both sets end with a nonzero word, so equal sets are the same length
+    if (_word0 != other._word0 || more_words() != other.more_words())
+	return false;
+    for (size_t w = 1; w <= more_words(); w++) {
+	if (more()[w] != other.more()[w])
+	    return false;
+    }
+    return true;
+}
+
+void
+MifsetMoreWords<true>::grow_more(size_t last_word)
+{
+    size_t n = more_words();
+
+    if (last_word <= n)
+	return;
+
+    Word* more = new Word[last_word + 1];
+    more[0] = last_word;
+    for (size_t w = 1; w <= n; w++)
+	more[w] = _more[w];
+    for (size_t w = n + 1; w <= last_word; w++)
+	more[w] = 0;
+    delete[] _more;
+    _more = more;
+}
+
+void
+MifsetMoreWords<true>::trim_more()
+{
+    size_t n = more_words();
+
+    // Keep the allocation, only forget the trailing empty words
+    while (n > 0 && _more[n] == 0)
+	n--;
+    if (n == 0)
+	free_more();
+    else
+	_more[0] = n;
+}
+
+void
+MifsetMoreWords<true>::copy_more(const MifsetMoreWords& other)
+{
+    size_t n = other.more_words();
+
+    if (n != more_words()) {
+	delete[] _more;
+	_more = new Word[n + 1];
+    }
+    for (size_t w = 0; w <= n; w++)
+	_more[w] = other._more[w];
+}
+
 
 void
 mifset_to_array(const Mifset& mifset, uint8_t *array)
@@ -65,11 +253,11 @@ mifset_to_array(const Mifset& mifset, uint8_t *array)
 	array[i] = 0;		// XXX: the extra, semi-filled byte
     
     // Set the bits
-    for (size_t i = 0; i < mifset.size(); i++) {
+    for (size_t i = mifset.find_first(); i < mifset.size();
+	 i = mifset.find_next(i)) {
 	size_t byte = i / sizeof(array[0]);
 	size_t bit = i % sizeof(array[0]);
-	if (mifset.test(i))
-	    array[byte] |= (1 << bit);
+	array[byte] |= (1 << bit);
     }
 }
 
@@ -98,11 +286,11 @@ mifset_to_vector(const Mifset& mifset, vector<uint8_t>& vector)
 	vector[i] = 0;
     
     // Set the bits
-    for (size_t i = 0; i < mifset.size(); i++) {
+    for (size_t i = mifset.find_first(); i < mifset.size();
+	 i = mifset.find_next(i)) {
 	size_t byte = i / sizeof(vector[0]);
 	size_t bit = i % sizeof(vector[0]);
-	if (mifset.test(i))
-	    vector[byte] |= (1 << bit);
+	vector[byte] |= (1 << bit);
     }
 }
 
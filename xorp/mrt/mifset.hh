@@ -33,11 +33,10 @@
 #include <sys/types.h>
 
 #include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+
 #include "max_vifs.h"
 
-#ifndef XORP_USE_USTL
-#include <bitset>
-#endif
 
 //
 // Constants definitions
@@ -47,9 +46,205 @@
 // Structures/classes, typedefs and macros
 //
 
-// Interface array bitmask
+/**
+ * @short The words of a Mifset past the first one.
+ *
+ * A set that fits in one word has no other word: this is then an empty
+ * base class, and the set is a single word like bitset<MAX_VIFS>.
+ */
+template <bool Wide>
+class MifsetMoreWords {
+protected:
+    typedef unsigned long	Word;
+
+    Word* more() const { return NULL; }
+    size_t more_words() const { return 0; }
+    void grow_more(size_t /* last_word */) { XLOG_UNREACHABLE(); }
+    void trim_more() {}
+    void free_more() {}
+};
+
+/**
+ * @short The words of a Mifset past the first one, for sets wider than a
+ * word.
+ *
+ * The words are allocated up to the last nonzero one, and freed when the
+ * set no longer has any interface past the first word.
+ */
+template <>
+class MifsetMoreWords<true> {
+protected:
+    typedef unsigned long	Word;
+
+    MifsetMoreWords() : _more(NULL) {}
+    MifsetMoreWords(const MifsetMoreWords& other) : _more(NULL) {
+	if (other._more != NULL)
+	    copy_more(other);
+    }
+    ~MifsetMoreWords() { delete[] _more; }
+
+    MifsetMoreWords& operator=(const MifsetMoreWords& other) {
+	if (other._more != NULL)
+	    copy_more(other);
+	else
+	    free_more();
+	return *this;
+    }
+
+    Word* more() const { return _more; }
+
+    // Index of the last word in more().  Word 0 holds the count, so the
+    // others are numbered like the words of the set.
+    size_t more_words() const {
+	return (_more == NULL) ? 0 : static_cast<size_t>(_more[0]);
+    }
+
+    void grow_more(size_t last_word);
+    void trim_more();
+    void free_more() {
+	delete[] _more;
+	_more = NULL;
+    }
+
+private:
+    void copy_more(const MifsetMoreWords& other);
+
+    Word	*_more;		// the other words up to the last nonzero one
+};
+
+/**
+ * @short Interface array bitmask.
+ *
+ * The set has the interface of bitset<MAX_VIFS>.  The first word is kept
+ * inline.  If MAX_VIFS fits in it, that is all there is, and the set is
+ * the size of bitset<MAX_VIFS>.  Otherwise the set only keeps the words up
+ * to the highest interface in it, so that MAX_VIFS can be raised without
+ * growing every multicast routing entry by the full width of the set.
+ *
+ * The bulk operations work a word at a time on the words in use.
+ */
+class Mifset : private MifsetMoreWords<(MAX_VIFS > 8 * sizeof(unsigned long))> {
+public:
+    typedef unsigned long	Word;
+    enum { WORD_BITS = sizeof(Word) * 8 };
+
+    Mifset() : _word0(0) {}
+
+    /**
+     * @return the number of interfaces the set can hold: MAX_VIFS.
+     */
+    size_t size() const { return MAX_VIFS; }
+
+    bool test(size_t vif_index) const {
+	if (vif_index < WORD_BITS)
+	    return (_word0 >> vif_index) & 1;
+	size_t w = vif_index / WORD_BITS;
+	if (w > more_words())
+	    return false;
+	return (more()[w] >> (vif_index % WORD_BITS)) & 1;
+    }
+    bool operator[](size_t vif_index) const { return test(vif_index); }
+
+    Mifset& set(size_t vif_index) {
+	XLOG_ASSERT(vif_index < size());
+	if (vif_index < WORD_BITS) {
+	    _word0 |= bit(vif_index);
+	    return *this;
+	}
+	size_t w = vif_index / WORD_BITS;
+	if (w > more_words())
+	    grow_more(w);
+	more()[w] |= bit(vif_index % WORD_BITS);
+	return *this;
+    }
+    Mifset& set(size_t vif_index, bool value) {
+	return value ? set(vif_index) : reset(vif_index);
+    }
+    Mifset& reset(size_t vif_index) {
+	XLOG_ASSERT(vif_index < size());
+	if (vif_index < WORD_BITS) {
+	    _word0 &= ~bit(vif_index);
+	    return *this;
+	}
+	size_t w = vif_index / WORD_BITS;
+	if (w > more_words())
+	    return *this;
+	more()[w] &= ~bit(vif_index % WORD_BITS);
+	if (w == more_words() && more()[w] == 0)
+	    trim_more();
+	return *this;
+    }
+    Mifset& flip(size_t vif_index) {
+	return set(vif_index, !test(vif_index));
+    }
+
+    Mifset& set();
+    Mifset& reset() {
+	_word0 = 0;
+	free_more();
+	return *this;
+    }
+    Mifset& flip();
+
+    bool any() const { return _word0 != 0 || more() != NULL; }
+    bool none() const { return !any(); }
+    size_t count() const;
+
+    /**
+     * Find the first interface in the set.
+     *
+     * Together with find_next() this visits the interfaces of a sparse set
+     * without testing each index up to MAX_VIFS.
+     *
+     * @return the index of the first interface, or size() if the set is
+     * empty.
+     */
+    size_t find_first() const { return find_from(0); }
+
+    /**
+     * Find the next interface in the set.
+     *
+     * @param vif_index the index to start after.
+     * @return the index of the next interface after @ref vif_index, or
+     * size() if there is none.
+     */
+    size_t find_next(size_t vif_index) const {
+	return find_from(vif_index + 1);
+    }
+
+    Mifset& operator&=(const Mifset& other);
+    Mifset& operator|=(const Mifset& other);
+    Mifset& operator^=(const Mifset& other);
+    Mifset operator~() const { return Mifset(*this).flip(); }
+
+    bool operator==(const Mifset& other) const;
+    bool operator!=(const Mifset& other) const { return !(*this == other); }
+
+private:
+    static Word bit(size_t n) { return static_cast<Word>(1) << n; }
+
+    size_t find_from(size_t vif_index) const;
+
+    Word	_word0;		// interfaces [0, WORD_BITS)
+};
+
+inline Mifset
+operator&(const Mifset& a, const Mifset& b)
+{
+    return Mifset(a) &= b;
+}
+
+inline Mifset
+operator|(const Mifset& a, const Mifset& b)
+{
+    return Mifset(a) |= b;
+}
 
-typedef bitset<MAX_VIFS> Mifset;
+inline Mifset
+operator^(const Mifset& a, const Mifset& b)
+{
+    return Mifset(a) ^= b;
+}
 
 
 //
@@ -33,6 +33,8 @@
 #include "libxorp/ipvxnet.hh"
 
 
+template <class E> class Mre;
+
 /**
  * @short Class to store (S,G) (Source, Group) pair of addresses.
  */
@@ -218,6 +220,11 @@ private:
 
 /**
  * @short Template class for Multicast Routing Table.
+ * 
+ * The entries are kept in two ordered maps, for walks by source or group
+ * address or prefix. In addition, exact (S,G) lookups use a hash table,
+ * and the entries of each group are linked together so that all sources
+ * of a group can be found without a search.
  */
 template <class E>
 class Mrt {
@@ -225,7 +232,9 @@ public:
     /**
      * Default constructor
      */
-    Mrt() {}
+    Mrt() : _sg_hash(HASH_MIN_SIZE, (E *)NULL),
+	    _g_hash(HASH_MIN_SIZE, (E *)NULL),
+	    _g_hash_count(0) {}
     
     /**
      * Destructor
@@ -258,6 +267,9 @@ public:
 	// Clear the (S,G) and (G,S) lookup tables
 	_sg_table.clear();
 	_gs_table.clear();
+	_sg_hash.assign(HASH_MIN_SIZE, (E *)NULL);
+	_g_hash.assign(HASH_MIN_SIZE, (E *)NULL);
+	_g_hash_count = 0;
     }
     
     /**
@@ -286,6 +298,9 @@ public:
 	mre->_sg_key = sg_pos.first;
 	mre->_gs_key = gs_pos.first;
 	
+	sg_hash_insert(mre);
+	group_list_insert(mre);
+	
 	return (mre);
     }
     
@@ -304,6 +319,8 @@ public:
 	if (mre->_sg_key != _sg_table.end()) {
 	    _sg_table.erase(mre->_sg_key);
 	    mre->_sg_key = _sg_table.end();
+	    sg_hash_remove(mre);
+	    group_list_remove(mre);
 	    ret_value = XORP_OK;
 	}
 	if (mre->_gs_key != _gs_table.end()) {
@@ -324,10 +341,12 @@ public:
      * and group @ref group_addr if found, otherwise NULL.
      */
     E *find(const IPvX& source_addr, const IPvX& group_addr) const {
-	const_sg_iterator pos = _sg_table.find(
-	    MreSgKey(SourceGroup(source_addr, group_addr)));
-	if (pos != _sg_table.end())
-	    return (pos->second);
+	size_t i = hash_index(_sg_hash, sg_hash(source_addr, group_addr));
+	for (E *mre = _sg_hash[i]; mre != NULL; mre = mre->_sg_hash_next) {
+	    if ((mre->group_addr() == group_addr)
+		&& (mre->source_addr() == source_addr))
+		return (mre);
+	}
 	return (NULL);
     }
     
@@ -369,6 +388,25 @@ public:
 	return (NULL);
     }
     
+    /**
+     * Get the list of multicast routing entries for a group address.
+     * 
+     * The rest of the list is walked by using @ref Mre::group_next() on
+     * each entry. The list is not ordered.
+     * 
+     * @param group_addr the group address to search for.
+     * @return the first multicast routing entry in the list of entries
+     * for group @ref group_addr if any, otherwise NULL.
+     */
+    E *group_list_begin(const IPvX& group_addr) const {
+	size_t i = hash_index(_g_hash, addr_hash(group_addr));
+	for (E *mre = _g_hash[i]; mre != NULL; mre = mre->_g_hash_next) {
+	    if (mre->group_addr() == group_addr)
+		return (mre);
+	}
+	return (NULL);
+    }
+    
     /**
      * Find the first multicast routing entry for a source address prefix.
      * 
@@ -649,8 +687,131 @@ public:
     }
     
 private:
+    // The initial number of hash buckets (a power of two)
+    static const size_t HASH_MIN_SIZE = 64;
+    
+    static uint32_t addr_hash(const IPvX& addr) {
+	uint32_t words[sizeof(IPvX) / sizeof(uint32_t)];
+	size_t n = addr.copy_out((uint8_t *)words) / sizeof(words[0]);
+	uint32_t h = 0;
+	
+	for (size_t i = 0; i < n; i++)
+	    h = (h ^ words[i]) * 2654435761U;	// Multiplicative hashing
+	return (h ^ (h >> 16));
+    }
+    
+    static uint32_t sg_hash(const IPvX& source_addr, const IPvX& group_addr) {
+	return (addr_hash(source_addr) * 31 + addr_hash(group_addr));
+    }
+    
+    static size_t hash_index(const vector<E *>& hash, uint32_t h) {
+	return (h & (hash.size() - 1));
+    }
+    
+    //
+    // Double the number of buckets of a hash table, with the entries
+    // chained through their member 'next'.
+    //
+    void hash_grow(vector<E *>& hash, E* Mre<E>::*next, bool is_sg) {
+	vector<E *> old_hash(2 * hash.size(), (E *)NULL);
+	
+	old_hash.swap(hash);
+	for (size_t i = 0; i < old_hash.size(); i++) {
+	    E *mre = old_hash[i];
+	    while (mre != NULL) {
+		E *next_mre = mre->*next;
+		uint32_t h;
+		if (is_sg)
+		    h = sg_hash(mre->source_addr(), mre->group_addr());
+		else
+		    h = addr_hash(mre->group_addr());
+		size_t j = hash_index(hash, h);
+		mre->*next = hash[j];
+		hash[j] = mre;
+		mre = next_mre;
+	    }
+	}
+    }
+    
+    void sg_hash_insert(E *mre) {
+	if (_sg_table.size() > _sg_hash.size())
+	    hash_grow(_sg_hash, &Mre<E>::_sg_hash_next, true);
+	
+	size_t i = hash_index(_sg_hash,
+			      sg_hash(mre->source_addr(), mre->group_addr()));
+	mre->_sg_hash_next = _sg_hash[i];
+	_sg_hash[i] = mre;
+    }
+    
+    void sg_hash_remove(E *mre) {
+	size_t i = hash_index(_sg_hash,
+			      sg_hash(mre->source_addr(), mre->group_addr()));
+	E **mre_p = &_sg_hash[i];
+	
+	while (*mre_p != mre)
+	    mre_p = &(*mre_p)->_sg_hash_next;
+	*mre_p = mre->_sg_hash_next;
+	mre->_sg_hash_next = NULL;
+    }
+    
+    //
+    // Add an entry to the list of entries for its group. The first entry
+    // of each list is in the group hash table, and the others are added
+    // after it.
+    //
+    void group_list_insert(E *mre) {
+	E *head = group_list_begin(mre->group_addr());
+	
+	if (head != NULL) {
+	    mre->_group_prev = head;
+	    mre->_group_next = head->_group_next;
+	    if (head->_group_next != NULL)
+		head->_group_next->_group_prev = mre;
+	    head->_group_next = mre;
+	    return;
+	}
+	
+	if (_g_hash_count >= _g_hash.size())
+	    hash_grow(_g_hash, &Mre<E>::_g_hash_next, false);
+	
+	size_t i = hash_index(_g_hash, addr_hash(mre->group_addr()));
+	mre->_g_hash_next = _g_hash[i];
+	_g_hash[i] = mre;
+	_g_hash_count++;
+    }
+    
+    void group_list_remove(E *mre) {
+	E *next = mre->_group_next;
+	
+	if (next != NULL)
+	    next->_group_prev = mre->_group_prev;
+	if (mre->_group_prev != NULL) {
+	    mre->_group_prev->_group_next = next;
+	} else {
+	    // The first entry: replace it in the group hash table
+	    size_t i = hash_index(_g_hash, addr_hash(mre->group_addr()));
+	    E **mre_p = &_g_hash[i];
+	    
+	    while (*mre_p != mre)
+		mre_p = &(*mre_p)->_g_hash_next;
+	    if (next != NULL) {
+		next->_g_hash_next = mre->_g_hash_next;
+		*mre_p = next;
+	    } else {
+		*mre_p = mre->_g_hash_next;
+		_g_hash_count--;
+	    }
+	    mre->_g_hash_next = NULL;
+	}
+	mre->_group_prev = NULL;
+	mre->_group_next = NULL;
+    }
+    
     SgMap _sg_table;		// The (S,G) source-first lookup table
     GsMap _gs_table;		// The (G,S) group-first lookup table
+    vector<E *> _sg_hash;	// The (S,G) hash table
+    vector<E *> _g_hash;	// The first entry of each group by group
+    size_t	_g_hash_count;	// The number of groups
 };
 
 /**
@@ -666,7 +827,9 @@ public:
      * @param group_addr the group address of the entry.
      */
     Mre(const IPvX& source_addr, const IPvX& group_addr)
-	: _source_group(source_addr, group_addr) {
+	: _source_group(source_addr, group_addr),
+	  _sg_hash_next(NULL), _g_hash_next(NULL),
+	  _group_prev(NULL), _group_next(NULL) {
 	//
 	// XXX: the iterators below should be set to
 	// _sg_table.end() and _gs_table.end() in the Mrt, but here
@@ -737,6 +900,14 @@ public:
      * @return the group-source table for this entry.
      */
     const typename Mrt<E>::gs_iterator& gs_key() const { return (_gs_key); }
+    
+    /**
+     * Get the next entry in the list of entries for the same group.
+     * 
+     * @return the next entry for the same group if any, otherwise NULL.
+     * @see Mrt::group_list_begin().
+     */
+    E		*group_next() const { return (_group_next); }
 
     /**
      * Convert this entry from binary form to presentation format.
@@ -758,6 +929,10 @@ private:
     const SourceGroup _source_group;	// The source and group addresses
     typename Mrt<E>::sg_iterator _sg_key; // The source-group table iterator
     typename Mrt<E>::gs_iterator _gs_key; // The group-source table iterator
+    E		*_sg_hash_next;		// The next entry in the (S,G) hash
+    E		*_g_hash_next;		// The next group in the group hash
+    E		*_group_prev;		// The previous entry for the group
+    E		*_group_next;		// The next entry for the group
 };
 
 //
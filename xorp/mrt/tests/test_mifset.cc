@@ -0,0 +1,288 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+//
+// Multicast interface set test program.
+//
+
+#include "mrt_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/exceptions.hh"
+
+
+
+#ifdef HAVE_GETOPT_H
+#include <getopt.h>
+#endif
+
+#include <bitset>
+
+#include "mifset.hh"
+
+
+//
+// XXX: MODIFY FOR YOUR TEST PROGRAM
+//
+static const char *program_name		= "test_mifset";
+static const char *program_description	= "Test multicast interface set";
+static const char *program_version_id	= "0.1";
+static const char *program_date		= "October 18, 2026";
+static const char *program_copyright	= "See file LICENSE";
+static const char *program_return_value	= "0 on success, 1 if test error, 2 if internal error";
+
+static bool s_verbose = false;
+bool verbose()			{ return s_verbose; }
+void set_verbose(bool v)	{ s_verbose = v; }
+
+static int s_failures = 0;
+bool failures()			{ return s_failures; }
+void incr_failures()		{ s_failures++; }
+
+
+
+//
+// printf(3)-like facility to conditionally print a message if verbosity
+// is enabled.
+//
+#define verbose_log(x...) _verbose_log(__FILE__,__LINE__, x)
+
+#define _verbose_log(file, line, x...)					\
+do {									\
+    if (verbose()) {							\
+	printf("From %s:%d: ", file, line);				\
+	printf(x);							\
+    }									\
+} while(0)
+
+
+//
+// Test and print a message whether two strings are lexicographically same.
+// The strings can be either C or C++ style.
+//
+#define verbose_match(s1, s2)						\
+    _verbose_match(__FILE__, __LINE__, s1, s2)
+
+bool
+_verbose_match(const char* file, int line, const string& s1, const string& s2)
+{
+    bool match = s1 == s2;
+
+    _verbose_log(file, line, "Comparing %s == %s : %s\n",
+		 s1.c_str(), s2.c_str(), match ? "OK" : "FAIL");
+    if (match == false)
+	incr_failures();
+    return match;
+}
+
+
+//
+// Test and print a message whether a condition is true.
+//
+// The first argument is the condition to test.
+// The second argument is a string with a brief description of the tested
+// condition.
+//
+#define verbose_assert(cond, desc) 					\
+    _verbose_assert(__FILE__, __LINE__, cond, desc)
+
+bool
+_verbose_assert(const char* file, int line, bool cond, const string& desc)
+{
+    _verbose_log(file, line,
+		 "Testing %s : %s\n", desc.c_str(), cond ? "OK" : "FAIL");
+    if (cond == false)
+	incr_failures();
+    return cond;
+}
+
+
+/**
+ * Print program info to output stream.
+ *
+ * @param stream the output stream the print the program info to.
+ */
+static void
+print_program_info(FILE *stream)
+{
+    fprintf(stream, "Name:          %s\n", program_name);
+    fprintf(stream, "Description:   %s\n", program_description);
+    fprintf(stream, "Version:       %s\n", program_version_id);
+    fprintf(stream, "Date:          %s\n", program_date);
+    fprintf(stream, "Copyright:     %s\n", program_copyright);
+    fprintf(stream, "Return:        %s\n", program_return_value);
+}
+
+/**
+ * Print program usage information to the stderr.
+ *
+ * @param progname the name of the program.
+ */
+static void
+usage(const char* progname)
+{
+    print_program_info(stderr);
+    fprintf(stderr, "usage: %s [-v] [-h]\n", progname);
+    fprintf(stderr, "       -h          : usage (this message)\n");
+    fprintf(stderr, "       -v          : verbose output\n");
+    fprintf(stderr, "Return 0 on success, 1 if test error, 2 if internal error.\n");
+}
+
+
+//
+// Compare a set against the reference bitset it should be equal to.
+//
+static bool
+mifset_equal(const Mifset& mifset, const bitset<MAX_VIFS>& ref)
+{
+    if (mifset.count() != ref.count() || mifset.any() != ref.any())
+	return false;
+    for (size_t i = 0; i < ref.size(); i++) {
+	if (mifset.test(i) != ref.test(i))
+	    return false;
+    }
+    return true;
+}
+
+static void
+test_mifset_ops()
+{
+    Mifset a, b, c;
+    bitset<MAX_VIFS> ra, rb;
+    size_t last = MAX_VIFS - 1;
+
+    //
+    // Set and reset single interfaces, low and high
+    //
+    verbose_assert(a.none() && a.count() == 0, "empty set");
+    verbose_assert(a.size() == MAX_VIFS, "size");
+    a.set(0);
+    a.set(last);
+    ra.set(0);
+    ra.set(last);
+    verbose_assert(mifset_equal(a, ra), "set first and last interface");
+    a.reset(last);
+    ra.reset(last);
+    verbose_assert(mifset_equal(a, ra), "reset last interface");
+    verbose_assert(a == c.set(0), "equal after reset of the high words");
+    a.flip(last / 2);
+    ra.flip(last / 2);
+    verbose_assert(mifset_equal(a, ra), "flip middle interface");
+
+    //
+    // Bulk operations against bitset
+    //
+    for (size_t i = 0; i < MAX_VIFS; i += 3) {
+	b.set(i);
+	rb.set(i);
+    }
+    verbose_assert(mifset_equal(a & b, ra & rb), "and");
+    verbose_assert(mifset_equal(a | b, ra | rb), "or");
+    verbose_assert(mifset_equal(a ^ b, ra ^ rb), "xor");
+    verbose_assert(mifset_equal(~b, ~rb), "not");
+    verbose_assert(mifset_equal(b ^ b, bitset<MAX_VIFS>()), "xor with self");
+    verbose_assert((b & ~b).none(), "and with complement");
+    verbose_assert(mifset_equal(c.set(), bitset<MAX_VIFS>().set()), "set all");
+    verbose_assert((~c).none(), "complement of all");
+    verbose_assert(c != b && Mifset(b) == b, "compare and copy");
+    c = b;
+    verbose_assert(c == b, "assign");
+    c.reset();
+    verbose_assert(c.none() && c != b, "reset all");
+
+    //
+    // Walk a sparse set
+    //
+    Mifset d;
+    vector<size_t> found;
+    d.set(1);
+    d.set(last);
+    for (size_t i = d.find_first(); i < d.size(); i = d.find_next(i))
+	found.push_back(i);
+    verbose_assert(found.size() == 2 && found[0] == 1 && found[1] == last,
+		   "find_first/find_next");
+    verbose_assert(Mifset().find_first() == MAX_VIFS, "find_first of empty");
+
+    //
+    // The one byte per interface conversion
+    //
+    vector<uint8_t> v(MAX_VIFS);
+    Mifset e;
+    mifset_to_vector(b, v);
+    verbose_assert(v[0] == 1 && v[1] == 0 && v[3] == 1, "mifset_to_vector");
+    vector_to_mifset(v, e);
+    verbose_assert(e == b, "vector_to_mifset");
+}
+
+int
+main(int argc, char * const argv[])
+{
+    int ret_value = 0;
+
+    //
+    // Initialize and start xlog
+    //
+    xlog_init(argv[0], NULL);
+    xlog_set_verbose(XLOG_VERBOSE_LOW);         // Least verbose messages
+    // XXX: verbosity of the error messages temporary increased
+    xlog_level_set_verbose(XLOG_LEVEL_ERROR, XLOG_VERBOSE_HIGH);
+    xlog_add_default_output();
+    xlog_start();
+
+    int ch;
+    while ((ch = getopt(argc, argv, "hv")) != -1) {
+	switch (ch) {
+	case 'v':
+	    set_verbose(true);
+	    break;
+	case 'h':
+	case '?':
+	default:
+	    usage(argv[0]);
+	    xlog_stop();
+	    xlog_exit();
+	    if (ch == 'h')
+		return (0);
+	    else
+		return (1);
+	}
+    }
+    argc -= optind;
+    argv += optind;
+
+    XorpUnexpectedHandler x(xorp_unexpected_handler);
+    try {
+	test_mifset_ops();
+	ret_value = failures() ? 1 : 0;
+    } catch (...) {
+	// Internal error
+	xorp_print_standard_exceptions();
+	ret_value = 2;
+    }
+
+    //
+    // Gracefully stop and exit xlog
+    //
+    xlog_stop();
+    xlog_exit();
+
+    return (ret_value);
+}
@@ -171,6 +171,48 @@ mre_list_str(const list<MyMre *>& mre_list)
     return res;
 }
 
+void
+test_group_list(Mrt<MyMre>& mrt, const IPvX& s, const IPvX& g, MyMre *mre_g)
+{
+    MyMre *mre = new MyMre(s, g);
+    set<MyMre *> expected_mre_set;
+    set<MyMre *> received_mre_set;
+    MyMre *t;
+
+    t = mrt.insert(mre);
+    verbose_assert(t == mre,
+		   c_format("Installing entry for %s", cstring(*mre)));
+
+    expected_mre_set.insert(mre);
+    expected_mre_set.insert(mre_g);
+    for (t = mrt.group_list_begin(g); t != NULL; t = t->group_next())
+	received_mre_set.insert(t);
+    verbose_assert(received_mre_set == expected_mre_set,
+		   c_format("Listing the entries for group %s", cstring(g)));
+
+    //
+    // Remove the first entry of the list
+    //
+    t = mrt.group_list_begin(g);
+    verbose_assert(mrt.remove(t) == XORP_OK,
+		   c_format("Removing entry for %s", cstring(*t)));
+    verbose_assert(mrt.find(t->source_addr(), g) == NULL,
+		   c_format("Searching for removed %s", cstring(*t)));
+    expected_mre_set.erase(t);
+    delete t;
+
+    received_mre_set.clear();
+    for (t = mrt.group_list_begin(g); t != NULL; t = t->group_next())
+	received_mre_set.insert(t);
+    verbose_assert(received_mre_set == expected_mre_set,
+		   c_format("Listing the entries for group %s", cstring(g)));
+
+    t = *expected_mre_set.begin();
+    verbose_assert(mrt.find(t->source_addr(), g) == t,
+		   c_format("Searching for (%s, %s)",
+			    cstring(t->source_addr()), cstring(g)));
+}
+
 void
 test_mrt()
 {
@@ -484,6 +526,12 @@ test_mrt()
     expected_mre_list.push_back(mre5_6);
     verbose_match(mre_list_str(received_mre_list),
 		  mre_list_str(expected_mre_list));
+
+    //
+    // Test the list of entries for a group
+    //
+    test_group_list(mrt_4, s1_4, g4_4, mre4_4);
+    test_group_list(mrt_6, s1_6, g4_6, mre4_6);
 }
 
 int
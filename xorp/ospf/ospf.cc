@@ -806,6 +806,13 @@ Ospf<A>::reset_filter(const uint32_t& filter)
     _policy_filters.reset(filter);
 }
 
+template <typename A>
+string
+Ospf<A>::filter_statistics(const uint32_t& filter)
+{
+    return _policy_filters.statistics(filter);
+}
+
 template <typename A>
 void
 Ospf<A>::push_routes()
@@ -878,6 +878,14 @@ class Ospf {
      */
     void reset_filter(const uint32_t& filter);
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter Id of filter to report on.
+     * @return human readable statistics of the filter.
+     */
+    string filter_statistics(const uint32_t& filter);
+
     /**
      * Push routes through policy filters for re-filtering.
      */
@@ -56,10 +56,8 @@ template <>
 void
 OspfVarRW<IPv4>::start_read()
 {
-    initialize(VAR_NETWORK, _ef.create(ElemIPv4Net::id,
-				       _network.str().c_str()));
-    initialize(VAR_NEXTHOP, _ef.create(ElemIPv4NextHop::id,
-	       _nexthop.str().c_str()));
+    _network_elem.set_val(_network);
+    _nexthop_elem.set_val(_nexthop);
 
     start_read_common();
 }
@@ -68,10 +66,8 @@ template <>
 void
 OspfVarRW<IPv6>::start_read()
 {
-    initialize(VAR_NETWORK, _ef.create(ElemIPv6Net::id,
-				       _network.str().c_str()));
-    initialize(VAR_NEXTHOP, _ef.create(ElemIPv6NextHop::id,
-               _nexthop.str().c_str()));
+    _network_elem.set_val(_network);
+    _nexthop_elem.set_val(_nexthop);
 
     start_read_common();
 }
@@ -80,11 +76,16 @@ template <typename A>
 void
 OspfVarRW<A>::start_read_common()
 {
+    initialize_typed(VAR_NETWORK, _network_elem);
+    initialize_typed(VAR_NEXTHOP, _nexthop_elem);
+
     initialize(VAR_POLICYTAGS, _policytags.element());
-    initialize(VAR_METRIC, _ef.create(ElemU32::id,
-				      c_format("%u", _metric).c_str()));
-    initialize(VAR_EBIT, _ef.create(ElemU32::id,
-				    c_format("%u", _e_bit ? 2 : 1).c_str()));
+
+    _metric_elem.set_val(_metric);
+    _e_bit_elem.set_val(_e_bit ? 2 : 1);
+
+    initialize_typed(VAR_METRIC, _metric_elem);
+    initialize_typed(VAR_EBIT, _e_bit_elem);
 
     // XXX which tag wins?
     Element* element = _policytags.element_tag();
@@ -94,8 +95,8 @@ OspfVarRW<A>::start_read_common()
 
     delete element;
 
-    initialize(VAR_TAG, _ef.create(ElemU32::id,
-				   c_format("%u", _tag).c_str()));
+    _tag_elem.set_val(_tag);
+    initialize_typed(VAR_TAG, _tag_elem);
 }
 
 template <typename A>
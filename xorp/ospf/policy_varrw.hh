@@ -24,7 +24,7 @@
 #define __OSPF_POLICY_VARRRW_HH__
 
 #include "policy/backend/single_varrw.hh"
-#include "policy/common/element_factory.hh"
+#include "policy/common/element.hh"
 #include "policy/backend/policy_filters.hh"
 #include "policy/backend/policytags.hh"
 
@@ -57,7 +57,13 @@ class OspfVarRW : public SingleVarRW {
     uint32_t&	    _tag;
     bool&	    _tag_set;
     PolicyTags&	    _policytags;
-    ElementFactory  _ef;
+
+    // Values read from the route
+    ElemNet<IPNet<A> >	_network_elem;
+    ElemNextHop<A>	_nexthop_elem;
+    ElemU32		_metric_elem;
+    ElemU32		_e_bit_elem;
+    ElemU32		_tag_elem;
 };
 
 #endif // __OSPF_POLICY_VARRRW_HH__
@@ -87,6 +87,35 @@ XrlIO<A>::recv(const string& interface,
 				 payload_copy.size());
 }
 
+template <typename A>
+void
+XrlIO<A>::recv_batch(const RawPacketBatch& batch)
+{
+    debug_msg("recv_batch(%u packets)\n", XORP_UINT_CAST(batch.size()));
+
+    if (IO<A>::_receive_cb.is_empty())
+	return;
+
+    //
+    // XXX: the callback's argument is not const-ified, so each payload is
+    // copied.  The copy is reused for all packets of the batch.
+    //
+    vector<uint8_t> payload_copy;
+    A src, dst;
+
+    for (size_t i = 0; i < batch.size(); i++) {
+	const vector<uint8_t>& payload = batch.payload(i);
+
+	batch.src_address(i).get(src);
+	batch.dst_address(i).get(dst);
+	payload_copy.assign(payload.begin(), payload.end());
+	// Actual receive code is in ospf.cc: Ospf<A>::receive
+	IO<A>::_receive_cb->dispatch(batch.if_name(i), batch.vif_name(i),
+				     dst, src, &payload_copy[0],
+				     payload_copy.size());
+    }
+}
+
 template <>
 bool
 XrlIO<IPv4>::send(const string& interface, const string& vif,
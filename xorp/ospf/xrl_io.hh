@@ -26,6 +26,7 @@
 #include "libxipc/xrl_router.hh"
 
 #include "libfeaclient/ifmgr_xrl_mirror.hh"
+#include "libfeaclient/raw_packet_batch.hh"
 #include "policy/backend/policytags.hh"
 
 #include "io.hh"
@@ -226,6 +227,11 @@ class XrlIO : public IO<A>,
 	      bool ip_internet_control,
 	      const vector<uint8_t>& payload);
 
+    /**
+     * Receive a batch of raw frames.
+     */
+    void recv_batch(const RawPacketBatch& batch);
+
     /**
      * Send Raw frames.
      */
@@ -154,6 +154,33 @@ XrlOspfV2Target::raw_packet4_client_0_1_recv(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlOspfV2Target::raw_packet4_client_0_1_recv_batch(
+    // Input values,
+    const XrlAtomList&	if_names,
+    const XrlAtomList&	vif_names,
+    const XrlAtomList&	src_addresses,
+    const XrlAtomList&	dst_addresses,
+    const XrlAtomList&	ip_protocols,
+    const XrlAtomList&	ip_ttls,
+    const XrlAtomList&	ip_toses,
+    const XrlAtomList&	ip_router_alerts,
+    const XrlAtomList&	ip_internet_controls,
+    const XrlAtomList&	payloads)
+{
+    RawPacketBatch batch(if_names, vif_names, src_addresses, dst_addresses,
+			 ip_protocols, ip_ttls, ip_toses, ip_router_alerts,
+			 ip_internet_controls, payloads);
+    string error_msg;
+
+    if (batch.check(AF_INET, error_msg) != XORP_OK)
+	return XrlCmdError::BAD_ARGS(error_msg);
+
+    _xrl_io.recv_batch(batch);
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlOspfV2Target::policy_backend_0_1_configure(const uint32_t& filter,
 					      const string& conf)
@@ -195,6 +222,20 @@ XrlOspfV2Target::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlOspfV2Target::policy_backend_0_1_get_statistics(const uint32_t& filter,
+                                                   string& statistics)
+{
+    try {
+	statistics = _ospf.filter_statistics(filter);
+    } catch(const PolicyException& e){ 
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlOspfV2Target::policy_redist4_0_1_add_route4(const IPv4Net& network,
 					       const bool& unicast,
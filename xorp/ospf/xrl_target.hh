@@ -97,6 +97,22 @@ class XrlOspfV2Target : XrlOspfv2TargetBase {
 	const bool&	ip_internet_control,
 	const vector<uint8_t>&	payload);
 
+    /**
+     *  Receive several IPv4 packets from a raw socket.
+     */
+    XrlCmdError raw_packet4_client_0_1_recv_batch(
+	// Input values,
+	const XrlAtomList&	if_names,
+	const XrlAtomList&	vif_names,
+	const XrlAtomList&	src_addresses,
+	const XrlAtomList&	dst_addresses,
+	const XrlAtomList&	ip_protocols,
+	const XrlAtomList&	ip_ttls,
+	const XrlAtomList&	ip_toses,
+	const XrlAtomList&	ip_router_alerts,
+	const XrlAtomList&	ip_internet_controls,
+	const XrlAtomList&	payloads);
+
     /**
      *  Configure a policy filter.
      *
@@ -123,6 +139,20 @@ class XrlOspfV2Target : XrlOspfv2TargetBase {
      */
     XrlCmdError policy_backend_0_1_push_routes();
 
+    /**
+     *  Obtain the per policy and per term counters of a filter, and the
+     *  time spent running it, since it was last configured.
+     *
+     *  @param filter the identifier of the filter.
+     *
+     *  @param statistics human readable statistics.
+     */
+    XrlCmdError policy_backend_0_1_get_statistics(
+	// Input values,
+	const uint32_t&	filter,
+	// Output values,
+	string&	statistics);
+
     /**
      *  Start route redistribution for an IPv4 route.
      *
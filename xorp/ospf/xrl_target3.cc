@@ -124,6 +124,46 @@ XrlOspfV3Target::raw_packet4_client_0_1_recv(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlOspfV3Target::raw_packet4_client_0_1_recv_batch(
+    // Input values,
+    const XrlAtomList&	if_names,
+    const XrlAtomList&	vif_names,
+    const XrlAtomList&	src_addresses,
+    const XrlAtomList&	dst_addresses,
+    const XrlAtomList&	ip_protocols,
+    const XrlAtomList&	ip_ttls,
+    const XrlAtomList&	ip_toses,
+    const XrlAtomList&	ip_router_alerts,
+    const XrlAtomList&	ip_internet_controls,
+    const XrlAtomList&	payloads)
+{
+    RawPacketBatch batch(if_names, vif_names, src_addresses, dst_addresses,
+			 ip_protocols, ip_ttls, ip_toses, ip_router_alerts,
+			 ip_internet_controls, payloads);
+    string error_msg;
+
+    if (batch.check(AF_INET, error_msg) != XORP_OK)
+	return XrlCmdError::BAD_ARGS(error_msg);
+
+    for (size_t i = 0; i < batch.size(); i++) {
+	XrlCmdError e = raw_packet4_client_0_1_recv(batch.if_name(i),
+						    batch.vif_name(i),
+						    batch.src_address4(i),
+						    batch.dst_address4(i),
+						    batch.ip_protocol(i),
+						    batch.ip_ttl(i),
+						    batch.ip_tos(i),
+						    batch.ip_router_alert(i),
+						    batch.ip_internet_control(i),
+						    batch.payload(i));
+	if (e != XrlCmdError::OKAY())
+	    return e;
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlOspfV3Target::raw_packet6_client_0_1_recv(
     // Input values,
@@ -157,6 +197,37 @@ XrlOspfV3Target::raw_packet6_client_0_1_recv(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlOspfV3Target::raw_packet6_client_0_1_recv_batch(
+    // Input values,
+    const XrlAtomList&	if_names,
+    const XrlAtomList&	vif_names,
+    const XrlAtomList&	src_addresses,
+    const XrlAtomList&	dst_addresses,
+    const XrlAtomList&	ip_protocols,
+    const XrlAtomList&	ip_ttls,
+    const XrlAtomList&	ip_toses,
+    const XrlAtomList&	ip_router_alerts,
+    const XrlAtomList&	ip_internet_controls,
+    const XrlAtomList&	ext_headers_counts,
+    const XrlAtomList&	ext_headers_type,
+    const XrlAtomList&	ext_headers_payload,
+    const XrlAtomList&	payloads)
+{
+    RawPacketBatch batch(if_names, vif_names, src_addresses, dst_addresses,
+			 ip_protocols, ip_ttls, ip_toses, ip_router_alerts,
+			 ip_internet_controls, ext_headers_counts,
+			 ext_headers_type, ext_headers_payload, payloads);
+    string error_msg;
+
+    if (batch.check(AF_INET6, error_msg) != XORP_OK)
+	return XrlCmdError::BAD_ARGS(error_msg);
+
+    _xrl_io_ipv6.recv_batch(batch);
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlOspfV3Target::policy_backend_0_1_configure(const uint32_t& filter,
 					      const string& conf)
@@ -198,6 +269,20 @@ XrlOspfV3Target::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlOspfV3Target::policy_backend_0_1_get_statistics(const uint32_t& filter,
+                                                   string& statistics)
+{
+    try {
+	statistics = _ospf_ipv6.filter_statistics(filter);
+    } catch(const PolicyException& e){ 
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlOspfV3Target::policy_redist6_0_1_add_route6(const IPv6Net& network,
 					       const bool& unicast,
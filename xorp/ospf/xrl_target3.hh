@@ -102,6 +102,22 @@ class XrlOspfV3Target : XrlOspfv3TargetBase {
 	const bool&	ip_internet_control,
 	const vector<uint8_t>&	payload);
 
+    /**
+     *  Receive several IPv4 packets from a raw socket.
+     */
+    XrlCmdError raw_packet4_client_0_1_recv_batch(
+	// Input values,
+	const XrlAtomList&	if_names,
+	const XrlAtomList&	vif_names,
+	const XrlAtomList&	src_addresses,
+	const XrlAtomList&	dst_addresses,
+	const XrlAtomList&	ip_protocols,
+	const XrlAtomList&	ip_ttls,
+	const XrlAtomList&	ip_toses,
+	const XrlAtomList&	ip_router_alerts,
+	const XrlAtomList&	ip_internet_controls,
+	const XrlAtomList&	payloads);
+
     /**
      *  Receive an IPv6 packet from a raw socket.
      *
@@ -148,6 +164,25 @@ class XrlOspfV3Target : XrlOspfv3TargetBase {
 	const XrlAtomList&	ext_headers_payload,
 	const vector<uint8_t>&	payload);
 
+    /**
+     *  Receive several IPv6 packets from a raw socket.
+     */
+    XrlCmdError raw_packet6_client_0_1_recv_batch(
+	// Input values,
+	const XrlAtomList&	if_names,
+	const XrlAtomList&	vif_names,
+	const XrlAtomList&	src_addresses,
+	const XrlAtomList&	dst_addresses,
+	const XrlAtomList&	ip_protocols,
+	const XrlAtomList&	ip_ttls,
+	const XrlAtomList&	ip_toses,
+	const XrlAtomList&	ip_router_alerts,
+	const XrlAtomList&	ip_internet_controls,
+	const XrlAtomList&	ext_headers_counts,
+	const XrlAtomList&	ext_headers_type,
+	const XrlAtomList&	ext_headers_payload,
+	const XrlAtomList&	payloads);
+
     /**
      *  Pure-virtual function that needs to be implemented to:
      *
@@ -174,6 +209,20 @@ class XrlOspfV3Target : XrlOspfv3TargetBase {
      */
     XrlCmdError policy_backend_0_1_push_routes();
 
+    /**
+     *  Obtain the per policy and per term counters of a filter, and the
+     *  time spent running it, since it was last configured.
+     *
+     *  @param filter the identifier of the filter.
+     *
+     *  @param statistics human readable statistics.
+     */
+    XrlCmdError policy_backend_0_1_get_statistics(
+	// Input values,
+	const uint32_t&	filter,
+	// Output values,
+	string&	statistics);
+
     /**
      *  Start route redistribution for an IPv6 route.
      *
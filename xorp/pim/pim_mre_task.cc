@@ -195,10 +195,12 @@ PimMreTask::run_task()
 {
     _time_slice.reset();
 
-    if (run_task_rp()) {
-	// The time slice has expired. Keep processing this task.
-	return (true);
-    }
+    do {
+	if (run_task_rp()) {
+	    // The time slice has expired. Keep processing this task.
+	    return (true);
+	}
+    } while (next_mrib_modified_prefix());
 
     //
     // The task has been completed, hence delete the task.
@@ -1670,3 +1672,38 @@ PimMreTask::add_mrib_delete_list(const list<Mrib *>& mrib_list)
 			     mrib_list.begin(),
 			     mrib_list.end());
 }
+
+//
+// Add a modified MRIB prefix to process after those already added.
+// Only for the tasks that process MRIB changes.
+//
+void
+PimMreTask::add_mrib_modified_prefix(const IPvXNet& modified_prefix)
+{
+    XLOG_ASSERT((_input_state == PimMreTrackState::INPUT_STATE_MRIB_RP_CHANGED)
+		|| (_input_state
+		    == PimMreTrackState::INPUT_STATE_MRIB_S_CHANGED));
+
+    _mrib_modified_prefixes.insert(modified_prefix);
+}
+
+//
+// Setup the processing of the next modified MRIB prefix (if any).
+//
+// Return true if there is a prefix to process, otherwise return false.
+bool
+PimMreTask::next_mrib_modified_prefix()
+{
+    if (_mrib_modified_prefixes.empty())
+	return (false);
+
+    IPvXNet modified_prefix = *_mrib_modified_prefixes.begin();
+    _mrib_modified_prefixes.erase(_mrib_modified_prefixes.begin());
+
+    if (_input_state == PimMreTrackState::INPUT_STATE_MRIB_RP_CHANGED)
+	set_rp_addr_prefix_rp(modified_prefix);
+    else
+	set_source_addr_prefix_sg_sg_rpt(modified_prefix);
+
+    return (true);
+}
@@ -72,6 +72,7 @@ public:
     void	add_pim_mfc(PimMfc *pim_mfc);
     void	add_pim_mfc_delete(PimMfc *pim_mfc);
     void	add_mrib_delete_list(const list<Mrib *>& mrib_list);
+    void	add_mrib_modified_prefix(const IPvXNet& modified_prefix);
     
     //
     // (*,*,RP) state setup
@@ -288,6 +289,8 @@ private:
     // Mrib related state
     //
     list<Mrib *> _mrib_delete_list;
+    set<IPvXNet> _mrib_modified_prefixes;	// Prefixes not processed yet
+    bool	next_mrib_modified_prefix();
 };
 
 #endif // __PIM_PIM_MRE_TASK_HH__
@@ -149,7 +149,7 @@ PimMribTable::commit_pending_transactions(uint32_t tid)
 {
     MribTable::commit_pending_transactions(tid);
     
-    apply_mrib_changes();
+    schedule_apply_mrib_changes();
 }
 
 //
@@ -160,6 +160,8 @@ PimMribTable::commit_pending_transactions(uint32_t tid)
 void
 PimMribTable::apply_mrib_changes()
 {
+    _apply_mrib_changes_timer.unschedule();
+
     while (! _modified_prefix_list.empty()) {
 	// Get the modified prefix address
 	IPvXNet modified_prefix_addr = _modified_prefix_list.front();
@@ -182,6 +184,17 @@ PimMribTable::apply_mrib_changes()
     mrib_list.clear();
 }
 
+void
+PimMribTable::schedule_apply_mrib_changes()
+{
+    if (_apply_mrib_changes_timer.scheduled())
+	return;		// The timer was already scheduled
+
+    _apply_mrib_changes_timer = pim_node().eventloop().new_oneoff_after(
+	TimeVal(0, 0),
+	callback(this, &PimMribTable::apply_mrib_changes));
+}
+
 //
 // Search the list of modified address prefixes and remove
 // all smaller prefixes. If there is a prefix that is larger
@@ -263,5 +276,5 @@ PimMribTable::resolve_prefixes_by_vif_name(const string& next_hop_vif_name,
 	_unresolved_prefixes.erase(iter2);
     }
 
-    apply_mrib_changes();
+    schedule_apply_mrib_changes();
 }
@@ -154,6 +154,15 @@ public:
      * machines.
      */
     void	apply_mrib_changes();
+
+    /**
+     * Apply all changes to the table once the current event has been
+     * processed.
+     * 
+     * All changes committed before then are merged, so a PimMre entry
+     * that is affected by several of them is processed only once.
+     */
+    void	schedule_apply_mrib_changes();
     
     /**
      * Get the list of modified prefixes since the last commit.
@@ -199,6 +208,9 @@ private:
 
     // The map of unresolved prefixes whose next-hop vif name was not resolved
     map<IPvXNet, string> _unresolved_prefixes;
+
+    // Timer to apply the changes committed during the current event
+    XorpTimer	_apply_mrib_changes_timer;
 };
 
 #endif // __PIM_PIM_MRIB_TABLE_HH__
@@ -132,27 +132,78 @@ PimMrt::add_task_rp_changed(const IPvX& affected_rp_addr)
 void
 PimMrt::add_task_mrib_changed(const IPvXNet& modified_prefix_addr)
 {
-    PimMreTask *pim_mre_task;
+    PimMreTask *pim_mre_task_rp = NULL;
+    PimMreTask *pim_mre_task_s = NULL;
     
-    do {
+    //
+    // The entries that depend on the MRIB entries for the prefix are
+    // found by the address they look up: the RP address of the (*,*,RP)
+    // entries (the related (*,G), (S,G) and (S,G,rpt) entries are
+    // processed through them), and the source address of the (S,G),
+    // (S,G,rpt) and PimMfc entries. If there are none, there is nothing
+    // to do.
+    //
+    bool is_rp_changed
+	= (pim_mrt_rp().source_by_prefix_begin(modified_prefix_addr)
+	   != pim_mrt_rp().source_by_prefix_end(modified_prefix_addr));
+    bool is_s_changed
+	= ((pim_mrt_sg().source_by_prefix_begin(modified_prefix_addr)
+	    != pim_mrt_sg().source_by_prefix_end(modified_prefix_addr))
+	   || (pim_mrt_sg_rpt().source_by_prefix_begin(modified_prefix_addr)
+	       != pim_mrt_sg_rpt().source_by_prefix_end(modified_prefix_addr))
+	   || (pim_mrt_mfc().source_by_prefix_begin(modified_prefix_addr)
+	       != pim_mrt_mfc().source_by_prefix_end(modified_prefix_addr)));
+    
+    if (! (is_rp_changed || is_s_changed))
+	return;
+    
+    //
+    // If the latest tasks are for MRIB changes as well, just add
+    // the prefix to those tasks. Otherwise, allocate new tasks.
+    // Thus, a burst of MRIB changes is processed by a single pair of
+    // tasks instead of a pair of tasks per modified prefix.
+    //
+    list<PimMreTask *>::reverse_iterator iter;
+    for (iter = pim_mre_task_list().rbegin();
+	 iter != pim_mre_task_list().rend();
+	 ++iter) {
+	PimMreTask *pim_mre_task = *iter;
+	if (pim_mre_task->input_state()
+	    == PimMreTrackState::INPUT_STATE_MRIB_RP_CHANGED) {
+	    if (pim_mre_task_rp == NULL)
+		pim_mre_task_rp = pim_mre_task;
+	    continue;
+	}
+	if (pim_mre_task->input_state()
+	    == PimMreTrackState::INPUT_STATE_MRIB_S_CHANGED) {
+	    if (pim_mre_task_s == NULL)
+		pim_mre_task_s = pim_mre_task;
+	    continue;
+	}
+	break;
+    }
+    
+    if (is_rp_changed) {
 	// Schedule the RP-related changes
-	pim_mre_task
-	    = new PimMreTask(this,
-			     PimMreTrackState::INPUT_STATE_MRIB_RP_CHANGED);
-	pim_mre_task->set_rp_addr_prefix_rp(modified_prefix_addr);
-	
-	add_task(pim_mre_task);
-    } while (false);
+	if (pim_mre_task_rp == NULL) {
+	    pim_mre_task_rp
+		= new PimMreTask(this,
+				 PimMreTrackState::INPUT_STATE_MRIB_RP_CHANGED);
+	    add_task(pim_mre_task_rp);
+	}
+	pim_mre_task_rp->add_mrib_modified_prefix(modified_prefix_addr);
+    }
     
-    do {
+    if (is_s_changed) {
 	// Schedule the S-related changes
-	pim_mre_task
-	    = new PimMreTask(this,
-			     PimMreTrackState::INPUT_STATE_MRIB_S_CHANGED);
-	pim_mre_task->set_source_addr_prefix_sg_sg_rpt(modified_prefix_addr);
-	
-	add_task(pim_mre_task);
-    } while (false);
+	if (pim_mre_task_s == NULL) {
+	    pim_mre_task_s
+		= new PimMreTask(this,
+				 PimMreTrackState::INPUT_STATE_MRIB_S_CHANGED);
+	    add_task(pim_mre_task_s);
+	}
+	pim_mre_task_s->add_mrib_modified_prefix(modified_prefix_addr);
+    }
 }
 
 void
@@ -727,11 +727,10 @@ PimJpHeader::network_commit(PimVif *pim_vif, const IPvX& target_nbr_addr,
 	    // Go through the (S,G) entries and add (S,G,rpt) Prune
 	    // if needed
 	    //
-	    PimMrtSg::const_gs_iterator iter3_begin, iter3_end, iter3;
-	    iter3_begin = pim_mrt().pim_mrt_sg().group_by_addr_begin(pim_mre_wc->group_addr());
-	    iter3_end = pim_mrt().pim_mrt_sg().group_by_addr_end(pim_mre_wc->group_addr());
-	    for (iter3 = iter3_begin; iter3 != iter3_end; ++iter3) {
-		PimMre *pim_mre_sg = iter3->second;
+	    PimMre *pim_mre_sg;
+	    for (pim_mre_sg = pim_mrt().pim_mrt_sg().group_list_begin(pim_mre_wc->group_addr());
+		 pim_mre_sg != NULL;
+		 pim_mre_sg = pim_mre_sg->group_next()) {
 		
 		if (pim_mre_sg->is_spt()) {
 		    // Note: If receiving (S,G) on the SPT, we only prune off
@@ -754,10 +753,10 @@ PimJpHeader::network_commit(PimVif *pim_vif, const IPvX& target_nbr_addr,
 	    // Go through the (S,G,rpt) entries and add (S,G,rpt) Prune
 	    // if needed.
 	    //
-	    iter3_begin = pim_mrt().pim_mrt_sg_rpt().group_by_addr_begin(pim_mre_wc->group_addr());
-	    iter3_end = pim_mrt().pim_mrt_sg_rpt().group_by_addr_end(pim_mre_wc->group_addr());
-	    for (iter3 = iter3_begin; iter3 != iter3_end; ++iter3) {
-		PimMre *pim_mre_sg_rpt = iter3->second;
+	    PimMre *pim_mre_sg_rpt;
+	    for (pim_mre_sg_rpt = pim_mrt().pim_mrt_sg_rpt().group_list_begin(pim_mre_wc->group_addr());
+		 pim_mre_sg_rpt != NULL;
+		 pim_mre_sg_rpt = pim_mre_sg_rpt->group_next()) {
 		if (pim_mre_sg_rpt->inherited_olist_sg_rpt().none()) {
 		    // Note: all (*,G) olist interfaces received RPT prunes
 		    // for (S,G).
@@ -169,11 +169,9 @@ PimVif::pim_register_stop_process(const IPvX& rp_addr,
     // Apply to all (S,G) entries for this group that are not in the NoInfo
     // state.
     // TODO: XXX: PAVPAVPAV: should schedule a timeslice task for this.
-    PimMrtSg::const_gs_iterator iter_begin, iter_end, iter;
-    iter_begin = pim_mrt().pim_mrt_sg().group_by_addr_begin(group_addr);
-    iter_end = pim_mrt().pim_mrt_sg().group_by_addr_end(group_addr);
-    for (iter = iter_begin; iter != iter_end; ++iter) {
-	PimMre *pim_mre = iter->second;
+    for (pim_mre = pim_mrt().pim_mrt_sg().group_list_begin(group_addr);
+	 pim_mre != NULL;
+	 pim_mre = pim_mre->group_next()) {
 	if (! pim_mre->is_register_noinfo_state())
 	    pim_mre->receive_register_stop();
     }
@@ -0,0 +1,616 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "policy/policy_module.h"
+#include "libxorp/xorp.h"
+#include "policy/common/operator_base.hh"
+#include "compiled_exec.hh"
+
+CompiledExec::CompiledExec() :
+	_depth(0), _max_depth(0), _failed(false), _compiled(false),
+	_sman(NULL), _subr(NULL), _varrw(NULL), _stack(NULL), _stacks(0),
+	_trash(NULL), _trashc(0), _trashs(2000), _true(true), _false(false)
+#ifndef XORP_DISABLE_PROFILE
+	, _profiler(NULL)
+#endif
+{
+    _trash = new Element*[_trashs];
+}
+
+CompiledExec::~CompiledExec()
+{
+    clear();
+    delete [] _trash;
+}
+
+void
+CompiledExec::clear()
+{
+    clear_trash();
+
+    for (vector<Element*>::iterator i = _consts.begin();
+	 i != _consts.end(); ++i) {
+	delete *i;
+    }
+    _consts.clear();
+
+    _ops.clear();
+    _programs.clear();
+    _policies.clear();
+    _subr_programs.clear();
+    _compiling.clear();
+    _term_ops.clear();
+
+    delete [] _stack;
+    _stack = NULL;
+    _stacks = 0;
+
+    _compiled = false;
+}
+
+bool
+CompiledExec::compile(vector<PolicyInstr*>* policies, SetManager* sman,
+		      SUBR* subr)
+{
+    clear();
+
+    if (!policies)
+	return false;
+
+    _sman   = sman;
+    _subr   = subr;
+    _failed = false;
+
+    unsigned depth = 0;
+
+    try {
+	for (vector<PolicyInstr*>::iterator i = policies->begin();
+	     i != policies->end() && !_failed; ++i) {
+	    unsigned idx = compile_policy(**i);
+
+	    if (_failed)
+		break;
+
+	    _policies.push_back(idx);
+	    depth = max(depth, _programs[idx].depth);
+	}
+    } catch (const PolicyException& e) {
+	// such as a missing set: let IvExec report it when it gets there
+	_failed = true;
+    }
+
+    if (_failed) {
+	clear();
+	return false;
+    }
+
+    _stacks   = depth + 1;
+    _stack    = new const Element*[_stacks];
+    _compiled = true;
+
+    return true;
+}
+
+unsigned
+CompiledExec::compile_policy(PolicyInstr& pi)
+{
+    if (pi.trace()) {
+	_failed = true;
+	return 0;
+    }
+
+    // we may be compiling a subroutine in the middle of a term
+    vector<Op> term_ops;
+    unsigned depth     = _depth;
+    unsigned max_depth = _max_depth;
+
+    term_ops.swap(_term_ops);
+
+    Policy p;
+    TermInstr** terms = pi.terms();
+
+    p.instr = &pi;
+
+    for (int i = 0; i < pi.termc() && !_failed; i++) {
+	Instruction** instr = terms[i]->instructions();
+
+	_term_ops.clear();
+	_depth = _max_depth = 0;
+
+	for (int j = 0; j < terms[i]->instrc() && !_failed; j++)
+	    instr[j]->accept(*this);
+
+	_term_ops.push_back(Op(Op::END));
+
+	p.terms.push_back(_ops.size());
+	p.term_instrs.push_back(terms[i]);
+	_ops.insert(_ops.end(), _term_ops.begin(), _term_ops.end());
+	p.depth = max(p.depth, _max_depth);
+    }
+
+    _programs.push_back(p);
+
+    _term_ops.swap(term_ops);
+    _depth     = depth;
+    _max_depth = max_depth;
+
+    return _programs.size() - 1;
+}
+
+void
+CompiledExec::push_op(const Op& op)
+{
+    _term_ops.push_back(op);
+
+    _depth++;
+    _max_depth = max(_max_depth, _depth);
+}
+
+void
+CompiledExec::pop_args(unsigned argc)
+{
+    // IvExec throws at run time, and so it will
+    if (_depth < argc) {
+	_failed = true;
+	return;
+    }
+
+    _depth -= argc;
+}
+
+bool
+CompiledExec::fold(const Oper& oper)
+{
+    unsigned argc = oper.arity();
+
+    if (argc == 0 || _term_ops.size() < argc)
+	return false;
+
+    // the arguments must all be constants, pushed right before
+    const Element* argv[2];
+    for (unsigned i = 0; i < argc; i++) {
+	const Op& arg = _term_ops[_term_ops.size() - argc + i];
+
+	if (arg.code != Op::PUSH)
+	    return false;
+
+	argv[i] = arg.elem;
+    }
+
+    Element* r;
+    try {
+	r = _disp.run(oper, argc, argv);
+    } catch (const PolicyException& e) {
+	// leave the error for run time
+	return false;
+    }
+
+    if (r->refcount() == 1)
+	_consts.push_back(r);
+
+    _term_ops.erase(_term_ops.end() - argc, _term_ops.end());
+    _depth -= argc;
+
+    Op op(Op::PUSH);
+    op.elem = r;
+    push_op(op);
+
+    return true;
+}
+
+void
+CompiledExec::visit(Push& p)
+{
+    // node owns element
+    Op op(Op::PUSH);
+    op.elem = &p.elem();
+
+    push_op(op);
+}
+
+void
+CompiledExec::visit(PushSet& ps)
+{
+    // set manager owns set, and keeps it until the filter is configured again
+    Op op(Op::PUSH);
+    op.elem = &_sman->getSet(ps.setid());
+
+    push_op(op);
+}
+
+void
+CompiledExec::visit(OnFalseExit& /* x */)
+{
+    if (_depth == 0) {
+	_failed = true;
+	return;
+    }
+
+    // a true constant never exits
+    if (!_term_ops.empty()) {
+	const Op& top = _term_ops.back();
+
+	if (top.code == Op::PUSH && top.elem->hash() == ElemBool::_hash
+	    && static_cast<const ElemBool*>(top.elem)->val())
+	    return;
+    }
+
+    _term_ops.push_back(Op(Op::ON_FALSE_EXIT));
+}
+
+void
+CompiledExec::visit(Load& l)
+{
+    Op op(Op::LOAD);
+    op.var = l.var();
+
+    push_op(op);
+}
+
+void
+CompiledExec::visit(Store& s)
+{
+    pop_args(1);
+
+    Op op(Op::STORE);
+    op.var = s.var();
+
+    _term_ops.push_back(op);
+}
+
+void
+CompiledExec::visit(Accept& /* a */)
+{
+    _term_ops.push_back(Op(Op::ACCEPT));
+}
+
+void
+CompiledExec::visit(Reject& /* r */)
+{
+    _term_ops.push_back(Op(Op::REJECT));
+}
+
+void
+CompiledExec::visit(Next& next)
+{
+    switch (next.flow()) {
+    case Next::TERM:
+	_term_ops.push_back(Op(Op::NEXT_TERM));
+	break;
+
+    case Next::POLICY:
+	_term_ops.push_back(Op(Op::NEXT_POLICY));
+	break;
+    }
+}
+
+void
+CompiledExec::visit(NaryInstr& nary)
+{
+    const Oper& oper = nary.op();
+    unsigned argc = oper.arity();
+
+    // the dispatcher only runs unary and binary operations
+    if (argc < 1 || argc > 2) {
+	_failed = true;
+	return;
+    }
+
+    if (fold(oper))
+	return;
+
+    pop_args(argc);
+
+    Op::Code code = argc == 1 ? Op::UNARY : Op::BINARY;
+
+    // the constructor needs to inspect its arguments
+    if (oper.hash() == HASH_OP_CTR)
+	code = Op::NARY;
+
+    Op op(code);
+    op.oper = &oper;
+
+    push_op(op);
+}
+
+void
+CompiledExec::visit(Subr& sub)
+{
+    string target = sub.target();
+
+    if (!_subr) {
+	_failed = true;
+	return;
+    }
+
+    SUBR::iterator i = _subr->find(target);
+    if (i == _subr->end() || _compiling.count(target)) {
+	_failed = true;
+	return;
+    }
+
+    map<string, unsigned>::iterator j = _subr_programs.find(target);
+    unsigned idx;
+
+    if (j == _subr_programs.end()) {
+	_compiling.insert(target);
+	idx = compile_policy(*i->second);
+	_compiling.erase(target);
+
+	if (_failed)
+	    return;
+
+	_subr_programs[target] = idx;
+    } else
+	idx = j->second;
+
+    // the subroutine gets a stack frame on top of ours
+    _max_depth = max(_max_depth, _depth + _programs[idx].depth);
+
+    Op op(Op::SUBR);
+    op.target = idx;
+
+    push_op(op);
+}
+
+IvExec::FlowAction
+CompiledExec::run(VarRW* varrw)
+{
+    XLOG_ASSERT(_compiled);
+    XLOG_ASSERT(varrw);
+
+    _varrw = varrw;
+    _varrw->enable_trace(false);
+
+    IvExec::FlowAction ret = IvExec::DEFAULT;
+
+    // execute all policies
+    for (int i = _policies.size() - 1; i >= 0; --i) {
+	IvExec::FlowAction fa = run_policy(_programs[_policies[i]], _stack);
+
+	// if a policy rejected/accepted a route then terminate.
+	if (fa != IvExec::DEFAULT) {
+	    ret = fa;
+	    break;
+	}
+    }
+
+    // important because varrw may hold pointers to trash elements
+    _varrw->sync();
+
+    clear_trash();
+
+    return ret;
+}
+
+IvExec::FlowAction
+CompiledExec::run_policy(const Policy& p, const Element** stack)
+{
+    IvExec::FlowAction outcome = IvExec::DEFAULT;
+    bool policy_matched = false;
+
+    for (unsigned t = 0; t < p.terms.size(); t++) {
+	Op* op = &_ops[p.terms[t]];
+	const Element** sp = stack - 1;
+	IvExec::FlowAction fa = IvExec::DEFAULT;
+	bool next_policy = false;
+	bool finished = false;
+	bool matched = true;
+	const Element* e;
+
+	for (; op->code != Op::END; ++op) {
+#ifndef XORP_DISABLE_PROFILE
+	    if (_profiler)
+		_profiler->start();
+#endif
+	    switch (op->code) {
+	    case Op::PUSH:
+		*++sp = op->elem;
+		break;
+
+	    case Op::LOAD:
+		// varrw owns element
+		*++sp = &_varrw->read_trace(op->var);
+		break;
+
+	    case Op::STORE:
+		e = *sp--;
+		if (e->hash() != ElemNull::_hash)
+		    _varrw->write_trace(op->var, *e);
+		break;
+
+	    case Op::UNARY:
+		*sp = apply_unary(*op, **sp);
+		break;
+
+	    case Op::BINARY:
+		// top-most argument is first
+		e = *sp--;
+		*sp = apply_binary(*op, *e, **sp);
+		break;
+
+	    case Op::NARY:
+		sp -= op->oper->arity() - 1;
+		*sp = apply_nary(*op, sp);
+		break;
+
+	    case Op::ON_FALSE_EXIT:
+		// we do not pop the element [see IvExec]
+		e = *sp;
+		if (e->hash() == ElemBool::_hash) {
+		    if (!static_cast<const ElemBool*>(e)->val()) {
+			finished = true;
+			matched = false;
+		    }
+		} else if (e->hash() == ElemNull::_hash) {
+		    finished = true;
+		    matched = false;
+		} else
+		    xorp_throw(IvExec::RuntimeError,
+			       "Expected bool on top of stack instead: ");
+		break;
+
+	    case Op::ACCEPT:
+		fa = IvExec::ACCEPT;
+		finished = true;
+		break;
+
+	    case Op::REJECT:
+		fa = IvExec::REJ;
+		finished = true;
+		break;
+
+	    case Op::NEXT_TERM:
+		finished = true;
+		break;
+
+	    case Op::NEXT_POLICY:
+		next_policy = true;
+		finished = true;
+		break;
+
+	    case Op::SUBR:
+		e = run_policy(_programs[op->target], sp + 1) == IvExec::REJ
+		    ? &_false : &_true;
+		*++sp = e;
+		break;
+
+	    case Op::END:
+		XLOG_UNREACHABLE();
+	    }
+#ifndef XORP_DISABLE_PROFILE
+	    if (_profiler)
+		_profiler->stop();
+#endif
+
+	    if (finished)
+		break;
+	}
+
+	p.term_instrs[t]->counters().count(matched, fa == IvExec::ACCEPT,
+					   fa == IvExec::REJ);
+	if (matched)
+	    policy_matched = true;
+
+	if (fa != IvExec::DEFAULT) {
+	    outcome = fa;
+	    break;
+	}
+
+	if (next_policy)
+	    break;
+    }
+
+    p.instr->counters().count(policy_matched, outcome == IvExec::ACCEPT,
+			      outcome == IvExec::REJ);
+
+    return outcome;
+}
+
+const Element*
+CompiledExec::apply_unary(Op& op, const Element& arg)
+{
+    Element::Hash h = arg.hash();
+
+    if (h != op.h1) {
+	if (h == ElemNull::_hash)
+	    return &_null;
+
+	op.un = _disp.lookup_un(*op.oper, h);
+	op.h1 = h;
+    }
+
+    if (!op.un) {
+	const Element* argv[] = { &arg };
+
+	return apply_nary(op, argv);
+    }
+
+    Element* r = op.un(arg);
+
+    if (r->refcount() == 1) {
+	_trash[_trashc++] = r;
+	XLOG_ASSERT(_trashc < _trashs);
+    }
+
+    return r;
+}
+
+const Element*
+CompiledExec::apply_binary(Op& op, const Element& left, const Element& right)
+{
+    Element::Hash lh = left.hash();
+    Element::Hash rh = right.hash();
+
+    if (lh != op.h1 || rh != op.h2) {
+	if (lh == ElemNull::_hash || rh == ElemNull::_hash)
+	    return &_null;
+
+	op.bin = _disp.lookup_bin(*op.oper, lh, rh);
+	op.h1  = lh;
+	op.h2  = rh;
+    }
+
+    if (!op.bin) {
+	const Element* argv[] = { &right, &left };
+
+	return apply_nary(op, argv);
+    }
+
+    Element* r = op.bin(left, right);
+
+    if (r->refcount() == 1) {
+	_trash[_trashc++] = r;
+	XLOG_ASSERT(_trashc < _trashs);
+    }
+
+    return r;
+}
+
+const Element*
+CompiledExec::apply_nary(const Op& op, const Element** argv)
+{
+    // arguments are as on the stack: the top-most, first one, is last
+    Element* r = _disp.run(*op.oper, op.oper->arity(), argv);
+
+    if (r->refcount() == 1) {
+	_trash[_trashc++] = r;
+	XLOG_ASSERT(_trashc < _trashs);
+    }
+
+    return r;
+}
+
+void
+CompiledExec::clear_trash()
+{
+    for (unsigned i = 0; i < _trashc; i++)
+	delete _trash[i];
+
+    _trashc = 0;
+}
+
+#ifndef XORP_DISABLE_PROFILE
+void
+CompiledExec::set_profiler(PolicyProfiler* pp)
+{
+    _profiler = pp;
+}
+#endif
@@ -0,0 +1,200 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __POLICY_BACKEND_COMPILED_EXEC_HH__
+#define __POLICY_BACKEND_COMPILED_EXEC_HH__
+
+#include "libxorp/xorp.h"
+
+#include "policy/common/dispatcher.hh"
+#include "policy/common/varrw.hh"
+#include "policy/common/element.hh"
+#include "policy/common/elem_null.hh"
+#ifndef XORP_DISABLE_PROFILE
+#include "policy_profiler.hh"
+#endif
+
+#include "instruction.hh"
+#include "set_manager.hh"
+#include "term_instr.hh"
+#include "policy_instr.hh"
+#include "policy_backend_parser.hh"
+#include "iv_exec.hh"
+
+/**
+ * @short Executes policies compiled to a flat sequence of operations.
+ *
+ * The instructions of all terms are translated once, when the filter is
+ * configured, into operations with their arguments already bound: the
+ * elements pushed and the sets are resolved to pointers, operations on
+ * constants are folded, and the callback of each operator is taken from the
+ * dispatcher the first time it runs and kept for as long as the types of its
+ * arguments do not change.  Running a filter then needs neither a visitor
+ * nor a dispatcher lookup, and only allocates if an operator creates a new
+ * element [boolean results are shared].
+ *
+ * Policies that are traced are not compiled, as only IvExec produces an
+ * execution trace.  The same goes for instructions that cannot be compiled.
+ * The caller should then use IvExec instead.
+ */
+class CompiledExec :
+    public NONCOPYABLE,
+    public InstrVisitor
+{
+public:
+    CompiledExec();
+    ~CompiledExec();
+
+    /**
+     * Compile policies.  The previous program is discarded.
+     *
+     * @return true if the policies were compiled, false if they need to be
+     * run by IvExec.
+     * @param policies policies to compile, NULL to discard the program.
+     * @param sman the sets referenced by the policies.
+     * @param subr the subroutines referenced by the policies.
+     */
+    bool compile(vector<PolicyInstr*>* policies, SetManager* sman,
+		 SUBR* subr);
+
+    /**
+     * @return true if there is a program to run.
+     */
+    bool compiled() const { return _compiled; }
+
+    /**
+     * Execute the compiled policies.
+     */
+    IvExec::FlowAction run(VarRW* varrw);
+
+    /**
+     * @return number of operations in the program.
+     */
+    unsigned op_count() const { return _ops.size(); }
+
+#ifndef XORP_DISABLE_PROFILE
+    void set_profiler(PolicyProfiler*);
+#endif
+
+    // Translation of instructions to operations.
+    void visit(Push& p);
+    void visit(PushSet& ps);
+    void visit(OnFalseExit& x);
+    void visit(Load& l);
+    void visit(Store& s);
+    void visit(Accept& a);
+    void visit(Reject& r);
+    void visit(NaryInstr& nary);
+    void visit(Next& next);
+    void visit(Subr& sub);
+
+private:
+    /**
+     * A compiled instruction.  A term ends with an END operation.
+     */
+    struct Op {
+	enum Code {
+	    PUSH,	    // push elem
+	    LOAD,	    // push variable var
+	    STORE,	    // pop into variable var
+	    UNARY,	    // apply oper, cached callback un
+	    BINARY,	    // apply oper, cached callback bin
+	    NARY,	    // apply oper through the dispatcher
+	    ON_FALSE_EXIT,
+	    ACCEPT,
+	    REJECT,
+	    NEXT_TERM,
+	    NEXT_POLICY,
+	    SUBR,	    // run policy target, push its result
+	    END
+	};
+
+	Op(Code c) : code(c), elem(NULL), var(0), oper(NULL), target(0),
+		     h1(0), h2(0) { bin = NULL; }
+
+	Code		    code;
+	const Element*	    elem;
+	VarRW::Id	    var;
+	const Oper*	    oper;
+	unsigned	    target;
+	Element::Hash	    h1;	    // argument types the callback is for
+	Element::Hash	    h2;
+	union {
+	    Dispatcher::CB_un	un;
+	    Dispatcher::CB_bin	bin;
+	};
+    };
+
+    /**
+     * A compiled policy: the offsets of the first operation of its terms,
+     * and the stack space needed to run it.  The instructions it was
+     * compiled from keep the counters.
+     */
+    struct Policy {
+	Policy() : depth(0), instr(NULL) {}
+
+	vector<unsigned>    terms;
+	unsigned	    depth;
+	PolicyInstr*	    instr;
+	vector<TermInstr*>  term_instrs;
+    };
+
+    void clear();
+    unsigned compile_policy(PolicyInstr& pi);
+    void push_op(const Op& op);
+    void pop_args(unsigned argc);
+    bool fold(const Oper& oper);
+
+    IvExec::FlowAction run_policy(const Policy& p, const Element** stack);
+    const Element* apply_unary(Op& op, const Element& arg);
+    const Element* apply_binary(Op& op, const Element& left,
+				const Element& right);
+    const Element* apply_nary(const Op& op, const Element** argv);
+    void clear_trash();
+
+    vector<Op>		    _ops;
+    vector<Policy>	    _programs;
+    vector<unsigned>	    _policies;	    // entry points, run last first
+    map<string, unsigned>   _subr_programs;
+    set<string>		    _compiling;
+    vector<Element*>	    _consts;	    // results of folded operations
+    vector<Op>		    _term_ops;	    // term being compiled
+    unsigned		    _depth;	    // its stack depth
+    unsigned		    _max_depth;
+    bool		    _failed;
+    bool		    _compiled;
+    SetManager*		    _sman;
+    SUBR*		    _subr;
+    VarRW*		    _varrw;
+    Dispatcher		    _disp;
+    const Element**	    _stack;
+    unsigned		    _stacks;
+    Element**		    _trash;
+    unsigned		    _trashc;
+    unsigned		    _trashs;
+    ElemNull		    _null;
+    ElemBool		    _true;
+    ElemBool		    _false;
+#ifndef XORP_DISABLE_PROFILE
+    PolicyProfiler*	    _profiler;
+#endif
+};
+
+#endif // __POLICY_BACKEND_COMPILED_EXEC_HH__
@@ -56,6 +56,33 @@ public:
      * @param varrw the VarRW associated with the route being filtered.
      */
     virtual bool acceptRoute(VarRW& varrw) = 0;
+
+    /**
+     * Check whether the configuration changes made since a route was last
+     * filtered may alter the outcome of the filter for that route.
+     *
+     * Filters which do not keep track of changes must assume they do.
+     *
+     * @return true if the route must be filtered again.
+     * @param varrw the VarRW associated with the route being checked.
+     */
+    virtual bool route_in_scope(VarRW& /* varrw */) { return true; }
+
+    /**
+     * Associate the latest configuration with a route, without running it.
+     *
+     * Only valid for routes which are not in scope of the changes.
+     *
+     * @param varrw the VarRW associated with the route being refreshed.
+     */
+    virtual void refresh_route(VarRW& /* varrw */) {}
+
+    /**
+     * Report how the policies of the filter have been matching routes.
+     *
+     * @return human readable statistics, empty if the filter keeps none.
+     */
+    virtual string statistics() { return ""; }
 };
 
 #endif // __POLICY_BACKEND_FILTER_BASE_HH__
@@ -29,7 +29,8 @@
 
 IvExec::IvExec() : 
 	       _policies(NULL), _policy_count(0), _stack_bottom(NULL), 
-	       _sman(NULL), _varrw(NULL), _finished(false), _fa(DEFAULT),
+	       _sman(NULL), _varrw(NULL), _finished(false),
+	       _term_matched(false), _fa(DEFAULT),
 	       _trash(NULL), _trashc(0), _trashs(2000)
 #ifndef XORP_DISABLE_PROFILE
 	       , _profiler(NULL)
@@ -122,10 +123,15 @@ IvExec::runPolicy(PolicyInstr& pi)
     // execute terms sequentially
     _ctr_flow = Next::TERM;
 
+    bool matched = false;
+
     // run all terms
     for (int i = 0; i < termc ; ++i) {
 	FlowAction fa = runTerm(*terms[i]);
 
+	if (_term_matched)
+	    matched = true;
+
 	// if term accepted/rejected route, then terminate.
 	if (fa != DEFAULT) {
 	    outcome = fa;
@@ -136,6 +142,8 @@ IvExec::runPolicy(PolicyInstr& pi)
 	    break;
     }
 
+    pi.counters().count(matched, outcome == ACCEPT, outcome == REJ);
+
     if (_do_trace)
 	_os << "Outcome of policy: " << fa2str(outcome) << endl;
 
@@ -152,6 +160,7 @@ IvExec::runTerm(TermInstr& ti)
 
     // we just started
     _finished = false;
+    _term_matched = true;
     _fa = DEFAULT;
 
     // clear stack
@@ -185,6 +194,8 @@ IvExec::runTerm(TermInstr& ti)
     if (_do_trace)
 	_os << "Outcome of term: " << fa2str(_fa) << endl;
 
+    ti.counters().count(_term_matched, _fa == ACCEPT, _fa == REJ);
+
     return _fa;
 }
 
@@ -232,6 +243,7 @@ IvExec::visit(OnFalseExit& /* x */)
 	    if(_do_trace)
 		_os << "GOT NULL ON TOP OF STACK, GOING TO NEXT TERM" << endl;
 	    _finished = true;
+	    _term_matched = false;
 	    return;
         }
 
@@ -250,8 +262,10 @@ IvExec::visit(OnFalseExit& /* x */)
     // continue computing the AND.
 
     // it is false, so lets go to next term
-    if(!t->val())
+    if(!t->val()) {
 	_finished = true;
+	_term_matched = false;
+    }
 
     if(_do_trace)
 	_os << "ONFALSE_EXIT: " << t->str() << endl;
@@ -458,11 +472,13 @@ IvExec::visit(Subr& sub)
 
     FlowAction old_fa = _fa;
     bool old_finished = _finished;
+    bool old_term_matched = _term_matched;
 
     FlowAction fa = runPolicy(*policy);
 
-    _fa       = old_fa;
-    _finished = old_finished;
+    _fa		  = old_fa;
+    _finished	  = old_finished;
+    _term_matched = old_term_matched;
 
     bool result = true;
 
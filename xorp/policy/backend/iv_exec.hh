@@ -166,6 +166,7 @@ private:
     SetManager*	    _sman;
     VarRW*	    _varrw;
     bool	    _finished;
+    bool	    _term_matched;	// no ON_FALSE_EXIT ended the term
     Dispatcher	    _disp;
     FlowAction	    _fa;
     Element**	    _trash;
@@ -23,6 +23,7 @@
 #include "policy/policy_module.h"
 #include "libxorp/xorp.h"
 #include "libxorp/xlog.h"
+#include "libxorp/c_format.hh"
 #include "policy/common/policy_utils.hh"
 #include "policy_filter.hh"
 #include "policy_backend_parser.hh"
@@ -32,11 +33,11 @@
 using namespace policy_utils;
 using policy_backend_parser::policy_backend_parse;
 
-PolicyFilter::PolicyFilter() : _policies(NULL),
+PolicyFilter::PolicyFilter() : _policies(NULL), _use_compiled(true),
 #ifndef XORP_DISABLE_PROFILE
 			       _profiler_exec(NULL),
 #endif
-			       _subr(NULL)
+			       _subr(NULL), _version(0)
 {
     _exec.set_set_manager(&_sman);
 }
@@ -64,10 +65,15 @@ void PolicyFilter::configure(const string& str)
 
     // replace with new conf
     _policies = policies;
+    _times = FilterTimes();
     _subr = subr;
     _sman.replace_sets(sets);
     _exec.set_policies(_policies);
     _exec.set_subr(_subr);
+
+    // the interpreter remains for whatever cannot be compiled
+    if (_use_compiled)
+	_compiled_exec.compile(_policies, &_sman, _subr);
 }
 
 PolicyFilter::~PolicyFilter()
@@ -78,6 +84,7 @@ PolicyFilter::~PolicyFilter()
 void PolicyFilter::reset()
 {
     if (_policies) {
+	_compiled_exec.compile(NULL, NULL, NULL);
 	delete_vector(_policies);
 	_policies = NULL;
 	_exec.set_policies(NULL);
@@ -106,13 +113,23 @@ bool PolicyFilter::acceptRoute(VarRW& varrw)
 	return default_action;
     }	
 
+    IvExec::FlowAction fa;
+    uint64_t start = FilterTimes::now();
+
+    // run policies
+    if (_compiled_exec.compiled()) {
+#ifndef XORP_DISABLE_PROFILE
+	_compiled_exec.set_profiler(_profiler_exec);
+#endif
+	fa = _compiled_exec.run(&varrw);
+    } else {
 #ifndef XORP_DISABLE_PROFILE
-    // setup profiling
-    _exec.set_profiler(_profiler_exec);
+	_exec.set_profiler(_profiler_exec);
 #endif
+	fa = _exec.run(&varrw);
+    }
 
-    // run policies
-    IvExec::FlowAction fa = _exec.run(&varrw);
+    _times.add(FilterTimes::now() - start);
 
     // print any trace data...
     uint32_t level = varrw.trace();
@@ -168,6 +185,56 @@ bool PolicyFilter::acceptRoute(VarRW& varrw)
     return default_action;
 }
 
+string
+PolicyFilter::statistics()
+{
+    if (!_policies)
+	return "No policies configured\n";
+
+    string s = c_format("%-32s %12s %12s %12s %12s\n", "Policy/Term",
+			"Evaluated", "Matched", "Accepted", "Rejected");
+
+    // policies run last first
+    for (vector<PolicyInstr*>::reverse_iterator i = _policies->rbegin();
+	 i != _policies->rend(); ++i) {
+	PolicyInstr* pi = *i;
+	const PolicyCounters& pc = pi->counters();
+
+	s += c_format("%-32s %12llu %12llu %12llu %12llu\n",
+		      pi->name().c_str(),
+		      (unsigned long long) pc.evaluated,
+		      (unsigned long long) pc.matched,
+		      (unsigned long long) pc.accepted,
+		      (unsigned long long) pc.rejected);
+
+	TermInstr** terms = pi->terms();
+	for (int j = 0; j < pi->termc(); j++) {
+	    const PolicyCounters& tc = terms[j]->counters();
+	    string name = "  " + terms[j]->name();
+
+	    s += c_format("%-32s %12llu %12llu %12llu %12llu\n",
+			  name.c_str(),
+			  (unsigned long long) tc.evaluated,
+			  (unsigned long long) tc.matched,
+			  (unsigned long long) tc.accepted,
+			  (unsigned long long) tc.rejected);
+	}
+    }
+
+    return s + _times.str();
+}
+
+void
+PolicyFilter::set_exec_compiled(bool on)
+{
+    _use_compiled = on;
+
+    if (!_use_compiled)
+	_compiled_exec.compile(NULL, NULL, NULL);
+    else if (_policies && !_compiled_exec.compiled())
+	_compiled_exec.compile(_policies, &_sman, _subr);
+}
+
 #ifndef XORP_DISABLE_PROFILE
 void
 PolicyFilter::set_profiler_exec(PolicyProfiler* profiler)
@@ -34,6 +34,8 @@
 #include "set_manager.hh"
 #include "filter_base.hh"
 #include "iv_exec.hh"
+#include "compiled_exec.hh"
+#include "policy_stats.hh"
 #include "libxorp/ref_ptr.hh"
 
 /**
@@ -86,14 +88,51 @@ public:
     void set_profiler_exec(PolicyProfiler* profiler);
 #endif
 
+    /**
+     * Choose how policies are run.  By default they are compiled when the
+     * filter is configured, unless they are traced.
+     *
+     * @param on true to compile policies, false to always interpret them.
+     */
+    void set_exec_compiled(bool on);
+
+    /**
+     * @return true if the current configuration runs compiled.
+     */
+    bool exec_compiled() const { return _compiled_exec.compiled(); }
+
+    /**
+     * Per policy and per term counters, and the time spent filtering, since
+     * the filter was configured.
+     *
+     * @return human readable statistics.
+     */
+    string statistics();
+
+    /**
+     * Configurations may be versioned by the owner of the filter.
+     *
+     * @return the version of this filter.
+     */
+    uint32_t version() const { return _version; }
+
+    /**
+     * @param version the version of this filter.
+     */
+    void set_version(uint32_t version) { _version = version; }
+
 private:
     vector<PolicyInstr*>*   _policies;
     SetManager		    _sman;
     IvExec		    _exec;
+    CompiledExec	    _compiled_exec;
+    bool		    _use_compiled;
 #ifndef XORP_DISABLE_PROFILE
     PolicyProfiler*	    _profiler_exec;
 #endif
     SUBR*		    _subr;
+    uint32_t		    _version;
+    FilterTimes		    _times;
 };
 
 typedef ref_ptr<PolicyFilter> RefPf;
@@ -65,6 +65,27 @@ PolicyFilters::reset(const uint32_t& ftype)
     pf.reset();
 }
 
+bool
+PolicyFilters::route_in_scope(const uint32_t& ftype, VarRW& varrw)
+{
+    FilterBase& pf = whichFilter(ftype);
+    return pf.route_in_scope(varrw);
+}
+
+void
+PolicyFilters::refresh_route(const uint32_t& ftype, VarRW& varrw)
+{
+    FilterBase& pf = whichFilter(ftype);
+    pf.refresh_route(varrw);
+}
+
+string
+PolicyFilters::statistics(const uint32_t& ftype)
+{
+    FilterBase& pf = whichFilter(ftype);
+    return pf.statistics();
+}
+
 FilterBase& 
 PolicyFilters::whichFilter(const uint32_t& ftype)
 {
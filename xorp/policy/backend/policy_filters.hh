@@ -80,6 +80,33 @@ public:
      */
     void reset(const uint32_t& type);
 
+    /**
+     * Check whether configuration changes may alter the outcome of a filter
+     * for a route which was filtered before the changes were made.
+     *
+     * @return true if the route must be filtered again.
+     * @param type which filter should be checked.
+     * @param varrw the VarRW associated with the route.
+     */
+    bool route_in_scope(const uint32_t& type, VarRW& varrw);
+
+    /**
+     * Associate the latest configuration of a filter with a route which is
+     * not in scope of the changes, without running the filter.
+     *
+     * @param type which filter should be refreshed.
+     * @param varrw the VarRW associated with the route.
+     */
+    void refresh_route(const uint32_t& type, VarRW& varrw);
+
+    /**
+     * Obtain the statistics of a filter.
+     *
+     * @return human readable statistics of the filter.
+     * @param type the filter to report on.
+     */
+    string statistics(const uint32_t& type);
+
 private:
     /**
      * Decide which filter to run based on its type.
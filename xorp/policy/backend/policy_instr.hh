@@ -82,11 +82,18 @@ public:
     void set_trace(bool trace)	{ _trace = trace; }
     bool trace() const		{ return _trace; }
 
+    /**
+     * @return counters of the policy, updated by whoever runs it.
+     */
+    PolicyCounters& counters() { return _counters; }
+    const PolicyCounters& counters() const { return _counters; }
+
 private:
     string	_name;
     TermInstr**	_terms;
     int		_termc;
     bool	_trace;
+    PolicyCounters _counters;
 };
 
 #endif // __POLICY_BACKEND_POLICY_INSTR_HH__
@@ -0,0 +1,454 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+#include "policy/policy_module.h"
+
+#include "libxorp/xorp.h"
+
+#include "policy_scope.hh"
+
+namespace {
+
+/**
+ * Split a configuration into statements.  A newline inside a quoted argument
+ * does not terminate the statement.
+ */
+void
+split_statements(const string& conf, vector<string>& out)
+{
+    string cur;
+    bool quoted = false;
+
+    for (string::size_type i = 0; i < conf.size(); ++i) {
+	char c = conf[i];
+
+	if (c == '"')
+	    quoted = !quoted;
+
+	if (c == '\n' && !quoted) {
+	    if (!cur.empty())
+		out.push_back(cur);
+	    cur.clear();
+	    continue;
+	}
+	cur += c;
+    }
+    if (!cur.empty())
+	out.push_back(cur);
+}
+
+/**
+ * Split off the first word of a statement.
+ *
+ * @return the first word.
+ * @param statement the statement.
+ * @param rest set to the remainder of the statement, without leading blanks.
+ */
+string
+first_word(const string& statement, string& rest)
+{
+    string::size_type start = statement.find_first_not_of(" \t");
+    if (start == string::npos) {
+	rest = "";
+	return "";
+    }
+
+    // statement and rest may be the same string.
+    string::size_type end = statement.find_first_of(" \t", start);
+    string word = statement.substr(start, end == string::npos ?
+					   string::npos : end - start);
+    string::size_type next = end == string::npos ? end :
+			     statement.find_first_not_of(" \t", end);
+
+    rest = next == string::npos ? "" : statement.substr(next);
+
+    return word;
+}
+
+string
+opcode(const string& statement)
+{
+    string rest;
+
+    return first_word(statement, rest);
+}
+
+/**
+ * @return the argument of a single argument statement.
+ */
+string
+argument(const string& statement)
+{
+    string rest;
+
+    first_word(statement, rest);
+    string::size_type end = rest.find_last_not_of(" \t");
+
+    return end == string::npos ? "" : rest.substr(0, end + 1);
+}
+
+bool
+is_operator(const string& op)
+{
+    static const char* ops[] = {
+	"==", "!=", "<", ">", "<=", ">=", "+", "-", "*", "/", "<<", ">>",
+	"&", "|", "^", "NOT", "AND", "OR", "XOR", "HEAD", "CTR",
+	"NON_EMPTY_INTERSECTION", "REGEX", NULL
+    };
+
+    for (const char** i = ops; *i != NULL; ++i) {
+	if (op == *i)
+	    return true;
+    }
+
+    return false;
+}
+
+/**
+ * Statements after which no more conditions of a term follow.
+ */
+bool
+is_action(const string& op)
+{
+    return op == "STORE" || op == "ACCEPT" || op == "REJECT"
+	   || op == "NEXT" || op == "POLICY";
+}
+
+} // anonymous namespace
+
+PolicyScope::PolicyScope(const set<VarRW::Id>& immutable)
+    : _immutable(immutable), _guard_count(0)
+{
+}
+
+PolicyScope::Extent
+PolicyScope::compare(const string& old_conf, const string& new_conf)
+{
+    Conf oldc;
+    Conf newc;
+
+    _scope_conf = "";
+    _guards.str("");
+    _old_sets.clear();
+    _new_sets.clear();
+    _guard_count = 0;
+
+    if (!parse(old_conf, oldc) || !parse(new_conf, newc))
+	return ALL;
+
+    // subroutines may be called from anywhere, so treat them as opaque.
+    if (oldc.subr != newc.subr)
+	return ALL;
+
+    // find the sets whose contents changed.
+    set<string> changed_sets;
+
+    for (SetMap::iterator i = oldc.sets.begin(); i != oldc.sets.end(); ++i) {
+	SetMap::iterator j = newc.sets.find(i->first);
+
+	if (j == newc.sets.end() || j->second != i->second)
+	    changed_sets.insert(i->first);
+    }
+    for (SetMap::iterator i = newc.sets.begin(); i != newc.sets.end(); ++i) {
+	if (oldc.sets.find(i->first) == oldc.sets.end())
+	    changed_sets.insert(i->first);
+    }
+
+    if (!changed_sets.empty()) {
+	Statements subr;
+
+	split_statements(oldc.subr, subr);
+	if (uses_sets(subr, changed_sets))
+	    return ALL;
+    }
+
+    // find the changed terms.  Unchanged terms must keep their relative
+    // order, or the route may be decided by a different term.
+    vector<string> old_kept;
+    vector<string> new_kept;
+    vector<const Statements*> old_changed;
+    vector<const Statements*> new_changed;
+
+    for (vector<string>::iterator i = oldc.order.begin();
+	 i != oldc.order.end(); ++i) {
+
+	const Statements& term = oldc.terms[*i];
+	TermMap::iterator j = newc.terms.find(*i);
+
+	if (j == newc.terms.end() || j->second != term
+	    || uses_sets(term, changed_sets))
+	    old_changed.push_back(&term);
+	else
+	    old_kept.push_back(*i);
+    }
+
+    for (vector<string>::iterator i = newc.order.begin();
+	 i != newc.order.end(); ++i) {
+
+	const Statements& term = newc.terms[*i];
+	TermMap::iterator j = oldc.terms.find(*i);
+
+	if (j == oldc.terms.end() || j->second != term
+	    || uses_sets(term, changed_sets))
+	    new_changed.push_back(&term);
+	else
+	    new_kept.push_back(*i);
+    }
+
+    if (old_kept != new_kept)
+	return ALL;
+
+    if (old_changed.empty() && new_changed.empty())
+	return NONE;
+
+    // the old terms must see the old contents of the changed sets.
+    set<string> none;
+
+    for (vector<const Statements*>::iterator i = old_changed.begin();
+	 i != old_changed.end(); ++i) {
+	if (!add_guard(**i, changed_sets, "old:"))
+	    return ALL;
+    }
+    for (vector<const Statements*>::iterator i = new_changed.begin();
+	 i != new_changed.end(); ++i) {
+	if (!add_guard(**i, none, ""))
+	    return ALL;
+    }
+
+    ostringstream oss;
+
+    oss << "POLICY_START scope" << endl;
+    oss << _guards.str();
+    oss << "TERM_START none" << endl;
+    oss << "REJECT" << endl;
+    oss << "TERM_END" << endl;
+    oss << "POLICY_END" << endl;
+
+    for (set<string>::iterator i = _old_sets.begin();
+	 i != _old_sets.end(); ++i) {
+
+	const string& def = oldc.sets[*i];
+
+	if (changed_sets.find(*i) == changed_sets.end()) {
+	    oss << def << endl;
+	    continue;
+	}
+
+	// SET <type> <name> <value>
+	string rest;
+	string type;
+	string name;
+
+	first_word(def, rest);
+	type = first_word(rest, rest);
+	name = first_word(rest, rest);
+	oss << "SET " << type << " old:" << name << " " << rest << endl;
+    }
+    for (set<string>::iterator i = _new_sets.begin();
+	 i != _new_sets.end(); ++i) {
+	// unchanged sets may already have been emitted for the old terms.
+	if (_old_sets.find(*i) != _old_sets.end()
+	    && changed_sets.find(*i) == changed_sets.end())
+	    continue;
+
+	oss << newc.sets[*i] << endl;
+    }
+
+    _scope_conf = oss.str();
+
+    return SOME;
+}
+
+bool
+PolicyScope::parse(const string& conf, Conf& out)
+{
+    enum { TOP, POLICY, TERM, SUBR } state = TOP;
+    Statements statements;
+    string policy;
+    string key;
+
+    split_statements(conf, statements);
+
+    for (Statements::iterator i = statements.begin();
+	 i != statements.end(); ++i) {
+
+	const string& s = *i;
+	string op = opcode(s);
+
+	if (op.empty())
+	    continue;
+
+	switch (state) {
+	case TOP:
+	    if (op == "POLICY_START") {
+		policy = argument(s);
+		state = POLICY;
+	    } else if (op == "SUBR_START") {
+		state = SUBR;
+	    } else if (op == "SET") {
+		string rest;
+		string name;
+
+		first_word(s, rest);
+		first_word(rest, rest);
+		name = first_word(rest, rest);
+
+		if (out.sets.find(name) != out.sets.end())
+		    return false;
+		out.sets[name] = s;
+	    } else
+		return false;
+	    break;
+
+	case SUBR:
+	    if (op == "SUBR_END")
+		state = TOP;
+	    else
+		out.subr += s + "\n";
+	    break;
+
+	case POLICY:
+	    if (op == "TERM_START") {
+		key = policy + " " + argument(s);
+
+		if (out.terms.find(key) != out.terms.end())
+		    return false;
+		out.order.push_back(key);
+		out.terms[key];
+		state = TERM;
+	    } else if (op == "POLICY_END") {
+		state = TOP;
+	    } else
+		return false;
+	    break;
+
+	case TERM:
+	    if (op == "TERM_END")
+		state = POLICY;
+	    else
+		out.terms[key].push_back(s);
+	    break;
+	}
+    }
+
+    return state == TOP;
+}
+
+bool
+PolicyScope::uses_sets(const Statements& term, const set<string>& sets)
+{
+    if (sets.empty())
+	return false;
+
+    for (Statements::const_iterator i = term.begin(); i != term.end(); ++i) {
+	if (opcode(*i) != "PUSH_SET")
+	    continue;
+
+	if (sets.find(argument(*i)) != sets.end())
+	    return true;
+    }
+
+    return false;
+}
+
+bool
+PolicyScope::add_guard(const Statements& term, const set<string>& renamed,
+		       const string& prefix)
+{
+    ostringstream guard;
+    Statements block;
+    set<string> used;
+    bool immutable = true;
+    bool found = false;
+
+    for (Statements::const_iterator i = term.begin(); i != term.end(); ++i) {
+	string op = opcode(*i);
+
+	if (is_action(op))
+	    break;
+
+	if (op != "ONFALSE_EXIT") {
+	    if (!is_immutable(*i))
+		immutable = false;
+	    block.push_back(*i);
+	    continue;
+	}
+
+	if (immutable && !block.empty()) {
+	    for (Statements::iterator j = block.begin(); j != block.end(); ++j) {
+		if (opcode(*j) != "PUSH_SET") {
+		    guard << *j << endl;
+		    continue;
+		}
+
+		string name = argument(*j);
+
+		used.insert(name);
+		if (renamed.find(name) != renamed.end())
+		    guard << "PUSH_SET " << prefix << name << endl;
+		else
+		    guard << *j << endl;
+	    }
+	    guard << "ONFALSE_EXIT" << endl;
+	    found = true;
+	}
+
+	block.clear();
+	immutable = true;
+    }
+
+    // an unconditional term may affect any route.
+    if (!found)
+	return false;
+
+    _guards << "TERM_START guard" << _guard_count++ << endl;
+    _guards << guard.str();
+    _guards << "ACCEPT" << endl;
+    _guards << "TERM_END" << endl;
+
+    set<string>& sets = prefix.empty() ? _new_sets : _old_sets;
+    sets.insert(used.begin(), used.end());
+
+    return true;
+}
+
+bool
+PolicyScope::is_immutable(const string& statement)
+{
+    string op = opcode(statement);
+
+    if (op == "PUSH" || op == "PUSH_SET")
+	return true;
+
+    if (op == "LOAD") {
+	string arg = argument(statement);
+	char* err = NULL;
+	VarRW::Id id = strtoul(arg.c_str(), &err, 10);
+
+	if (arg.empty() || *err != '\0')
+	    return false;
+
+	return _immutable.find(id) != _immutable.end();
+    }
+
+    return is_operator(op);
+}
@@ -0,0 +1,119 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+#ifndef __POLICY_BACKEND_POLICY_SCOPE_HH__
+#define __POLICY_BACKEND_POLICY_SCOPE_HH__
+
+#include "policy/common/varrw.hh"
+
+/**
+ * @short Works out which routes a filter reconfiguration may affect.
+ *
+ * Two backend configurations are compared term by term.  Terms which were
+ * added, removed or modified [including terms which reference a set whose
+ * contents changed] are the only ones which may filter a route differently.
+ * If a term's conditions are false for a route, the term is skipped no
+ * matter where it sits in the filter.
+ *
+ * Of those conditions only the ones reading immutable variables [such as the
+ * network of the route] are kept, since earlier terms may have modified
+ * anything else.  Dropping a condition only widens the scope, so the result
+ * is conservative.  The kept conditions are emitted as a backend
+ * configuration which accepts a route iff the route may be affected.
+ */
+class PolicyScope {
+public:
+    enum Extent {
+	NONE,	// both configurations filter every route the same way.
+	SOME,	// only routes accepted by scope_conf() may be affected.
+	ALL	// any route may be affected.
+    };
+
+    /**
+     * @param immutable variables which policies can read but never write.
+     */
+    PolicyScope(const set<VarRW::Id>& immutable);
+
+    /**
+     * Compare two backend configurations.
+     *
+     * @return the extent of routes which the change may affect.
+     * @param old_conf the configuration being replaced.
+     * @param new_conf the new configuration.
+     */
+    Extent compare(const string& old_conf, const string& new_conf);
+
+    /**
+     * @return backend configuration accepting the routes which may be
+     * affected.  Only meaningful if compare() returned SOME.
+     */
+    const string& scope_conf() const { return _scope_conf; }
+
+private:
+    typedef vector<string>		Statements;
+    typedef map<string, Statements>	TermMap;
+    typedef map<string, string>		SetMap;
+
+    struct Conf {
+	vector<string>	order;	// term keys in order of execution.
+	TermMap		terms;	// term key -> statements.
+	SetMap		sets;	// set name -> definition.
+	string		subr;	// subroutines are compared as a whole.
+    };
+
+    /**
+     * Split a configuration into terms and sets.
+     *
+     * @return false if the configuration could not be understood.
+     */
+    bool parse(const string& conf, Conf& out);
+
+    /**
+     * @return true if the term uses any of the sets.
+     */
+    bool uses_sets(const Statements& term, const set<string>& sets);
+
+    /**
+     * Append the conditions of a term that only read immutable variables to
+     * the scope configuration.
+     *
+     * @return false if no such conditions exist.
+     * @param term statements of the term.
+     * @param renamed sets to be referenced under a different name.
+     * @param prefix prefix of the renamed sets.
+     */
+    bool add_guard(const Statements& term, const set<string>& renamed,
+		   const string& prefix);
+
+    /**
+     * @return true if a statement is pure and reads no mutable variable.
+     */
+    bool is_immutable(const string& statement);
+
+    set<VarRW::Id>	_immutable;
+    string		_scope_conf;
+    ostringstream	_guards;
+    set<string>		_old_sets;	// sets referenced by old terms.
+    set<string>		_new_sets;	// sets referenced by new terms.
+    unsigned		_guard_count;
+};
+
+#endif // __POLICY_BACKEND_POLICY_SCOPE_HH__
@@ -0,0 +1,106 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "policy/policy_module.h"
+#include "libxorp/xorp.h"
+#include "libxorp/c_format.hh"
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_TIME_H
+#include <time.h>
+#endif
+
+#include "policy_stats.hh"
+
+FilterTimes::FilterTimes() : _routes(0), _total_ns(0)
+{
+    for (unsigned i = 0; i < BUCKETS; i++)
+	_buckets[i] = 0;
+}
+
+uint64_t
+FilterTimes::now()
+#if defined(HAVE_CLOCK_GETTIME) && defined(HAVE_CLOCK_MONOTONIC)
+{
+    struct timespec ts;
+
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#else
+{
+    struct timeval tv;
+
+    ::gettimeofday(&tv, 0);
+
+    return (uint64_t) tv.tv_sec * 1000000000ULL + tv.tv_usec * 1000ULL;
+}
+#endif
+
+void
+FilterTimes::add(uint64_t ns)
+{
+    uint64_t us = ns / 1000;
+    unsigned b = 0;
+
+    while (us && b < BUCKETS - 1) {
+	us >>= 1;
+	b++;
+    }
+
+    _routes++;
+    _total_ns += ns;
+    _buckets[b]++;
+}
+
+string
+FilterTimes::str() const
+{
+    string s;
+
+    s += c_format("Routes filtered: %llu, total time: %llu us",
+		  (unsigned long long) _routes,
+		  (unsigned long long) (_total_ns / 1000));
+
+    if (_routes)
+	s += c_format(", average: %.2f us",
+		      (double) _total_ns / _routes / 1000.0);
+
+    s += "\nTime per route:";
+
+    for (unsigned i = 0; i < BUCKETS; i++) {
+	if (!_buckets[i])
+	    continue;
+
+	if (i == 0)
+	    s += " <1us: ";
+	else if (i == BUCKETS - 1)
+	    s += c_format(" >=%uus: ", 1U << (i - 1));
+	else
+	    s += c_format(" <%uus: ", 1U << i);
+
+	s += c_format("%llu", (unsigned long long) _buckets[i]);
+    }
+
+    return s + "\n";
+}
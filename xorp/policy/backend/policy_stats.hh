@@ -0,0 +1,94 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __POLICY_BACKEND_POLICY_STATS_HH__
+#define __POLICY_BACKEND_POLICY_STATS_HH__
+
+/**
+ * @short Counters of a policy or of a term.
+ *
+ * Unlike the profiler, counters are always kept.  They belong to the
+ * instructions they count, so they start from zero with each configuration.
+ */
+struct PolicyCounters {
+    PolicyCounters() : evaluated(0), matched(0), accepted(0), rejected(0) {}
+
+    /**
+     * Account for one run.
+     *
+     * @param match true if the conditions held.
+     * @param accept true if the route was accepted.
+     * @param reject true if the route was rejected.
+     */
+    void count(bool match, bool accept, bool reject) {
+	evaluated++;
+	if (match)
+	    matched++;
+	if (accept)
+	    accepted++;
+	if (reject)
+	    rejected++;
+    }
+
+    uint64_t	evaluated;	// routes run through
+    uint64_t	matched;	// ... for which the conditions held
+    uint64_t	accepted;
+    uint64_t	rejected;
+};
+
+/**
+ * @short Time spent running a filter.
+ *
+ * Keeps the total, and a histogram of the time taken by each route in
+ * power of two buckets of microseconds.
+ */
+class FilterTimes {
+public:
+    static const unsigned BUCKETS = 16;
+
+    FilterTimes();
+
+    /**
+     * @return the current time in nanoseconds, from an arbitrary origin.
+     */
+    static uint64_t now();
+
+    /**
+     * Account for one route.
+     *
+     * @param ns nanoseconds it took to filter the route.
+     */
+    void add(uint64_t ns);
+
+    /**
+     * @return human readable times.
+     */
+    string str() const;
+
+    uint64_t routes() const { return _routes; }
+    uint64_t total_ns() const { return _total_ns; }
+
+private:
+    uint64_t	_routes;
+    uint64_t	_total_ns;
+    uint64_t	_buckets[BUCKETS];	// [0] < 1us, [n] < 2^n us
+};
+
+#endif // __POLICY_BACKEND_POLICY_STATS_HH__
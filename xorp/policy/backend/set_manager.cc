@@ -23,6 +23,7 @@
 #include "libxorp/xorp.h"
 
 #include "set_manager.hh"
+#include "policy/common/elem_set.hh"
 #include "policy/common/policy_utils.hh"
 
 SetManager::SetManager() : _sets(NULL) {
@@ -51,6 +52,17 @@ SetManager::replace_sets(SetMap* sets) {
     clear();
 
     _sets = sets;
+    if (_sets == NULL)
+	return;
+
+    // sets only change here, so this is where their lookup structures are
+    // built.
+    for (SetMap::iterator i = _sets->begin(); i != _sets->end(); ++i) {
+	ElemSet* es = dynamic_cast<ElemSet*>(i->second);
+
+	if (es != NULL)
+	    es->build_index();
+    }
 }
 
 void
@@ -58,11 +58,11 @@ SingleVarRW::read(const Id& id)
 
 	    // no luck... need to explicitly read...
 	    if (!e)
-		initialize(id, single_read(id));
+		read_single(id);
 	}
 	// client already had chance to initialize... but apparently didn't...
 	else
-	   initialize(id, single_read(id));
+	   read_single(id);
 
 	// the client may have initialized the variables after the start_read
 	// marker, so try reading again...
@@ -150,8 +150,10 @@ SingleVarRW::initialize(const Id& id, Element* e)
 
     // special case nulls [for supported variables, but not present in this
     // particular case].
-    if(!e)
-	e = new ElemNull();
+    if(!e) {
+	_elems[id] = &_null;
+	return;
+    }
 
     _elems[id] = e;
 
@@ -161,6 +163,34 @@ SingleVarRW::initialize(const Id& id, Element* e)
     _trashc++;
 }
 
+void
+SingleVarRW::initialize_typed(const Id& id, const Element& e)
+{
+    // as for initialize(), a write or an earlier initialization wins
+    if (_elems[id])
+	return;
+
+    // the derived class owns the element [do not trash]
+    _elems[id] = &e;
+}
+
+const Element*
+SingleVarRW::single_read_typed(const Id& /* id */)
+{
+    return NULL;
+}
+
+void
+SingleVarRW::read_single(const Id& id)
+{
+    const Element* e = single_read_typed(id);
+
+    if (e)
+	initialize_typed(id, *e);
+    else
+	initialize(id, single_read(id));
+}
+
 void
 SingleVarRW::initialize(PolicyTags& pt)
 {
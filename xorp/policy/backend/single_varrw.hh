@@ -30,6 +30,7 @@
 #include "policy/common/varrw.hh"
 #include "policy/common/policy_utils.hh"
 #include "policy/common/element_base.hh"
+#include "policy/common/elem_null.hh"
 #include "policytags.hh"
 
 /**
@@ -102,6 +103,20 @@ public:
     
     void initialize(PolicyTags& pt);
 
+    /**
+     * Register a variable for read access with an element owned by the
+     * derived class.
+     *
+     * The derived class would typically keep one element per variable, and
+     * set its value for every route [see ElemU32::set_val()].  This avoids
+     * allocating a new element, or parsing it from a string, for every read.
+     * The element must remain valid and unchanged until the next sync().
+     *
+     * @param id identifier of variable that may be read.
+     * @param e value of variable.
+     */
+    void initialize_typed(const Id& id, const Element& e);
+
     /**
      * If any reads are performed, this is a marker which informs the derived
      * class that reads will now start.
@@ -134,12 +149,32 @@ public:
      */
     virtual Element* single_read(const Id& id) = 0;
 
+    /**
+     * Read of a variable into an element owned by the derived class, under
+     * the same conditions as for initialize_typed().  This is tried before
+     * single_read().
+     *
+     * @return variable requested, null_element() if the variable is not
+     * present in THIS route, or NULL if it must be read by single_read().
+     * @param id the id of the variable.
+     */
+    virtual const Element* single_read_typed(const Id& id);
+
     /**
      * Marks the end of writes in case there were any modified fields.
      */
     virtual void end_write() {}
 
+protected:
+    /**
+     * @return the element of variables that are not present in the route.
+     */
+    const Element* null_element() const { return &_null; }
+
 private:
+    void read_single(const Id& id);
+
+    ElemNull	    _null;
     Element*	    _trash[16];
     unsigned	    _trashc;
     const Element*  _elems[VAR_MAX];    // Map that caches element read/writes 
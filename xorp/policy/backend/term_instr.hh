@@ -29,6 +29,7 @@
 
 
 #include "instruction.hh"
+#include "policy_stats.hh"
 #include "policy/common/policy_utils.hh"
 
 /**
@@ -79,10 +80,17 @@ public:
 
     int instrc() { return _instrc; }
 
+    /**
+     * @return counters of the term, updated by whoever runs it.
+     */
+    PolicyCounters& counters() { return _counters; }
+    const PolicyCounters& counters() const { return _counters; }
+
 private:
     string _name;
     Instruction** _instructions;
     int		  _instrc;
+    PolicyCounters _counters;
 };
 
 #endif // __POLICY_BACKEND_TERM_INSTR_HH__
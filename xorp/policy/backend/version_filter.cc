@@ -36,7 +36,8 @@
 
 VersionFilter::VersionFilter(const VarRW::Id& fname) : 
 		    _filter(new PolicyFilter), 
-		    _fname(fname)
+		    _fname(fname),
+		    _version(0)
 {
 }
 
@@ -59,7 +60,7 @@ VersionFilter::configure(const string& conf)
 	throw e;
     }
     
-    _filter = RefPf(pf);
+    install(pf, conf);
 }
 
 void
@@ -68,11 +69,50 @@ VersionFilter::reset()
     PolicyFilter* pf = new PolicyFilter();
     pf->reset();
 
+    install(pf, "");
+}
+
+void
+VersionFilter::install(PolicyFilter* pf, const string& conf)
+{
+    Change change;
+
+    change.version = ++_version;
+    pf->set_version(_version);
+
+    PolicyScope ps(_immutable);
+    change.extent = ps.compare(_conf, conf);
+
+    if (change.extent == PolicyScope::SOME) {
+	PolicyFilter* scope = new PolicyFilter();
+
+	try {
+	    scope->configure(ps.scope_conf());
+	    change.scope = RefPf(scope);
+	} catch(const PolicyException& e) {
+	    XLOG_WARNING("Cannot narrow down policy change: %s",
+			 e.str().c_str());
+	    delete scope;
+	    change.extent = PolicyScope::ALL;
+	}
+    }
+
+    _changes.push_back(change);
+    if (_changes.size() > MAX_CHANGES)
+	_changes.pop_front();
+
+    _conf = conf;
     _filter = RefPf(pf);
 }
 
-bool
-VersionFilter::acceptRoute(VarRW& varrw)
+void
+VersionFilter::set_immutable_vars(const set<VarRW::Id>& vars)
+{
+    _immutable = vars;
+}
+
+RefPf
+VersionFilter::route_filter(VarRW& varrw)
 {
     // get the associated filter
     RefPf filter;
@@ -88,6 +128,14 @@ VersionFilter::acceptRoute(VarRW& varrw)
 	xorp_throw(PolicyException, "Reading filter but didn't get ElemFilter!");
     }
 
+    return filter;
+}
+
+bool
+VersionFilter::acceptRoute(VarRW& varrw)
+{
+    RefPf filter = route_filter(varrw);
+
     // filter exists... run it
     if(!filter.is_empty())
 	return filter->acceptRoute(varrw);
@@ -101,3 +149,64 @@ VersionFilter::acceptRoute(VarRW& varrw)
     XLOG_ASSERT(!_filter.is_empty());
     return _filter->acceptRoute(varrw);
 }
+
+bool
+VersionFilter::route_in_scope(VarRW& varrw)
+{
+    RefPf filter = route_filter(varrw);
+
+    // never filtered.
+    if (filter.is_empty())
+	return true;
+
+    uint32_t version = filter->version();
+    if (version == _version)
+	return false;
+
+    // we no longer know what changed since.
+    if (_changes.empty() || _changes.front().version > version + 1)
+	return true;
+
+    for (list<Change>::iterator i = _changes.begin();
+	 i != _changes.end(); ++i) {
+
+	const Change& change = *i;
+
+	if (change.version <= version)
+	    continue;
+
+	switch (change.extent) {
+	case PolicyScope::NONE:
+	    break;
+
+	case PolicyScope::ALL:
+	    return true;
+
+	case PolicyScope::SOME:
+	    try {
+		if (change.scope->acceptRoute(varrw))
+		    return true;
+	    } catch(const PolicyException&) {
+		return true;
+	    }
+	    break;
+	}
+    }
+
+    return false;
+}
+
+void
+VersionFilter::refresh_route(VarRW& varrw)
+{
+    ElemFilter cur(_filter);
+
+    varrw.write(_fname, cur);
+    varrw.sync();
+}
+
+string
+VersionFilter::statistics()
+{
+    return _filter->statistics();
+}
@@ -25,6 +25,7 @@
 #include "policy/common/varrw.hh"
 #include "filter_base.hh"
 #include "policy_filter.hh"
+#include "policy_scope.hh"
 
 /**
  * @short Policy filters which support versioning [i.e. keep old version].
@@ -41,6 +42,10 @@
  * because we cannot assume when to increment and decrement the reference count.
  * Say it's a normal route lookup and we do the filtering, and it results to
  * "accepted".  It doesn't imply we need to +1 the reference count.
+ *
+ * Each configuration gets a version number.  The filter also remembers which
+ * routes each of the recent configuration changes may affect, so routes
+ * outside the scope of the changes need not be filtered again.
  */
 class VersionFilter : public FilterBase {
 public:
@@ -74,9 +79,69 @@ public:
      */
     bool acceptRoute(VarRW& varrw);
 
+    /**
+     * Declare the variables which policies can read but never modify.
+     * Conditions on these variables are used to narrow down the routes
+     * affected by a configuration change.
+     *
+     * @param vars the immutable variables.
+     */
+    void set_immutable_vars(const set<VarRW::Id>& vars);
+
+    /**
+     * Check whether the changes made since the route was last filtered may
+     * alter the outcome of the filter.
+     *
+     * @return true if the route must be filtered again.
+     * @param varrw the VarRW associated with the route.
+     */
+    bool route_in_scope(VarRW& varrw);
+
+    /**
+     * Associate the latest configuration with a route.
+     *
+     * @param varrw the VarRW associated with the route.
+     */
+    void refresh_route(VarRW& varrw);
+
+    /**
+     * @return statistics of the latest configuration.
+     */
+    string statistics();
+
 private:
-    RefPf _filter;
-    VarRW::Id _fname;
+    /**
+     * A configuration change, and the routes it may affect.
+     */
+    struct Change {
+	uint32_t		version;	// version of the new filter.
+	PolicyScope::Extent	extent;
+	RefPf			scope;		// accepts affected routes.
+    };
+
+    /**
+     * Install a new filter, recording the change from the current one.
+     *
+     * @param pf the new filter.
+     * @param conf the configuration of the new filter.
+     */
+    void install(PolicyFilter* pf, const string& conf);
+
+    /**
+     * @return the filter which was associated with the route.
+     */
+    RefPf route_filter(VarRW& varrw);
+
+    // changes older than this are forgotten, and routes filtered before
+    // them are always filtered again.
+    static const size_t MAX_CHANGES = 16;
+
+    RefPf		_filter;
+    VarRW::Id		_fname;
+    string		_conf;
+    uint32_t		_version;
+    list<Change>	_changes;
+    set<VarRW::Id>	_immutable;
 };
 
 #endif // __POLICY_BACKEND_VERSION_FILTER_HH__
@@ -27,8 +27,27 @@
 
 
 VersionFilters::VersionFilters() : PolicyFilters(
-				    new VersionFilter(VarRW::VAR_FILTER_IM),
-				    new VersionFilter(VarRW::VAR_FILTER_SM),
-				    new VersionFilter(VarRW::VAR_FILTER_EX))
+				    _import = new VersionFilter(VarRW::VAR_FILTER_IM),
+				    _export_sm = new VersionFilter(VarRW::VAR_FILTER_SM),
+				    _export = new VersionFilter(VarRW::VAR_FILTER_EX))
 {
 }
+
+void
+VersionFilters::set_immutable_vars(const uint32_t& ftype,
+				   const set<VarRW::Id>& vars)
+{
+    switch(ftype) {
+	case 1:
+	    _import->set_immutable_vars(vars);
+	    return;
+	case 2:
+	    _export_sm->set_immutable_vars(vars);
+	    return;
+	case 4:
+	    _export->set_immutable_vars(vars);
+	    return;
+    }
+    xorp_throw(PolicyFiltersErr, 
+	       "Unknown filter: " + policy_utils::to_str(ftype));
+}
@@ -23,6 +23,7 @@
 #define __POLICY_BACKEND_VERSION_FILTERS_HH__
 
 #include "policy_filters.hh"
+#include "version_filter.hh"
 
 /**
  * @short Policy filters which support versioning [i.e. keep old version].
@@ -43,6 +44,20 @@
 class VersionFilters : public PolicyFilters {
 public:
     VersionFilters();
+
+    /**
+     * Declare the variables which policies of a filter can read but never
+     * modify.
+     *
+     * @param type the filter.
+     * @param vars the immutable variables.
+     */
+    void set_immutable_vars(const uint32_t& type, const set<VarRW::Id>& vars);
+
+private:
+    VersionFilter*	_import;
+    VersionFilter*	_export_sm;
+    VersionFilter*	_export;
 };
 
 #endif // __POLICY_BACKEND_VERSION_FILTERS_HH__
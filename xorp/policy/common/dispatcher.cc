@@ -69,6 +69,29 @@ Dispatcher::Value Dispatcher::lookup(const Oper& op, unsigned argc, const Elemen
     return _map[key];
 }
 
+Dispatcher::CB_bin
+Dispatcher::lookup_bin(const Oper& op, Element::Hash left,
+		       Element::Hash right) const
+{
+    XLOG_ASSERT(op.arity() == 2);
+
+    unsigned int key = op.hash() | left << 5 | right << 10;
+
+    XLOG_ASSERT(key < DISPATCHER_MAP_SZ);
+    return _map[key].bin;
+}
+
+Dispatcher::CB_un
+Dispatcher::lookup_un(const Oper& op, Element::Hash arg) const
+{
+    XLOG_ASSERT(op.arity() == 1);
+
+    unsigned int key = op.hash() | arg << 5;
+
+    XLOG_ASSERT(key < DISPATCHER_MAP_SZ);
+    return _map[key].un;
+}
+
 /* NOTE:  add() is called before logging framework is online. */
 void Dispatcher::logAdd(const Oper& op, unsigned int k, const Element* arg1, const Element* arg2) const {
 // Enable this if debugging is needed.
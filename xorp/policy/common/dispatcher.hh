@@ -149,13 +149,37 @@ public:
 		 const Element& left, 
 		 const Element& right) const;
 
-private:
     // Callback for binary operation
     typedef Element* (*CB_bin)(const Element&, const Element&);
     
     // Callback for unary operation
     typedef Element* (*CB_un)(const Element&);
 
+    /**
+     * Find the callback of a binary operation, so that it may be called
+     * directly for arguments of the given types.
+     *
+     * Null arguments and the ctr operation are not handled by callbacks, and
+     * must go through run().
+     *
+     * @return callback which will perform the operation, or NULL if none.
+     * @param op operation to perform.
+     * @param left hash of the type of the first argument.
+     * @param right hash of the type of the second argument.
+     */
+    CB_bin lookup_bin(const Oper& op, Element::Hash left,
+		      Element::Hash right) const;
+
+    /**
+     * Find the callback of an unary operation.
+     *
+     * @return callback which will perform the operation, or NULL if none.
+     * @param op operation to perform.
+     * @param arg hash of the type of the argument.
+     */
+    CB_un lookup_un(const Oper& op, Element::Hash arg) const;
+
+private:
     // A key relates to either a binary (x)or unary operation.
     typedef union {
 	CB_un un;
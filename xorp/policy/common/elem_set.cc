@@ -26,12 +26,13 @@
 
 
 template <class T>
-ElemSetAny<T>::ElemSetAny(const Set& val) : ElemSet(_hash), _val(val) 
+ElemSetAny<T>::ElemSetAny(const Set& val) : ElemSet(_hash), _val(val),
+					     _index(NULL)
 {
 }
 
 template <class T>
-ElemSetAny<T>::ElemSetAny(const char* c_str) : ElemSet(_hash)
+ElemSetAny<T>::ElemSetAny(const char* c_str) : ElemSet(_hash), _index(NULL)
 {
     if (!c_str)
 	return;
@@ -47,10 +48,23 @@ ElemSetAny<T>::ElemSetAny(const char* c_str) : ElemSet(_hash)
 }
 
 template <class T>
-ElemSetAny<T>::ElemSetAny() : ElemSet(_hash)
+ElemSetAny<T>::ElemSetAny() : ElemSet(_hash), _index(NULL)
 {
 }
 
+template <class T>
+ElemSetAny<T>::ElemSetAny(const ElemSetAny<T>& rhs) : ElemSet(_hash),
+						     _val(rhs._val),
+						     _index(NULL)
+{
+}
+
+template <class T>
+ElemSetAny<T>::~ElemSetAny()
+{
+    clear_index();
+}
+
 template <class T>
 string 
 ElemSetAny<T>::str() const 
@@ -85,6 +99,7 @@ template <class T>
 void 
 ElemSetAny<T>::insert(const T& s) 
 {
+    clear_index();
     _val.insert(s);
 }
 
@@ -92,6 +107,7 @@ template <class T>
 void
 ElemSetAny<T>::insert(const ElemSetAny<T>& s)
 {
+    clear_index();
     _val.insert(s._val.begin(), s._val.end());
 }
 
@@ -215,18 +231,47 @@ template <class T>
 bool
 ElemSetAny<T>::nonempty_intersection(const ElemSetAny<T>& rhs) const
 {
-    Set tmp;
-    set_intersection(_val.begin(), _val.end(),
-		     rhs._val.begin(), rhs._val.end(),
-		     insert_iterator<Set>(tmp,tmp.begin()));
+    // Typically a few route attributes against a large configured set.
+    const ElemSetAny<T>* probe = this;
+    const Index* index = rhs._index;
+
+    if (index == NULL) {
+	probe = &rhs;
+	index = _index;
+    }
+
+    if (index != NULL) {
+	for (const_iterator i = probe->_val.begin(); i != probe->_val.end();
+	     ++i) {
+	    if (index->contains(*i))
+		return true;
+	}
+
+	return false;
+    }
+
+    // both are sorted: walk them together
+    const_iterator i = _val.begin();
+    const_iterator j = rhs._val.begin();
+
+    while (i != _val.end() && j != rhs._val.end()) {
+	if (*i < *j)
+	    ++i;
+	else if (*j < *i)
+	    ++j;
+	else
+	    return true;
+    }
 
-    return tmp.size();
+    return false;
 }
 
 template <class T>
 void
 ElemSetAny<T>::erase(const ElemSetAny<T>& rhs)
 {
+    clear_index();
+
     // go through all elements and delete ones present
     for (typename Set::const_iterator i = rhs._val.begin(); 
 	 i != rhs._val.end(); ++i) {
@@ -280,6 +325,26 @@ ElemSetAny<T>::type() const
     return id;
 }
 
+template <class T>
+void
+ElemSetAny<T>::build_index()
+{
+    if (!Index::ENABLED || _index != NULL)
+	return;
+
+    _index = new Index(_val);
+}
+
+template <class T>
+void
+ElemSetAny<T>::clear_index()
+{
+    if (_index != NULL) {
+	delete _index;
+	_index = NULL;
+    }
+}
+
 // define the various sets
 template <> const char* ElemSetU32::id = "set_u32";
 template <> Element::Hash ElemSetU32::_hash = HASH_ELEM_SET_U32;
@@ -24,6 +24,7 @@
 
 #include "element_base.hh"
 #include "element.hh"
+#include "elem_set_index.hh"
 
 
 class ElemSet : public Element {
@@ -32,6 +33,12 @@ public:
     virtual ~ElemSet() {}
 
     virtual void erase(const ElemSet&) = 0;
+
+    /**
+     * Build the lookup structure used to match elements against the set.
+     * Changing the set discards it.
+     */
+    virtual void build_index() = 0;
 };
 
 /**
@@ -46,6 +53,7 @@ public:
     typedef set<T> Set;
     typedef typename Set::iterator iterator;
     typedef typename Set::const_iterator const_iterator;
+    typedef SetIndex<T> Index;
 
     static const char* id;
     static Hash _hash;
@@ -57,6 +65,8 @@ public:
      */
     ElemSetAny(const char* c_str);
     ElemSetAny();
+    ElemSetAny(const ElemSetAny<T>& rhs);   // the index is not copied
+    ~ElemSetAny();
 
     /**
      * @return string representation of set.
@@ -217,8 +227,20 @@ public:
 
     string dbgstr() const;
 
+    void build_index();
+
+    /**
+     * @return the lookup structure of the set, or NULL if it has none.
+     */
+    const Index* index() const { return _index; }
+
 private:
+    ElemSetAny& operator=(const ElemSetAny<T>&);	// not assignable
+
+    void clear_index();
+
     Set _val;
+    Index* _index;
 };
 
 // define set types
@@ -0,0 +1,210 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __POLICY_COMMON_ELEM_SET_INDEX_HH__
+#define __POLICY_COMMON_ELEM_SET_INDEX_HH__
+
+#include "libxorp/trie.hh"
+#include "element.hh"
+
+/**
+ * @short Lookup structure for the elements of a set.
+ *
+ * Sets keep their elements in a std::set, which is what the set operations
+ * need, but matching a single element against a large set is better done
+ * with a structure built for that element type.  An index is built once
+ * when the set is installed, and is only used for lookups.
+ *
+ * Types with no specialization have no index.
+ */
+template <class T>
+class SetIndex : public NONCOPYABLE {
+public:
+    enum { ENABLED = 0 };
+
+    SetIndex(const set<T>& /* s */) {}
+
+    bool contains(const T& /* e */) const {
+	XLOG_UNREACHABLE();
+	return false;
+    }
+};
+
+/**
+ * @short Index of a set of communities.
+ *
+ * A bitmap of hashed communities answers most lookups of communities that are
+ * not in the set with a single bit test.  Others are confirmed by a binary
+ * search in a sorted array.
+ */
+template <>
+class SetIndex<ElemCom32> : public NONCOPYABLE {
+public:
+    enum { ENABLED = 1 };
+
+    SetIndex(const set<ElemCom32>& s) : _shift(32 - MIN_BITS) {
+	// aim for at most one bit in eight set
+	while (_shift > 32 - MAX_BITS && (1U << (32 - _shift)) < s.size() * 8)
+	    _shift--;
+
+	_bitmap.resize((1U << (32 - _shift)) / 32, 0);
+	_vals.reserve(s.size());
+
+	for (set<ElemCom32>::const_iterator i = s.begin(); i != s.end(); ++i) {
+	    uint32_t h = slot(i->val());
+
+	    _bitmap[h >> 5] |= 1U << (h & 31);
+	    _vals.push_back(i->val());	// already sorted
+	}
+    }
+
+    bool contains(uint32_t com) const {
+	uint32_t h = slot(com);
+
+	if (!(_bitmap[h >> 5] & (1U << (h & 31))))
+	    return false;
+
+	return binary_search(_vals.begin(), _vals.end(), com);
+    }
+
+    bool contains(const ElemCom32& e) const { return contains(e.val()); }
+
+private:
+    enum { MIN_BITS = 6, MAX_BITS = 20 };
+
+    uint32_t slot(uint32_t com) const {
+	// multiplicative hashing: well known communities only differ in their
+	// low bits.
+	return (com * 2654435761U) >> _shift;
+    }
+
+    unsigned		_shift;
+    vector<uint32_t>	_bitmap;
+    vector<uint32_t>	_vals;
+};
+
+/**
+ * @short Index of a set of networks.
+ *
+ * The networks are kept in a trie along with their modifier.  A network
+ * matches the set if it matches any of its entries according to the modifier
+ * of the entry, as net_set_match() does.  Exact, longer and orlonger entries
+ * are found among the entries that contain the network, which are on the path
+ * from the trie root.  Shorter and orshorter entries need a walk of the
+ * subtree below the network, which is only done if the set has any.
+ */
+template <class A>
+class SetIndex<ElemNet<IPNet<A> > > : public NONCOPYABLE {
+public:
+    typedef ElemNet<IPNet<A> >		Elem;
+    typedef typename Elem::Mod		Mod;
+    typedef Trie<A, Mod>		NetTrie;
+
+    enum { ENABLED = 1 };
+
+    SetIndex(const set<Elem>& s) : _shorter(0) {
+	for (typename set<Elem>::const_iterator i = s.begin();
+	     i != s.end(); ++i) {
+	    const Elem& e = *i;
+
+	    switch (e.mod()) {
+	    case Elem::MOD_NOT:
+		_not.push_back(e.val());
+		break;
+
+	    case Elem::MOD_SHORTER:
+	    case Elem::MOD_ORSHORTER:
+		_shorter++;
+		// FALLTHROUGH
+	    default:
+		_trie.insert(e.val(), e.mod());
+		break;
+	    }
+	}
+    }
+
+    /**
+     * @return true if the network matches any entry.
+     * @param net network to match.
+     */
+    bool match(const IPNet<A>& net) const {
+	typename NetTrie::iterator i = _trie.find(net);
+
+	for (typename NetTrie::Node* n = i.cur(); n != NULL;
+	     n = n->get_parent()) {
+	    if (!n->has_payload())
+		continue;
+
+	    switch (n->p()) {
+	    case Elem::MOD_NONE:
+	    case Elem::MOD_EXACT:
+	    case Elem::MOD_ORSHORTER:
+		if (n->k() == net)
+		    return true;
+		break;
+
+	    case Elem::MOD_ORLONGER:
+		return true;
+
+	    case Elem::MOD_LONGER:
+		if (n->k() != net)
+		    return true;
+		break;
+
+	    default:
+		break;
+	    }
+	}
+
+	if (_shorter) {
+	    for (i = _trie.search_subtree(net); i != _trie.end(); ++i) {
+		Mod mod = i.payload();
+
+		if (mod == Elem::MOD_ORSHORTER
+		    || (mod == Elem::MOD_SHORTER && i.key() != net))
+		    return true;
+	    }
+	}
+
+	// a set rarely has more than one "not" entry
+	for (typename vector<IPNet<A> >::const_iterator j = _not.begin();
+	     j != _not.end(); ++j) {
+	    if (*j != net)
+		return true;
+	}
+
+	return false;
+    }
+
+    bool contains(const Elem& e) const {
+	// like the set, ignore the modifier
+	if (_trie.lookup_node(e.val()) != _trie.end())
+	    return true;
+
+	return find(_not.begin(), _not.end(), e.val()) != _not.end();
+    }
+
+private:
+    NetTrie		_trie;
+    vector<IPNet<A> >	_not;
+    unsigned		_shorter;
+};
+
+#endif // __POLICY_COMMON_ELEM_SET_INDEX_HH__
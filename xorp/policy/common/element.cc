@@ -122,20 +122,16 @@ ElemCom32::str() const {
 }
 
 template<class A>
-ElemNet<A>::ElemNet() : Element(_hash), _net(NULL), _mod(MOD_NONE), _op(NULL)
+ElemNet<A>::ElemNet() : Element(_hash), _mod(MOD_NONE), _op(NULL)
 {
-    _net = new A();
 }
 
 template<class A>
-ElemNet<A>::ElemNet(const char* str) : Element(_hash), _net(NULL),
-				       _mod(MOD_NONE), _op(NULL)
+ElemNet<A>::ElemNet(const char* str) : Element(_hash), _mod(MOD_NONE),
+				       _op(NULL)
 {
-    if (!str) {
-	_net = new A();
-
+    if (!str)
 	return;
-    }
 
     // parse modifier
     string in = str;
@@ -149,7 +145,7 @@ ElemNet<A>::ElemNet(const char* str) : Element(_hash), _net(NULL),
 
     // parse net
     try {
-	    _net = new A(in.c_str());
+	    _net = A(in.c_str());
     } catch(...) {
 	ostringstream oss;
 
@@ -160,10 +156,9 @@ ElemNet<A>::ElemNet(const char* str) : Element(_hash), _net(NULL),
 }
 
 template<class A>
-ElemNet<A>::ElemNet(const A& net) : Element(_hash), _net(NULL), _mod(MOD_NONE),
+ElemNet<A>::ElemNet(const A& net) : Element(_hash), _net(net), _mod(MOD_NONE),
 				    _op(NULL)
 {
-    _net = new A(net);
 }
 
 template<class A>
@@ -172,21 +167,18 @@ ElemNet<A>::ElemNet(const ElemNet<A>& net) : Element(_hash),
 					     _mod(net._mod),
 					     _op(NULL)
 {
-    if (_net)
-	_net = new A(*_net);
 }
 
 template<class A>
 ElemNet<A>::~ElemNet()
 {
-    delete _net;
 }
 
 template<class A>
 string
 ElemNet<A>::str() const
 {
-    string str = _net->str();
+    string str = _net.str();
 
     if (_mod != MOD_NONE) {
 	str += "~";
@@ -207,21 +199,21 @@ template<class A>
 const A&
 ElemNet<A>::val() const
 {
-    return *_net;
+    return _net;
 }
 
 template<class A>
 bool
 ElemNet<A>::operator<(const ElemNet<A>& rhs) const
 {
-    return *_net < *rhs._net;
+    return _net < rhs._net;
 }
 
 template<class A>
 bool
 ElemNet<A>::operator==(const ElemNet<A>& rhs) const
 {
-    return *_net == *rhs._net;
+    return _net == rhs._net;
 }
 
 template<class A>
@@ -152,6 +152,17 @@ public:
     uint32_t val() const { return _val; }
     const char* type() const { return id; }
 
+    /**
+     * Change the value of the element in place.
+     *
+     * Elements are otherwise never modified.  This is meant for a VarRW that
+     * keeps one element per variable and reuses it for every route it reads,
+     * instead of allocating a new one [see SingleVarRW::initialize_typed()].
+     *
+     * @param val the new value.
+     */
+    void set_val(const uint32_t val) { _val = val; }
+
     bool operator==(const ElemU32& rhs) const { return _val == rhs._val; }
     bool operator<(const ElemU32& rhs) const { return _val < rhs._val; }
 
@@ -267,6 +278,9 @@ public:
     bool val() const { return _val; }
     const char* type() const { return id; }
 
+    // Change the value in place [see ElemU32::set_val()].
+    void set_val(const bool val) { _val = val; }
+
     bool operator==(const ElemBool& rhs) const { return _val == rhs._val; }
 
 private:
@@ -458,6 +472,18 @@ public:
      */
     const T& val() const { return *_val; }
 
+    /**
+     * Make the element refer to another object [see ElemU32::set_val()].
+     *
+     * @param val the object to refer to.  The caller keeps ownership.
+     */
+    void set_val(const T& val) {
+	if (_free)
+	    delete _val;
+	_val = &val;
+	_free = false;
+    }
+
     const char* type() const { return id; }
 
     ElemRefAny(const ElemRefAny<T>& copy) : Element(_hash) {
@@ -498,6 +524,8 @@ public:
     string	    str() const;
     const char*	    type() const;
     const A&	    val() const;
+    void	    set_val(const A& net) { _net = net; } // see ElemU32
+    Mod		    mod() const { return _mod; }
     static Mod	    str_to_mod(const char* p);
     static string   mod_to_str(Mod mod);
     BinOper&	    op() const;
@@ -508,9 +536,7 @@ public:
     string dbgstr() const {
 	ostringstream oss;
 	oss << "ElemNet: hash: " << (int)(hash()) << " id: " << id << " mod: " << (int)(_mod);
-	if (_net) {
-	    oss << " net: " << _net->str();
-	}
+	oss << " net: " << _net.str();
 	if (_op) {
 	    oss << " op: " << _op->str();
 	}
@@ -520,10 +546,7 @@ public:
 #ifdef XORP_USE_USTL
     ElemNet& operator=(const ElemNet<A>& rhs) {
 	if (this != &rhs) {
-	    if (_net) {
-		delete _net;
-	    }
-	    _net = new A(*rhs._net);
+	    _net = rhs._net;
 	    _mod = rhs._mod;
 	    _op = rhs._op;
 	}
@@ -534,7 +557,7 @@ private:
     ElemNet& operator=(const ElemNet<A>&);	// not assignable
 #endif
 
-    const A*		_net;
+    A			_net;
     Mod			_mod;
     mutable BinOper*	_op;
 };
@@ -564,6 +587,9 @@ public:
     const A&	addr() const;
     const A&	val() const; // for relop compatibility
 
+    // Change the address in place [see ElemU32::set_val()].
+    void	set_val(const A& nh) { _var = VAR_NONE; _addr = nh; }
+
     string dbgstr() const {
 	ostringstream oss;
 	oss << "ElemNextHop: hash: " << (int)(hash()) << " id: " << id << " var: " << (int)(_var) << " addr: " << _addr.str();
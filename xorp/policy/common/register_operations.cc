@@ -227,7 +227,7 @@ template <class T>
 Element* 
 set_ne_int(const ElemSetAny<T>& l, const ElemSetAny<T>& r)
 {
-    return new ElemBool(l.nonempty_intersection(r));
+    return return_bool(l.nonempty_intersection(r));
 }
 
 Element* 
@@ -371,6 +371,12 @@ template<class A>
 Element*
 net_set_match(const ElemNet<A>& left, const ElemSetAny<ElemNet<A> >& right)
 {
+    const typename ElemSetAny<ElemNet<A> >::Index* index = right.index();
+
+    // sets installed by the SetManager are indexed
+    if (index != NULL)
+	return return_bool(index->match(left.val()));
+
     bool ret = false;
 
     for (typename ElemSetAny<ElemNet<A> >::const_iterator i = right.begin();
@@ -0,0 +1,492 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+//
+// Set index test program.
+//
+// The sets installed by the SetManager are indexed.  Copies of a set are
+// not, so matching against a copy goes through the elements one by one, as
+// all sets did before they had an index.  Both must give the same answers.
+//
+
+#include "policy/policy_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/exceptions.hh"
+#include "libxorp/test_main.hh"
+
+#include "policy/common/elem_set.hh"
+#include "policy/common/dispatcher.hh"
+#include "policy/common/operator.hh"
+#include "policy/common/policy_utils.hh"
+#include "policy/backend/set_manager.hh"
+
+
+namespace {
+
+// Deterministic, so a failure can be reproduced.
+uint32_t
+next_random(uint32_t& seed)
+{
+    seed = seed * 1103515245U + 12345U;
+    return (seed >> 8);
+}
+
+template <class A> A random_addr(uint32_t& seed);
+
+// Within 10.0.0.0/8.
+template <>
+IPv4
+random_addr<IPv4>(uint32_t& seed)
+{
+    return (IPv4(htonl(0x0a000000U | (next_random(seed) & 0x00ffffffU))));
+}
+
+// Within 2001:db8::/32.
+template <>
+IPv6
+random_addr<IPv6>(uint32_t& seed)
+{
+    uint32_t a[4];
+
+    a[0] = htonl(0x20010db8U);
+    a[1] = htonl(next_random(seed) << 8 | (next_random(seed) & 0xff));
+    a[2] = htonl(next_random(seed));
+    a[3] = htonl(next_random(seed));
+
+    return (IPv6(a));
+}
+
+/**
+ * A network below the base network of the address family, with a prefix
+ * length up to @ref spread bits longer, so networks often overlap.
+ */
+template <class A>
+IPNet<A>
+random_net(uint32_t& seed, uint32_t spread)
+{
+    uint32_t base = A::ip_version() == 4 ? 8 : 32;
+
+    return (IPNet<A>(random_addr<A>(seed),
+		     base + next_random(seed) % (spread + 1)));
+}
+
+template <class A>
+ElemNet<IPNet<A> >
+make_elem(const IPNet<A>& net, typename ElemNet<IPNet<A> >::Mod mod)
+{
+    typedef ElemNet<IPNet<A> > Elem;
+    string s = net.str();
+
+    if (mod != Elem::MOD_NONE)
+	s += "~" + Elem::mod_to_str(mod);
+
+    return (Elem(s.c_str()));
+}
+
+bool
+is_true(const Element* e)
+{
+    const ElemBool* b = dynamic_cast<const ElemBool*>(e);
+
+    XLOG_ASSERT(b != NULL);
+
+    return (b->val());
+}
+
+/**
+ * Match @ref net against the set installed as @ref name and against an
+ * unindexed copy of it.
+ */
+template <class A>
+bool
+check_match(TestInfo& info, const SetManager& sm, const string& name,
+	    const ElemSetAny<ElemNet<IPNet<A> > >& linear,
+	    const IPNet<A>& net)
+{
+    typedef ElemSetAny<ElemNet<IPNet<A> > > Set;
+
+    const Set& indexed = dynamic_cast<const Set&>(sm.getSet(name));
+    ElemNet<IPNet<A> > e(net);
+    Dispatcher d;
+
+    if (indexed.index() == NULL || linear.index() != NULL) {
+	DOUT(info) << "set " << name << " is not indexed as expected" << endl;
+	return false;
+    }
+
+    bool want = is_true(d.run(OpLe(), e, linear));
+    bool got = is_true(d.run(OpLe(), e, indexed));
+
+    if (want != got) {
+	DOUT(info) << net.str() << " <= " << name << " {" << linear.str()
+		   << "}: indexed " << got << " linear " << want << endl;
+	return false;
+    }
+
+    // either side may have the index
+    Set probe;
+    probe.insert(e);
+    want = linear.nonempty_intersection(probe);
+    if (indexed.nonempty_intersection(probe) != want
+	|| probe.nonempty_intersection(indexed) != want) {
+	DOUT(info) << net.str() << " in " << name
+		   << ": indexed intersection differs" << endl;
+	return false;
+    }
+
+    return true;
+}
+
+/**
+ * The networks to match against a set: the networks of the set, the
+ * networks just above and below them, and random ones.
+ */
+template <class A>
+void
+probes(uint32_t& seed, const ElemSetAny<ElemNet<IPNet<A> > >& s,
+       unsigned count, uint32_t spread, vector<IPNet<A> >& out)
+{
+    typedef ElemSetAny<ElemNet<IPNet<A> > > Set;
+
+    for (typename Set::const_iterator i = s.begin(); i != s.end(); ++i) {
+	const IPNet<A>& net = i->val();
+
+	out.push_back(net);
+	if (net.prefix_len() > 0)
+	    out.push_back(IPNet<A>(net.masked_addr(), net.prefix_len() - 1));
+	if (net.prefix_len() < A::addr_bitlen()) {
+	    out.push_back(IPNet<A>(net.masked_addr(), net.prefix_len() + 1));
+	    out.push_back(IPNet<A>(net.top_addr(), net.prefix_len() + 1));
+	}
+    }
+
+    for (unsigned i = 0; i < count; i++)
+	out.push_back(random_net<A>(seed, spread));
+}
+
+/**
+ * A few networks against a set with one entry of each modifier.
+ */
+template <class A>
+bool
+test_net_modifiers(TestInfo& info, const char* base, const char* inside,
+		   const char* outside)
+{
+    typedef ElemNet<IPNet<A> >	Elem;
+    typedef ElemSetAny<Elem>	Set;
+
+    IPNet<A> net(base);
+    IPNet<A> in(inside);
+    IPNet<A> out(outside);
+    IPNet<A> above(net.masked_addr(), net.prefix_len() - 1);
+    const typename Elem::Mod mods[] = {
+	Elem::MOD_NONE, Elem::MOD_EXACT, Elem::MOD_SHORTER,
+	Elem::MOD_ORSHORTER, Elem::MOD_LONGER, Elem::MOD_ORLONGER,
+	Elem::MOD_NOT
+    };
+    // whether net, in, out and above match each modifier
+    const bool expect[][4] = {
+	{ true,  false, false, false },	// none
+	{ true,  false, false, false },	// exact
+	{ false, false, false, true  },	// shorter
+	{ true,  false, false, true  },	// orshorter
+	{ false, true,  false, false },	// longer
+	{ true,  true,  false, false },	// orlonger
+	{ false, true,  true,  true  },	// not
+    };
+
+    for (unsigned m = 0; m < sizeof(mods) / sizeof(mods[0]); m++) {
+	SetManager sm;
+	SetManager::SetMap* sets = new SetManager::SetMap;
+	Set* s = new Set;
+
+	s->insert(make_elem(net, mods[m]));
+	(*sets)["s"] = s;
+	sm.replace_sets(sets);		// indexes the sets
+
+	Set linear(*s);
+	const IPNet<A> nets[] = { net, in, out, above };
+
+	for (unsigned n = 0; n < 4; n++) {
+	    if (!check_match(info, sm, "s", linear, nets[n]))
+		return false;
+
+	    Dispatcher d;
+	    bool got = is_true(d.run(OpLe(), Elem(nets[n]), *s));
+	    if (got != expect[m][n]) {
+		DOUT(info) << nets[n].str() << " <= {" << s->str() << "}: "
+			   << got << ", expected " << expect[m][n] << endl;
+		return false;
+	    }
+	}
+    }
+
+    return true;
+}
+
+/**
+ * Random sets of random networks and modifiers, rebuilt with
+ * SetManager::replace_sets.
+ */
+template <class A>
+bool
+test_net_random(TestInfo& info, uint32_t spread)
+{
+    typedef ElemNet<IPNet<A> >	Elem;
+    typedef ElemSetAny<Elem>	Set;
+
+    uint32_t seed = 1;
+    SetManager sm;
+
+    for (unsigned round = 0; round < 10; round++) {
+	SetManager::SetMap* sets = new SetManager::SetMap;
+	map<string, Set*> linear;
+	// the empty set, small sets, and sets bigger than a single lookup
+	const unsigned sizes[] = { 0, 1, 3, 10, 100, 1000 };
+
+	for (unsigned k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+	    Set* s = new Set;
+	    // Mostly one modifier, as configured sets are, with "not" rare.
+	    unsigned mix = next_random(seed) % 3;
+
+	    for (unsigned i = 0; i < sizes[k]; i++) {
+		unsigned m = mix == 0 ? next_random(seed) % 6
+		    : next_random(seed) % 40;
+		typename Elem::Mod mod;
+
+		if (m < 6)
+		    mod = static_cast<typename Elem::Mod>(m);
+		else if (m == 39)
+		    mod = Elem::MOD_NOT;
+		else if (mix == 1)
+		    mod = Elem::MOD_ORLONGER;
+		else
+		    mod = Elem::MOD_EXACT;
+
+		s->insert(make_elem(random_net<A>(seed, spread), mod));
+	    }
+
+	    string name = c_format("set%u", k);
+	    (*sets)[name] = s;
+	    linear[name] = new Set(*s);
+	}
+
+	// replaces, and frees, the sets of the previous round
+	sm.replace_sets(sets);
+
+	bool ok = true;
+	for (typename map<string, Set*>::iterator i = linear.begin();
+	     ok && i != linear.end(); ++i) {
+	    vector<IPNet<A> > nets;
+
+	    probes(seed, *i->second, 200, spread, nets);
+	    for (size_t n = 0; ok && n < nets.size(); n++)
+		ok = check_match(info, sm, i->first, *i->second, nets[n]);
+	}
+
+	policy_utils::clear_map(linear);
+	if (!ok)
+	    return false;
+    }
+
+    return true;
+}
+
+bool
+check_communities(TestInfo& info, const SetManager& sm, const string& name,
+		  const ElemSetCom32& linear, const ElemSetCom32& probe)
+{
+    const ElemSetCom32& indexed =
+	dynamic_cast<const ElemSetCom32&>(sm.getSet(name));
+    Dispatcher d;
+
+    if (indexed.index() == NULL || linear.index() != NULL
+	|| probe.index() != NULL) {
+	DOUT(info) << "set " << name << " is not indexed as expected" << endl;
+	return false;
+    }
+
+    bool want = is_true(d.run(OpNEInt(), probe, linear));
+
+    if (is_true(d.run(OpNEInt(), probe, indexed)) != want
+	|| is_true(d.run(OpNEInt(), indexed, probe)) != want) {
+	DOUT(info) << "{" << probe.str() << "} NON_EMPTY_INTERSECTION "
+		   << name << " {" << linear.str() << "}: indexed differs from "
+		   << want << endl;
+	return false;
+    }
+
+    for (ElemSetCom32::const_iterator i = probe.begin(); i != probe.end();
+	 ++i) {
+	bool in = false;
+
+	for (ElemSetCom32::const_iterator j = linear.begin();
+	     !in && j != linear.end(); ++j)
+	    in = j->val() == i->val();
+
+	if (indexed.index()->contains(*i) != in) {
+	    DOUT(info) << i->str() << " in " << name << ": indexed differs from "
+		       << in << endl;
+	    return false;
+	}
+    }
+
+    return true;
+}
+
+/**
+ * Random sets of communities, rebuilt with SetManager::replace_sets, against
+ * the communities of routes.
+ */
+bool
+test_communities(TestInfo& info)
+{
+    // a few ASes, so routes often carry communities of the sets
+    const uint32_t ases = 8;
+    // NO_EXPORT, NO_ADVERTISE and NO_EXPORT_SUBCONFED
+    const uint32_t well_known[] = { 0xFFFFFF01, 0xFFFFFF02, 0xFFFFFF03 };
+    uint32_t seed = 1;
+    SetManager sm;
+
+    for (unsigned round = 0; round < 4; round++) {
+	SetManager::SetMap* sets = new SetManager::SetMap;
+	map<string, ElemSetCom32*> linear;
+	// the empty set, small sets, and a set that uses the largest bitmap
+	const unsigned sizes[] = { 0, 1, 5, 100, 1000, 150000 };
+
+	for (unsigned k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+	    ElemSetCom32* s = new ElemSetCom32;
+
+	    for (unsigned i = 0; i < sizes[k]; i++) {
+		uint32_t as = 1 + next_random(seed) % ases;
+		s->insert(ElemCom32(as << 16 | next_random(seed) % 4096));
+	    }
+	    if (sizes[k] > 0 && k % 2)
+		s->insert(ElemCom32(well_known[round % 3]));
+
+	    string name = c_format("set%u", k);
+	    (*sets)[name] = s;
+	    linear[name] = new ElemSetCom32(*s);
+	}
+
+	sm.replace_sets(sets);
+
+	bool ok = true;
+	for (unsigned r = 0; ok && r < 200; r++) {
+	    // the communities of a route
+	    ElemSetCom32 probe;
+	    for (unsigned i = next_random(seed) % 5; i > 0; i--) {
+		uint32_t as = 1 + next_random(seed) % ases;
+		probe.insert(ElemCom32(as << 16 | next_random(seed) % 4096));
+	    }
+	    if (next_random(seed) % 4 == 0)
+		probe.insert(ElemCom32(well_known[next_random(seed) % 3]));
+
+	    for (map<string, ElemSetCom32*>::iterator i = linear.begin();
+		 ok && i != linear.end(); ++i)
+		ok = check_communities(info, sm, i->first, *i->second, probe);
+	}
+
+	policy_utils::clear_map(linear);
+	if (!ok)
+	    return false;
+    }
+
+    return true;
+}
+
+bool
+test_ipv4_modifiers(TestInfo& info)
+{
+    return (test_net_modifiers<IPv4>(info, "10.1.0.0/16", "10.1.2.0/24",
+				     "10.2.0.0/16"));
+}
+
+bool
+test_ipv6_modifiers(TestInfo& info)
+{
+    return (test_net_modifiers<IPv6>(info, "2001:db8:1::/48",
+				     "2001:db8:1:2::/64", "2001:db8:2::/48"));
+}
+
+bool
+test_ipv4_random(TestInfo& info)
+{
+    return (test_net_random<IPv4>(info, 16));
+}
+
+bool
+test_ipv6_random(TestInfo& info)
+{
+    return (test_net_random<IPv6>(info, 32));
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    XorpUnexpectedHandler x(xorp_unexpected_handler);
+
+    xlog_init(argv[0], NULL);
+    xlog_set_verbose(XLOG_VERBOSE_HIGH);
+    xlog_add_default_output();
+    xlog_start();
+
+    TestMain t(argc, argv);
+
+    string test =
+	t.get_optional_args("-t", "--test", "run only the specified test");
+    t.complete_args_parsing();
+
+    struct test {
+	string test_name;
+	XorpCallback1<bool, TestInfo&>::RefPtr cb;
+    } tests[] = {
+	{"ipv4_modifiers", callback(test_ipv4_modifiers)},
+	{"ipv6_modifiers", callback(test_ipv6_modifiers)},
+	{"ipv4_random", callback(test_ipv4_random)},
+	{"ipv6_random", callback(test_ipv6_random)},
+	{"communities", callback(test_communities)},
+    };
+
+    try {
+	if ("" == test) {
+	    for (size_t i = 0; i < sizeof(tests) / sizeof(struct test); i++)
+		t.run(tests[i].test_name, tests[i].cb);
+	} else {
+	    for (size_t i = 0; i < sizeof(tests) / sizeof(struct test); i++)
+		if (test == tests[i].test_name) {
+		    t.run(tests[i].test_name, tests[i].cb);
+		    return t.exit();
+		}
+	    t.failed("No test with name " + test + " found\n");
+	}
+    } catch(...) {
+	xorp_catch_standard_exceptions();
+    }
+
+    xlog_stop();
+    xlog_exit();
+
+    return t.exit();
+}
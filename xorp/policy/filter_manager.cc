@@ -26,6 +26,7 @@
 #include "policy_module.h"
 #include "libxorp/xorp.h"
 #include "libxorp/debug.h"
+#include "libxorp/c_format.hh"
 #include "backend/policytags.hh"
 #include "filter_manager.hh"
 
@@ -46,8 +47,11 @@ FilterManager::FilterManager(const CodeMap& imp,
 	_policy_backend(&rtr),
 	_rib(&rtr),
 	_rib_name("rib"), // FIXME: rib name hardcoded
-	_pmap(pmap)
+	_pmap(pmap),
+	_stats_interval(10000)
 {
+    _stats_timer = _eventloop.new_periodic_ms(_stats_interval,
+		    callback(this, &FilterManager::stats_timeout));
 }
 
 void
@@ -308,6 +312,11 @@ FilterManager::death(const string& protocol)
     delete_queue_protocol(_import_queue,protocol);
     _push_queue.erase(protocol);
 
+    // its counters went with it.
+    _stats.erase(FilterKey(protocol, filter::IMPORT));
+    _stats.erase(FilterKey(protocol, filter::EXPORT_SOURCEMATCH));
+    _stats.erase(FilterKey(protocol, filter::EXPORT));
+
     // send out update
     _rib.send_remove_policy_redist_tags(_rib_name.c_str(),
 		_pmap.xrl_target(protocol),
@@ -316,6 +325,88 @@ FilterManager::death(const string& protocol)
     debug_msg("[POLICY] Protocol death: %s\n",protocol.c_str());
 }
 
+void
+FilterManager::request_statistics()
+{
+    request_statistics(_import, filter::IMPORT);
+    request_statistics(_sourcematch, filter::EXPORT_SOURCEMATCH);
+    request_statistics(_export, filter::EXPORT);
+}
+
+void
+FilterManager::request_statistics(const CodeMap& cm, filter::Filter f)
+{
+    // forget the statistics of filters which have no code anymore.
+    for (StatsMap::iterator i = _stats.begin(); i != _stats.end();) {
+	StatsMap::iterator j = i++;
+
+	if (j->first.second == f && cm.find(j->first.first) == cm.end())
+	    _stats.erase(j);
+    }
+
+    for (CodeMap::const_iterator i = cm.begin(); i != cm.end(); ++i) {
+	const string& protocol = i->first;
+
+	if (!_process_watch.alive(protocol))
+	    continue;
+
+	_policy_backend.send_get_statistics(_pmap.xrl_target(protocol).c_str(),
+	    f,
+	    callback(this, &FilterManager::statistics_cb, protocol, f));
+    }
+}
+
+void
+FilterManager::statistics_cb(const XrlError& e, const string* stats,
+			     string protocol, filter::Filter f)
+{
+    FilterKey key(protocol, f);
+
+    if (e != XrlError::OKAY()) {
+	XLOG_WARNING("Unable to get %s %s filter statistics: %s",
+		     protocol.c_str(), filter::filter2str(f),
+		     e.str().c_str());
+
+	_stats.erase(key);
+	return;
+    }
+
+    FilterStats& fs = _stats[key];
+
+    fs.stats = *stats;
+    _eventloop.current_time(fs.collected);
+}
+
+bool
+FilterManager::stats_timeout()
+{
+    request_statistics();
+
+    return true;
+}
+
+string
+FilterManager::statistics() const
+{
+    string s;
+    TimeVal now;
+
+    _eventloop.current_time(now);
+
+    for (StatsMap::const_iterator i = _stats.begin(); i != _stats.end(); ++i) {
+	const FilterStats& fs = i->second;
+
+	s += c_format("%s %s filter, collected %d seconds ago:\n",
+		      i->first.first.c_str(),
+		      filter::filter2str(i->first.second),
+		      (now - fs.collected).sec());
+	s += fs.stats;
+	s += "\n";
+    }
+
+    return s;
+}
+
 void
 FilterManager::delete_queue_protocol(ConfQueue& queue,
 				     const string& protocol)
@@ -132,7 +132,63 @@ public:
      */
     void death(const string& protocol);
 
+    /**
+     * Ask the filters of all live protocols for their statistics.  Replies
+     * arrive asynchronously.  This is also done every stats_interval
+     * milliseconds, so that the statistics shown are recent.
+     */
+    void request_statistics();
+
+    /**
+     * @return the statistics last received from the filters, each with
+     * the time it was collected, empty if none.
+     */
+    string statistics() const;
+
+    /**
+     * @return how often, in milliseconds, the statistics are collected.
+     */
+    uint32_t stats_interval() const { return _stats_interval; }
+
 private:
+    typedef pair<string, filter::Filter> FilterKey;
+
+    /**
+     * The statistics of a filter, and when they were received.
+     */
+    struct FilterStats {
+	string	stats;
+	TimeVal	collected;
+    };
+    typedef map<FilterKey, FilterStats> StatsMap;
+
+    /**
+     * Request the statistics of a filter-type from all protocols which
+     * have code for it, and forget those of protocols which no longer do.
+     *
+     * @param cm CodeMap of the filter-type.
+     * @param f filter-type.
+     */
+    void request_statistics(const CodeMap& cm, filter::Filter f);
+
+    /**
+     * Xrl callback for statistics requests.
+     *
+     * @param e possible XRL error.
+     * @param stats statistics of the filter.
+     * @param protocol protocol the filter belongs to.
+     * @param f filter-type.
+     */
+    void statistics_cb(const XrlError& e, const string* stats,
+		       string protocol, filter::Filter f);
+
+    /**
+     * Periodic timeout: collect the statistics again.
+     *
+     * @return true, the timer keeps running.
+     */
+    bool stats_timeout();
+
     /**
      * Update the import filter for a specific protocol.
      *
@@ -206,6 +262,10 @@ private:
 
     string _rib_name;
     ProtocolMap& _pmap;
+
+    StatsMap _stats;
+    uint32_t _stats_interval;
+    XorpTimer _stats_timer;
 };
 
 #endif // __POLICY_FILTER_MANAGER_HH__
@@ -356,6 +356,9 @@ PolicyTarget::show(const string& arg)
 	name = arg.substr(i + 1);
     }
 
+    if (type.compare("statistics") == 0)
+	return show_statistics();
+
     RESOURCES res;
 
     show(type, name, res);
@@ -372,6 +375,23 @@ PolicyTarget::show(const string& arg)
     return oss.str();
 }
 
+string
+PolicyTarget::show_statistics()
+{
+    // CLI commands are answered synchronously, so show the statistics the
+    // filter manager collected last, with their age, and ask for fresh ones.
+    string stats = _filter_manager.statistics();
+
+    _filter_manager.request_statistics();
+
+    if (stats.empty())
+	return c_format("No statistics collected yet, they are collected "
+			"every %u seconds.\n",
+			XORP_UINT_CAST(_filter_manager.stats_interval() / 1000));
+
+    return stats;
+}
+
 void
 PolicyTarget::show(const string& type, const string& name, RESOURCES& res)
 {
@@ -254,6 +254,7 @@ public:
     string test_policy(const string& arg);
     string show(const string& arg);
     void   show(const string& type, const string& name, RESOURCES& res);
+    string show_statistics();
     bool   test_policy(const string& policy, const string& prefix,
 		       const string& attributes, string& mods);
     bool   test_policy(const string& policy, const RATTR& attrs, RATTR& mods);
@@ -42,6 +42,12 @@ enum {
     BTYPE_BGP,
 };
 
+enum {
+    ETYPE_INTERPRETED = 0,
+    ETYPE_COMPILED,
+    ETYPE_BOTH,
+};
+
 template<class A>
 struct bgp_routes {
     bgp_routes();
@@ -83,6 +89,7 @@ struct conf {
     string	c_varrw_file;
     unsigned	c_iterations;
     int		c_type;
+    int		c_engine;
     int		c_profiler;
 
     // stats
@@ -104,12 +111,18 @@ usage(const string& progname)
 	 << "-v\t<varrw file>"	    << endl
 	 << "-i\t<iterations>"	    << endl
 	 << "-t\t<benchmark type>"  << endl
+	 << "-e\t<execution engine>" << endl
 	 << "-n\tdisable profiler"  << endl
          << "-h\thelp"		    << endl
 	 << endl
 	 << "Supported benchmark types:" << endl
 	 << "0\tFileVarRW (test policy filter)" << endl
 	 << "1\tBGPVarRW" << endl
+	 << endl
+	 << "Supported execution engines:" << endl
+	 << "0\tinterpreted (IvExec)" << endl
+	 << "1\tcompiled (CompiledExec) [default]" << endl
+	 << "2\tboth, one after the other" << endl
 	 ;
 
     exit(1);
@@ -234,6 +247,29 @@ create_varrw(int i)
     return NULL;
 }
 
+void
+benchmark_engine(PolicyFilter& filter, VarRW** varrws, bool compiled)
+{
+    unsigned iters = _conf.c_iterations;
+
+    filter.set_exec_compiled(compiled);
+    memset(&_conf.c_exec_total, 0, sizeof(_conf.c_exec_total));
+
+    cout << "Benchmarking "
+	 << (filter.exec_compiled() ? "compiled" : "interpreted")
+	 << " policies.  Iterations: " << iters << endl;
+
+    get_time(_conf.c_start);
+
+    for (unsigned i = 0; i < iters; i++)
+	do_iter(filter, *varrws[i], i);
+
+    get_time(_conf.c_end);
+
+    cout << "Stats:" << endl;
+    stats();
+}
+
 void
 benchmark_run(void)
 {
@@ -246,22 +282,30 @@ benchmark_run(void)
 
     read_file(_conf.c_policy_file, policy);
     filter.configure(policy);
-    filter.set_profiler_exec(&_conf.c_exec);
+    if (_conf.c_profiler)
+	filter.set_profiler_exec(&_conf.c_exec);
 
     varrws = new VarRW* [iters];
     for (unsigned i = 0; i < iters; i++)
 	varrws[i] = create_varrw(i);
 
-    cout << "Benchmarking.  Iterations: " << iters << endl;
-    get_time(_conf.c_start);
+    switch (_conf.c_engine) {
+    case ETYPE_INTERPRETED:
+	benchmark_engine(filter, varrws, false);
+	break;
 
-    for (unsigned i = 0; i < iters; i++)
-	do_iter(filter, *varrws[i], i);
+    case ETYPE_COMPILED:
+	benchmark_engine(filter, varrws, true);
+	break;
 
-    get_time(_conf.c_end);
+    case ETYPE_BOTH:
+	benchmark_engine(filter, varrws, false);
+	benchmark_engine(filter, varrws, true);
+	break;
 
-    cout << "Stats:" << endl;
-    stats();
+    default:
+	die("unknown execution engine");
+    }
 }
 
 void
@@ -279,10 +323,15 @@ main(int argc, char* argv[])
 
     _conf.c_iterations = 100000;
     _conf.c_type       = 0;
+    _conf.c_engine     = ETYPE_COMPILED;
     _conf.c_profiler   = 1;
 
-    while ((opt = getopt(argc, argv, "hp:v:i:t:n")) != -1) {
+    while ((opt = getopt(argc, argv, "hp:v:i:t:e:n")) != -1) {
 	switch (opt) {
+	    case 'e':
+		_conf.c_engine = atoi(optarg);
+		break;
+
 	    case 'n':
 		_conf.c_profiler = 0;
 		break;
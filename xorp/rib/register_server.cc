@@ -41,6 +41,10 @@ NotifyQueue::NotifyQueue(const string& module_name)
 void
 NotifyQueue::add_entry(NotifyQueueEntry* e) 
 {
+    if (!_queue.empty() && _queue.back()->absorb(e)) {
+	delete e;
+	return;
+    }
     _queue.push_back(e);
 }
 
@@ -50,6 +54,7 @@ NotifyQueue::send_next()
     XrlCompleteCB cb = callback(this, &NotifyQueue::xrl_done);
 
     _queue.front()->send(_response_sender, _module_name, cb);
+    delete _queue.front();
     _queue.pop_front();
     if (_queue.empty()) {
 	_active = false;
@@ -104,21 +109,54 @@ NotifyQueueChangedEntry<IPv4>::send(ResponseSender* response_sender,
 					      _protocol_origin.c_str(), cb);
 }
 
+template <class A>
+bool
+NotifyQueueInvalidateEntry<A>::absorb(const NotifyQueueEntry* e)
+{
+    const NotifyQueueInvalidateEntry<A>* other =
+	dynamic_cast<const NotifyQueueInvalidateEntry<A>* >(e);
+
+    if (other == NULL || other->_multicast != _multicast)
+	return false;
+    if (_nets.size() + other->_nets.size() > MAX_BATCH)
+	return false;
+
+    _nets.insert(_nets.end(), other->_nets.begin(), other->_nets.end());
+    return true;
+}
+
 template <>
 void
 NotifyQueueInvalidateEntry<IPv4>::send(ResponseSender* response_sender,
 				       const string& module_name,
 				       NotifyQueue::XrlCompleteCB& cb) 
 {
-    debug_msg("Sending route_info_invalid4\n");
-    response_sender->send_route_info_invalid4(module_name.c_str(),
-					      _net.masked_addr(),
-					      _net.prefix_len(), cb);
+    if (_nets.size() == 1) {
+	debug_msg("Sending route_info_invalid4\n");
+	response_sender->send_route_info_invalid4(module_name.c_str(),
+						  _nets.front().masked_addr(),
+						  _nets.front().prefix_len(),
+						  cb);
+	return;
+    }
+
+    debug_msg("Sending route_info_invalid4_batch %u\n",
+	      XORP_UINT_CAST(_nets.size()));
+    XrlAtomList addrs;
+    XrlAtomList prefix_lens;
+    vector<IPv4Net>::const_iterator i;
+    for (i = _nets.begin(); i != _nets.end(); ++i) {
+	addrs.append(XrlAtom(i->masked_addr()));
+	prefix_lens.append(XrlAtom(i->prefix_len()));
+    }
+    response_sender->send_route_info_invalid4_batch(module_name.c_str(),
+						    addrs, prefix_lens, cb);
 }
 
 
 RegisterServer::RegisterServer(XrlRouter* xrl_router)
-    : _response_sender(xrl_router)
+    : _xrl_router(xrl_router),
+      _response_sender(xrl_router)
 {
 }
 
@@ -172,6 +210,22 @@ void
 RegisterServer::flush() 
 {
     debug_msg("REGSERV: flush\n");
+    if (_flush_timer.scheduled())
+	return;
+
+    //
+    // Every RIB operation ends with a flush.  Wait until the event
+    // loop has run the other operations that are ready, so that the
+    // notifications they generate can be merged.
+    //
+    _flush_timer = _xrl_router->eventloop().new_oneoff_after(
+	TimeVal::ZERO(),
+	callback(this, &RegisterServer::flush_queues));
+}
+
+void
+RegisterServer::flush_queues() 
+{
     map<string, NotifyQueue* >::iterator iter;
     for (iter = _queuemap.begin(); iter != _queuemap.end(); ++iter) {
 	iter->second->flush(&_response_sender);
@@ -201,9 +255,23 @@ NotifyQueueInvalidateEntry<IPv6>::send(ResponseSender* response_sender,
 				       const string& module_name,
 				       NotifyQueue::XrlCompleteCB& cb) 
 {
-    response_sender->send_route_info_invalid6(module_name.c_str(),
-					      _net.masked_addr(),
-					      _net.prefix_len(), cb);
+    if (_nets.size() == 1) {
+	response_sender->send_route_info_invalid6(module_name.c_str(),
+						  _nets.front().masked_addr(),
+						  _nets.front().prefix_len(),
+						  cb);
+	return;
+    }
+
+    XrlAtomList addrs;
+    XrlAtomList prefix_lens;
+    vector<IPv6Net>::const_iterator i;
+    for (i = _nets.begin(); i != _nets.end(); ++i) {
+	addrs.append(XrlAtom(i->masked_addr()));
+	prefix_lens.append(XrlAtom(i->prefix_len()));
+    }
+    response_sender->send_route_info_invalid6_batch(module_name.c_str(),
+						    addrs, prefix_lens, cb);
 }
 
 
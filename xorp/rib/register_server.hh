@@ -29,6 +29,7 @@
 #include "libxorp/ipv4.hh"
 #include "libxorp/ipv6.hh"
 #include "libxorp/ipnet.hh"
+#include "libxorp/timer.hh"
 
 #include "xrl/interfaces/rib_client_xif.hh"
 
@@ -60,6 +61,9 @@ public:
     /**
      * Add an notification entry to the queue.
      *
+     * If the entry at the back of the queue can absorb the new entry
+     * the two are merged and sent in a single XRL.
+     *
      * @param e the notification entry to be queued.
      */
     void add_entry(NotifyQueueEntry* e);
@@ -133,6 +137,16 @@ public:
      */
     virtual EntryType type() const = 0;
 
+    /**
+     * Merge another queue entry into this one, so that both are sent
+     * in a single XRL.
+     *
+     * @param e the entry queued after this one.
+     * @return true if the entry was merged, in which case it may be
+     * deleted by the caller.
+     */
+    virtual bool absorb(const NotifyQueueEntry* /* e */) { return false; }
+
 private:
 };
 
@@ -206,6 +220,9 @@ class NotifyQueueChangedEntry : public NotifyQueueEntry {
  * caused a route registration to become invalid.  The client must
  * re-register to find out what actually happened.
  *
+ * Consecutive invalidations for the same client are merged into one
+ * entry, which is sent as a single batch XRL.
+ *
  * The template class A is the address family: either the IPv4 class
  * or the IPv6 class.
  */
@@ -222,7 +239,7 @@ public:
      * RIB.  
      */
     NotifyQueueInvalidateEntry(const IPNet<A>& net, bool multicast)
-	: _net(net), _multicast(multicast) {}
+	: _multicast(multicast) { _nets.push_back(net); }
 
     /**
      * @return INVALIDATE
@@ -230,6 +247,12 @@ public:
      */
     EntryType type() const { return INVALIDATE; }
 
+    /**
+     * Merge a following invalidation of the same address family and
+     * RIB into this entry.
+     */
+    bool absorb(const NotifyQueueEntry* e);
+
     /**
      * Actually send the XRL that communicates this change to the
      * registered process.
@@ -244,10 +267,15 @@ public:
 	      const string& module_name,
 	      NotifyQueue::XrlCompleteCB& cb);
 
+    /**
+     * The maximum number of invalidations sent in a single XRL.
+     */
+    static const size_t MAX_BATCH = 256;
+
 private:
-    IPNet<A>	_net;	// The valid_subnet from the RouteRegister
-			// instance.  The other end already knows the
-			// route's full subnet.
+    vector<IPNet<A> > _nets;	// The valid_subnets from the RouteRegister
+				// instances.  The other end already knows
+				// the routes' full subnets.
     bool	_multicast;	// If true, a change occured in multicast RIB,
 				// otherwise it occured in the unicast RIB
 };
@@ -350,12 +378,20 @@ public:
 #endif
 
     /**
+     * Flush the notification queues at the end of the current
+     * event-loop iteration, so that all the notifications generated
+     * in the meantime for a module can be merged.
+     *
      * @see NotifyQueue::flush
      */
     virtual void flush();
 
 protected:
     void add_entry_to_queue(const string& module_name, NotifyQueueEntry* e);
+    void flush_queues();
+
+    XrlRouter*	_xrl_router;
+    XorpTimer	_flush_timer;
     map<string, NotifyQueue* > _queuemap;
     ResponseSender _response_sender;
 };
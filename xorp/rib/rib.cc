@@ -270,6 +270,14 @@ RIB<A>::RIB(RibTransportType t, RibManager& rib_manager, EventLoop& eventloop)
 		  static_distance);
     }
 
+    v = getenv("XORP_RIB_RESTART_GRACE");
+    if (v) {
+	_restart_grace_period = TimeVal(atoi(v), 0);
+	XLOG_INFO("Keeping the routes of a routing protocol that died for %s "
+		  "seconds based on XORP_RIB_RESTART_GRACE environment variable.",
+		  _restart_grace_period.str().c_str());
+    }
+
     // TODO: XXX: don't use hard-coded values below!
     _admin_distances["connected"] =        CONNECTED_ADMIN_DISTANCE;
     _admin_distances["static"] =           static_distance;
@@ -429,7 +437,14 @@ RIB<A>::initialize_ext_int()
 {
     XLOG_ASSERT(!_ext_int_table);
 
-    _ext_int_table = new ExtIntTable<A>();
+    if (getenv("XORP_RIB_CONSOLIDATED_TABLE") != NULL) {
+	XLOG_INFO("Using a consolidated best-route table for IPv%u based on "
+		  "XORP_RIB_CONSOLIDATED_TABLE environment variable.",
+		  XORP_UINT_CAST(A::ip_version()));
+	_ext_int_table = new ConsolidatedTable<A>();
+    } else {
+	_ext_int_table = new ExtIntTable<A>();
+    }
 
     XLOG_ASSERT(_final_table == NULL);
 
@@ -1277,7 +1292,10 @@ RIB<A>::target_death(const string& target_class,
 	    // We've found the target.
 	    XLOG_INFO("Received death event for protocol %s shutting down %s",
 		      target_class.c_str(), iter->second->str().c_str());
-	    iter->second->routing_protocol_shutdown();
+	    if (_restart_grace_period > TimeVal::ZERO())
+		iter->second->routing_protocol_restart(_restart_grace_period);
+	    else
+		iter->second->routing_protocol_shutdown();
 	    _routing_protocol_instances.erase(iter);
 
 	    // No need to go any further.
@@ -34,6 +34,7 @@
 #include "rt_tab_base.hh"
 #include "rt_tab_origin.hh"
 #include "rt_tab_extint.hh"
+#include "rt_tab_consolidated.hh"
 #include "rt_tab_redist.hh"
 #include "rt_tab_pol_redist.hh"
 #include "rt_tab_register.hh"
@@ -151,7 +152,9 @@ public:
     int initialize_register(RegisterServer& register_server);
 
     /**
-     * Initialize the RIB's ExtIntTable.
+     * Initialize the RIB's ExtIntTable.  If the environment variable
+     * XORP_RIB_CONSOLIDATED_TABLE is set, then a ConsolidatedTable is
+     * used instead.
      *
      * @return XORP_OK on success, otherwise XORP_ERROR.
      */
@@ -488,7 +491,9 @@ public:
 
     /**
      * An XRL Target died.  We need to check if it's a routing
-     * protocol, and if it was, clean up after it.
+     * protocol, and if it was, clean up after it.  If a restart grace
+     * period is set, then the routes of the routing protocol are kept
+     * as stale until it ends, rather than deleted at once.
      *
      * @param target_class the XRL Class of the target that died.
      * @param target_instance the XRL Class Instance of the target that died.
@@ -719,6 +724,7 @@ protected:
 
     bool		_multicast;
     bool		_errors_are_fatal;
+    TimeVal		_restart_grace_period;	// Keep routes after a death
 
 
 
@@ -733,7 +739,7 @@ protected:
     RegisterTable<A>*		_register_table;
     PolicyRedistTable<A>*	_policy_redist_table;
     PolicyConnectedTable<A>*	_policy_connected_table;
-    ExtIntTable<A>*		_ext_int_table;
+    BestRouteTable<A>*		_ext_int_table;
 
 
     OriginTableMap			_routing_protocol_instances;
@@ -591,6 +591,12 @@ RibManager::reset_filter(const uint32_t& filter)
     _policy_filters.reset(filter);
 }
 
+string
+RibManager::filter_statistics(const uint32_t& filter)
+{
+    return _policy_filters.statistics(filter);
+}
+
 void
 RibManager::remove_policy_redist_tags(const string& protocol)
 {
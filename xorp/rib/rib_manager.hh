@@ -307,6 +307,14 @@ public:
      */
     void reset_filter(const uint32_t& filter);
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter Identifier of filter to report on.
+     * @return human readable statistics of the filter.
+     */
+    string filter_statistics(const uint32_t& filter);
+
     /**
      * @return the global instance of policy filters.
      */
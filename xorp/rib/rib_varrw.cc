@@ -40,21 +40,19 @@ RIBVarRW<A>::start_read()
 
     read_route_nexthop(_route);
 
-    ostringstream oss;
-
-    oss << _route.metric();
-
-    initialize(VAR_METRIC, _ef.create(ElemU32::id, oss.str().c_str()));
+    _metric_elem.set_val(_route.metric());
+    initialize_typed(VAR_METRIC, _metric_elem);
 }
 
 template <>
 void
 RIBVarRW<IPv4>::read_route_nexthop(IPRouteEntry<IPv4>& route)
 {
-    initialize(VAR_NETWORK4,
-	       _ef.create(ElemIPv4Net::id, route.net().str().c_str()));
-    initialize(VAR_NEXTHOP4, _ef.create(ElemIPv4NextHop::id,
-               route.nexthop_addr().str().c_str()));
+    _network_elem.set_val(route.net());
+    _nexthop_elem.set_val(route.nexthop_addr());
+
+    initialize_typed(VAR_NETWORK4, _network_elem);
+    initialize_typed(VAR_NEXTHOP4, _nexthop_elem);
     initialize(VAR_NETWORK6, NULL);
     initialize(VAR_NEXTHOP6, NULL);
 }
@@ -63,10 +61,11 @@ template <>
 void
 RIBVarRW<IPv6>::read_route_nexthop(IPRouteEntry<IPv6>& route)
 {
-    initialize(VAR_NETWORK6,
-	       _ef.create(ElemIPv6Net::id, route.net().str().c_str()));
-    initialize(VAR_NEXTHOP6, _ef.create(ElemIPv6NextHop::id,
-               route.nexthop_addr().str().c_str()));
+    _network_elem.set_val(route.net());
+    _nexthop_elem.set_val(route.nexthop_addr());
+
+    initialize_typed(VAR_NETWORK6, _network_elem);
+    initialize_typed(VAR_NEXTHOP6, _nexthop_elem);
 
     initialize(VAR_NETWORK4, NULL);
     initialize(VAR_NEXTHOP4, NULL);
@@ -24,7 +24,7 @@
 #define __RIB_RIB_VARRW_HH__
 
 #include "policy/backend/single_varrw.hh"
-#include "policy/common/element_factory.hh"
+#include "policy/common/element.hh"
 #include "route.hh"
 
 /**
@@ -73,7 +73,11 @@ private:
     void read_route_nexthop(IPRouteEntry<A>& r);
 
     IPRouteEntry<A>&	_route;
-    ElementFactory	_ef;
+
+    // Values read from the route
+    ElemNet<IPNet<A> >	_network_elem;
+    ElemNextHop<A>	_nexthop_elem;
+    ElemU32		_metric_elem;
 };
 
 #endif // __RIB_RIB_VARRW_HH__
@@ -40,7 +40,8 @@ enum TableType {
     LOG_TABLE			= 1 << 7,
     POLICY_REDIST_TABLE		= 1 << 8,
     POLICY_CONNECTED_TABLE	= 1 << 9,
-    MAX_TABLE_TYPE		= 1 << 9
+    CONSOLIDATED_TABLE		= 1 << 10,
+    MAX_TABLE_TYPE		= 1 << 10
 };
 
 /**
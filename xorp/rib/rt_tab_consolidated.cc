@@ -0,0 +1,509 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "rib_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/debug.h"
+
+#include "rt_tab_consolidated.hh"
+
+template<class A>
+inline const string&
+ConsolidatedTable<A>::consolidated_name()
+{
+    static string CONSOLIDATED_NAME(c_format("Consolidated Table IPv%d",
+					     A::ip_version()));
+    return CONSOLIDATED_NAME;
+}
+
+template<class A>
+ConsolidatedTable<A>::ConsolidatedTable()
+    : BestRouteTable<A>(consolidated_name())
+{
+    debug_msg("New Consolidated: %s\n", this->tablename().c_str());
+}
+
+template<class A>
+ConsolidatedTable<A>::~ConsolidatedTable()
+{
+    NodeIterator iter;
+    for (iter = _routes.begin(); iter != _routes.end(); ++iter) {
+	vector<Candidate>& candidates = iter->candidates;
+	for (size_t i = 0; i < candidates.size(); i++) {
+	    delete candidates[i].resolved;
+	    delete candidates[i].unresolved;
+	}
+    }
+    _routes.delete_all_nodes();
+    _resolving_parents.clear();
+    _unresolved_nexthops.clear();
+    _all_tables.clear();
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::change_admin_distance(OriginTable<A>* ot, uint32_t ad)
+{
+    XLOG_ASSERT(ot && ot->route_count() == 0);
+
+    typename RouteTableMap::iterator iter;
+    iter = _all_tables.find(ot->admin_distance());
+    if (iter == _all_tables.end() || iter->second != ot)
+	return XORP_ERROR;
+    if (_all_tables.find(ad) != _all_tables.end()) {
+	XLOG_ERROR("Admin distance %u is already used by table %s",
+		   XORP_UINT_CAST(ad),
+		   _all_tables.find(ad)->second->tablename().c_str());
+	return XORP_ERROR;
+    }
+    _all_tables.erase(iter);
+    _all_tables[ad] = ot;
+
+    /* Change the AD of OriginTable */
+    ot->change_admin_distance(ad);
+    return XORP_OK;
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::add_protocol_table(OriginTable<A>* new_table)
+{
+    switch (new_table->protocol_type()) {
+    case IGP:
+    case EGP:
+	break;
+    default:
+	XLOG_ERROR("OriginTable for unrecognized protocol received!\n");
+	return XORP_ERROR;
+    }
+    XLOG_ASSERT(_all_tables.find(new_table->admin_distance()) == _all_tables.end());
+    _all_tables[new_table->admin_distance()] = new_table;
+    new_table->set_next_table(this);
+    return XORP_OK;
+}
+
+template<class A>
+inline bool
+ConsolidatedTable<A>::needs_resolving(const IPRouteEntry<A>& route)
+{
+    return (route.protocol()->protocol_type() == EGP
+	    && route.nexthop()->type() != PEER_NEXTHOP);
+}
+
+template<class A>
+const IPRouteEntry<A>*
+ConsolidatedTable<A>::best_igp_route(const RouteNode& node)
+{
+    for (size_t i = 0; i < node.candidates.size(); i++) {
+	const IPRouteEntry<A>* route = node.candidates[i].route;
+	if (route->protocol()->protocol_type() == IGP)
+	    return route;
+    }
+    return NULL;
+}
+
+template<class A>
+typename ConsolidatedTable<A>::Candidate*
+ConsolidatedTable<A>::find_candidate(RouteNode& node,
+				     const IPRouteEntry<A>* route)
+{
+    for (size_t i = 0; i < node.candidates.size(); i++) {
+	if (node.candidates[i].route == route)
+	    return &node.candidates[i];
+    }
+    return NULL;
+}
+
+template<class A>
+typename ConsolidatedTable<A>::NodeIterator
+ConsolidatedTable<A>::find_igp_node(NodeIterator iter) const
+{
+    while (iter != _routes.end() && best_igp_route(*iter) == NULL)
+	iter = _routes.find_less_specific(iter.key());
+    return iter;
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::add_igp_route(const IPRouteEntry<A>& route)
+{
+    XLOG_ASSERT(route.nexthop()->type() != EXTERNAL_NEXTHOP);
+    debug_msg("route comes from IGP %s\n", route.str().c_str());
+
+    return add_candidate(route);
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::add_egp_route(const IPRouteEntry<A>& route)
+{
+    debug_msg("route comes from EGP %s\n", route.str().c_str());
+
+    return add_candidate(route);
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::delete_igp_route(const IPRouteEntry<A>* route, bool b)
+{
+    debug_msg("IGP route deleted %s\n", route->str().c_str());
+
+    return delete_candidate(route, b);
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::delete_egp_route(const IPRouteEntry<A>* route, bool b)
+{
+    debug_msg("EGP route deleted %s\n", route->str().c_str());
+
+    return delete_candidate(route, b);
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::add_candidate(const IPRouteEntry<A>& route)
+{
+    XLOG_ASSERT(this->next_table() != NULL);
+    XLOG_ASSERT(_all_tables.find(route.admin_distance()) != _all_tables.end());
+
+    NodeIterator iter = _routes.lookup_node(route.net());
+    if (iter == _routes.end())
+	iter = _routes.insert(route.net(), RouteNode());
+
+    RouteNode& node = *iter;
+    const IPRouteEntry<A>* old_igp_route = best_igp_route(node);
+
+    typename vector<Candidate>::iterator ci = node.candidates.begin();
+    while (ci != node.candidates.end()
+	   && ci->route->admin_distance() < route.admin_distance()) {
+	++ci;
+    }
+    XLOG_ASSERT(ci == node.candidates.end()
+		|| ci->route->admin_distance() != route.admin_distance());
+    ci = node.candidates.insert(ci, Candidate(&route));
+
+    if (needs_resolving(route))
+	resolve_nexthop(*ci);
+
+    update_installed(iter);
+
+    const IPRouteEntry<A>* new_igp_route = best_igp_route(node);
+    if (new_igp_route != old_igp_route)
+	igp_route_changed(route.net(), old_igp_route, new_igp_route, false);
+
+    return XORP_OK;
+}
+
+template<class A>
+int
+ConsolidatedTable<A>::delete_candidate(const IPRouteEntry<A>* route, bool b)
+{
+    XLOG_ASSERT(this->next_table() != NULL);
+
+    NodeIterator iter = _routes.lookup_node(route->net());
+    if (iter == _routes.end()) {
+	XLOG_ERROR("Attempt to delete a route that doesn't exist: %s",
+		   route->str().c_str());
+	return XORP_ERROR;
+    }
+
+    RouteNode& node = *iter;
+    const IPRouteEntry<A>* old_igp_route = best_igp_route(node);
+
+    Candidate* candidate = find_candidate(node, route);
+    if (candidate == NULL) {
+	XLOG_ERROR("Attempt to delete a route that doesn't exist: %s",
+		   route->str().c_str());
+	return XORP_ERROR;
+    }
+
+    // Keep the resolved copy until the delete has been propagated
+    ResolvedIPRouteEntry<A>* resolved = release_nexthop(*candidate);
+    node.candidates.erase(node.candidates.begin()
+			  + (candidate - &node.candidates[0]));
+
+    const IPRouteEntry<A>* new_igp_route = best_igp_route(node);
+    IPNet<A> net = route->net();
+
+    update_installed(iter);
+    delete resolved;
+
+    if (new_igp_route != old_igp_route)
+	igp_route_changed(net, old_igp_route, new_igp_route, b);
+
+    return XORP_OK;
+}
+
+template<class A>
+void
+ConsolidatedTable<A>::update_installed(NodeIterator iter)
+{
+    RouteNode& node = *iter;
+    const IPRouteEntry<A>* best = NULL;
+
+    for (size_t i = 0; i < node.candidates.size(); i++) {
+	if (node.candidates[i].is_usable()) {
+	    best = node.candidates[i].entry();
+	    break;
+	}
+    }
+
+    const IPRouteEntry<A>* old = node.installed;
+    bool is_empty = node.candidates.empty();
+    node.installed = best;
+
+    // The node must be gone before the delete is propagated, so that
+    // lookups from downstream don't find it.
+    if (is_empty)
+	_routes.erase(iter);
+
+    if (best == old)
+	return;
+    if (old != NULL)
+	propagate_delete(old);
+    if (best != NULL)
+	propagate_add(*best);
+}
+
+template<class A>
+inline void
+ConsolidatedTable<A>::propagate_add(const IPRouteEntry<A>& route)
+{
+    if (route.protocol()->protocol_type() == IGP)
+	this->next_table()->add_igp_route(route);
+    else
+	this->next_table()->add_egp_route(route);
+}
+
+template<class A>
+inline void
+ConsolidatedTable<A>::propagate_delete(const IPRouteEntry<A>* route)
+{
+    if (route->protocol()->protocol_type() == IGP)
+	this->next_table()->delete_igp_route(route);
+    else
+	this->next_table()->delete_egp_route(route);
+}
+
+template<class A>
+void
+ConsolidatedTable<A>::resolve_nexthop(Candidate& candidate)
+{
+    XLOG_ASSERT(candidate.resolved == NULL && candidate.unresolved == NULL);
+
+    const A& nexthop = candidate.route->nexthop_addr();
+    NodeIterator iter = find_igp_node(_routes.find(nexthop));
+    if (iter == _routes.end()) {
+	debug_msg("nexthop %s was unresolved\n", nexthop.str().c_str());
+	keep_unresolved(candidate);
+	return;
+    }
+
+    const IPRouteEntry<A>* nexthop_route = best_igp_route(*iter);
+    debug_msg("nexthop resolved to \n   %s\n", nexthop_route->str().c_str());
+
+    ResolvedIPRouteEntry<A>* resolved
+	= new ResolvedIPRouteEntry<A>(nexthop_route, candidate.route);
+    resolved->set_backlink(
+	_resolving_parents.insert(make_pair(nexthop_route->net(), resolved)));
+    candidate.resolved = resolved;
+}
+
+template<class A>
+void
+ConsolidatedTable<A>::keep_unresolved(Candidate& candidate)
+{
+    XLOG_ASSERT(candidate.resolved == NULL && candidate.unresolved == NULL);
+
+    UnresolvedIPRouteEntry<A>* unresolved
+	= new UnresolvedIPRouteEntry<A>(candidate.route);
+    unresolved->set_backlink(
+	_unresolved_nexthops.insert(make_pair(candidate.route->nexthop_addr(),
+					      unresolved)));
+    candidate.unresolved = unresolved;
+}
+
+template<class A>
+ResolvedIPRouteEntry<A>*
+ConsolidatedTable<A>::release_nexthop(Candidate& candidate)
+{
+    ResolvedIPRouteEntry<A>* resolved = candidate.resolved;
+
+    if (resolved != NULL) {
+	_resolving_parents.erase(resolved->backlink());
+	candidate.resolved = NULL;
+    }
+    if (candidate.unresolved != NULL) {
+	_unresolved_nexthops.erase(candidate.unresolved->backlink());
+	delete candidate.unresolved;
+	candidate.unresolved = NULL;
+    }
+
+    return resolved;
+}
+
+template<class A>
+void
+ConsolidatedTable<A>::resolve_again(const RouteList& routes,
+				    bool keep_unresolved)
+{
+    typename RouteList::const_iterator ri;
+    for (ri = routes.begin(); ri != routes.end(); ++ri) {
+	const IPRouteEntry<A>* route = *ri;
+
+	NodeIterator iter = _routes.lookup_node(route->net());
+	XLOG_ASSERT(iter != _routes.end());
+	Candidate* candidate = find_candidate(*iter, route);
+	XLOG_ASSERT(candidate != NULL);
+
+	ResolvedIPRouteEntry<A>* resolved = release_nexthop(*candidate);
+	if (keep_unresolved)
+	    this->keep_unresolved(*candidate);
+	else
+	    resolve_nexthop(*candidate);
+
+	update_installed(iter);
+	delete resolved;
+    }
+}
+
+template<class A>
+void
+ConsolidatedTable<A>::igp_route_changed(const IPNet<A>& net,
+					const IPRouteEntry<A>* old_route,
+					const IPRouteEntry<A>* new_route,
+					bool b)
+{
+    debug_msg("igp_route_changed: %s\n", net.str().c_str());
+
+    RouteList routes;
+
+    if (old_route != NULL) {
+	//
+	// The EGP routes resolved through the old route now resolve
+	// through the new route, or through a less specific subnet.
+	//
+	typename ResolvingParentMultiMap::iterator iter, end;
+	iter = _resolving_parents.lower_bound(net);
+	end = _resolving_parents.upper_bound(net);
+	for ( ; iter != end; ++iter)
+	    routes.push_back(iter->second->egp_parent());
+
+	resolve_again(routes, new_route == NULL && b);
+	return;
+    }
+
+    //
+    // A subnet with a new IGP route takes over the nexthops inside it
+    // from the less specific subnet that resolved them so far.
+    //
+    NodeIterator parent = _routes.find_less_specific(net);
+    parent = find_igp_node(parent);
+    if (parent != _routes.end()) {
+	typename ResolvingParentMultiMap::iterator iter, end;
+	iter = _resolving_parents.lower_bound(parent.key());
+	end = _resolving_parents.upper_bound(parent.key());
+	for ( ; iter != end; ++iter) {
+	    const IPRouteEntry<A>* egp_parent = iter->second->egp_parent();
+	    if (net.contains(egp_parent->nexthop_addr()))
+		routes.push_back(egp_parent);
+	}
+    }
+
+    //
+    // _unresolved_nexthops is ordered by address, so lower_bound on
+    // the subnet base address gives us the first nexthop it resolves.
+    //
+    typename UnresolvedNexthopMultiMap::iterator iter;
+    iter = _unresolved_nexthops.lower_bound(net.masked_addr());
+    for ( ; iter != _unresolved_nexthops.end(); ++iter) {
+	if (iter->first > net.top_addr())
+	    break;
+	routes.push_back(iter->second->route());
+    }
+
+    resolve_again(routes, false);
+}
+
+template<class A>
+const IPRouteEntry<A>*
+ConsolidatedTable<A>::lookup_route(const IPNet<A>& net) const
+{
+    NodeIterator iter = _routes.lookup_node(net);
+    return ((iter == _routes.end()) ? NULL : iter->installed);
+}
+
+template<class A>
+const IPRouteEntry<A>*
+ConsolidatedTable<A>::lookup_route(const A& addr) const
+{
+    NodeIterator iter = _routes.find(addr);
+
+    // Skip subnets that only have EGP routes with unresolved nexthops
+    while (iter != _routes.end() && iter->installed == NULL)
+	iter = _routes.find_less_specific(iter.key());
+
+    return ((iter == _routes.end()) ? NULL : iter->installed);
+}
+
+template<class A>
+RouteRange<A>*
+ConsolidatedTable<A>::lookup_route_range(const A& addr) const
+{
+    const IPRouteEntry<A>* route = lookup_route(addr);
+
+    //
+    // The bounds are those of the most specific subnet with a node,
+    // which may be tighter than needed when that subnet has no route
+    // propagated downstream.
+    //
+    A bottom_addr, top_addr;
+    _routes.find_bounds(addr, bottom_addr, top_addr);
+    return (new RouteRange<A>(addr, route, top_addr, bottom_addr));
+}
+
+template<class A>
+string
+ConsolidatedTable<A>::str() const
+{
+    string s;
+
+    s = "-------\nConsolidatedTable: " + this->tablename() + "\n";
+    s += c_format("%u subnets, %u resolved and %u unresolved nexthops\n",
+		  XORP_UINT_CAST(_routes.size()),
+		  XORP_UINT_CAST(_resolving_parents.size()),
+		  XORP_UINT_CAST(_unresolved_nexthops.size()));
+    typename RouteTableMap::const_iterator iter;
+    for (iter = _all_tables.begin(); iter != _all_tables.end(); ++iter) {
+	s += c_format("AD: %d %s\n", iter->first,
+		      (iter->second->protocol_type() == IGP) ? "IGP" : "EGP");
+	s += iter->second->str() + "\n";
+    }
+    if (this->next_table() == NULL)
+	s += "no next table\n";
+    else
+	s += "next table = " + this->next_table()->tablename() + "\n";
+    return s;
+}
+
+template class ConsolidatedTable<IPv4>;
+template class ConsolidatedTable<IPv6>;
@@ -0,0 +1,257 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __RIB_RT_TAB_CONSOLIDATED_HH__
+#define __RIB_RT_TAB_CONSOLIDATED_HH__
+
+#include "rt_tab_extint.hh"
+
+
+/**
+ * @short Pick the best route for each subnet from all origin tables
+ * in a single trie, while resolving nexthops that are not immediate
+ * neighbors.
+ *
+ * ConsolidatedTable is an alternative to @ref ExtIntTable.  It keeps
+ * one trie node per subnet, holding the route each origin table has
+ * for that subnet ordered by admin distance, and the route that is
+ * currently propagated downstream.  The first usable candidate wins:
+ * routes from IGP tables and EGP routes with a directly connected
+ * nexthop are always usable, other EGP routes only once their nexthop
+ * resolves.
+ *
+ * The nexthop of an EGP route is resolved through the best IGP route
+ * of the most specific subnet that has one.  The resolved route, or
+ * the fact that the nexthop did not resolve, is kept with the
+ * candidate itself.  An add or delete is thus handled with a single
+ * trie lookup, and a masked route is found in the same node instead
+ * of being looked up again in the origin tables.
+ *
+ * A RIB normally only has one ConsolidatedTable.
+ */
+template<class A>
+class ConsolidatedTable : public BestRouteTable<A> {
+public:
+    /**
+     * ConsolidatedTable Constructor.
+     */
+    ConsolidatedTable();
+
+    /**
+     * ConsolidatedTable Destructor.
+     */
+    virtual ~ConsolidatedTable();
+
+    /**
+     * Add a route from an IGP origin table.  The route is propagated
+     * downstream if it has the best admin distance for its subnet.
+     * It may also change how the nexthops of EGP routes resolve.
+     *
+     * @param route the new route.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int add_igp_route(const IPRouteEntry<A>& route);
+
+    /**
+     * Add a route from an EGP origin table.  The route is propagated
+     * downstream if it has the best admin distance for its subnet and
+     * its nexthop resolves.
+     *
+     * @param route the new route.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int add_egp_route(const IPRouteEntry<A>& route);
+
+    /**
+     * Delete a route from an IGP origin table.  If the route was
+     * propagated downstream, then the next best route for the subnet
+     * replaces it.
+     *
+     * @param route the route to be deleted.
+     * @param b true if a route for the same subnet is about to be
+     * added by the same origin table.  EGP routes resolved through
+     * this route are then kept unresolved until that happens.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int delete_igp_route(const IPRouteEntry<A>* route, bool b);
+
+    /**
+     * Delete a route from an EGP origin table.  If the route was
+     * propagated downstream, then the next best route for the subnet
+     * replaces it.
+     *
+     * @param route the route to be deleted.
+     * @param b unused.
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int delete_egp_route(const IPRouteEntry<A>* route, bool b);
+
+    /**
+     * Lookup a specific subnet.
+     *
+     * @param net the subnet to look up.
+     * @return a pointer to the route entry propagated downstream for
+     * this subnet if it exists, NULL otherwise.
+     */
+    const IPRouteEntry<A>* lookup_route(const IPNet<A>& net) const;
+
+    /**
+     * Lookup an IP address to get the most specific route propagated
+     * downstream that matches this address.
+     *
+     * @param addr the IP address to look up.
+     * @return a pointer to the route entry if any entry matches, NULL
+     * otherwise.
+     */
+    const IPRouteEntry<A>* lookup_route(const A& addr) const;
+
+    /**
+     * Lookup an IP address to get the most specific route propagated
+     * downstream that matches this address, along with the
+     * RouteRange information for this address and route.
+     *
+     * @see RouteRange
+     * @param addr the IP address to look up.
+     * @return a pointer to a RouteRange class instance containing the
+     * relevant answer.  It is up to the recipient of this pointer to
+     * free the associated memory.
+     */
+    RouteRange<A>* lookup_route_range(const A& addr) const;
+
+    /**
+     * @return the table type (@ref TableType).
+     */
+    TableType type() const	{ return CONSOLIDATED_TABLE; }
+
+    /**
+     * Changes the admin distance of an OriginTable that has no routes.
+     *
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int change_admin_distance(OriginTable<A>* ot, uint32_t ad);
+
+    /**
+     * Plumb a new OriginTable into this table.
+     *
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    int add_protocol_table(OriginTable<A>* new_table);
+
+    /**
+     * Render this ConsolidatedTable as a string for debugging purposes.
+     */
+    string str() const;
+
+private:
+    /**
+     * The route of one origin table for a subnet.  Only EGP routes
+     * with a nexthop that is not directly connected need resolving,
+     * and for those exactly one of resolved and unresolved is set.
+     */
+    struct Candidate {
+	Candidate(const IPRouteEntry<A>* r)
+	    : route(r), resolved(NULL), unresolved(NULL) {}
+
+	bool is_usable() const { return unresolved == NULL; }
+	const IPRouteEntry<A>* entry() const {
+	    return (resolved != NULL) ? resolved : route;
+	}
+
+	const IPRouteEntry<A>*		route;
+	ResolvedIPRouteEntry<A>*	resolved;
+	UnresolvedIPRouteEntry<A>*	unresolved;
+    };
+
+    /**
+     * All the candidates for a subnet, ordered by admin distance.
+     */
+    struct RouteNode {
+	RouteNode() : installed(NULL) {}
+
+	vector<Candidate>	candidates;
+	const IPRouteEntry<A>*	installed;	// Propagated downstream
+    };
+
+    typedef Trie<A, RouteNode> RouteNodeTrie;
+    typedef typename RouteNodeTrie::iterator NodeIterator;
+    typedef typename ResolvedIPRouteEntry<A>::RouteBackLink ResolvingParentMultiMap;
+    typedef typename UnresolvedIPRouteEntry<A>::RouteBackLink UnresolvedNexthopMultiMap;
+    typedef map<uint16_t, OriginTable<A>* > RouteTableMap;
+    typedef list<const IPRouteEntry<A>*> RouteList;
+
+    int add_candidate(const IPRouteEntry<A>& route);
+    int delete_candidate(const IPRouteEntry<A>* route, bool b);
+
+    /**
+     * Make the route propagated downstream for a subnet match the
+     * best usable candidate, and drop the trie node if it has no
+     * candidates left.
+     */
+    void update_installed(NodeIterator iter);
+
+    void propagate_add(const IPRouteEntry<A>& route);
+    void propagate_delete(const IPRouteEntry<A>* route);
+
+    static bool needs_resolving(const IPRouteEntry<A>& route);
+    static const IPRouteEntry<A>* best_igp_route(const RouteNode& node);
+    static Candidate* find_candidate(RouteNode& node,
+				     const IPRouteEntry<A>* route);
+
+    /**
+     * Walk from a node towards less specific subnets until a node
+     * with an IGP route is found.
+     */
+    NodeIterator find_igp_node(NodeIterator iter) const;
+
+    void resolve_nexthop(Candidate& candidate);
+    void keep_unresolved(Candidate& candidate);
+    ResolvedIPRouteEntry<A>* release_nexthop(Candidate& candidate);
+
+    /**
+     * Resolve the nexthops of EGP routes again, and propagate any
+     * change downstream.
+     *
+     * @param routes the EGP routes, as held by their origin tables.
+     * @param keep_unresolved if true, do not try to resolve the
+     * nexthops but store the routes as unresolved.
+     */
+    void resolve_again(const RouteList& routes, bool keep_unresolved);
+
+    /**
+     * Handle a change of the best IGP route for a subnet.
+     */
+    void igp_route_changed(const IPNet<A>& net,
+			   const IPRouteEntry<A>* old_route,
+			   const IPRouteEntry<A>* new_route, bool b);
+
+    RouteTableMap		_all_tables;
+    RouteNodeTrie		_routes;
+
+    // _resolving_parents gives us a fast way of finding the EGP
+    // routes affected by a change of the IGP route for a subnet
+    ResolvingParentMultiMap	_resolving_parents;
+
+    // _unresolved_nexthops is ordered by nexthop, so the EGP routes
+    // that a new IGP route may resolve can be found by range
+    UnresolvedNexthopMultiMap	_unresolved_nexthops;
+
+    static const string& consolidated_name();
+};
+
+#endif // __RIB_RT_TAB_CONSOLIDATED_HH__
@@ -36,7 +36,7 @@ ExtIntTable<A>::ext_int_name()
 
 template<class A>
 ExtIntTable<A>::ExtIntTable()
-    : RouteTable<A>(ext_int_name())
+    : BestRouteTable<A>(ext_int_name())
 {
     debug_msg("New ExtInt: %s\n", this->tablename().c_str());
 }
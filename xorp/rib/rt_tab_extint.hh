@@ -25,6 +25,64 @@
 #include "rt_tab_origin.hh"
 
 
+/**
+ * @short Interface of the table that picks the best route for each
+ * subnet across all the @ref OriginTable instances.
+ *
+ * A RIB has exactly one such table, which is either an @ref
+ * ExtIntTable or a @ref ConsolidatedTable.  All origin tables are
+ * plumbed into it, and the @ref RegisterTable is its next table.
+ */
+template<class A>
+class BestRouteTable : public RouteTable<A> {
+public:
+    BestRouteTable(const string& name) : RouteTable<A>(name) {}
+
+    /**
+     * Lookup a specific subnet.
+     *
+     * @param net the subnet to look up.
+     * @return a pointer to the winning route entry if it exists, NULL
+     * otherwise.
+     */
+    virtual const IPRouteEntry<A>* lookup_route(const IPNet<A>& net) const = 0;
+
+    /**
+     * Lookup an IP address to get the most specific winning route
+     * that matches this address.
+     *
+     * @param addr the IP address to look up.
+     * @return a pointer to the route entry if any entry matches, NULL
+     * otherwise.
+     */
+    virtual const IPRouteEntry<A>* lookup_route(const A& addr) const = 0;
+
+    /**
+     * Lookup an IP address to get the most specific winning route
+     * that matches this address, along with the range of addresses
+     * for which the answer is the same.
+     *
+     * @param addr the IP address to look up.
+     * @return a pointer to a RouteRange class instance.  It is up to
+     * the recipient of this pointer to free the associated memory.
+     */
+    virtual RouteRange<A>* lookup_route_range(const A& addr) const = 0;
+
+    /**
+     * Changes the admin distance of an OriginTable that has no routes.
+     *
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    virtual int change_admin_distance(OriginTable<A>* ot, uint32_t ad) = 0;
+
+    /**
+     * Plumb a new OriginTable into this table.
+     *
+     * @return XORP_OK on success, otherwise XORP_ERROR.
+     */
+    virtual int add_protocol_table(OriginTable<A>* new_table) = 0;
+};
+
 /**
  * @short Make two route @ref RouteTables behave like one, while
  * resolving nexthops that are not immediate neighbors
@@ -58,7 +116,7 @@
  * A RIB normally only has one ExtIntTable.
  */
 template<class A>
-class ExtIntTable : public RouteTable<A> {
+class ExtIntTable : public BestRouteTable<A> {
 public:
     /**
      * ExtIntTable Constructor.
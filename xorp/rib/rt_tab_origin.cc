@@ -41,6 +41,7 @@ OriginTable<A>::OriginTable(const string&	tablename,
     : RouteTable<A>(tablename),
       _admin_distance(admin_distance),
       _eventloop(eventloop),
+      _stale_route_table(NULL),
       _gen(0)
 {
     XLOG_ASSERT(admin_distance <= 255);
@@ -57,6 +58,20 @@ OriginTable<A>::~OriginTable()
     delete _ip_route_table;
 }
 
+template<class A>
+bool
+OriginTable<A>::is_same_route(const IPRouteEntry<A>& a,
+			      const IPRouteEntry<A>& b)
+{
+    return (a.net() == b.net()
+	    && a.vif() == b.vif()
+	    && a.nexthop()->type() == b.nexthop()->type()
+	    && a.nexthop_addr() == b.nexthop_addr()
+	    && a.metric() == b.metric()
+	    && a.admin_distance() == b.admin_distance()
+	    && a.policytags() == b.policytags());
+}
+
 
 template<class A>
 int
@@ -65,13 +80,34 @@ OriginTable<A>::add_route(IPRouteEntry<A>* route)
     debug_msg("OT[%s]: Adding route %s\n", this->tablename().c_str(),
 	    route->str().c_str());
 
+    route->set_admin_distance(_admin_distance);
+
+    if (_stale_route_table != NULL) {
+	typename RouteTrie::iterator iter;
+	iter = _stale_route_table->lookup_node(route->net());
+	if (iter != _stale_route_table->end()) {
+	    const IPRouteEntry<A>* stale = *iter;
+	    _stale_route_table->erase(iter);
+
+	    if (is_same_route(*stale, *route)) {
+		// Keep the route that is already downstream
+		delete (route);
+		return XORP_OK;
+	    }
+
+	    // The route has changed, so replace the stale one
+	    _ip_route_table->erase(stale->net());
+	    XLOG_ASSERT(this->next_table() != NULL);
+	    this->generic_delete_route(stale, false);
+	    delete stale;
+	}
+    }
+
     if (lookup_ip_route(route->net()) != NULL) {
 	delete (route);
 	return XORP_ERROR;
     }
 
-    route->set_admin_distance(_admin_distance);
-
     _ip_route_table->insert(route->net(), route);
 
     // Propagate to next table
@@ -96,6 +132,8 @@ OriginTable<A>::delete_route(const IPNet<A>& net, bool b)
     if (iter != _ip_route_table->end()) {
 	const IPRouteEntry<A>* found = *iter;
 	_ip_route_table->erase(net);
+	if (_stale_route_table != NULL)
+	    _stale_route_table->erase(net);
 	// Propagate to next table
 	XLOG_ASSERT(this->next_table() != NULL);
 	this->generic_delete_route(found, b);
@@ -120,12 +158,15 @@ OriginTable<A>::delete_all_routes()
 	delete *iter;
     }
     _ip_route_table->delete_all_nodes();
+    clear_stale_routes();
 }
 
 template<class A>
 void
 OriginTable<A>::routing_protocol_shutdown()
 {
+    clear_stale_routes();
+
     //
     // Put existing ip_route_table to one side.  The plumbing changes that
     // accompany the creation and plumbing of the deletion table may trigger
@@ -143,6 +184,76 @@ OriginTable<A>::routing_protocol_shutdown()
     this->allocate_deletion_table(old_ip_route_table);
 }
 
+template<class A>
+void
+OriginTable<A>::routing_protocol_restart(const TimeVal& grace_period)
+{
+    //
+    // Every route is stale until the new instance of the routing
+    // protocol adds it again, including routes that were still stale
+    // from an earlier restart.
+    //
+    if (_stale_route_table == NULL)
+	_stale_route_table = new RouteTrie();
+    _stale_route_table->delete_all_nodes();
+
+    typename RouteTrie::iterator iter;
+    for (iter = _ip_route_table->begin();
+	 iter != _ip_route_table->end();
+	 ++iter) {
+	_stale_route_table->insert(iter.key(), *iter);
+    }
+
+    XLOG_INFO("Keeping %u routes of %s as stale for %s seconds",
+	      XORP_UINT_CAST(stale_route_count()), this->tablename().c_str(),
+	      grace_period.str().c_str());
+
+    _stale_timer = _eventloop.new_oneoff_after(grace_period,
+	callback(this, &OriginTable<A>::sweep_stale_routes));
+}
+
+template<class A>
+void
+OriginTable<A>::sweep_stale_routes()
+{
+    RouteTrie* stale_route_table = _stale_route_table;
+    _stale_route_table = NULL;
+    if (stale_route_table == NULL)
+	return;
+
+    XLOG_INFO("Grace period of %s ended: deleting %u stale routes, "
+	      "keeping %u routes",
+	      this->tablename().c_str(),
+	      XORP_UINT_CAST(stale_route_table->route_count()),
+	      XORP_UINT_CAST(route_count() - stale_route_table->route_count()));
+
+    if (stale_route_table->empty()) {
+	delete stale_route_table;
+	return;
+    }
+
+    //
+    // Hand the stale routes to a DeletionTable, which will delete
+    // them in the background.
+    //
+    typename RouteTrie::iterator iter;
+    for (iter = stale_route_table->begin();
+	 iter != stale_route_table->end();
+	 ++iter) {
+	_ip_route_table->erase(iter.key());
+    }
+    this->allocate_deletion_table(stale_route_table);
+}
+
+template<class A>
+void
+OriginTable<A>::clear_stale_routes()
+{
+    _stale_timer.unschedule();
+    delete _stale_route_table;
+    _stale_route_table = NULL;
+}
+
 template<class A>
 const IPRouteEntry<A>*
 OriginTable<A>::lookup_ip_route(const IPNet<A>& net) const
@@ -176,6 +287,8 @@ OriginTable<A>::str() const
 
     s = "-------\nOriginTable: " + this->tablename() + "\n" +
 	( this->protocol_type() == IGP ? "IGP\n" : "EGP\n" ) ;
+    if (_stale_route_table != NULL)
+	s += c_format("%u stale routes\n", XORP_UINT_CAST(stale_route_count()));
     if (this->next_table() == NULL)
 	s += "no next table\n";
     else
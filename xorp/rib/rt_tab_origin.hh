@@ -106,6 +106,18 @@ public:
      */
     void routing_protocol_shutdown();
 
+    /**
+     * Keep all the routes that are in this OriginTable, but mark them
+     * as stale.  A stale route that is added again unchanged before the
+     * grace period ends is refreshed without any change downstream,
+     * and one that is added with a change replaces the stale route.
+     * Routes that are still stale when the grace period ends are
+     * deleted, and the deletions propagated downstream.
+     *
+     * @param grace_period how long to keep the stale routes.
+     */
+    void routing_protocol_restart(const TimeVal& grace_period);
+
     /**
      * Lookup a specific subnet to see if it is in this OriginTable.
      *
@@ -162,16 +174,38 @@ public:
      */
     uint32_t route_count() const;
 
+    /**
+     * Get the number of routes that are stale after a restart of the
+     * routing protocol.
+     */
+    uint32_t stale_route_count() const;
+
     /**
      * Get the trie.
      */
     const RouteTrie& route_container() const;
 
 protected:
+    /**
+     * Delete the routes that are still stale at the end of the grace
+     * period.
+     */
+    void sweep_stale_routes();
+
+    /**
+     * Stop keeping stale routes, without deleting them.
+     */
+    void clear_stale_routes();
+
+    static bool is_same_route(const IPRouteEntry<A>& a,
+			      const IPRouteEntry<A>& b);
+
     uint16_t		_admin_distance;	// 0 .. 255
     //
     EventLoop&   	_eventloop;
     RouteTrie*		_ip_route_table;
+    RouteTrie*		_stale_route_table;	// Not yet added again
+    XorpTimer		_stale_timer;
     uint32_t	 	_gen;
 
     virtual int generic_delete_route(const IPRouteEntry<A>*, bool) = 0;
@@ -241,6 +275,13 @@ OriginTable<A>::route_count() const
     return _ip_route_table->route_count();
 }
 
+template <class A>
+inline uint32_t
+OriginTable<A>::stale_route_count() const
+{
+    return (_stale_route_table == NULL) ? 0 : _stale_route_table->route_count();
+}
+
 template <class A>
 inline const typename OriginTable<A>::RouteTrie&
 OriginTable<A>::route_container() const
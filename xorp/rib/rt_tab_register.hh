@@ -349,7 +349,7 @@ public:
      */
     TableType type() const	{ return REGISTER_TABLE; }
 
-    void set_parent(ExtIntTable<A>* new_parent);
+    void set_parent(BestRouteTable<A>* new_parent);
 
     /**
      * Cause the register server to push out queued changes to the
@@ -390,7 +390,7 @@ private:
 
     map<string, ModuleData>		_module_names;
     Trie<A, RouteRegister<A>* >		_ipregistry;
-    ExtIntTable<A>*			_parent;
+    BestRouteTable<A>*			_parent;
     RegisterServer&			_register_server;
     bool				_multicast;  // true if a multicast rib
 };
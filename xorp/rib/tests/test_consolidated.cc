@@ -0,0 +1,181 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "rib_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/debug.h"
+#include "libxorp/eventloop.hh"
+
+#include "rib.hh"
+#include "rt_tab_origin.hh"
+#include "rt_tab_consolidated.hh"
+#include "rt_tab_expect.hh"
+
+
+int
+main(int /* argc */, char* argv[])
+{
+    //
+    // Initialize and start xlog
+    //
+    xlog_init(argv[0], NULL);
+    xlog_set_verbose(XLOG_VERBOSE_LOW);		// Least verbose messages
+    // XXX: verbosity of the error messages temporary increased
+    xlog_level_set_verbose(XLOG_LEVEL_ERROR, XLOG_VERBOSE_HIGH);
+    xlog_add_default_output();
+    xlog_start();
+    EventLoop eventloop;
+
+    TypedOriginTable<IPv4, EGP> ebgp("ebgp", 20, eventloop);
+    TypedOriginTable<IPv4, IGP> ospf("ospf", 110, eventloop);
+    TypedOriginTable<IPv4, EGP> ibgp("ibgp", 200, eventloop);
+    ConsolidatedTable<IPv4> ct;
+    ExpectTable<IPv4> et("expect", &ospf);
+
+    ct.set_next_table(&et);
+    XLOG_ASSERT(ct.add_protocol_table(&ebgp) == XORP_OK);
+    XLOG_ASSERT(ct.add_protocol_table(&ospf) == XORP_OK);
+    XLOG_ASSERT(ct.add_protocol_table(&ibgp) == XORP_OK);
+
+    Vif tmp_vif1("vif1");
+    RibVif<IPv4> vif1(NULL, tmp_vif1);
+    IPPeerNextHop<IPv4> nh1(IPv4("1.0.0.1"));
+    IPPeerNextHop<IPv4> nh2(IPv4("1.0.0.2"));
+    IPPeerNextHop<IPv4> nh3(IPv4("1.0.0.3"));
+    IPExternalNextHop<IPv4> bgp_nh1(IPv4("10.1.1.1"));
+    IPExternalNextHop<IPv4> bgp_nh2(IPv4("40.0.0.1"));
+    Protocol igp("ospf", IGP);
+    Protocol egp("bgp", EGP);
+    IPv4Net net8("10.0.0.0/8");
+    IPv4Net net16("10.1.0.0/16");
+    IPv4Net net20("20.0.0.0/8");
+    IPv4Net net30("30.0.0.0/8");
+    IPv4Net net40("40.0.0.0/8");
+
+    IPRouteEntry<IPv4> igp8(net8, &vif1, nh1.get_copy(), &igp, 10);
+    IPRouteEntry<IPv4> igp16(net16, &vif1, nh2.get_copy(), &igp, 10);
+    IPRouteEntry<IPv4> igp40(net40, &vif1, nh1.get_copy(), &igp, 10);
+    IPRouteEntry<IPv4> ebgp16(net16, &vif1, nh3.get_copy(), &egp, 0);
+    IPRouteEntry<IPv4> ibgp20(net20, NULL, bgp_nh1.get_copy(), &egp, 0);
+    IPRouteEntry<IPv4> ibgp30(net30, NULL, bgp_nh2.get_copy(), &egp, 0);
+
+    // What the ibgp routes look like once their nexthops resolve
+    IPRouteEntry<IPv4> ibgp20_via_nh1(net20, &vif1, nh1.get_copy(), &egp, 0);
+    IPRouteEntry<IPv4> ibgp20_via_nh2(net20, &vif1, nh2.get_copy(), &egp, 0);
+    IPRouteEntry<IPv4> ibgp30_via_nh1(net30, &vif1, nh1.get_copy(), &egp, 0);
+
+    //
+    // An EGP route is propagated once its nexthop resolves.
+    //
+    et.expect_add(igp8);
+    ospf.add_route(new IPRouteEntry<IPv4>(igp8));
+
+    et.expect_add(ibgp20_via_nh1);
+    ibgp.add_route(new IPRouteEntry<IPv4>(ibgp20));
+    XLOG_ASSERT(et.expected_route_changes().empty());
+    XLOG_ASSERT(ct.lookup_route(IPv4("20.1.2.3")) != NULL);
+    XLOG_ASSERT(ct.lookup_route(IPv4("20.1.2.3"))->nexthop_addr()
+		== nh1.addr());
+
+    printf("-------------------------------------------------------\n");
+
+    //
+    // A more specific IGP route takes over the nexthop.
+    //
+    et.expect_add(igp16);
+    et.expect_delete(ibgp20_via_nh1);
+    et.expect_add(ibgp20_via_nh2);
+    ospf.add_route(new IPRouteEntry<IPv4>(igp16));
+    XLOG_ASSERT(et.expected_route_changes().empty());
+
+    //
+    // An unresolved nexthop hides the route until an IGP route
+    // covers it.
+    //
+    ibgp.add_route(new IPRouteEntry<IPv4>(ibgp30));
+    XLOG_ASSERT(ct.lookup_route(IPv4("30.0.0.1")) == NULL);
+    XLOG_ASSERT(ct.lookup_route(net30) == NULL);
+
+    et.expect_add(igp40);
+    et.expect_add(ibgp30_via_nh1);
+    ospf.add_route(new IPRouteEntry<IPv4>(igp40));
+    XLOG_ASSERT(et.expected_route_changes().empty());
+
+    printf("-------------------------------------------------------\n");
+
+    //
+    // A route with a better admin distance masks the IGP route, but
+    // doesn't change how nexthops resolve.
+    //
+    et.expect_delete(igp16);
+    et.expect_add(ebgp16);
+    ebgp.add_route(new IPRouteEntry<IPv4>(ebgp16));
+    XLOG_ASSERT(et.expected_route_changes().empty());
+    XLOG_ASSERT(ct.lookup_route(net16)->nexthop_addr() == nh3.addr());
+
+    et.expect_delete(ebgp16);
+    et.expect_add(igp16);
+    ebgp.delete_route(net16);
+    XLOG_ASSERT(et.expected_route_changes().empty());
+
+    printf("-------------------------------------------------------\n");
+
+    //
+    // Deleting IGP routes moves the nexthop to a less specific route,
+    // and then leaves it unresolved.
+    //
+    et.expect_delete(igp16);
+    et.expect_delete(ibgp20_via_nh2);
+    et.expect_add(ibgp20_via_nh1);
+    ospf.delete_route(net16);
+    XLOG_ASSERT(et.expected_route_changes().empty());
+
+    et.expect_delete(igp8);
+    et.expect_delete(ibgp20_via_nh1);
+    ospf.delete_route(net8);
+    XLOG_ASSERT(et.expected_route_changes().empty());
+    XLOG_ASSERT(ct.lookup_route(IPv4("20.1.2.3")) == NULL);
+
+    RouteRange<IPv4>* rr = ct.lookup_route_range(IPv4("40.1.2.3"));
+    XLOG_ASSERT(rr->route() != NULL && rr->net() == net40);
+    XLOG_ASSERT(rr->bottom() == net40.masked_addr());
+    XLOG_ASSERT(rr->top() == net40.top_addr());
+    delete rr;
+
+    printf("-------------------------------------------------------\n");
+
+    //
+    // Clean up, leaving nothing behind.
+    //
+    ibgp.delete_route(net20);
+    et.expect_delete(igp40);
+    et.expect_delete(ibgp30_via_nh1);
+    ospf.delete_route(net40);
+    ibgp.delete_route(net30);
+    XLOG_ASSERT(et.expected_route_changes().empty());
+    XLOG_ASSERT(ct.lookup_route(IPv4("30.0.0.1")) == NULL);
+    XLOG_ASSERT(ct.lookup_route(IPv4("40.0.0.1")) == NULL);
+
+    printf("-------------------------------------------------------\n");
+
+    return 0;
+}
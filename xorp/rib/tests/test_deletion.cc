@@ -132,5 +132,54 @@ main(int /* argc */, char* argv[])
 
     printf("-------------------------------------------------------\n");
 
+    //
+    // Validate that after a restart with a grace period, routes that
+    // are added again unchanged cause no churn, changed routes are
+    // replaced, and routes that are not added again are deleted when
+    // the grace period ends.
+    //
+
+    IPv4Net net4("10.0.4.0/24");
+    IPRouteEntry<IPv4> route4(net4, &vif1, nh1.get_copy(), &protocol, 100);
+    IPRouteEntry<IPv4> route5(net2, &vif2, nh2.get_copy(), &protocol, 100);
+
+    dt.expect_add(route1);
+    dt.expect_add(route2);
+    dt.expect_add(route4);
+
+    ot.add_route(new IPRouteEntry<IPv4>(route1));
+    ot.add_route(new IPRouteEntry<IPv4>(route2));
+    ot.add_route(new IPRouteEntry<IPv4>(route4));
+
+    ot.routing_protocol_restart(TimeVal(0, 100000));
+    XLOG_ASSERT(ot.stale_route_count() == 3);
+    XLOG_ASSERT(dt.parent()->next_table()->type() == EXPECT_TABLE);
+
+    ot.add_route(new IPRouteEntry<IPv4>(route1));
+    XLOG_ASSERT(ot.stale_route_count() == 2);
+
+    dt.expect_delete(route2);
+    dt.expect_add(route5);
+    ot.add_route(new IPRouteEntry<IPv4>(route5));
+    XLOG_ASSERT(ot.stale_route_count() == 1);
+    XLOG_ASSERT(dt.expected_route_changes().empty());
+
+    dt.expect_delete(route4);
+    while (ot.stale_route_count() != 0)
+	eventloop.run();
+    while (dt.parent()->next_table()->type() != EXPECT_TABLE) {
+	XLOG_ASSERT(dt.parent()->next_table()->type() == DELETION_TABLE);
+	eventloop.run();
+    }
+    XLOG_ASSERT(dt.expected_route_changes().empty());
+    XLOG_ASSERT(ot.route_count() == 2);
+
+    dt.expect_delete(route1);
+    dt.expect_delete(route5);
+    ot.delete_route(net1);
+    ot.delete_route(net2);
+
+    printf("-------------------------------------------------------\n");
+
     return 0;
 }
@@ -95,6 +95,18 @@ public:
 	return XrlCmdError::OKAY();
     }
 
+    XrlCmdError rib_client_0_1_route_info_invalid4_batch(
+	// Input values,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens)
+    {
+	for (size_t i = 0; i < addrs.size(); i++) {
+	    rib_client_0_1_route_info_invalid4(addrs.get(i).ipv4(),
+					       prefix_lens.get(i).uint32());
+	}
+	return XrlCmdError::OKAY();
+    }
+
     XrlCmdError rib_client_0_1_route_info_invalid6(
 	// Input values,
         const IPv6&	/* addr */,
@@ -103,6 +115,14 @@ public:
 	return XrlCmdError::OKAY();
     }
 
+    XrlCmdError rib_client_0_1_route_info_invalid6_batch(
+	// Input values,
+	const XrlAtomList&	/* addrs */,
+	const XrlAtomList&	/* prefix_lens */)
+    {
+	return XrlCmdError::OKAY();
+    }
+
     bool verify_invalidated(const string& invalid);
     bool verify_changed(const string& changed);
     bool verify_no_info();
@@ -313,6 +333,92 @@ register_interest(XrlRibV0p1Client& client,
     return XORP_OK;
 }
 
+void
+register_batch_done(const XrlError& e,
+		    const XrlAtomList* resolves,
+		    const XrlAtomList* base_addrs,
+		    const XrlAtomList* prefix_lens,
+		    const XrlAtomList* /* real_prefix_lens */,
+		    const XrlAtomList* nexthops,
+		    const XrlAtomList* metrics,
+		    IPv4Net expected_net,
+		    IPv4 expected_nexthop,
+		    uint32_t expected_metric)
+{
+    XLOG_ASSERT(e == XrlCmdError::OKAY());
+
+    // The first address resolves, the second doesn't.
+    XLOG_ASSERT(resolves->size() == 2);
+    XLOG_ASSERT(resolves->get(0).uint32() == 1);
+    XLOG_ASSERT(resolves->get(1).uint32() == 0);
+
+    IPv4Net net(base_addrs->get(0).ipv4(), prefix_lens->get(0).uint32());
+    XLOG_ASSERT(net == expected_net);
+    XLOG_ASSERT(nexthops->get(0).ipv4() == expected_nexthop);
+    XLOG_ASSERT(metrics->get(0).uint32() == expected_metric);
+    xrl_done_flag = true;
+}
+
+int
+register_interest_batch(XrlRibV0p1Client& client,
+			EventLoop& loop,
+			const IPv4& resolvable,
+			const IPv4& unresolvable,
+			const IPv4Net& expected_net,
+			const IPv4& expected_nexthop,
+			uint32_t expected_metric)
+{
+    XrlAtomList addrs;
+    addrs.append(XrlAtom(resolvable));
+    addrs.append(XrlAtom(unresolvable));
+
+    client.send_register_interest4_batch("rib", "ribclient", addrs,
+					 callback(register_batch_done,
+						  expected_net,
+						  expected_nexthop,
+						  expected_metric));
+
+    xrl_done_flag = false;
+    while (xrl_done_flag == false) {
+	loop.run();
+    }
+    return XORP_OK;
+}
+
+void
+deregister_batch_done(const XrlError& e, const XrlAtomList* failed,
+		      uint32_t expected_failed)
+{
+    XLOG_ASSERT(e == XrlCmdError::OKAY());
+    XLOG_ASSERT(failed->size() == 1);
+    XLOG_ASSERT(failed->get(0).uint32() == expected_failed);
+    xrl_done_flag = true;
+}
+
+int
+deregister_interest_batch(XrlRibV0p1Client& client,
+			  EventLoop& loop,
+			  const IPv4Net& registered,
+			  const IPv4Net& unregistered)
+{
+    XrlAtomList addrs;
+    XrlAtomList prefix_lens;
+    addrs.append(XrlAtom(registered.masked_addr()));
+    prefix_lens.append(XrlAtom(registered.prefix_len()));
+    addrs.append(XrlAtom(unregistered.masked_addr()));
+    prefix_lens.append(XrlAtom(unregistered.prefix_len()));
+
+    client.send_deregister_interest4_batch("rib", "ribclient",
+					   addrs, prefix_lens,
+					   callback(deregister_batch_done,
+						    static_cast<uint32_t>(1)));
+
+    xrl_done_flag = false;
+    while (xrl_done_flag == false) {
+	loop.run();
+    }
+    return XORP_OK;
+}
 
 int
 main(int /* argc */, char* argv[])
@@ -414,6 +520,17 @@ main(int /* argc */, char* argv[])
     ribclienttarget.verify_invalidated("9.0.1.0/24");
     (void)ribclienttarget.verify_no_info();
 
+    printf("====================================================\n");
+
+    add_route(xc, eventloop, "ospf", IPv4Net("9.0.4.0/24"),
+	      IPv4("1.0.0.2"), 7);
+
+    register_interest_batch(xc, eventloop, IPv4("9.0.4.1"), IPv4("9.0.5.1"),
+			    IPv4Net("9.0.4.0/24"), IPv4("1.0.0.2"), 7);
+
+    deregister_interest_batch(xc, eventloop, IPv4Net("9.0.4.0/24"),
+			      IPv4Net("10.0.0.0/8"));
+
     //
     // Gracefully stop and exit xlog
     //
@@ -828,6 +828,77 @@ XrlRibTarget::rib_0_1_deregister_interest4(// Input values,
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlRibTarget::rib_0_1_register_interest4_batch(// Input values,
+					       const string& target,
+					       const XrlAtomList& addrs,
+					       // Output values,
+					       XrlAtomList& resolves,
+					       XrlAtomList& base_addrs,
+					       XrlAtomList& prefix_lens,
+					       XrlAtomList& real_prefix_lens,
+					       XrlAtomList& nexthops,
+					       XrlAtomList& metrics)
+{
+    for (size_t i = 0; i < addrs.size(); i++) {
+	const XrlAtom& atom = addrs.get(i);
+	if (atom.type() != xrlatom_ipv4)
+	    return XrlCmdError::BAD_ARGS("Element inside addrs isn't ipv4");
+
+	bool resolve = false;
+	IPv4 base_addr;
+	uint32_t prefix_len = 0;
+	uint32_t real_prefix_len = 0;
+	IPv4 nexthop;
+	uint32_t metric = 0;
+	XrlCmdError e = rib_0_1_register_interest4(target, atom.ipv4(),
+						   resolve, base_addr,
+						   prefix_len, real_prefix_len,
+						   nexthop, metric);
+	if (e != XrlCmdError::OKAY())
+	    return e;
+
+	resolves.append(XrlAtom(static_cast<uint32_t>(resolve ? 1 : 0)));
+	base_addrs.append(XrlAtom(base_addr));
+	prefix_lens.append(XrlAtom(prefix_len));
+	real_prefix_lens.append(XrlAtom(real_prefix_len));
+	nexthops.append(XrlAtom(nexthop));
+	metrics.append(XrlAtom(metric));
+    }
+    return XrlCmdError::OKAY();
+}
+
+XrlCmdError
+XrlRibTarget::rib_0_1_deregister_interest4_batch(// Input values,
+						 const string& target,
+						 const XrlAtomList& addrs,
+						 const XrlAtomList& prefix_lens,
+						 // Output values,
+						 XrlAtomList& failed)
+{
+    if (addrs.size() != prefix_lens.size()) {
+	string error_msg = c_format("Deregistration mismatch: %u address(es) "
+				    "and %u prefix length(s)",
+				    XORP_UINT_CAST(addrs.size()),
+				    XORP_UINT_CAST(prefix_lens.size()));
+	return XrlCmdError::BAD_ARGS(error_msg);
+    }
+
+    for (size_t i = 0; i < addrs.size(); i++) {
+	const XrlAtom& atom_addr = addrs.get(i);
+	const XrlAtom& atom_prefix_len = prefix_lens.get(i);
+	if (atom_addr.type() != xrlatom_ipv4
+	    || atom_prefix_len.type() != xrlatom_uint32) {
+	    return XrlCmdError::BAD_ARGS("Bad element type in deregistration");
+	}
+
+	IPv4Net net(atom_addr.ipv4(), atom_prefix_len.uint32());
+	if (_urib4.route_deregister(net, target) != XORP_OK)
+	    failed.append(XrlAtom(static_cast<uint32_t>(i)));
+    }
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlRibTarget::rib_0_1_get_protocol_admin_distances(
     // Input values,
@@ -1028,6 +1099,19 @@ XrlRibTarget::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlRibTarget::policy_backend_0_1_get_statistics(const uint32_t& filter,
+						string& statistics)
+{
+    try {
+	statistics = _rib_manager->filter_statistics(filter);
+    } catch(const PolicyException& e) {
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlRibTarget::rib_0_1_remove_policy_redist_tags(const string& protocol)
 {
@@ -1694,4 +1778,75 @@ XrlRibTarget::rib_0_1_deregister_interest6(// Input values,
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlRibTarget::rib_0_1_register_interest6_batch(// Input values,
+					       const string& target,
+					       const XrlAtomList& addrs,
+					       // Output values,
+					       XrlAtomList& resolves,
+					       XrlAtomList& base_addrs,
+					       XrlAtomList& prefix_lens,
+					       XrlAtomList& real_prefix_lens,
+					       XrlAtomList& nexthops,
+					       XrlAtomList& metrics)
+{
+    for (size_t i = 0; i < addrs.size(); i++) {
+	const XrlAtom& atom = addrs.get(i);
+	if (atom.type() != xrlatom_ipv6)
+	    return XrlCmdError::BAD_ARGS("Element inside addrs isn't ipv6");
+
+	bool resolve = false;
+	IPv6 base_addr;
+	uint32_t prefix_len = 0;
+	uint32_t real_prefix_len = 0;
+	IPv6 nexthop;
+	uint32_t metric = 0;
+	XrlCmdError e = rib_0_1_register_interest6(target, atom.ipv6(),
+						   resolve, base_addr,
+						   prefix_len, real_prefix_len,
+						   nexthop, metric);
+	if (e != XrlCmdError::OKAY())
+	    return e;
+
+	resolves.append(XrlAtom(static_cast<uint32_t>(resolve ? 1 : 0)));
+	base_addrs.append(XrlAtom(base_addr));
+	prefix_lens.append(XrlAtom(prefix_len));
+	real_prefix_lens.append(XrlAtom(real_prefix_len));
+	nexthops.append(XrlAtom(nexthop));
+	metrics.append(XrlAtom(metric));
+    }
+    return XrlCmdError::OKAY();
+}
+
+XrlCmdError
+XrlRibTarget::rib_0_1_deregister_interest6_batch(// Input values,
+						 const string& target,
+						 const XrlAtomList& addrs,
+						 const XrlAtomList& prefix_lens,
+						 // Output values,
+						 XrlAtomList& failed)
+{
+    if (addrs.size() != prefix_lens.size()) {
+	string error_msg = c_format("Deregistration mismatch: %u address(es) "
+				    "and %u prefix length(s)",
+				    XORP_UINT_CAST(addrs.size()),
+				    XORP_UINT_CAST(prefix_lens.size()));
+	return XrlCmdError::BAD_ARGS(error_msg);
+    }
+
+    for (size_t i = 0; i < addrs.size(); i++) {
+	const XrlAtom& atom_addr = addrs.get(i);
+	const XrlAtom& atom_prefix_len = prefix_lens.get(i);
+	if (atom_addr.type() != xrlatom_ipv6
+	    || atom_prefix_len.type() != xrlatom_uint32) {
+	    return XrlCmdError::BAD_ARGS("Bad element type in deregistration");
+	}
+
+	IPv6Net net(atom_addr.ipv6(), atom_prefix_len.uint32());
+	if (_urib6.route_deregister(net, target) != XORP_OK)
+	    failed.append(XrlAtom(static_cast<uint32_t>(i)));
+    }
+    return XrlCmdError::OKAY();
+}
+
 #endif //ipv6
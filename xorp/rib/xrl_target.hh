@@ -546,6 +546,37 @@ protected:
 	const IPv4&	addr,
 	const uint32_t&	prefix_len);
 
+    /**
+     *  Register interest in several addresses at once.
+     *
+     *  @see rib_0_1_register_interest4
+     */
+    XrlCmdError rib_0_1_register_interest4_batch(
+	// Input values,
+	const string&	target,
+	const XrlAtomList&	addrs,
+	// Output values,
+	XrlAtomList&	resolves,
+	XrlAtomList&	base_addrs,
+	XrlAtomList&	prefix_lens,
+	XrlAtomList&	real_prefix_lens,
+	XrlAtomList&	nexthops,
+	XrlAtomList&	metrics);
+
+    /**
+     *  De-register several interests at once.
+     *
+     *  @param failed the indices of the registrations that were not found.
+     *  @see rib_0_1_deregister_interest4
+     */
+    XrlCmdError rib_0_1_deregister_interest4_batch(
+	// Input values,
+	const string&	target,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens,
+	// Output values,
+	XrlAtomList&	failed);
+
     /**
      *  Get the configured admin distances from a selected RIB
      *  for all routing protocols configured with one.
@@ -644,6 +675,18 @@ protected:
      */
     XrlCmdError policy_backend_0_1_push_routes();
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter id of filter to report on.
+     * @param statistics human readable statistics of the filter.
+     */
+    XrlCmdError policy_backend_0_1_get_statistics(
+        // Input values,
+        const uint32_t& filter,
+        // Output values,
+        string&         statistics);
+
     /**
      * Remove protocol's redistribution tags
      */
@@ -942,6 +985,37 @@ protected:
 	const IPv6&	addr,
 	const uint32_t&	prefix_len);
 
+    /**
+     *  Register interest in several addresses at once.
+     *
+     *  @see rib_0_1_register_interest6
+     */
+    XrlCmdError rib_0_1_register_interest6_batch(
+	// Input values,
+	const string&	target,
+	const XrlAtomList&	addrs,
+	// Output values,
+	XrlAtomList&	resolves,
+	XrlAtomList&	base_addrs,
+	XrlAtomList&	prefix_lens,
+	XrlAtomList&	real_prefix_lens,
+	XrlAtomList&	nexthops,
+	XrlAtomList&	metrics);
+
+    /**
+     *  De-register several interests at once.
+     *
+     *  @param failed the indices of the registrations that were not found.
+     *  @see rib_0_1_deregister_interest6
+     */
+    XrlCmdError rib_0_1_deregister_interest6_batch(
+	// Input values,
+	const string&	target,
+	const XrlAtomList&	addrs,
+	const XrlAtomList&	prefix_lens,
+	// Output values,
+	XrlAtomList&	failed);
+
 #endif //ipv6
 
 #ifndef XORP_DISABLE_PROFILE
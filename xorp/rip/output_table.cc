@@ -27,10 +27,82 @@
 #include "packet_queue.hh"
 #include "route_db.hh"
 
+/**
+ * Packets built earlier can only be sent as they are if the authentication
+ * handler leaves the same room for routes.
+ */
+template <typename A>
+static uint32_t cache_layout(Port<A>& port);
+
+template <>
+uint32_t
+cache_layout(Port<IPv4>& port)
+{
+    const AuthHandlerBase* ah = port.af_state().auth_handler();
+
+    return (ah->head_entries() << 16) | ah->max_routing_entries();
+}
+
+template <>
+uint32_t
+cache_layout(Port<IPv6>& /* port */)
+{
+    return 0;
+}
+
+template <typename A>
+OutputTable<A>::OutputTable(EventLoop&		e,
+			    Port<A>&		port,
+			    PacketQueue<A>&	pkt_queue,
+			    RouteDB<A>&		rdb,
+			    const A&		ip_addr,
+			    uint16_t		ip_port,
+			    bool		cached)
+    : OutputBase<A>(e, port, pkt_queue, ip_addr, ip_port),
+      _rw(rdb), _rw_valid(false),
+      _cached(cached), _rdb(rdb), _uq(rdb.update_queue()),
+      _pending_pos(0), _cache_pos(0), _cache_routes(0), _slot_routes(0),
+      _cache_built(false),
+      _cache_layout(0), _cache_horizon(NONE), _cache_adv_def_rt(false)
+{
+    if (_cached)
+	_uq_iter = _uq.create_reader();
+}
+
+template <typename A>
+OutputTable<A>::~OutputTable()
+{
+    flush_cache();
+    _uq.destroy_reader(_uq_iter);
+}
+
+template <typename A>
+void
+OutputTable<A>::send_packets(list<RipPacket<A>*>& auth_packets)
+{
+    typename list<RipPacket<A>*>::iterator iter;
+    for (iter = auth_packets.begin(); iter != auth_packets.end(); ++iter) {
+	RipPacket<A>* auth_pkt = *iter;
+	this->_pkt_queue.enqueue_packet(auth_pkt);
+	if (this->ip_port() == RIP_AF_CONSTANTS<A>::IP_PORT) {
+	    this->_port.counters().incr_unsolicited_updates();
+	} else {
+	    this->_port.counters().incr_non_rip_updates_sent();
+	}
+	this->incr_packets_sent();
+    }
+    this->_port.push_packets();
+}
+
 template <typename A>
 void
 OutputTable<A>::output_packet()
 {
+    if (_cached) {
+	output_cached_packet();
+	return;
+    }
+
     if (_rw_valid == false) {
 	_rw.reset();
 	_rw_valid = true;
@@ -89,18 +161,7 @@ OutputTable<A>::output_packet()
     if (done == 0 || rpa.packet_finish(auth_packets) == false) {
 	// No routes added to packet or error finishing packet off.
     } else {
-	typename list<RipPacket<A>*>::iterator iter;
-	for (iter = auth_packets.begin(); iter != auth_packets.end(); ++iter) {
-	    RipPacket<A>* auth_pkt = *iter;
-	    this->_pkt_queue.enqueue_packet(auth_pkt);
-	    if (this->ip_port() == RIP_AF_CONSTANTS<A>::IP_PORT) {
-		this->_port.counters().incr_unsolicited_updates();
-	    } else {
-		this->_port.counters().incr_non_rip_updates_sent();
-	    }
-	    this->incr_packets_sent();
-	}
-	this->_port.push_packets();
+	send_packets(auth_packets);
     }
     delete pkt;
 
@@ -121,6 +182,9 @@ template <typename A>
 void
 OutputTable<A>::start_output_processing()
 {
+    if (_cached)
+	start_cached_dump();
+
     output_packet();		// starts timer
 }
 
@@ -132,6 +196,226 @@ OutputTable<A>::stop_output_processing()
 }
 
 
+template <typename A>
+bool
+OutputTable<A>::cache_valid() const
+{
+    if (_cache_built == false)
+	return false;
+
+    if (_cache_layout != cache_layout(this->_port)
+	|| _cache_horizon != this->_port.horizon()
+	|| _cache_adv_def_rt != this->_port.advertise_default_route())
+	return false;
+
+    // Routes come and go: start again when they would fit in a lot fewer
+    // packets.
+    if (_slot_routes != 0
+	&& 3 * _cache.size() > 4 * (_cache_routes / _slot_routes + 1))
+	return false;
+
+    return true;
+}
+
+template <typename A>
+void
+OutputTable<A>::flush_cache()
+{
+    for (size_t i = 0; i < _cache.size(); i++)
+	delete _cache[i].pkt;
+
+    _cache.clear();
+    _cache_slot.clear();
+    _cache_new.clear();
+    _cache_pending.clear();
+    _pending_pos = 0;
+    _cache_pos = 0;
+    _cache_routes = 0;
+    _slot_routes = 0;
+}
+
+template <typename A>
+void
+OutputTable<A>::start_cached_dump()
+{
+    // Routes of an interrupted dump that did not get a packet yet.
+    if (_pending_pos < _cache_pending.size()) {
+	_cache_new.insert(_cache_pending.begin() + _pending_pos,
+			  _cache_pending.end());
+    }
+    _cache_pending.clear();
+    _pending_pos = 0;
+    _cache_pos = 0;
+
+    if (cache_valid() == false) {
+	flush_cache();
+
+	_cache_built = true;
+	_cache_layout = cache_layout(this->_port);
+	_cache_horizon = this->_port.horizon();
+	_cache_adv_def_rt = this->_port.advertise_default_route();
+
+	// Start from the table as it is now.
+	_uq.ffwd(_uq_iter);
+
+	vector<typename RouteDB<A>::ConstDBRouteEntry> routes;
+	_rdb.dump_routes(routes);
+
+	_cache_pending.reserve(routes.size());
+	for (size_t i = 0; i < routes.size(); i++)
+	    _cache_pending.push_back(routes[i]->net());
+
+	return;
+    }
+
+    const RouteEntry<A>* r;
+    for (r = _uq.get(_uq_iter); r != 0; r = _uq.next(_uq_iter)) {
+	typename CacheSlots::const_iterator i = _cache_slot.find(r->net());
+
+	if (i == _cache_slot.end())
+	    _cache_new.insert(r->net());
+	else
+	    _cache[i->second].dirty = true;
+    }
+
+    //
+    // Routes are deleted from the table without an update once their
+    // deletion timer expires.
+    //
+    for (size_t i = 0; i < _cache.size(); i++) {
+	if (_cache[i].dying)
+	    _cache[i].dirty = true;
+    }
+}
+
+template <typename A>
+size_t
+OutputTable<A>::encode_packet(uint32_t slot, const vector<Net>& nets, size_t n)
+{
+    CachedPacket& cp = _cache[slot];
+
+    _cache_routes -= cp.routes;
+    delete cp.pkt;
+    cp.pkt = 0;
+    cp.routes = 0;
+    cp.dying = 0;
+    cp.dirty = false;
+
+    ResponsePacketAssembler<A> rpa(this->_port);
+    RipPacket<A>* pkt = new RipPacket<A>(this->ip_addr(), this->ip_port());
+    rpa.packet_start(pkt);
+
+    for ( ; n < nets.size(); n++) {
+	const Net& net = nets[n];
+	const RouteEntry<A>* r = _rdb.find_route(net);
+
+	if (r == 0 || r->filtered()) {
+	    _cache_slot.erase(net);
+	    continue;
+	}
+
+	if (rpa.packet_full())
+	    break;
+
+	pair<A,uint16_t> p = this->_port.route_policy(*r);
+
+	//
+	// Routes the port does not advertise stay with the packet, so that
+	// it is built again if they change.
+	//
+	if (p.second <= RIP_INFINITY) {
+	    if (rpa.packet_add_route(net, p.first, p.second, r->tag())
+		== false)
+		break;
+	    cp.routes++;
+	}
+
+	_cache_slot[net] = slot;
+	cp.nets.push_back(net);
+	if (r->cost() == RIP_INFINITY)
+	    cp.dying++;
+    }
+
+    if (n < nets.size() && cp.routes > _slot_routes)
+	_slot_routes = cp.routes;
+
+    if (cp.routes == 0) {
+	delete pkt;
+    } else {
+	rpa.packet_close();
+	cp.pkt = pkt;
+	_cache_routes += cp.routes;
+    }
+
+    return n;
+}
+
+template <typename A>
+void
+OutputTable<A>::rebuild_packet(uint32_t slot)
+{
+    vector<Net> nets;
+    nets.swap(_cache[slot].nets);
+
+    size_t n = encode_packet(slot, nets, 0);
+
+    // Whatever no longer fits goes to a new packet at the end of the dump.
+    for ( ; n < nets.size(); n++) {
+	_cache_slot.erase(nets[n]);
+	_cache_new.insert(nets[n]);
+    }
+}
+
+template <typename A>
+void
+OutputTable<A>::output_cached_packet()
+{
+    const RipPacket<A>* pkt = 0;
+
+    while (pkt == 0) {
+	if (_cache_pos < _cache.size()) {
+	    uint32_t slot = _cache_pos++;
+
+	    if (_cache[slot].dirty)
+		rebuild_packet(slot);
+	    pkt = _cache[slot].pkt;
+	    continue;
+	}
+
+	if (_pending_pos == _cache_pending.size()) {
+	    _cache_pending.clear();
+	    _pending_pos = 0;
+
+	    if (_cache_new.empty())
+		return;		// Done, do not reschedule
+
+	    _cache_pending.insert(_cache_pending.end(),
+				  _cache_new.begin(), _cache_new.end());
+	    _cache_new.clear();
+	}
+
+	// Routes with no packet yet fill new packets.
+	_cache.push_back(CachedPacket());
+	_cache_pos = _cache.size();
+	_pending_pos = encode_packet(_cache_pos - 1, _cache_pending,
+				     _pending_pos);
+	pkt = _cache.back().pkt;
+	if (_cache.back().nets.empty()) {
+	    _cache.pop_back();
+	    _cache_pos--;
+	}
+    }
+
+    ResponsePacketAssembler<A> rpa(this->_port);
+    list<RipPacket<A>*> auth_packets;
+    if (rpa.packet_authenticate(*pkt, auth_packets))
+	send_packets(auth_packets);
+
+    this->_op_timer
+	= this->_e.new_oneoff_after_ms(this->interpacket_gap_ms(),
+			callback(this, &OutputTable<A>::output_packet));
+}
+
 // ----------------------------------------------------------------------------
 // Instantiations
 
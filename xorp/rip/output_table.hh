@@ -26,7 +26,9 @@
 #include "libxorp/xlog.h"
 
 #include "output.hh"
+#include "packets.hh"
 #include "route_db.hh"
+#include "update_queue.hh"
 
 /**
  * @short Route Table Output class.
@@ -34,6 +36,10 @@
  * The OutputTable class produces an asynchronous RIP table dump. It's
  * intended use is for solicited and unsolicited routing table.
  *
+ * A table which is dumped periodically can keep the packets it sends.
+ * The packets are then only encoded again when routes they hold appear on
+ * the update queue, and the next dump replays the others as they are.
+ *
  * Specialized implementations exist for IPv4 and IPv6.
  * Non-copyable due to inheritance from OutputBase<A>.
  */
@@ -41,16 +47,19 @@ template <typename A>
 class OutputTable :
     public OutputBase<A>
 {
+public:
+    typedef IPNet<A>	Net;
+
 public:
     OutputTable(EventLoop&	e,
 		Port<A>&	port,
 		PacketQueue<A>&	pkt_queue,
 		RouteDB<A>&	rdb,
 		const A&	ip_addr = RIP_AF_CONSTANTS<A>::IP_GROUP(),
-		uint16_t	ip_port = RIP_AF_CONSTANTS<A>::IP_PORT)
-	: OutputBase<A>(e, port, pkt_queue, ip_addr, ip_port),
-	  _rw(rdb), _rw_valid(false)
-    {}
+		uint16_t	ip_port = RIP_AF_CONSTANTS<A>::IP_PORT,
+		bool		cached = false);
+
+    ~OutputTable();
 
 protected:
     void output_packet();
@@ -58,8 +67,52 @@ protected:
     void stop_output_processing();
 
 private:
+    /**
+     * A packet of the table, as encoded when last built.
+     */
+    struct CachedPacket {
+	CachedPacket() : pkt(0), routes(0), dying(0), dirty(true) {}
+
+	vector<Net>	nets;	// Routes the packet is responsible for
+	RipPacket<A>*	pkt;	// Packet, not authenticated (0 if empty)
+	uint32_t	routes;	// Routes advertised in packet
+	uint32_t	dying;	// Routes at infinity, deleted without update
+	bool		dirty;	// Packet must be built again before use
+    };
+
+    typedef map<Net, uint32_t, NetCmp<A> > CacheSlots;
+
+    void output_cached_packet();
+    void start_cached_dump();
+    bool cache_valid() const;
+    void flush_cache();
+    void rebuild_packet(uint32_t slot);
+    size_t encode_packet(uint32_t slot, const vector<Net>& nets, size_t n);
+    void send_packets(list<RipPacket<A>*>& auth_packets);
+
     RouteWalker<A>	_rw;		// RouteWalker
     bool		_rw_valid;	// RouteWalker is valid (no reset req).
+
+    const bool		_cached;	// Keep packets between dumps
+    RouteDB<A>&		_rdb;
+    UpdateQueue<A>&	_uq;
+    typename UpdateQueue<A>::ReadIterator _uq_iter;
+
+    vector<CachedPacket> _cache;	// Packets in order of output
+    CacheSlots		_cache_slot;	// Packet each route is in
+    set<Net>		_cache_new;	// Routes not in any packet yet
+    vector<Net>		_cache_pending;	// ... being added in this dump
+    size_t		_pending_pos;	// Next pending route
+    size_t		_cache_pos;	// Next packet of this dump
+    uint32_t		_cache_routes;	// Routes advertised in all packets
+    uint32_t		_slot_routes;	// Most routes seen in full packet
+
+    bool		_cache_built;	// Packets built from the RouteDB once
+
+    // Port state the packets were built with.
+    uint32_t		_cache_layout;
+    RipHorizon		_cache_horizon;
+    bool		_cache_adv_def_rt;
 };
 
 #endif // __RIP_OUTPUT_TABLE_HH__
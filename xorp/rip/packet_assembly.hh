@@ -202,6 +202,23 @@ public:
      */
     bool packet_finish(list<RipPacket<A>* >& auth_packets);
 
+    /**
+     * Finish packet without authenticating it.  The packet can then be
+     * kept and sent any number of times with @ref packet_authenticate.
+     */
+    void packet_close();
+
+    /**
+     * Authenticate a copy of a packet finished with @ref packet_close.
+     *
+     * @param pkt the packet, which is not modified.
+     * @param auth_packets a return-by-reference list with the
+     * authenticated RIP packets (one copy for each valid authentication key).
+     * @return true on success, false if a failure is detected.
+     */
+    bool packet_authenticate(const RipPacket<A>&	pkt,
+			     list<RipPacket<A>* >&	auth_packets);
+
 private:
     /**
      * Copy Constructor (Disabled).
@@ -331,6 +348,32 @@ ResponsePacketAssembler<IPv4>::packet_finish(
     return true;
 }
 
+template <>
+inline void
+ResponsePacketAssembler<IPv4>::packet_close()
+{
+    _pkt->set_max_entries(_pos);
+}
+
+template <>
+inline bool
+ResponsePacketAssembler<IPv4>::packet_authenticate(
+    const RipPacket<IPv4>&	pkt,
+    list<RipPacket<IPv4>* >&	auth_packets)
+{
+    AuthHandlerBase& ah = _sp_state.ah();
+
+    // The handler authenticates the packet it is given as well.
+    RipPacket<IPv4> copy(pkt);
+    size_t n_routes = 0;
+    if ((ah.authenticate_outbound(copy, auth_packets, n_routes) != true)
+	|| (n_routes == 0)) {
+	XLOG_ERROR("Outbound authentication error: %s\n", ah.error().c_str());
+	return false;
+    }
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // ResponsePacketAssembler<IPv6> implementation
 
@@ -411,6 +454,25 @@ ResponsePacketAssembler<IPv6>::packet_finish(
     return true;
 }
 
+template <>
+inline void
+ResponsePacketAssembler<IPv6>::packet_close()
+{
+    _pkt->set_max_entries(_pos);
+}
+
+template <>
+inline bool
+ResponsePacketAssembler<IPv6>::packet_authenticate(
+    const RipPacket<IPv6>&	pkt,
+    list<RipPacket<IPv6>* >&	auth_packets)
+{
+    RipPacket<IPv6>* packet = new RipPacket<IPv6>(pkt);
+    auth_packets.push_back(packet);
+
+    return true;
+}
+
 
 // ----------------------------------------------------------------------------
 // RequestTablePacketAssembler<IPv4> implementation
@@ -42,6 +42,8 @@ Peer<A>::Peer(RipPort& p, const Addr& addr)
     : RouteEntryOrigin<A>(false), _port(p), _addr(addr),
       _peer_routes(*this)
 {
+    _expiry_cb = callback(this, &Peer<A>::expire_route);
+
     RouteDB<A>& rdb = _port.port_manager().system().route_db();
     rdb.insert_peer(this);
 }
@@ -125,15 +127,13 @@ template <typename A>
 void
 Peer<A>::set_expiry_timer(Route* route)
 {
-    XorpTimer t;
     uint32_t secs = expiry_secs();
     EventLoop& eventloop = _port.port_manager().eventloop();
 
-    if (secs) {
-        t = eventloop.new_oneoff_after_ms(secs * 1000,
-					  callback(this, &Peer<A>::expire_route, route));
-    }
-    route->set_timer(t);
+    if (secs)
+	_peer_routes.schedule_timeout(route, eventloop, secs, _expiry_cb);
+    else
+	_peer_routes.unschedule_timeout(route);
 }
 
 template <typename A>
@@ -226,6 +226,7 @@ protected:
     PeerCounters	_counters;
     TimeVal		_last_active;
     PeerRoutes<A>	_peer_routes;
+    typename Route::TimeoutCallback _expiry_cb;
 };
 
 
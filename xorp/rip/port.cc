@@ -251,7 +251,9 @@ Port<A>::start_output_processing()
 				    &Port<A>::unsolicited_response_timeout));
 
     // Create unsolicited response (table dump) output process
-    _ur_out = new OutputTable<A>(e, *this, *_packet_queue, rdb);
+    _ur_out = new OutputTable<A>(e, *this, *_packet_queue, rdb,
+				 RIP_AF_CONSTANTS<A>::IP_GROUP(),
+				 RIP_AF_CONSTANTS<A>::IP_PORT, true);
 
     // Schedule unsolicited output process
     TimeVal delay = TimeVal(constants().triggered_update_delay(), 0);
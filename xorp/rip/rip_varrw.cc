@@ -40,7 +40,8 @@ RIPVarRW<A>::start_read()
 
     read_route_nexthop(_route);
 
-    initialize(VAR_METRIC, new ElemU32(_route.cost()));
+    _metric_elem.set_val(_route.cost());
+    initialize_typed(VAR_METRIC, _metric_elem);
 
     // XXX which tag wins?
     Element* element = _route.policytags().element_tag();
@@ -50,7 +51,8 @@ RIPVarRW<A>::start_read()
 
     delete element;
 
-    initialize(VAR_TAG, new ElemU32(_route.tag()));
+    _tag_elem.set_val(_route.tag());
+    initialize_typed(VAR_TAG, _tag_elem);
 }
 
 template <class A>
@@ -118,8 +120,11 @@ template <>
 void
 RIPVarRW<IPv4>::read_route_nexthop(RouteEntry<IPv4>& route)
 {
-    initialize(VAR_NETWORK4, new ElemIPv4Net(route.net()));
-    initialize(VAR_NEXTHOP4, new ElemIPv4NextHop(route.nexthop()));
+    _network_elem.set_val(route.net());
+    _nexthop_elem.set_val(route.nexthop());
+
+    initialize_typed(VAR_NETWORK4, _network_elem);
+    initialize_typed(VAR_NEXTHOP4, _nexthop_elem);
     
     initialize(VAR_NETWORK6, NULL);
     initialize(VAR_NEXTHOP6, NULL);
@@ -150,8 +155,11 @@ template <>
 void
 RIPVarRW<IPv6>::read_route_nexthop(RouteEntry<IPv6>& route)
 {
-    initialize(VAR_NETWORK6, new ElemIPv6Net(route.net()));
-    initialize(VAR_NEXTHOP6, new ElemIPv6NextHop(route.nexthop()));
+    _network_elem.set_val(route.net());
+    _nexthop_elem.set_val(route.nexthop());
+
+    initialize_typed(VAR_NETWORK6, _network_elem);
+    initialize_typed(VAR_NEXTHOP6, _nexthop_elem);
     
     initialize(VAR_NETWORK4, NULL);
     initialize(VAR_NEXTHOP4, NULL);
@@ -68,6 +68,12 @@ private:
     bool write_nexthop(const Id& id, const Element& e);
 
     RouteEntry<A>&	_route;
+
+    // Values read from the route
+    ElemNet<IPNet<A> >	_network_elem;
+    ElemNextHop<A>	_nexthop_elem;
+    ElemU32		_metric_elem;
+    ElemU32		_tag_elem;
 };
 
 #endif // __RIP_RIP_VARRW_HH__
@@ -65,6 +65,8 @@ RouteDB<A>::RouteDB(EventLoop& e, PolicyFilters& pfs)
       _policy_filters(pfs)
 {
     _uq = new UpdateQueue<A>();
+    _expiry_cb = callback(this, &RouteDB<A>::expire_route);
+    _deletion_cb = callback(this, &RouteDB<A>::delete_route);
 }
 
 template <typename A>
@@ -149,12 +151,8 @@ void
 RouteDB<A>::set_deletion_timer(Route* r)
 {
     RouteOrigin* o = r->origin();
-    uint32_t deletion_ms = o->deletion_secs() * 1000;
 
-    XorpTimer t = _eventloop.new_oneoff_after_ms(deletion_ms,
-				callback(this, &RouteDB<A>::delete_route, r));
-
-    r->set_timer(t);
+    o->schedule_timeout(r, _eventloop, o->deletion_secs(), _deletion_cb);
 }
 
 template <typename A>
@@ -172,15 +170,13 @@ template <typename A>
 void
 RouteDB<A>::set_expiry_timer(Route* r)
 {
-    XorpTimer t;
     RouteOrigin* o = r->origin();
     uint32_t expiry_secs = o->expiry_secs();
 
-    if (expiry_secs) {
-	t = _eventloop.new_oneoff_after_ms(expiry_secs * 1000,
-			   callback(this, &RouteDB<A>::expire_route, r));
-    }
-    r->set_timer(t);
+    if (expiry_secs)
+	o->schedule_timeout(r, _eventloop, expiry_secs, _expiry_cb);
+    else
+	o->unschedule_timeout(r);
 }
 
 template <typename A>
@@ -334,7 +330,7 @@ RouteDB<A>::update_route(const Net&		net,
 	delete new_route;
 
 	if (cost == RIP_INFINITY) {
-	    if ((orig_cost == RIP_INFINITY) && r->timer().scheduled()) {
+	    if ((orig_cost == RIP_INFINITY) && r->timeout_scheduled()) {
 		//
 		// XXX: The deletion process is started only when the
 		// metric is set the first time to infinity.
@@ -431,9 +427,11 @@ RouteDB<A>::update_route(const Net&		net,
 	    if (expiry_timeval == TimeVal::ZERO())
 		break;		// XXX: the old route would never expire
 
-	    TimeVal remain;
-	    if (r->timer().time_remaining(remain) != true)
+	    if (! r->timeout_scheduled())
 		break;		// XXX: couldn't get the remaining time
+	    TimeVal remain;
+	    _eventloop.current_time(remain);
+	    remain = r->timeout() - remain;
 	    if (remain < (expiry_timeval / 2)) {
 		should_replace = true;
 		break;
@@ -587,15 +585,11 @@ RouteWalker<A>::pause(uint32_t pause_ms)
     // point to resume from.  We're advertising the route at infinity
     // so advertising it once past it's original expiry is no big deal
 
-    XorpTimer t = _pos->second->timer();
-    if (t.scheduled() && _pos->second->cost() == RIP_INFINITY) {
+    if (_pos->second->cost() == RIP_INFINITY) {
 	TimeVal next_run;
 	_route_db.eventloop().current_time(next_run);
 	next_run += TimeVal(0, 1000 * pause_ms * 2); // factor of 2 == slack
-	if (t.expiry() <= next_run) {
-	    t.schedule_at(next_run);
-	    _pos->second->set_timer(t);
-	}
+	_pos->second->postpone_timeout(next_run);
     }
     _last_visited = _pos->second->net();
 }
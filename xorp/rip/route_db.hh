@@ -222,6 +222,8 @@ protected:
 
 protected:
     EventLoop&		_eventloop;
+    typename Route::TimeoutCallback _expiry_cb;
+    typename Route::TimeoutCallback _deletion_cb;
     RouteContainer	_routes;
     UpdateQueue<A>*	_uq;
     PolicyFilters&	_policy_filters;
@@ -57,7 +57,8 @@ RouteEntry<A>::RouteEntry(const Net&	n,
 			  Origin*&	o,
 			  uint16_t	tag)
     : _net(n), _nh(nh), _ifname(ifname), _vifname(vifname),
-      _cost(cost), _tag(tag), _ref_cnt(0), _filtered(false)
+      _cost(cost), _tag(tag), _ref_cnt(0), _timeout_bucket(0),
+      _filtered(false)
 {
     associate(o);
 }
@@ -72,8 +73,8 @@ RouteEntry<A>::RouteEntry(const Net&		n,
 			  uint16_t		tag,
 			  const PolicyTags&	policytags)
     : _net(n), _nh(nh), _ifname(ifname), _vifname(vifname),
-      _cost(cost), _tag(tag), _ref_cnt(0), _policytags(policytags),
-      _filtered(false)
+      _cost(cost), _tag(tag), _ref_cnt(0), _timeout_bucket(0),
+      _policytags(policytags), _filtered(false)
 {
     associate(o);
 }
@@ -191,6 +192,15 @@ RouteEntry<A>::set_policytags(const PolicyTags& ptags)
     return false;
 }
 
+template <typename A>
+void
+RouteEntry<A>::postpone_timeout(const TimeVal& t)
+{
+    // The route stays in its bucket, the sweep moves it on if need be.
+    if (timeout_scheduled() && _timeout < t)
+	_timeout = t;
+}
+
 
 /**
  * A comparitor for the purposes of sorting containers of RouteEntry objects.
@@ -229,6 +239,15 @@ struct RouteEntryOrigin<A>::RouteEntryStore {
 public:
     typedef map<IPNet<A>, RouteEntry<A>*, NetCmp<A> > Container;
     Container routes;
+
+    // Routes due to time out, by the second at which their bucket is
+    // swept.  Routes are never swept before their timeout.
+    typedef map<int32_t, set<RouteEntry<A>*> > Timeouts;
+    Timeouts	timeouts;
+    EventLoop*	eventloop;
+    XorpTimer	sweep_timer;
+
+    RouteEntryStore() : eventloop(0) {}
 };
 
 
@@ -276,6 +295,9 @@ RouteEntryOrigin<A>::dissociate(Route* r)
 	return false;
     }
     _rtstore->routes.erase(i);
+
+    unqueue_timeout(r);
+    r->_timeout_cb.release();
     return true;
 }
 
@@ -325,6 +347,122 @@ RouteEntryOrigin<A>::find_route(const Net& n) const
     return i->second;
 }
 
+template <typename A>
+void
+RouteEntryOrigin<A>::schedule_timeout(Route* r, EventLoop& e, uint32_t secs,
+				      const TimeoutCallback& cb)
+{
+    XLOG_ASSERT(r->origin() == this);
+
+    TimeVal now;
+    e.current_time(now);
+
+    _rtstore->eventloop = &e;
+    r->_timeout = now + TimeVal(secs, 0);
+    r->_timeout_cb = cb;
+
+    // A route that is already in a bucket that is not later than the new
+    // timeout is left there: the sweep of the bucket requeues it.
+    if (r->_timeout_bucket != 0
+	&& r->_timeout_bucket <= r->_timeout.sec() + 1)
+	return;
+
+    unqueue_timeout(r);
+    queue_timeout(r);
+}
+
+template <typename A>
+void
+RouteEntryOrigin<A>::unschedule_timeout(Route* r)
+{
+    XLOG_ASSERT(r->origin() == this);
+
+    unqueue_timeout(r);
+    r->_timeout_cb.release();
+}
+
+template <typename A>
+void
+RouteEntryOrigin<A>::queue_timeout(Route* r)
+{
+    XLOG_ASSERT(r->_timeout_bucket == 0);
+    XLOG_ASSERT(_rtstore->eventloop != 0);
+
+    int32_t bucket = r->_timeout.sec() + 1;
+
+    _rtstore->timeouts[bucket].insert(r);
+    r->_timeout_bucket = bucket;
+
+    if (_rtstore->timeouts.begin()->first != bucket)
+	return;
+
+    XorpTimer& t = _rtstore->sweep_timer;
+    TimeVal when(bucket, 0);
+
+    if (t.scheduled() && t.expiry() <= when)
+	return;
+
+    t = _rtstore->eventloop->new_oneoff_at(when,
+		callback(this, &RouteEntryOrigin<A>::sweep_timeouts));
+}
+
+template <typename A>
+void
+RouteEntryOrigin<A>::unqueue_timeout(Route* r)
+{
+    if (r->_timeout_bucket == 0)
+	return;
+
+    typename RouteEntryStore::Timeouts::iterator
+	i = _rtstore->timeouts.find(r->_timeout_bucket);
+    XLOG_ASSERT(i != _rtstore->timeouts.end());
+
+    i->second.erase(r);
+    if (i->second.empty())
+	_rtstore->timeouts.erase(i);
+    r->_timeout_bucket = 0;
+
+    // An early sweep timer is harmless, it finds nothing to do.
+    if (_rtstore->timeouts.empty())
+	_rtstore->sweep_timer.unschedule();
+}
+
+template <typename A>
+void
+RouteEntryOrigin<A>::sweep_timeouts()
+{
+    typename RouteEntryStore::Timeouts& timeouts = _rtstore->timeouts;
+    TimeVal now;
+    _rtstore->eventloop->current_time(now);
+
+    //
+    // The timeout callbacks may delete routes, and schedule or cancel the
+    // timeouts of others, so the first bucket is looked up afresh each
+    // time round.
+    //
+    while (! timeouts.empty() && TimeVal(timeouts.begin()->first, 0) <= now) {
+	Route* r = *timeouts.begin()->second.begin();
+
+	unqueue_timeout(r);
+	if (now < r->_timeout) {
+	    // Refreshed since it was queued
+	    queue_timeout(r);
+	    continue;
+	}
+
+	TimeoutCallback cb = r->_timeout_cb;
+	r->_timeout_cb.release();
+	cb->dispatch(r);
+    }
+
+    if (timeouts.empty())
+	return;
+
+    _rtstore->sweep_timer = _rtstore->eventloop->new_oneoff_at(
+		TimeVal(timeouts.begin()->first, 0),
+		callback(this, &RouteEntryOrigin<A>::sweep_timeouts));
+}
+
 
 // ----------------------------------------------------------------------------
 // Instantiations
@@ -24,7 +24,7 @@
 
 #include "libxorp/xorp.h"
 #include "libxorp/ipnet.hh"
-#include "libxorp/timer.hh"
+#include "libxorp/eventloop.hh"
 #include "policy/backend/policytags.hh"
 
 template<typename A> class RouteEntryOrigin;
@@ -45,6 +45,8 @@ public:
     typedef A Addr;
     typedef IPNet<A> Net;
     typedef RouteEntryOrigin<A> Origin;
+    typedef typename XorpCallback1<void, RouteEntry<A>*>::RefPtr
+							TimeoutCallback;
 
 public:
     /**
@@ -188,14 +190,22 @@ public:
     uint16_t tag() const 		{ return _tag; }
 
     /**
-     * Set a Timer Event associated with this route.
+     * @return true if the route is due to time out.  Timeouts are
+     * scheduled with @ref RouteEntryOrigin::schedule_timeout.
      */
-    void set_timer(const XorpTimer& t) 	{ _timer = t; }
+    bool timeout_scheduled() const	{ return !_timeout_cb.is_empty(); }
 
     /**
-     * Get Timer associated with route.
+     * @return time at which the route times out, if it is due to.
      */
-    const XorpTimer& timer() const 	{ return _timer; }
+    const TimeVal& timeout() const	{ return _timeout; }
+
+    /**
+     * Push back the time at which the route times out, if it is due to.
+     *
+     * @param t new time, ignored if it is before the current one.
+     */
+    void postpone_timeout(const TimeVal& t);
 
     /**
      * @return policy-tags associated with route.
@@ -226,6 +236,7 @@ public:
 
 private:
     friend class RouteEntryRef<A>;
+    friend class RouteEntryOrigin<A>;
     void ref()				{ _ref_cnt++; }
     uint16_t unref()			{ return --_ref_cnt; }
     uint16_t ref_cnt() const		{ return _ref_cnt; }
@@ -244,8 +255,10 @@ protected:
     uint16_t	_tag;
     uint16_t	_ref_cnt;
 
-    XorpTimer	_timer;
-    
+    TimeVal	_timeout;
+    TimeoutCallback _timeout_cb;
+    int32_t	_timeout_bucket;	// Bucket in origin, 0 if none
+
     PolicyTags	_policytags;
     bool	_filtered;
 };
@@ -309,6 +322,7 @@ class RouteEntryOrigin :
 public:
     typedef RouteEntry<A> Route;
     typedef IPNet<A>	  Net;
+    typedef typename Route::TimeoutCallback TimeoutCallback;
     struct RouteEntryStore;
 
 public:
@@ -358,6 +372,30 @@ public:
      */
     void dump_routes(vector<const Route*>& routes) const;
 
+    /**
+     * Schedule a route associated with this RouteEntryOrigin to time out.
+     *
+     * Routes due to time out are kept in buckets by the second they are
+     * due, and one timer per origin sweeps the buckets.  A route is only
+     * moved to a later bucket when its bucket comes up, so pushing back
+     * the timeout of a route, as a refresh does, just records the time.
+     * Scheduling replaces any timeout the route already had.
+     *
+     * @param r route to time out.
+     * @param e event loop to run the sweep timer on.
+     * @param secs seconds from now before the route times out.
+     * @param cb callback invoked with the route when it times out.
+     */
+    void schedule_timeout(Route* r, EventLoop& e, uint32_t secs,
+			  const TimeoutCallback& cb);
+
+    /**
+     * Cancel the timeout of a route, if any.
+     *
+     * @param r route associated with this RouteEntryOrigin.
+     */
+    void unschedule_timeout(Route* r);
+
     /**
      * Retrieve number of seconds before routes associated with this
      * RouteEntryOrigin should be marked as expired.  A return value of 0
@@ -372,6 +410,10 @@ public:
     virtual uint32_t deletion_secs() const = 0;
 
 protected:
+    void queue_timeout(Route* r);
+    void unqueue_timeout(Route* r);
+    void sweep_timeouts();
+
     struct RouteEntryStore* _rtstore;
 
 private:
@@ -110,6 +110,16 @@ public:
 	_policy_filters.reset(filter);
     }
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter id of filter to report on.
+     * @return human readable statistics of the filter.
+     */
+    string filter_statistics(const uint32_t& filter) {
+	return _policy_filters.statistics(filter);
+    }
+
     /**
      * Push routes through policy filters for re-filtering.
      */
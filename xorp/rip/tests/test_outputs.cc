@@ -266,6 +266,10 @@ ResponseReader<IPv4>::get(IPNet<IPv4>& 	n,
 	return false;
 
     const PacketRouteEntry<IPv4> pre(pre_ptr);
+    if (pre.is_auth_entry()) {
+	_pe++;
+	return get(n, nh, cost, tag);
+    }
     n 	 = pre.net();
     nh 	 = pre.nexthop();
     cost = pre.metric();
@@ -493,6 +497,23 @@ public:
 
 static const IfMgrIfTree ift_dummy = IfMgrIfTree();
 
+//
+// OutputTable keeping its packets, as ports use it for periodic updates.
+//
+template <typename A>
+class CachedOutputTable : public OutputTable<A>
+{
+public:
+    CachedOutputTable(EventLoop&	e,
+		      Port<A>&		port,
+		      PacketQueue<A>&	pkt_queue,
+		      RouteDB<A>&	rdb)
+	: OutputTable<A>(e, port, pkt_queue, rdb,
+			 RIP_AF_CONSTANTS<A>::IP_GROUP(),
+			 RIP_AF_CONSTANTS<A>::IP_PORT, true)
+    {}
+};
+
 template <typename A, typename OutputClass>
 class OutputTester
 {
@@ -596,6 +617,255 @@ protected:
     const set<IPNet<A> >& _tpn;
     const set<IPNet<A> >& _opn;
 };
+// ----------------------------------------------------------------------------
+// CachedDumpTester
+//
+// Runs a series of periodic dumps from an OutputTable keeping its packets
+// alongside a plain OutputTable, changing the routes and the port between
+// dumps.  Each dump of the cached table must advertise the same routes, with
+// the same next hops, costs and tags, as the plain table does.
+//
+
+template <typename A>
+static bool set_plaintext_auth(Port<A>& port);
+
+template <>
+bool
+set_plaintext_auth(Port<IPv4>& port)
+{
+    PlaintextAuthHandler* ah = new PlaintextAuthHandler();
+    ah->set_key("test");
+    delete port.af_state().set_auth_handler(ah);
+    return true;
+}
+
+template <>
+bool
+set_plaintext_auth(Port<IPv6>& /* port */)
+{
+    return false;	// No authentication with IPv6
+}
+
+template <typename A>
+class CachedDumpTester : public OutputTester<A, OutputTable<A> >
+{
+public:
+    typedef map<IPNet<A>, string> DumpedRoutes;
+
+    CachedDumpTester(const set<IPNet<A> >& test_peer_nets,
+		     const set<IPNet<A> >& other_peer_nets)
+	: OutputTester<A, OutputTable<A> >(test_peer_nets, other_peer_nets)
+    {
+	// Poisoned routes get deleted while the test runs.
+	this->_pm.test_port()->constants().set_deletion_secs(1);
+	this->_pm.other_port()->constants().set_deletion_secs(1);
+	this->_pm.test_port()->constants().set_interpacket_delay_ms(1);
+    }
+
+    int
+    run_test()
+    {
+	RouteDB<A>& rdb = this->_rip_system.route_db();
+
+	this->_pm.test_port()->set_horizon(NONE);
+
+	// Routes are already there when the tables are created.
+	if (update_routes(this->_tpn, this->_pm.test_peer(), 0, 5)
+	    || update_routes(this->_opn, this->_pm.other_peer(), 0, 5))
+	    return 1;
+
+	PacketQueue<A>		plain_out;
+	PacketQueue<A>		cached_out;
+	OutputTable<A>		plain(this->_e, *this->_pm.test_port(),
+				      plain_out, rdb);
+	CachedOutputTable<A>	cached(this->_e, *this->_pm.test_port(),
+				       cached_out, rdb);
+
+	if (dump("first", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	// Nothing changed: packets are sent again as they are.
+	if (dump("unchanged", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	// New costs for some routes, new routes from the other peer.
+	if (update_routes(this->_tpn, this->_pm.test_peer(), 3, 7)
+	    || update_routes(this->_opn, this->_pm.other_peer(), 5, 2))
+	    return 1;
+	set<IPNet<A> > all_nets;
+	make_nets<A>(all_nets, this->_tpn.size() + this->_opn.size() + 40);
+	set<IPNet<A> > extra;
+	for (typename set<IPNet<A> >::const_iterator i = all_nets.begin();
+	     i != all_nets.end(); ++i) {
+	    if (this->_tpn.count(*i) == 0 && this->_opn.count(*i) == 0)
+		extra.insert(*i);
+	    if (extra.size() == 40)
+		break;
+	}
+	if (update_routes(extra, this->_pm.other_peer(), 0, 3))
+	    return 1;
+	if (dump("changed", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	// Poisoned routes are advertised at infinity...
+	if (update_routes(this->_tpn, this->_pm.test_peer(), 4, RIP_INFINITY)
+	    || update_routes(this->_opn, this->_pm.other_peer(), 6,
+			     RIP_INFINITY))
+	    return 1;
+	if (dump("poisoned", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	// ... until their deletion timer removes them from the table.
+	bool timeout = false;
+	XorpTimer tot = this->_e.set_flag_after_ms(5000, &timeout);
+	while (poisoned_routes() != 0 && timeout == false)
+	    this->_e.run();
+	if (timeout) {
+	    verbose_log("Poisoned routes not deleted!\n");
+	    return 1;
+	}
+	if (dump("deleted", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	this->_pm.test_port()->set_horizon(SPLIT);
+	if (dump("split horizon", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	this->_pm.test_port()->set_horizon(SPLIT_POISON_REVERSE);
+	if (dump("poison reverse", plain, plain_out, cached, cached_out))
+	    return 1;
+
+	if (set_plaintext_auth(*this->_pm.test_port())) {
+	    if (update_routes(this->_opn, this->_pm.other_peer(), 7, 9))
+		return 1;
+	    if (dump("authentication", plain, plain_out, cached, cached_out))
+		return 1;
+	}
+
+	return dump("last", plain, plain_out, cached, cached_out);
+    }
+
+protected:
+    /**
+     * Update one route in every step of the given nets.
+     */
+    int
+    update_routes(const set<IPNet<A> >& nets, RouteEntryOrigin<A>* reo,
+		  uint32_t step, uint32_t cost)
+    {
+	string ifname, vifname;		// XXX: not set, because not needed
+	RouteDB<A>& rdb = this->_rip_system.route_db();
+	uint32_t n = 0;
+
+	for (typename set<IPNet<A> >::const_iterator i = nets.begin();
+	     i != nets.end(); ++i, ++n) {
+	    if (step != 0 && n % step != 0)
+		continue;
+	    if (rdb.update_route(*i, A::ZERO(), ifname, vifname, cost, n,
+				 reo, PolicyTags(), false) == false) {
+		verbose_log("Failed to update route for %s\n",
+			    i->str().c_str());
+		return 1;
+	    }
+	}
+	return 0;
+    }
+
+    uint32_t
+    poisoned_routes()
+    {
+	vector<typename RouteDB<A>::ConstDBRouteEntry> routes;
+	this->_rip_system.route_db().dump_routes(routes);
+
+	uint32_t n = 0;
+	for (size_t i = 0; i < routes.size(); i++) {
+	    if (routes[i]->cost() == RIP_INFINITY)
+		n++;
+	}
+	return n;
+    }
+
+    /**
+     * Collect the routes advertised by the packets of a queue.
+     */
+    int
+    collect(PacketQueue<A>& q, DumpedRoutes& routes)
+    {
+	IPNet<A> n;
+	A	 nh;
+	uint32_t cost;
+	uint32_t tag;
+
+	while (q.empty() == false) {
+	    ResponseReader<A> rr(q.head());
+	    while (rr.get(n, nh, cost, tag) == true) {
+		string s = c_format("%s cost %u tag %u", nh.str().c_str(),
+				    XORP_UINT_CAST(cost),
+				    XORP_UINT_CAST(tag));
+		if (routes.insert(make_pair(n, s)).second == false) {
+		    verbose_log("%s advertised twice\n", n.str().c_str());
+		    return 1;
+		}
+	    }
+	    q.pop_head();
+	}
+	return 0;
+    }
+
+    int
+    dump(const char* what,
+	 OutputTable<A>& plain, PacketQueue<A>& plain_out,
+	 OutputTable<A>& cached, PacketQueue<A>& cached_out)
+    {
+	verbose_log("Dump %s\n", what);
+
+	plain.start();
+	cached.start();
+
+	bool timeout = false;
+	XorpTimer tot = this->_e.set_flag_after_ms(10000, &timeout);
+	while ((plain.running() || cached.running()) && timeout == false)
+	    this->_e.run();
+	if (timeout) {
+	    verbose_log("Timed out!\n");
+	    return 1;
+	}
+
+	DumpedRoutes plain_routes;
+	DumpedRoutes cached_routes;
+	if (collect(plain_out, plain_routes)
+	    || collect(cached_out, cached_routes))
+	    return 1;
+
+	typename DumpedRoutes::const_iterator i = plain_routes.begin();
+	typename DumpedRoutes::const_iterator j = cached_routes.begin();
+	while (i != plain_routes.end() || j != cached_routes.end()) {
+	    if (j == cached_routes.end()
+		|| (i != plain_routes.end() && i->first < j->first)) {
+		verbose_log("%s missing from cached dump\n",
+			    i->first.str().c_str());
+		return 1;
+	    }
+	    if (i == plain_routes.end() || j->first < i->first) {
+		verbose_log("%s only in cached dump\n",
+			    j->first.str().c_str());
+		return 1;
+	    }
+	    if (i->second != j->second) {
+		verbose_log("%s: %s in cached dump, %s expected\n",
+			    i->first.str().c_str(), j->second.c_str(),
+			    i->second.c_str());
+		return 1;
+	    }
+	    ++i;
+	    ++j;
+	}
+
+	verbose_log("%u routes\n", XORP_UINT_CAST(plain_routes.size()));
+	return 0;
+    }
+};
+
 
 
 /**
@@ -708,6 +978,45 @@ run_all_test_cases()
 	OutputTester<A, OutputTable<A> > tester(tpn, opn);
 	PoisonReverseValidator<A> prv(tpn, opn);
 	rval |= tester.run_test(SPLIT_POISON_REVERSE, prv);
+	if (rval)
+	    return rval;
+    }
+
+    //
+    // OutputTable class tests, with packets kept between dumps
+    //
+    {
+	verbose_log("=== IPv%u No Horizon cached table test ===\n",
+		    XORP_UINT_CAST(A::ip_version()));
+	OutputTester<A, CachedOutputTable<A> > tester(tpn, opn);
+	NoHorizonValidator<A> nohv(tpn, opn);
+	rval |= tester.run_test(NONE, nohv);
+	if (rval)
+	    return rval;
+    }
+    {
+	verbose_log("=== IPv%u Split Horizon cached table test ===\n",
+		    XORP_UINT_CAST(A::ip_version()));
+	OutputTester<A, CachedOutputTable<A> > tester(tpn, opn);
+	SplitHorizonValidator<A> shv(tpn, opn);
+	rval |= tester.run_test(SPLIT, shv);
+	if (rval)
+	    return rval;
+    }
+    {
+	verbose_log("=== IPv%u Split Horizon Poison Reverse cached table "
+		    "test ===\n", XORP_UINT_CAST(A::ip_version()));
+	OutputTester<A, CachedOutputTable<A> > tester(tpn, opn);
+	PoisonReverseValidator<A> prv(tpn, opn);
+	rval |= tester.run_test(SPLIT_POISON_REVERSE, prv);
+	if (rval)
+	    return rval;
+    }
+    {
+	verbose_log("=== IPv%u cached table dumps test ===\n",
+		    XORP_UINT_CAST(A::ip_version()));
+	CachedDumpTester<A> tester(tpn, opn);
+	rval |= tester.run_test();
     }
     return rval;
 }
@@ -173,7 +173,7 @@ public:
 		return false;
 	    }
 	    if (wait_on_expiring) {
-		TimeVal delta = rw->current_route()->timer().expiry() - now;
+		TimeVal delta = rw->current_route()->timeout() - now;
 		if (delta < ten_ms) {
 		    verbose_log("Pausing on route about to be expired "
 				"or deleted (expiry in %d.%06d secs).\n",
@@ -307,6 +307,9 @@ public:
 
     XrlCmdError policy_backend_0_1_push_routes();
 
+    XrlCmdError policy_backend_0_1_get_statistics(const uint32_t& filter,
+						  string& statistics);
+
 
     XrlCmdError policy_redistx_0_1_add_routex(const IPNet<A>&	    net,
 					      const bool&	    unicast,
@@ -1294,6 +1297,21 @@ XrlRipCommonTarget<A>::policy_backend_0_1_push_routes()
     return XrlCmdError::OKAY();
 }
 
+template <typename A>
+XrlCmdError
+XrlRipCommonTarget<A>::policy_backend_0_1_get_statistics(
+    const uint32_t& filter,
+    string& statistics)
+{
+    try {
+	statistics = _rip_system.filter_statistics(filter);
+    } catch(const PolicyException& e) {
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+    return XrlCmdError::OKAY();
+}
+
 template <typename A>
 XrlCmdError 
 XrlRipCommonTarget<A>::policy_redistx_0_1_add_routex(const IPNet<A>&	net,
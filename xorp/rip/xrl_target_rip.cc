@@ -809,6 +809,13 @@ XrlRipTarget::policy_backend_0_1_push_routes()
     return _ct->policy_backend_0_1_push_routes();
 }
 
+XrlCmdError
+XrlRipTarget::policy_backend_0_1_get_statistics(const uint32_t& filter,
+						string& statistics)
+{
+    return _ct->policy_backend_0_1_get_statistics(filter, statistics);
+}
+
 XrlCmdError 
 XrlRipTarget::policy_redist4_0_1_add_route4(const IPv4Net&	network,
 					    const bool&		unicast,
@@ -340,6 +340,12 @@ public:
 
     XrlCmdError policy_backend_0_1_push_routes();
 
+    XrlCmdError policy_backend_0_1_get_statistics(
+        // Input values,
+        const uint32_t& filter,
+        // Output values,
+        string&         statistics);
+
     XrlCmdError policy_redist4_0_1_add_route4(
         // Input values,
         const IPv4Net&  network,
@@ -534,6 +534,13 @@ XrlRipngTarget::policy_backend_0_1_push_routes()
     return _ct->policy_backend_0_1_push_routes();
 }
 
+XrlCmdError
+XrlRipngTarget::policy_backend_0_1_get_statistics(const uint32_t& filter,
+						  string& statistics)
+{
+    return _ct->policy_backend_0_1_get_statistics(filter, statistics);
+}
+
 XrlCmdError 
 XrlRipngTarget::policy_redist6_0_1_add_route6(const IPv6Net&	    network,
 					      const bool&	    unicast,
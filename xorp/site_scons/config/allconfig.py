@@ -146,6 +146,9 @@ def DoAllConfig(env, conf, host_os):
     has_libxnet = conf.CheckLib('xnet')
     has_recvmsg = conf.CheckFunc('recvmsg')
     has_sendmsg = conf.CheckFunc('sendmsg')
+    # linux: several datagrams per system call
+    has_recvmmsg = conf.CheckFunc('recvmmsg')
+    has_sendmmsg = conf.CheckFunc('sendmmsg')
     
     # may be in -lrt
     has_librt = conf.CheckLib('rt')
@@ -877,6 +880,13 @@ def DoAllConfig(env, conf, host_os):
         print "  After install, rm -fr xorp/obj build directory to"
         print "  clear the configure cache before re-building.\n"
 
+    # linux: memory-mapped AF_PACKET receive ring for l2 comms.
+    #  The filter programs are still compiled with libpcap.
+    has_tpacket_v3 = conf.CheckDeclaration('TPACKET_V3',
+					   '#include <linux/if_packet.h>')
+    if has_tpacket_v3:
+        conf.Define('HAVE_TPACKET_V3')
+
     # pcap filtering can be used to cut down on un-needed netlink packets.
     #  This is a performance gain only, can function fine without it.
     prereq_pcap_bpf = []
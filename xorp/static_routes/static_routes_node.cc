@@ -1249,6 +1249,11 @@ StaticRoutesNode::reset_filter(const uint32_t& filter) {
     _policy_filters.reset(filter);
 }
 
+string
+StaticRoutesNode::filter_statistics(const uint32_t& filter) {
+    return _policy_filters.statistics(filter);
+}
+
 void
 StaticRoutesNode::push_routes()
 {
@@ -37,34 +37,29 @@ StaticRoutesVarRW::start_read()
     initialize(_route.policytags());
 
     if (_is_ipv4) {
-	initialize(VAR_NETWORK4,
-		   _ef.create(ElemIPv4Net::id,
-			      _route.network().str().c_str()));
-	initialize(VAR_NEXTHOP4,
-		   _ef.create(ElemIPv4NextHop::id,
-			      _route.nexthop().str().c_str()));
+	_network4.set_val(_route.network().get_ipv4net());
+	_nexthop4.set_val(_route.nexthop().get_ipv4());
+
+	initialize_typed(VAR_NETWORK4, _network4);
+	initialize_typed(VAR_NEXTHOP4, _nexthop4);
 	
 	initialize(VAR_NETWORK6, NULL);
 	initialize(VAR_NEXTHOP6, NULL);
     }
 
     if (_is_ipv6) {
-	initialize(VAR_NETWORK6,
-		   _ef.create(ElemIPv6Net::id,
-			      _route.network().str().c_str()));
-	initialize(VAR_NEXTHOP6,
-		   _ef.create(ElemIPv6NextHop::id,
-			      _route.nexthop().str().c_str()));
+	_network6.set_val(_route.network().get_ipv6net());
+	_nexthop6.set_val(_route.nexthop().get_ipv6());
+
+	initialize_typed(VAR_NETWORK6, _network6);
+	initialize_typed(VAR_NEXTHOP6, _nexthop6);
 
 	initialize(VAR_NETWORK4, NULL);
 	initialize(VAR_NEXTHOP4, NULL);
     }
 
-    ostringstream oss;
-
-    oss << _route.metric();
-
-    initialize(VAR_METRIC, _ef.create(ElemU32::id, oss.str().c_str()));
+    _metric.set_val(_route.metric());
+    initialize_typed(VAR_METRIC, _metric);
 }
 
 void
@@ -24,7 +24,7 @@
 #define __STATIC_ROUTES_STATIC_ROUTES_VARRW_HH__
 
 #include "policy/backend/single_varrw.hh"
-#include "policy/common/element_factory.hh"
+#include "policy/common/element.hh"
 #include "static_routes_node.hh"
 
 /**
@@ -51,9 +51,15 @@ public:
 
 private:
     StaticRoute&	_route;
-    ElementFactory	_ef;
     bool		_is_ipv4;
     bool		_is_ipv6;
+
+    // Values read from the route
+    ElemIPv4Net		_network4;
+    ElemIPv4NextHop	_nexthop4;
+    ElemIPv6Net		_network6;
+    ElemIPv6NextHop	_nexthop6;
+    ElemU32		_metric;
 };
 
 #endif // __STATIC_ROUTES_STATIC_ROUTES_VARRW_HH__
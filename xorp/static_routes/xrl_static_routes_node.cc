@@ -2575,3 +2575,17 @@ XrlStaticRoutesNode::policy_backend_0_1_push_routes()
     StaticRoutesNode::push_routes(); 
     return XrlCmdError::OKAY();
 }
+
+XrlCmdError
+XrlStaticRoutesNode::policy_backend_0_1_get_statistics(const uint32_t& filter,
+                                                       string& statistics)
+{
+    try {
+	statistics = StaticRoutesNode::filter_statistics(filter);
+    } catch(const PolicyException& e) {
+	return XrlCmdError::COMMAND_FAILED("Filter statistics failed: " +
+					   e.str());
+    }
+
+    return XrlCmdError::OKAY();
+}
@@ -564,6 +564,18 @@ protected:
      */
     XrlCmdError policy_backend_0_1_push_routes();
 
+    /**
+     * Obtain the statistics of a policy filter.
+     *
+     * @param filter identifier of filter to report on.
+     * @param statistics human readable statistics of the filter.
+     */
+    XrlCmdError policy_backend_0_1_get_statistics(
+        // Input values,
+        const uint32_t& filter,
+        // Output values,
+        string&         statistics);
+
 
 private:
     const ServiceBase* ifmgr_mirror_service_base() const {
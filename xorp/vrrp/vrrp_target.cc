@@ -27,6 +27,8 @@
 #include "libxorp/xlog.h"
 #include "libxorp/status_codes.h"
 
+#include "libfeaclient/raw_packet_batch.hh"
+
 #include "vrrp_target.hh"
 #include "vrrp_exception.hh"
 
@@ -730,6 +732,46 @@ VrrpTarget::raw_packet4_client_0_1_recv(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+VrrpTarget::raw_packet4_client_0_1_recv_batch(
+        // Input values,
+        const XrlAtomList&      if_names,
+        const XrlAtomList&      vif_names,
+        const XrlAtomList&      src_addresses,
+        const XrlAtomList&      dst_addresses,
+        const XrlAtomList&      ip_protocols,
+        const XrlAtomList&      ip_ttls,
+        const XrlAtomList&      ip_toses,
+        const XrlAtomList&      ip_router_alerts,
+        const XrlAtomList&      ip_internet_controls,
+        const XrlAtomList&      payloads)
+{
+    RawPacketBatch batch(if_names, vif_names, src_addresses, dst_addresses,
+			 ip_protocols, ip_ttls, ip_toses, ip_router_alerts,
+			 ip_internet_controls, payloads);
+    string error_msg;
+
+    if (batch.check(AF_INET, error_msg) != XORP_OK)
+	return XrlCmdError::BAD_ARGS(error_msg);
+
+    for (size_t i = 0; i < batch.size(); i++) {
+	XrlCmdError e = raw_packet4_client_0_1_recv(batch.if_name(i),
+						    batch.vif_name(i),
+						    batch.src_address4(i),
+						    batch.dst_address4(i),
+						    batch.ip_protocol(i),
+						    batch.ip_ttl(i),
+						    batch.ip_tos(i),
+						    batch.ip_router_alert(i),
+						    batch.ip_internet_control(i),
+						    batch.payload(i));
+	if (e != XrlCmdError::OKAY())
+	    return e;
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 VrrpTarget::raw_link_client_0_1_recv(
         // Input values,
@@ -255,6 +255,19 @@ protected:
         const bool&     ip_internet_control,
         const vector<uint8_t>&  payload);
 
+    XrlCmdError raw_packet4_client_0_1_recv_batch(
+        // Input values,
+        const XrlAtomList&      if_names,
+        const XrlAtomList&      vif_names,
+        const XrlAtomList&      src_addresses,
+        const XrlAtomList&      dst_addresses,
+        const XrlAtomList&      ip_protocols,
+        const XrlAtomList&      ip_ttls,
+        const XrlAtomList&      ip_toses,
+        const XrlAtomList&      ip_router_alerts,
+        const XrlAtomList&      ip_internet_controls,
+        const XrlAtomList&      payloads);
+
     XrlCmdError raw_link_client_0_1_recv(
         // Input values,
         const string&   if_name,
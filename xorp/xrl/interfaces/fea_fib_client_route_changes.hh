@@ -0,0 +1,36 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __XRL_INTERFACES_FEA_FIB_CLIENT_ROUTE_CHANGES_HH__
+#define __XRL_INTERFACES_FEA_FIB_CLIENT_ROUTE_CHANGES_HH__
+
+//
+// The route change codes of the fea_fib_client route_changes4 and
+// route_changes6 XRLs (see fea_fib_client.xif).  The values are on the
+// wire: don't change them.
+//
+enum {
+    FIB_CLIENT_ROUTE_ADD	= 0,	// As add_route4/6
+    FIB_CLIENT_ROUTE_REPLACE	= 1,	// As replace_route4/6: reserved,
+					// the FEA reports a changed route
+					// as an add, but clients accept it
+    FIB_CLIENT_ROUTE_DELETE	= 2	// As delete_route4/6
+};
+
+#endif // __XRL_INTERFACES_FEA_FIB_CLIENT_ROUTE_CHANGES_HH__